@@ -66,6 +66,7 @@ uint8_t adxl345_basic_init(adxl345_interface_t interface, adxl345_address_t addr
     DRIVER_ADXL345_LINK_DELAY_MS(&gs_handle, adxl345_interface_delay_ms);
     DRIVER_ADXL345_LINK_DEBUG_PRINT(&gs_handle, adxl345_interface_debug_print);
     DRIVER_ADXL345_LINK_RECEIVE_CALLBACK(&gs_handle, adxl345_interface_receive_callback);
+    DRIVER_ADXL345_LINK_CLOCK_US(&gs_handle, adxl345_interface_clock_us);
     
     /* set the interface */
     res = adxl345_set_interface(&gs_handle, interface);
@@ -707,6 +708,45 @@ uint8_t adxl345_basic_read(float g[3])
     return 0;
 }
 
+/**
+ * @brief     basic example enable or disable the data ready interrupt
+ * @param[in] enable bool value
+ * @return    status code
+ *            - 0 success
+ *            - 1 set failed
+ * @note      the data ready interrupt is mapped to the interrupt pin 1,
+ *            the pin is released after the data is read
+ */
+uint8_t adxl345_basic_set_data_ready(adxl345_bool_t enable)
+{
+    /* set data ready interrupt */
+    if (adxl345_set_interrupt(&gs_handle, ADXL345_INTERRUPT_DATA_READY, enable) != 0)
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     basic example set the output data rate
+ * @param[in] rate output data rate
+ * @return    status code
+ *            - 0 success
+ *            - 1 set failed
+ * @note      none
+ */
+uint8_t adxl345_basic_set_rate(adxl345_rate_t rate)
+{
+    /* set rate */
+    if (adxl345_set_rate(&gs_handle, rate) != 0)
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
 /**
  * @brief  basic example deinit
  * @return status code
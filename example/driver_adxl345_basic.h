@@ -103,6 +103,27 @@ extern "C"{
  */
 uint8_t adxl345_basic_init(adxl345_interface_t interface, adxl345_address_t addr_pin);
 
+/**
+ * @brief     basic example enable or disable the data ready interrupt
+ * @param[in] enable bool value
+ * @return    status code
+ *            - 0 success
+ *            - 1 set failed
+ * @note      the data ready interrupt is mapped to the interrupt pin 1,
+ *            the pin is released after the data is read
+ */
+uint8_t adxl345_basic_set_data_ready(adxl345_bool_t enable);
+
+/**
+ * @brief     basic example set the output data rate
+ * @param[in] rate output data rate
+ * @return    status code
+ *            - 0 success
+ *            - 1 set failed
+ * @note      none
+ */
+uint8_t adxl345_basic_set_rate(adxl345_rate_t rate);
+
 /**
  * @brief  basic example deinit
  * @return status code
@@ -39,8 +39,11 @@
 
 static adxl345_handle_t gs_handle;                                   /**< adxl345 handle */
 static void (*a_callback)(float (*g)[3], uint16_t len) = NULL;       /**< irq callback */
-static int16_t gs_raw[32][3];                                        /**< raw data buffer */
-static float gs_data[32][3];                                         /**< data buffer */
+static int16_t gs_raw[2][32][3];                                     /**< raw data double buffer */
+static float gs_data[2][32][3];                                      /**< data double buffer */
+static adxl345_async_request_t gs_request[2];                        /**< async read requests */
+static volatile uint8_t gs_pending[2];                               /**< request pending flags */
+static uint8_t gs_index;                                             /**< next request index */
 
 /**
  * @brief  fifo irq
@@ -61,6 +64,29 @@ uint8_t adxl345_fifo_irq_handler(void)
     }
 }
 
+/**
+ * @brief     fifo async read callback
+ * @param[in] *request pointer to an async request structure
+ * @note      none
+ */
+static void a_adxl345_fifo_read_callback(adxl345_async_request_t *request)
+{
+    uint8_t index = *((uint8_t *)request->user);
+    
+    if (request->status != 0)
+    {
+        adxl345_interface_debug_print("adxl345: read failed.\n");
+    }
+    else
+    {
+        if (a_callback != NULL)
+        {
+            a_callback(request->g, request->len);
+        }
+    }
+    gs_pending[index] = 0;
+}
+
 /**
  * @brief     fifo receive callback
  * @param[in] type irq type
@@ -72,18 +98,29 @@ static void a_adxl345_fifo_receive_callback(uint8_t type)
     {
         case ADXL345_INTERRUPT_WATERMARK :
         {
-            uint16_t len;
+            static uint8_t index[2] = {0, 1};
+            uint8_t i = gs_index;
             
-            len = 32;
-            if (adxl345_read(&gs_handle, (int16_t (*)[3])gs_raw, (float (*)[3])gs_data, (uint16_t *)&len) != 0)
+            /* this buffer is still drained or processed, the next watermark drains the fifo */
+            if (gs_pending[i] != 0)
             {
-                adxl345_interface_debug_print("adxl345: read failed.\n");
-                
                 return;
             }
-            if (a_callback != NULL)
+            
+            /* drain the fifo into the free buffer while the other one is processed */
+            gs_request[i].raw = gs_raw[i];
+            gs_request[i].g = gs_data[i];
+            gs_request[i].len = 32;
+            gs_request[i].callback = a_adxl345_fifo_read_callback;
+            gs_request[i].user = &index[i];
+            gs_pending[i] = 1;
+            gs_index = i ^ 1;
+            if (adxl345_read_async(&gs_handle, &gs_request[i]) != 0)
             {
-                a_callback(gs_data, len);
+                gs_pending[i] = 0;
+                adxl345_interface_debug_print("adxl345: read async failed.\n");
+                
+                return;
             }
             
             break;
@@ -103,7 +140,8 @@ static void a_adxl345_fifo_receive_callback(uint8_t type)
  * @return    status code
  *            - 0 success
  *            - 1 init failed
- * @note      none
+ * @note      the callback runs on the completion context of adxl345_interface_async_complete,
+ *            so the next fifo drain can run while it processes a buffer
  */
 uint8_t adxl345_fifo_init(adxl345_interface_t interface, adxl345_address_t addr_pin,
                           void (*callback)(float (*g)[3], uint16_t len))
@@ -127,6 +165,12 @@ uint8_t adxl345_fifo_init(adxl345_interface_t interface, adxl345_address_t addr_
     DRIVER_ADXL345_LINK_DELAY_MS(&gs_handle, adxl345_interface_delay_ms);
     DRIVER_ADXL345_LINK_DEBUG_PRINT(&gs_handle, adxl345_interface_debug_print);
     DRIVER_ADXL345_LINK_RECEIVE_CALLBACK(&gs_handle, a_adxl345_fifo_receive_callback);
+    DRIVER_ADXL345_LINK_ASYNC_SUBMIT(&gs_handle, adxl345_interface_async_submit);
+    DRIVER_ADXL345_LINK_ASYNC_COMPLETE(&gs_handle, adxl345_interface_async_complete);
+    DRIVER_ADXL345_LINK_CLOCK_US(&gs_handle, adxl345_interface_clock_us);
+    gs_pending[0] = 0;
+    gs_pending[1] = 0;
+    gs_index = 0;
     
     /* set the interface */
     res = adxl345_set_interface(&gs_handle, interface);
@@ -155,6 +199,16 @@ uint8_t adxl345_fifo_init(adxl345_interface_t interface, adxl345_address_t addr_
         return 1;
     }
     
+    /* set default retry */
+    res = adxl345_set_retry(&gs_handle, ADXL345_FIFO_DEFAULT_RETRY, ADXL345_FIFO_DEFAULT_BACKOFF);
+    if (res != 0)
+    {
+        adxl345_interface_debug_print("adxl345: set retry failed.\n");
+        (void)adxl345_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
     /* set default rate */
     res = adxl345_set_rate(&gs_handle, ADXL345_FIFO_DEFAULT_RATE);
     if (res != 0)
@@ -771,6 +825,25 @@ uint8_t adxl345_fifo_init(adxl345_interface_t interface, adxl345_address_t addr_
     return 0;
 }
 
+/**
+ * @brief     fifo example set the output data rate
+ * @param[in] rate output data rate
+ * @return    status code
+ *            - 0 success
+ *            - 1 set failed
+ * @note      none
+ */
+uint8_t adxl345_fifo_set_rate(adxl345_rate_t rate)
+{
+    /* set rate */
+    if (adxl345_set_rate(&gs_handle, rate) != 0)
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
 /**
  * @brief  fifo example deinit
  * @return status code
@@ -86,6 +86,8 @@ extern "C"{
 #define ADXL345_FIFO_DEFAULT_INACTION_TIME               3                                     /**< inaction 3s */
 #define ADXL345_FIFO_DEFAULT_FREE_FALL_THRESHOLD         0.8f                                  /**< free fall threshold 0.8g */
 #define ADXL345_FIFO_DEFAULT_FREE_FALL_TIME              10                                    /**< free fall time 10 ms */
+#define ADXL345_FIFO_DEFAULT_RETRY                       3                                     /**< retry 3 times */
+#define ADXL345_FIFO_DEFAULT_BACKOFF                     1                                     /**< backoff 1 ms */
 
 /**
  * @brief  fifo irq
@@ -104,11 +106,22 @@ uint8_t adxl345_fifo_irq_handler(void);
  * @return    status code
  *            - 0 success
  *            - 1 init failed
- * @note      none
+ * @note      the callback runs on the completion context of adxl345_interface_async_complete,
+ *            so the next fifo drain can run while it processes a buffer
  */
 uint8_t adxl345_fifo_init(adxl345_interface_t interface, adxl345_address_t addr_pin,
                           void (*callback)(float (*g)[3], uint16_t len));
 
+/**
+ * @brief     fifo example set the output data rate
+ * @param[in] rate output data rate
+ * @return    status code
+ *            - 0 success
+ *            - 1 set failed
+ * @note      none
+ */
+uint8_t adxl345_fifo_set_rate(adxl345_rate_t rate);
+
 /**
  * @brief  fifo example deinit
  * @return status code
@@ -165,6 +165,7 @@ uint8_t adxl345_interrupt_init(adxl345_interface_t interface, adxl345_address_t
     DRIVER_ADXL345_LINK_DELAY_MS(&gs_handle, adxl345_interface_delay_ms);
     DRIVER_ADXL345_LINK_DEBUG_PRINT(&gs_handle, adxl345_interface_debug_print);
     DRIVER_ADXL345_LINK_RECEIVE_CALLBACK(&gs_handle, a_adxl345_interrupt_receive_callback);
+    DRIVER_ADXL345_LINK_CLOCK_US(&gs_handle, adxl345_interface_clock_us);
     
     /* set the interface */
     res = adxl345_set_interface(&gs_handle, interface);
@@ -167,6 +167,48 @@ void adxl345_interface_debug_print(const char *const fmt, ...)
     
 }
 
+/**
+ * @brief     interface async submit
+ * @param[in] *work pointer to a work function address
+ * @param[in] *arg pointer to a work argument
+ * @return    status code
+ *            - 0 success
+ *            - 1 submit failed
+ * @note      run work(arg) on an io context, a port without async support can run it directly
+ */
+uint8_t adxl345_interface_async_submit(void (*work)(void *arg), void *arg)
+{
+    work(arg);
+    
+    return 0;
+}
+
+/**
+ * @brief     interface async complete
+ * @param[in] *done pointer to a completion function address
+ * @param[in] *arg pointer to a completion argument
+ * @return    status code
+ *            - 0 success
+ *            - 1 submit failed
+ * @note      run done(arg) on a completion context outside the io context, a port without async support can run it directly
+ */
+uint8_t adxl345_interface_async_complete(void (*done)(void *arg), void *arg)
+{
+    done(arg);
+    
+    return 0;
+}
+
+/**
+ * @brief  interface clock us
+ * @return free running time in us
+ * @note   only the difference of two values is used, so it may wrap
+ */
+uint32_t adxl345_interface_clock_us(void)
+{
+    return 0;
+}
+
 /**
  * @brief     interface receive callback
  * @param[in] type irq type
@@ -0,0 +1,188 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      bus_fault.h
+ * @brief     bus fault header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef BUS_FAULT_H
+#define BUS_FAULT_H
+
+#include "driver_adxl345.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup bus_fault bus fault function
+ * @brief    bus fault function modules
+ * @{
+ */
+
+/**
+ * @brief bus fault script definition
+ * @note  one rule per line, a '#' starts a comment and "seed <num>" sets the random seed,
+ *        a rule is "<reg | lo-hi | *> <read | write | any> <fault>...", the faults are
+ *        fail=<p> which drops the transaction, truncate=<bytes>[:<p>] which moves only the bytes and fails,
+ *        stuck=<byte>[:<p>] which reads every byte as the value, delay=<us> | <lo>-<hi> | exp<mean> which
+ *        adds a fixed, uniform or exponential latency, after=<num> which skips the first matching transactions
+ *        and count=<num> which limits the injected transactions, p is a probability from 0 to 1 and 1 by default
+ */
+#define BUS_FAULT_RULES       32        /**< max rules */
+
+/**
+ * @brief bus fault type definition
+ */
+#define BUS_FAULT_TYPE_WRITE  (1 << 0)  /**< write transaction, cleared for a read */
+
+/**
+ * @brief bus fault recovery structure definition
+ */
+typedef struct bus_fault_recovery_s
+{
+    uint32_t count;             /**< recovered fault count */
+    uint32_t mean_us;           /**< mean time from a fault to the next clean transaction in us */
+    uint32_t max_us;            /**< max time from a fault to the next clean transaction in us */
+    uint32_t before_sps;        /**< samples per second read before the first fault */
+    uint32_t after_sps;         /**< samples per second read after the first recovery */
+} bus_fault_recovery_t;
+
+/**
+ * @brief     bus fault set the latency function
+ * @param[in] *delay_us pointer to a delay function in us, the latency faults are skipped if it is NULL
+ * @note      the bus interface sets the function which passes the time on its bus
+ */
+void bus_fault_set_delay(void (*delay_us)(uint32_t us));
+
+/**
+ * @brief     bus fault set the clock function
+ * @param[in] *clock_us pointer to a free running clock function in us, the recovery isn't tracked if it is NULL
+ * @note      the bus interface sets the clock its latency faults advance
+ */
+void bus_fault_set_clock(uint32_t (*clock_us)(void));
+
+/**
+ * @brief     bus fault open
+ * @param[in] *path pointer to a script file path buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 open failed
+ * @note      every bus_fault_transfer call is matched against the script until bus_fault_close
+ */
+uint8_t bus_fault_open(const char *path);
+
+/**
+ * @brief  bus fault close
+ * @return status code
+ *         - 0 success
+ *         - 1 close failed
+ * @note   none
+ */
+uint8_t bus_fault_close(void);
+
+/**
+ * @brief  bus fault check the script
+ * @return status code
+ *         - 0 not opened
+ *         - 1 opened
+ * @note   none
+ */
+uint8_t bus_fault_is_open(void);
+
+/**
+ * @brief      bus fault get the status
+ * @param[out] *transfer pointer to a transaction count buffer
+ * @param[out] *fail pointer to a dropped transaction count buffer
+ * @param[out] *truncate pointer to a truncated transaction count buffer
+ * @param[out] *stuck pointer to a stuck transaction count buffer
+ * @param[out] *delay_us pointer to an added latency buffer in us
+ * @note       none
+ */
+void bus_fault_get_status(uint32_t *transfer, uint32_t *fail, uint32_t *truncate, uint32_t *stuck, uint32_t *delay_us);
+
+/**
+ * @brief      bus fault get the recovery
+ * @param[out] *recovery pointer to a recovery structure
+ * @note       the rates are 0 when their window holds no samples or the clock isn't set
+ */
+void bus_fault_get_recovery(bus_fault_recovery_t *recovery);
+
+/**
+ * @brief         bus fault run a transaction
+ * @param[in]     type transaction type
+ * @param[in]     addr iic device write address, 0 for spi
+ * @param[in]     reg register address, the spi read and multiple bytes bits are ignored by the match
+ * @param[in,out] *buf pointer to a data buffer
+ * @param[in]     len length of the data buffer
+ * @param[in]     *transfer pointer to the real transaction function
+ * @return        status code
+ *                - 0 success
+ *                - 1 transfer failed
+ * @note          the transaction runs unchanged if the script isn't opened,
+ *                the read bytes after a truncation are 0xFF, the stuck fault only changes the read bytes
+ */
+uint8_t bus_fault_transfer(uint8_t type, uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len,
+                           uint8_t (*transfer)(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len));
+
+/**
+ * @brief     bus fault attach to a handle
+ * @param[in] *handle pointer to an adxl345 handle structure
+ * @param[in] *path pointer to a script file path buffer
+ * @param[in] *delay_us pointer to a delay function in us
+ * @return    status code
+ *            - 0 success
+ *            - 1 attach failed
+ * @note      link the bus hooks of the handle before, they are wrapped until bus_fault_detach,
+ *            the latency faults are skipped if delay_us is NULL and the recovery runs on the clock_us of the handle
+ */
+uint8_t bus_fault_attach(adxl345_handle_t *handle, const char *path, void (*delay_us)(uint32_t us));
+
+/**
+ * @brief     bus fault detach from a handle
+ * @param[in] *handle pointer to an adxl345 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 detach failed
+ * @note      the bus hooks of the handle are restored and the script is closed
+ */
+uint8_t bus_fault_detach(adxl345_handle_t *handle);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
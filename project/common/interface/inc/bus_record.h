@@ -0,0 +1,220 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      bus_record.h
+ * @brief     bus record header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef BUS_RECORD_H
+#define BUS_RECORD_H
+
+#include "driver_adxl345.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup bus_record bus record function
+ * @brief    bus record function modules
+ * @{
+ */
+
+/**
+ * @brief bus record file definition
+ * @note  the file starts with the 4 bytes magic "AXRC", 1 byte version and 3 reserved bytes,
+ *        every transaction is stored as an 8 bytes little endian timestamp in us since the record start,
+ *        1 byte type, 1 byte iic address, 1 byte register, 1 byte result, 2 bytes little endian length
+ *        and the payload which is the data read or written, a delay is stored as an entry without payload
+ *        so the replay knows which transactions the interrupt handler ran inside every delay,
+ *        the version 1 files kept a 4 bytes timestamp that wrapped after 71 minutes and are rejected
+ */
+#define BUS_RECORD_MAGIC          "AXRC"        /**< file magic */
+#define BUS_RECORD_VERSION        2             /**< file version */
+
+/**
+ * @brief bus record type definition
+ */
+#define BUS_RECORD_TYPE_WRITE     (1 << 0)      /**< write transaction, cleared for a read */
+#define BUS_RECORD_TYPE_SPI       (1 << 1)      /**< spi transaction, cleared for an iic one */
+#define BUS_RECORD_TYPE_DELAY     (1 << 2)      /**< end of a delay, no bus transaction */
+
+/**
+ * @brief     bus record open
+ * @param[in] *path pointer to a file path buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 open failed
+ * @note      every bus_record_log call is written to the file until bus_record_close
+ */
+uint8_t bus_record_open(const char *path);
+
+/**
+ * @brief  bus record close
+ * @return status code
+ *         - 0 success
+ *         - 1 close failed
+ * @note   none
+ */
+uint8_t bus_record_close(void);
+
+/**
+ * @brief     bus record log a transaction
+ * @param[in] type transaction type
+ * @param[in] addr iic device write address, 0 for spi
+ * @param[in] reg register address
+ * @param[in] *buf pointer to a payload buffer
+ * @param[in] len payload length
+ * @param[in] res transaction result
+ * @note      nothing is written if the record isn't opened,
+ *            one record is written atomically so several pthreads can log
+ */
+void bus_record_log(uint8_t type, uint8_t addr, uint8_t reg, const uint8_t *buf, uint16_t len, uint8_t res);
+
+/**
+ * @brief     bus record attach to a handle
+ * @param[in] *handle pointer to an adxl345 handle structure
+ * @param[in] *path pointer to a file path buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 attach failed
+ * @note      the bus and delay hooks of the handle are wrapped to log every transaction,
+ *            call it after the link and before adxl345_init, only one handle can be attached
+ */
+uint8_t bus_record_attach(adxl345_handle_t *handle, const char *path);
+
+/**
+ * @brief     bus record detach from a handle
+ * @param[in] *handle pointer to an adxl345 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 detach failed
+ * @note      the bus and delay hooks of the handle are restored and the file is closed
+ */
+uint8_t bus_record_detach(adxl345_handle_t *handle);
+
+/**
+ * @brief     bus replay open
+ * @param[in] *path pointer to a file path buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 open failed
+ * @note      the whole file is loaded into the memory
+ */
+uint8_t bus_replay_open(const char *path);
+
+/**
+ * @brief  bus replay close
+ * @return status code
+ *         - 0 success
+ * @note   none
+ */
+uint8_t bus_replay_close(void);
+
+/**
+ * @brief  bus replay check
+ * @return 1 if the replay is opened, otherwise 0
+ * @note   none
+ */
+uint8_t bus_replay_is_open(void);
+
+/**
+ * @brief  bus replay rewind
+ * @note   the next transaction is the first one again and the mismatch counter is cleared
+ */
+void bus_replay_rewind(void);
+
+/**
+ * @brief      bus replay get status
+ * @param[out] *pos pointer to a replayed transaction count buffer
+ * @param[out] *total pointer to a total transaction count buffer
+ * @param[out] *mismatch pointer to a mismatch count buffer
+ * @note       a mismatch is a transaction whose type, address, register, length or written payload
+ *             differs from the record, or one after the end of the record
+ */
+void bus_replay_get_status(uint32_t *pos, uint32_t *total, uint32_t *mismatch);
+
+/**
+ * @brief      bus replay peek the next transaction
+ * @param[out] *type pointer to a transaction type buffer
+ * @param[out] *addr pointer to an iic device write address buffer
+ * @param[out] *reg pointer to a register address buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 no more transactions
+ * @note       the transaction isn't consumed
+ */
+uint8_t bus_replay_peek(uint8_t *type, uint8_t *addr, uint8_t *reg);
+
+/**
+ * @brief      bus replay transaction
+ * @param[in]  type transaction type
+ * @param[in]  addr iic device write address, 0 for spi
+ * @param[in]  reg register address
+ * @param[in]  *buf pointer to a payload buffer, filled for a read
+ * @param[in]  len payload length
+ * @return     recorded result or 1 on a mismatch
+ * @note       the transactions are served in the recorded order
+ */
+uint8_t bus_replay_transfer(uint8_t type, uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len);
+
+/**
+ * @brief     bus replay attach to a handle
+ * @param[in] *handle pointer to an adxl345 handle structure
+ * @param[in] *path pointer to a file path buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 attach failed
+ * @note      the bus hooks of the handle are replaced by the replay, the bus init and deinit
+ *            do nothing and the delay only consumes its recorded entry, only one handle can be attached
+ */
+uint8_t bus_replay_attach(adxl345_handle_t *handle, const char *path);
+
+/**
+ * @brief     bus replay detach from a handle
+ * @param[in] *handle pointer to an adxl345 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 detach failed
+ * @note      the bus hooks of the handle are restored and the replay is closed
+ */
+uint8_t bus_replay_detach(adxl345_handle_t *handle);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,135 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      iic_scheduler.h
+ * @brief     iic scheduler header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef IIC_SCHEDULER_H
+#define IIC_SCHEDULER_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup iic_scheduler iic scheduler function
+ * @brief    iic scheduler function modules
+ * @{
+ */
+
+/**
+ * @brief iic scheduler max device definition
+ */
+#define IIC_SCHEDULER_MAX_DEVICE 4        /**< max devices on one bus */
+
+/**
+ * @brief     iic scheduler init
+ * @param[in] *name pointer to an iic device name buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      the bus transport is opened once and shared by all the devices,
+ *            every init must be paired with a deinit
+ */
+uint8_t iic_scheduler_init(char *name);
+
+/**
+ * @brief  iic scheduler deinit
+ * @return status code
+ *         - 0 success
+ *         - 1 deinit failed
+ * @note   the bus transport is closed by the last deinit
+ */
+uint8_t iic_scheduler_deinit(void);
+
+/**
+ * @brief      iic scheduler read
+ * @param[in]  addr iic device write address
+ * @param[in]  reg iic register address
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of the data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       addr = device_address_7bits << 1,
+ *             the prefetched registers and samples are served from the cache
+ */
+uint8_t iic_scheduler_read(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len);
+
+/**
+ * @brief     iic scheduler write
+ * @param[in] addr iic device write address
+ * @param[in] reg iic register address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      addr = device_address_7bits << 1,
+ *            a write drops the prefetched cache of the device
+ */
+uint8_t iic_scheduler_write(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len);
+
+/**
+ * @brief  iic scheduler prefetch
+ * @return status code
+ *         - 0 success
+ *         - 1 prefetch failed
+ * @note   the interrupt source and the fifo registers of all the devices are read in one combined transfer,
+ *         then every fifo entry is read as a 6 bytes segment in one combined transfer with the fullest fifo first,
+ *         the next irq handler and adxl345_read of every device are served from the cache,
+ *         the interrupt source is cleared on the chip so the irq handler of every device must run after the prefetch
+ */
+uint8_t iic_scheduler_prefetch(void);
+
+/**
+ * @brief      iic scheduler get the status
+ * @param[out] *prefetch pointer to a prefetch count buffer
+ * @param[out] *sample pointer to a buffer of the samples served from the cache
+ * @note       the counters are cleared by the first init
+ */
+void iic_scheduler_get_status(uint32_t *prefetch, uint32_t *sample);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,129 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      iic_scheduler_bus.h
+ * @brief     iic scheduler bus header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef IIC_SCHEDULER_BUS_H
+#define IIC_SCHEDULER_BUS_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup iic_scheduler_bus iic scheduler bus function
+ * @brief    iic scheduler bus transport modules, every project links its own transport
+ * @ingroup  iic_scheduler
+ * @{
+ */
+
+/**
+ * @brief iic scheduler segment structure definition
+ */
+typedef struct iic_scheduler_segment_s
+{
+    uint8_t addr;         /**< iic device write address */
+    uint8_t reg;          /**< first register address */
+    uint8_t *buf;         /**< point to a data buffer */
+    uint16_t len;         /**< data length */
+} iic_scheduler_segment_t;
+
+/**
+ * @brief      iic scheduler bus open
+ * @param[in]  *name pointer to an iic device name buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 open failed
+ * @note       called by the first iic_scheduler_init
+ */
+uint8_t iic_scheduler_bus_open(char *name);
+
+/**
+ * @brief  iic scheduler bus close
+ * @return status code
+ *         - 0 success
+ *         - 1 close failed
+ * @note   called by the last iic_scheduler_deinit
+ */
+uint8_t iic_scheduler_bus_close(void);
+
+/**
+ * @brief      iic scheduler bus read
+ * @param[in]  addr iic device write address
+ * @param[in]  reg iic register address
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of the data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       called with the scheduler mutex held
+ */
+uint8_t iic_scheduler_bus_read(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len);
+
+/**
+ * @brief     iic scheduler bus write
+ * @param[in] addr iic device write address
+ * @param[in] reg iic register address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      called with the scheduler mutex held
+ */
+uint8_t iic_scheduler_bus_write(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len);
+
+/**
+ * @brief     iic scheduler bus transfer
+ * @param[in] *segment pointer to a segment buffer
+ * @param[in] n segment number
+ * @return    status code
+ *            - 0 success
+ *            - 1 transfer failed
+ * @note      every segment is a register write and a read with a repeated start,
+ *            the segments run in the given order, called with the scheduler mutex held
+ */
+uint8_t iic_scheduler_bus_transfer(iic_scheduler_segment_t *segment, uint16_t n);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
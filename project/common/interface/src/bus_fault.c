@@ -0,0 +1,961 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      bus_fault.c
+ * @brief     bus fault source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "bus_fault.h"
+#include <math.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @brief bus fault delay type definition
+ */
+#define BUS_FAULT_DELAY_NONE        0        /**< no latency */
+#define BUS_FAULT_DELAY_UNIFORM     1        /**< uniform latency from lo to hi */
+#define BUS_FAULT_DELAY_EXP         2        /**< exponential latency with the mean lo */
+
+/**
+ * @brief bus fault register definition
+ */
+#define BUS_FAULT_REG_DATAX0        0x32     /**< data X0 register, a read of it is counted as samples */
+
+/**
+ * @brief bus fault rule structure definition
+ */
+typedef struct bus_fault_rule_s
+{
+    uint8_t reg_lo;              /**< first matched register */
+    uint8_t reg_hi;              /**< last matched register */
+    uint8_t read;                /**< match the reads */
+    uint8_t write;               /**< match the writes */
+    uint32_t fail_ppm;           /**< drop probability in ppm */
+    uint16_t truncate;           /**< moved bytes of a truncated transaction */
+    uint32_t truncate_ppm;       /**< truncate probability in ppm */
+    uint8_t stuck;               /**< stuck byte value */
+    uint32_t stuck_ppm;          /**< stuck probability in ppm */
+    uint8_t delay_type;          /**< latency distribution */
+    uint32_t delay_lo;           /**< min or mean latency in us */
+    uint32_t delay_hi;           /**< max latency in us */
+    uint32_t after;              /**< skipped matching transactions */
+    uint32_t count;              /**< max injected transactions, 0 means no limit */
+    uint32_t seen;               /**< matching transactions */
+    uint32_t hit;                /**< injected transactions */
+} bus_fault_rule_t;
+
+/**
+ * @brief global var definition
+ */
+static pthread_mutex_t gs_fault_mutex = PTHREAD_MUTEX_INITIALIZER;     /**< fault mutex */
+static bus_fault_rule_t gs_fault_rule[BUS_FAULT_RULES];                  /**< fault rules */
+static uint8_t gs_fault_rules;                                           /**< rule count */
+static uint8_t gs_fault_open;                                            /**< script opened flag */
+static uint64_t gs_fault_random;                                         /**< random state */
+static void (*gs_fault_delay_us)(uint32_t us);                           /**< delay function */
+static uint32_t gs_fault_transfer;                                       /**< transaction count */
+static uint32_t gs_fault_fail;                                           /**< dropped transaction count */
+static uint32_t gs_fault_truncate;                                       /**< truncated transaction count */
+static uint32_t gs_fault_stuck;                                          /**< stuck transaction count */
+static uint32_t gs_fault_delay;                                          /**< added latency in us */
+static uint32_t (*gs_fault_clock_us)(void);                              /**< clock function */
+static uint8_t gs_fault_down;                                            /**< faulted and not recovered flag */
+static uint32_t gs_fault_down_us;                                        /**< time of the fault */
+static uint32_t gs_fault_recover;                                        /**< recovered fault count */
+static uint64_t gs_fault_recover_sum;                                    /**< sum of the recovery time in us */
+static uint32_t gs_fault_recover_max;                                    /**< max recovery time in us */
+static uint8_t gs_fault_phase;                                           /**< 0 before the first fault, 1 faulted, 2 recovered */
+static uint32_t gs_fault_first_us;                                       /**< time of the first read sample */
+static uint32_t gs_fault_fault_us;                                       /**< time of the first fault */
+static uint32_t gs_fault_recover_us;                                     /**< time of the first recovery */
+static uint32_t gs_fault_last_us;                                        /**< time of the last read sample */
+static uint32_t gs_fault_before;                                         /**< samples read before the first fault */
+static uint32_t gs_fault_after;                                          /**< samples read after the first recovery */
+static adxl345_handle_t gs_fault_hook;                                   /**< hooks wrapped by the fault */
+
+/**
+ * @brief  get the next random number
+ * @return random number
+ * @note   xorshift64*, so a script runs the same faults with the same seed
+ */
+static uint64_t a_bus_fault_random(void)
+{
+    gs_fault_random ^= gs_fault_random >> 12;
+    gs_fault_random ^= gs_fault_random << 25;
+    gs_fault_random ^= gs_fault_random >> 27;
+    
+    return gs_fault_random * 0x2545F4914F6CDD1DULL;
+}
+
+/**
+ * @brief     roll a probability
+ * @param[in] ppm probability in ppm
+ * @return    1 if hit, 0 otherwise
+ * @note      none
+ */
+static uint8_t a_bus_fault_roll(uint32_t ppm)
+{
+    if (ppm == 0)
+    {
+        return 0;
+    }
+    
+    return ((a_bus_fault_random() % 1000000ULL) < ppm) ? 1 : 0;
+}
+
+/**
+ * @brief     get a latency of the rule
+ * @param[in] *rule pointer to a rule structure
+ * @return    latency in us
+ * @note      none
+ */
+static uint32_t a_bus_fault_delay(const bus_fault_rule_t *rule)
+{
+    double u;
+    
+    if (rule->delay_type == BUS_FAULT_DELAY_UNIFORM)
+    {
+        return rule->delay_lo + (uint32_t)(a_bus_fault_random() % ((uint64_t)rule->delay_hi - rule->delay_lo + 1));
+    }
+    else if (rule->delay_type == BUS_FAULT_DELAY_EXP)
+    {
+        /* u is in (0, 1] so the log is finite */
+        u = (double)((a_bus_fault_random() >> 11) + 1) * (1.0 / 9007199254740992.0);
+        
+        return (uint32_t)(-log(u) * rule->delay_lo + 0.5);
+    }
+    else
+    {
+        return 0;
+    }
+}
+
+/**
+ * @brief      parse a probability
+ * @param[in]  *str pointer to a string buffer, NULL means 1
+ * @param[out] *ppm pointer to a probability buffer in ppm
+ * @return     status code
+ *             - 0 success
+ *             - 1 parse failed
+ * @note       none
+ */
+static uint8_t a_bus_fault_parse_prob(const char *str, uint32_t *ppm)
+{
+    char *end;
+    double p;
+    
+    if (str == NULL)
+    {
+        *ppm = 1000000;
+        
+        return 0;
+    }
+    p = strtod(str, &end);
+    if ((end == str) || (*end != '\0') || (p < 0.0) || (p > 1.0))
+    {
+        return 1;
+    }
+    *ppm = (uint32_t)(p * 1000000.0 + 0.5);
+    
+    return 0;
+}
+
+/**
+ * @brief      parse a number with an optional probability
+ * @param[in]  *str pointer to a "<num>[:<p>]" string buffer
+ * @param[out] *value pointer to a number buffer
+ * @param[out] *ppm pointer to a probability buffer in ppm
+ * @return     status code
+ *             - 0 success
+ *             - 1 parse failed
+ * @note       none
+ */
+static uint8_t a_bus_fault_parse_value(char *str, uint32_t *value, uint32_t *ppm)
+{
+    char *end;
+    char *prob;
+    
+    prob = strchr(str, ':');
+    if (prob != NULL)
+    {
+        *prob = '\0';
+        prob++;
+    }
+    *value = (uint32_t)strtoul(str, &end, 0);
+    if ((end == str) || (*end != '\0'))
+    {
+        return 1;
+    }
+    
+    return a_bus_fault_parse_prob(prob, ppm);
+}
+
+/**
+ * @brief      parse one rule
+ * @param[in]  *line pointer to a line buffer
+ * @param[out] *rule pointer to a rule structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 parse failed
+ * @note       none
+ */
+static uint8_t a_bus_fault_parse_rule(char *line, bus_fault_rule_t *rule)
+{
+    char *save;
+    char *tok;
+    char *end;
+    char *val;
+    uint32_t value;
+    
+    memset(rule, 0, sizeof(bus_fault_rule_t));
+    
+    /* parse the registers */
+    tok = strtok_r(line, " \t", &save);
+    if (strcmp(tok, "*") == 0)
+    {
+        rule->reg_lo = 0x00;
+        rule->reg_hi = 0x3F;
+    }
+    else
+    {
+        rule->reg_lo = (uint8_t)strtoul(tok, &end, 0);
+        rule->reg_hi = rule->reg_lo;
+        if (*end == '-')
+        {
+            val = end + 1;
+            rule->reg_hi = (uint8_t)strtoul(val, &end, 0);
+            if (end == val)
+            {
+                return 1;
+            }
+        }
+        if ((end == tok) || (*end != '\0') || (rule->reg_lo > rule->reg_hi) || (rule->reg_hi > 0x3F))
+        {
+            return 1;
+        }
+    }
+    
+    /* parse the direction */
+    tok = strtok_r(NULL, " \t", &save);
+    if (tok == NULL)
+    {
+        return 1;
+    }
+    rule->read = ((strcmp(tok, "read") == 0) || (strcmp(tok, "any") == 0)) ? 1 : 0;
+    rule->write = ((strcmp(tok, "write") == 0) || (strcmp(tok, "any") == 0)) ? 1 : 0;
+    if ((rule->read == 0) && (rule->write == 0))
+    {
+        return 1;
+    }
+    
+    /* parse the faults */
+    while ((tok = strtok_r(NULL, " \t", &save)) != NULL)
+    {
+        val = strchr(tok, '=');
+        if (val == NULL)
+        {
+            return 1;
+        }
+        *val = '\0';
+        val++;
+        if (strcmp(tok, "fail") == 0)
+        {
+            if (a_bus_fault_parse_prob(val, &rule->fail_ppm) != 0)
+            {
+                return 1;
+            }
+        }
+        else if (strcmp(tok, "truncate") == 0)
+        {
+            if ((a_bus_fault_parse_value(val, &value, &rule->truncate_ppm) != 0) || (value > 0xFFFF))
+            {
+                return 1;
+            }
+            rule->truncate = (uint16_t)value;
+        }
+        else if (strcmp(tok, "stuck") == 0)
+        {
+            if ((a_bus_fault_parse_value(val, &value, &rule->stuck_ppm) != 0) || (value > 0xFF))
+            {
+                return 1;
+            }
+            rule->stuck = (uint8_t)value;
+        }
+        else if (strcmp(tok, "delay") == 0)
+        {
+            if (strncmp(val, "exp", 3) == 0)
+            {
+                rule->delay_type = BUS_FAULT_DELAY_EXP;
+                rule->delay_lo = (uint32_t)strtoul(val + 3, &end, 0);
+                if ((end == val + 3) || (*end != '\0'))
+                {
+                    return 1;
+                }
+            }
+            else
+            {
+                rule->delay_type = BUS_FAULT_DELAY_UNIFORM;
+                rule->delay_lo = (uint32_t)strtoul(val, &end, 0);
+                rule->delay_hi = rule->delay_lo;
+                if (*end == '-')
+                {
+                    rule->delay_hi = (uint32_t)strtoul(end + 1, &end, 0);
+                }
+                if ((end == val) || (*end != '\0') || (rule->delay_lo > rule->delay_hi))
+                {
+                    return 1;
+                }
+            }
+        }
+        else if (strcmp(tok, "after") == 0)
+        {
+            rule->after = (uint32_t)strtoul(val, &end, 0);
+            if ((end == val) || (*end != '\0'))
+            {
+                return 1;
+            }
+        }
+        else if (strcmp(tok, "count") == 0)
+        {
+            rule->count = (uint32_t)strtoul(val, &end, 0);
+            if ((end == val) || (*end != '\0'))
+            {
+                return 1;
+            }
+        }
+        else
+        {
+            return 1;
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     track the recovery after a transaction
+ * @param[in] clean transaction succeeded without an injected fault
+ * @param[in] samples fifo entries or data samples read by the transaction
+ * @note      a fault opens a recovery that the next clean transaction closes,
+ *            the samples are counted before the first fault and after the first recovery
+ */
+static void a_bus_fault_track(uint8_t clean, uint16_t samples)
+{
+    uint32_t now;
+    uint32_t us;
+    
+    pthread_mutex_lock(&gs_fault_mutex);
+    
+    /* skip without a clock */
+    if (gs_fault_clock_us == NULL)
+    {
+        pthread_mutex_unlock(&gs_fault_mutex);
+        
+        return;
+    }
+    now = gs_fault_clock_us();
+    if (clean == 0)
+    {
+        /* open a recovery at the first fault of a run */
+        if (gs_fault_down == 0)
+        {
+            gs_fault_down = 1;
+            gs_fault_down_us = now;
+        }
+        if (gs_fault_phase == 0)
+        {
+            gs_fault_phase = 1;
+            gs_fault_fault_us = now;
+        }
+    }
+    else
+    {
+        /* close the recovery */
+        if (gs_fault_down != 0)
+        {
+            us = now - gs_fault_down_us;
+            gs_fault_down = 0;
+            gs_fault_recover++;
+            gs_fault_recover_sum += us;
+            gs_fault_recover_max = (us > gs_fault_recover_max) ? us : gs_fault_recover_max;
+            if (gs_fault_phase == 1)
+            {
+                gs_fault_phase = 2;
+                gs_fault_recover_us = now;
+            }
+        }
+        
+        /* count the samples */
+        if (samples != 0)
+        {
+            if ((gs_fault_phase == 0) && (gs_fault_before == 0))
+            {
+                gs_fault_first_us = now;
+            }
+            if (gs_fault_phase == 0)
+            {
+                gs_fault_before += samples;
+            }
+            else if (gs_fault_phase == 2)
+            {
+                gs_fault_after += samples;
+            }
+            else
+            {
+                /* no window while faulted */
+            }
+            gs_fault_last_us = now;
+        }
+    }
+    pthread_mutex_unlock(&gs_fault_mutex);
+}
+
+/**
+ * @brief     bus fault set the clock function
+ * @param[in] *clock_us pointer to a free running clock function in us, the recovery isn't tracked if it is NULL
+ * @note      the bus interface sets the clock its latency faults advance
+ */
+void bus_fault_set_clock(uint32_t (*clock_us)(void))
+{
+    pthread_mutex_lock(&gs_fault_mutex);
+    gs_fault_clock_us = clock_us;
+    pthread_mutex_unlock(&gs_fault_mutex);
+}
+
+/**
+ * @brief     bus fault set the latency function
+ * @param[in] *delay_us pointer to a delay function in us, the latency faults are skipped if it is NULL
+ * @note      the bus interface sets the function which passes the time on its bus
+ */
+void bus_fault_set_delay(void (*delay_us)(uint32_t us))
+{
+    pthread_mutex_lock(&gs_fault_mutex);
+    gs_fault_delay_us = delay_us;
+    pthread_mutex_unlock(&gs_fault_mutex);
+}
+
+/**
+ * @brief     bus fault open
+ * @param[in] *path pointer to a script file path buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 open failed
+ * @note      every bus_fault_transfer call is matched against the script until bus_fault_close
+ */
+uint8_t bus_fault_open(const char *path)
+{
+    FILE *file;
+    char line[256];
+    char *p;
+    char *end;
+    uint32_t n;
+    uint8_t rules;
+    uint64_t seed;
+    
+    /* check the script */
+    if (gs_fault_open != 0)
+    {
+        return 1;
+    }
+    
+    /* open the file */
+    file = fopen(path, "r");
+    if (file == NULL)
+    {
+        perror("bus fault: open failed");
+        
+        return 1;
+    }
+    
+    /* parse the rules */
+    rules = 0;
+    seed = 1;
+    n = 0;
+    while (fgets(line, sizeof(line), file) != NULL)
+    {
+        n++;
+        p = strchr(line, '#');
+        if (p != NULL)
+        {
+            *p = '\0';
+        }
+        line[strcspn(line, "\r\n")] = '\0';
+        p = line + strspn(line, " \t");
+        if (*p == '\0')
+        {
+            continue;
+        }
+        if ((strncmp(p, "seed", 4) == 0) && ((p[4] == ' ') || (p[4] == '\t')))
+        {
+            seed = strtoull(p + 4, &end, 0);
+            if ((end == p + 4) || (end[strspn(end, " \t")] != '\0'))
+            {
+                (void)fprintf(stderr, "bus fault: line %u is invalid.\n", n);
+                (void)fclose(file);
+                
+                return 1;
+            }
+            continue;
+        }
+        if ((rules >= BUS_FAULT_RULES) || (a_bus_fault_parse_rule(p, &gs_fault_rule[rules]) != 0))
+        {
+            (void)fprintf(stderr, "bus fault: line %u is invalid.\n", n);
+            (void)fclose(file);
+            
+            return 1;
+        }
+        rules++;
+    }
+    (void)fclose(file);
+    
+    /* start the script */
+    pthread_mutex_lock(&gs_fault_mutex);
+    gs_fault_rules = rules;
+    
+    /* spread a small seed with splitmix64 */
+    seed += 0x9E3779B97F4A7C15ULL;
+    seed = (seed ^ (seed >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    seed = (seed ^ (seed >> 27)) * 0x94D049BB133111EBULL;
+    seed ^= seed >> 31;
+    gs_fault_random = (seed != 0) ? seed : 1;
+    gs_fault_transfer = 0;
+    gs_fault_fail = 0;
+    gs_fault_truncate = 0;
+    gs_fault_stuck = 0;
+    gs_fault_delay = 0;
+    gs_fault_down = 0;
+    gs_fault_recover = 0;
+    gs_fault_recover_sum = 0;
+    gs_fault_recover_max = 0;
+    gs_fault_phase = 0;
+    gs_fault_before = 0;
+    gs_fault_after = 0;
+    gs_fault_open = 1;
+    pthread_mutex_unlock(&gs_fault_mutex);
+    
+    return 0;
+}
+
+/**
+ * @brief  bus fault close
+ * @return status code
+ *         - 0 success
+ *         - 1 close failed
+ * @note   none
+ */
+uint8_t bus_fault_close(void)
+{
+    /* check the script */
+    if (gs_fault_open == 0)
+    {
+        return 1;
+    }
+    
+    /* stop the script */
+    pthread_mutex_lock(&gs_fault_mutex);
+    gs_fault_open = 0;
+    gs_fault_rules = 0;
+    pthread_mutex_unlock(&gs_fault_mutex);
+    
+    return 0;
+}
+
+/**
+ * @brief  bus fault check the script
+ * @return status code
+ *         - 0 not opened
+ *         - 1 opened
+ * @note   none
+ */
+uint8_t bus_fault_is_open(void)
+{
+    return gs_fault_open;
+}
+
+/**
+ * @brief      bus fault get the status
+ * @param[out] *transfer pointer to a transaction count buffer
+ * @param[out] *fail pointer to a dropped transaction count buffer
+ * @param[out] *truncate pointer to a truncated transaction count buffer
+ * @param[out] *stuck pointer to a stuck transaction count buffer
+ * @param[out] *delay_us pointer to an added latency buffer in us
+ * @note       none
+ */
+void bus_fault_get_status(uint32_t *transfer, uint32_t *fail, uint32_t *truncate, uint32_t *stuck, uint32_t *delay_us)
+{
+    pthread_mutex_lock(&gs_fault_mutex);
+    *transfer = gs_fault_transfer;
+    *fail = gs_fault_fail;
+    *truncate = gs_fault_truncate;
+    *stuck = gs_fault_stuck;
+    *delay_us = gs_fault_delay;
+    pthread_mutex_unlock(&gs_fault_mutex);
+}
+
+/**
+ * @brief      bus fault get the recovery
+ * @param[out] *recovery pointer to a recovery structure
+ * @note       the rates are 0 when their window holds no samples or the clock isn't set
+ */
+void bus_fault_get_recovery(bus_fault_recovery_t *recovery)
+{
+    uint32_t us;
+    
+    pthread_mutex_lock(&gs_fault_mutex);
+    memset(recovery, 0, sizeof(bus_fault_recovery_t));
+    recovery->count = gs_fault_recover;
+    recovery->mean_us = (gs_fault_recover != 0) ? (uint32_t)(gs_fault_recover_sum / gs_fault_recover) : 0;
+    recovery->max_us = gs_fault_recover_max;
+    us = gs_fault_fault_us - gs_fault_first_us;
+    if ((gs_fault_before != 0) && (us != 0))
+    {
+        recovery->before_sps = (uint32_t)((uint64_t)gs_fault_before * 1000000ULL / us);
+    }
+    us = gs_fault_last_us - gs_fault_recover_us;
+    if ((gs_fault_after != 0) && (us != 0))
+    {
+        recovery->after_sps = (uint32_t)((uint64_t)gs_fault_after * 1000000ULL / us);
+    }
+    pthread_mutex_unlock(&gs_fault_mutex);
+}
+
+/**
+ * @brief         bus fault run a transaction
+ * @param[in]     type transaction type
+ * @param[in]     addr iic device write address, 0 for spi
+ * @param[in]     reg register address, the spi read and multiple bytes bits are ignored by the match
+ * @param[in,out] *buf pointer to a data buffer
+ * @param[in]     len length of the data buffer
+ * @param[in]     *transfer pointer to the real transaction function
+ * @return        status code
+ *                - 0 success
+ *                - 1 transfer failed
+ * @note          the transaction runs unchanged if the script isn't opened,
+ *                the read bytes after a truncation are 0xFF, the stuck fault only changes the read bytes
+ */
+uint8_t bus_fault_transfer(uint8_t type, uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len,
+                           uint8_t (*transfer)(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len))
+{
+    uint8_t i;
+    uint8_t hit;
+    uint8_t fail;
+    uint8_t write;
+    int16_t stuck;
+    uint16_t cut;
+    uint32_t delay;
+    uint8_t res;
+    bus_fault_rule_t *rule;
+    void (*delay_us)(uint32_t us);
+    
+    /* run unchanged without a script */
+    if (gs_fault_open == 0)
+    {
+        return transfer(addr, reg, buf, len);
+    }
+    
+    /* match the rules in the script order */
+    write = ((type & BUS_FAULT_TYPE_WRITE) != 0) ? 1 : 0;
+    fail = 0;
+    stuck = -1;
+    cut = len;
+    delay = 0;
+    pthread_mutex_lock(&gs_fault_mutex);
+    gs_fault_transfer++;
+    for (i = 0; i < gs_fault_rules; i++)
+    {
+        rule = &gs_fault_rule[i];
+        if (((reg & 0x3F) < rule->reg_lo) || ((reg & 0x3F) > rule->reg_hi) ||
+            ((write != 0) ? (rule->write == 0) : (rule->read == 0)))
+        {
+            continue;
+        }
+        rule->seen++;
+        if ((rule->seen <= rule->after) || ((rule->count != 0) && (rule->hit >= rule->count)))
+        {
+            continue;
+        }
+        
+        /* roll every fault of the rule */
+        hit = 0;
+        if (rule->delay_type != BUS_FAULT_DELAY_NONE)
+        {
+            delay += a_bus_fault_delay(rule);
+            hit = 1;
+        }
+        if (a_bus_fault_roll(rule->fail_ppm) != 0)
+        {
+            fail = 1;
+            hit = 1;
+        }
+        if ((rule->truncate < len) && (a_bus_fault_roll(rule->truncate_ppm) != 0))
+        {
+            cut = (rule->truncate < cut) ? rule->truncate : cut;
+            hit = 1;
+        }
+        if ((write == 0) && (a_bus_fault_roll(rule->stuck_ppm) != 0))
+        {
+            stuck = rule->stuck;
+            hit = 1;
+        }
+        if (hit != 0)
+        {
+            rule->hit++;
+        }
+    }
+    if (fail != 0)
+    {
+        gs_fault_fail++;
+    }
+    else if (cut < len)
+    {
+        gs_fault_truncate++;
+    }
+    else if (stuck >= 0)
+    {
+        gs_fault_stuck++;
+    }
+    else
+    {
+        /* clean transaction */
+    }
+    delay_us = gs_fault_delay_us;
+    if (delay_us == NULL)
+    {
+        delay = 0;
+    }
+    gs_fault_delay += delay;
+    pthread_mutex_unlock(&gs_fault_mutex);
+    
+    /* add the latency */
+    if (delay != 0)
+    {
+        delay_us(delay);
+    }
+    
+    /* drop the transaction */
+    if (fail != 0)
+    {
+        a_bus_fault_track(0, 0);
+        
+        return 1;
+    }
+    
+    /* move only the first bytes */
+    if (cut < len)
+    {
+        if (cut != 0)
+        {
+            (void)transfer(addr, reg, buf, cut);
+        }
+        if (write == 0)
+        {
+            memset(buf + cut, 0xFF, len - cut);
+        }
+        a_bus_fault_track(0, 0);
+        
+        return 1;
+    }
+    
+    /* run the transaction */
+    res = transfer(addr, reg, buf, len);
+    if ((res == 0) && (stuck >= 0))
+    {
+        memset(buf, (uint8_t)stuck, len);
+    }
+    a_bus_fault_track(((res == 0) && (stuck < 0)) ? 1 : 0,
+                      ((write == 0) && ((reg & 0x3F) == BUS_FAULT_REG_DATAX0)) ? (uint16_t)(len / 6) : 0);
+    
+    return res;
+}
+
+/**
+ * @brief      fault spi read adapter
+ * @param[in]  addr unused address
+ * @param[in]  reg spi register address
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of the data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       none
+ */
+static uint8_t a_bus_fault_spi_read_adapter(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    (void)addr;
+    
+    return gs_fault_hook.spi_read(reg, buf, len);
+}
+
+/**
+ * @brief     fault spi write adapter
+ * @param[in] addr unused address
+ * @param[in] reg spi register address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      none
+ */
+static uint8_t a_bus_fault_spi_write_adapter(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    (void)addr;
+    
+    return gs_fault_hook.spi_write(reg, buf, len);
+}
+
+/**
+ * @brief      fault iic read hook
+ * @param[in]  addr iic device write address
+ * @param[in]  reg iic register address
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of the data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       none
+ */
+static uint8_t a_bus_fault_iic_read(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    return bus_fault_transfer(0, addr, reg, buf, len, gs_fault_hook.iic_read);
+}
+
+/**
+ * @brief     fault iic write hook
+ * @param[in] addr iic device write address
+ * @param[in] reg iic register address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      none
+ */
+static uint8_t a_bus_fault_iic_write(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    return bus_fault_transfer(BUS_FAULT_TYPE_WRITE, addr, reg, buf, len, gs_fault_hook.iic_write);
+}
+
+/**
+ * @brief      fault spi read hook
+ * @param[in]  reg spi register address
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of the data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       none
+ */
+static uint8_t a_bus_fault_spi_read(uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    return bus_fault_transfer(0, 0, reg, buf, len, a_bus_fault_spi_read_adapter);
+}
+
+/**
+ * @brief     fault spi write hook
+ * @param[in] reg spi register address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      none
+ */
+static uint8_t a_bus_fault_spi_write(uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    return bus_fault_transfer(BUS_FAULT_TYPE_WRITE, 0, reg, buf, len, a_bus_fault_spi_write_adapter);
+}
+
+/**
+ * @brief     bus fault attach to a handle
+ * @param[in] *handle pointer to an adxl345 handle structure
+ * @param[in] *path pointer to a script file path buffer
+ * @param[in] *delay_us pointer to a delay function in us
+ * @return    status code
+ *            - 0 success
+ *            - 1 attach failed
+ * @note      link the bus hooks of the handle before, they are wrapped until bus_fault_detach,
+ *            the latency faults are skipped if delay_us is NULL and the recovery runs on the clock_us of the handle
+ */
+uint8_t bus_fault_attach(adxl345_handle_t *handle, const char *path, void (*delay_us)(uint32_t us))
+{
+    /* check the handle */
+    if ((handle == NULL) || (gs_fault_hook.iic_read != NULL))
+    {
+        return 1;
+    }
+    
+    /* open the script */
+    if (bus_fault_open(path) != 0)
+    {
+        return 1;
+    }
+    bus_fault_set_delay(delay_us);
+    bus_fault_set_clock(handle->clock_us);
+    
+    /* wrap the hooks */
+    memcpy(&gs_fault_hook, handle, sizeof(adxl345_handle_t));
+    handle->iic_read = a_bus_fault_iic_read;
+    handle->iic_write = a_bus_fault_iic_write;
+    handle->spi_read = a_bus_fault_spi_read;
+    handle->spi_write = a_bus_fault_spi_write;
+    
+    return 0;
+}
+
+/**
+ * @brief     bus fault detach from a handle
+ * @param[in] *handle pointer to an adxl345 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 detach failed
+ * @note      the bus hooks of the handle are restored and the script is closed
+ */
+uint8_t bus_fault_detach(adxl345_handle_t *handle)
+{
+    /* check the handle */
+    if ((handle == NULL) || (gs_fault_hook.iic_read == NULL))
+    {
+        return 1;
+    }
+    
+    /* restore the hooks */
+    handle->iic_read = gs_fault_hook.iic_read;
+    handle->iic_write = gs_fault_hook.iic_write;
+    handle->spi_read = gs_fault_hook.spi_read;
+    handle->spi_write = gs_fault_hook.spi_write;
+    memset(&gs_fault_hook, 0, sizeof(adxl345_handle_t));
+    
+    return bus_fault_close();
+}
@@ -0,0 +1,716 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      bus_record.c
+ * @brief     bus record source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "bus_record.h"
+#include <stdlib.h>
+#include <time.h>
+
+/**
+ * @brief bus record length definition
+ */
+#define BUS_RECORD_HEADER_LEN         8         /**< file header length */
+#define BUS_RECORD_ENTRY_LEN          14        /**< transaction header length */
+
+/**
+ * @brief global var definition
+ */
+static FILE *gs_record_file = NULL;              /**< record file */
+static struct timespec gs_record_start;          /**< record start time */
+static adxl345_handle_t gs_record_hook;          /**< hooks wrapped by the record */
+static uint8_t *gs_replay_buf = NULL;            /**< replay file content */
+static uint32_t gs_replay_size;                  /**< replay file size */
+static uint32_t gs_replay_offset;                /**< next transaction offset */
+static uint32_t gs_replay_pos;                   /**< replayed transaction count */
+static uint32_t gs_replay_total;                 /**< total transaction count */
+static uint32_t gs_replay_mismatch;              /**< mismatch count */
+static adxl345_handle_t gs_replay_hook;          /**< hooks replaced by the replay */
+
+/**
+ * @brief     bus record open
+ * @param[in] *path pointer to a file path buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 open failed
+ * @note      every bus_record_log call is written to the file until bus_record_close
+ */
+uint8_t bus_record_open(const char *path)
+{
+    uint8_t header[BUS_RECORD_HEADER_LEN] = {0};
+    
+    /* check the record */
+    if (gs_record_file != NULL)
+    {
+        return 1;
+    }
+    
+    /* open the file */
+    gs_record_file = fopen(path, "wb");
+    if (gs_record_file == NULL)
+    {
+        perror("bus record: open failed");
+        
+        return 1;
+    }
+    
+    /* write the header */
+    memcpy(header, BUS_RECORD_MAGIC, 4);
+    header[4] = BUS_RECORD_VERSION;
+    if (fwrite(header, 1, BUS_RECORD_HEADER_LEN, gs_record_file) != BUS_RECORD_HEADER_LEN)
+    {
+        perror("bus record: write failed");
+        (void)fclose(gs_record_file);
+        gs_record_file = NULL;
+        
+        return 1;
+    }
+    clock_gettime(CLOCK_MONOTONIC, &gs_record_start);
+    
+    return 0;
+}
+
+/**
+ * @brief  bus record close
+ * @return status code
+ *         - 0 success
+ *         - 1 close failed
+ * @note   none
+ */
+uint8_t bus_record_close(void)
+{
+    int res;
+    
+    /* check the record */
+    if (gs_record_file == NULL)
+    {
+        return 1;
+    }
+    
+    /* close the file */
+    res = fclose(gs_record_file);
+    gs_record_file = NULL;
+    if (res != 0)
+    {
+        perror("bus record: close failed");
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     bus record log a transaction
+ * @param[in] type transaction type
+ * @param[in] addr iic device write address, 0 for spi
+ * @param[in] reg register address
+ * @param[in] *buf pointer to a payload buffer
+ * @param[in] len payload length
+ * @param[in] res transaction result
+ * @note      nothing is written if the record isn't opened,
+ *            one record is written atomically so several pthreads can log
+ */
+void bus_record_log(uint8_t type, uint8_t addr, uint8_t reg, const uint8_t *buf, uint16_t len, uint8_t res)
+{
+    uint8_t entry[BUS_RECORD_ENTRY_LEN];
+    uint64_t us;
+    uint8_t i;
+    struct timespec now;
+    
+    /* check the record */
+    if (gs_record_file == NULL)
+    {
+        return;
+    }
+    
+    /* set the entry */
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    us = (uint64_t)((int64_t)(now.tv_sec - gs_record_start.tv_sec) * 1000000LL +
+                    (int64_t)(now.tv_nsec - gs_record_start.tv_nsec) / 1000LL);
+    for (i = 0; i < 8; i++)
+    {
+        entry[i] = (uint8_t)(us >> (8 * i));
+    }
+    entry[8] = type;
+    entry[9] = addr;
+    entry[10] = reg;
+    entry[11] = res;
+    entry[12] = (uint8_t)(len >> 0);
+    entry[13] = (uint8_t)(len >> 8);
+    
+    /* write the entry and the payload together */
+    flockfile(gs_record_file);
+    (void)fwrite(entry, 1, BUS_RECORD_ENTRY_LEN, gs_record_file);
+    if (len != 0)
+    {
+        (void)fwrite(buf, 1, len, gs_record_file);
+    }
+    funlockfile(gs_record_file);
+}
+
+/**
+ * @brief      record iic read hook
+ * @param[in]  addr iic device write address
+ * @param[in]  reg iic register address
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of the data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       none
+ */
+static uint8_t a_bus_record_iic_read(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    uint8_t res;
+    
+    res = gs_record_hook.iic_read(addr, reg, buf, len);
+    bus_record_log(0, addr, reg, buf, len, res);
+    
+    return res;
+}
+
+/**
+ * @brief     record iic write hook
+ * @param[in] addr iic device write address
+ * @param[in] reg iic register address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      none
+ */
+static uint8_t a_bus_record_iic_write(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    uint8_t res;
+    
+    res = gs_record_hook.iic_write(addr, reg, buf, len);
+    bus_record_log(BUS_RECORD_TYPE_WRITE, addr, reg, buf, len, res);
+    
+    return res;
+}
+
+/**
+ * @brief      record spi read hook
+ * @param[in]  reg register address
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of the data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       none
+ */
+static uint8_t a_bus_record_spi_read(uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    uint8_t res;
+    
+    res = gs_record_hook.spi_read(reg, buf, len);
+    bus_record_log(BUS_RECORD_TYPE_SPI, 0, reg, buf, len, res);
+    
+    return res;
+}
+
+/**
+ * @brief     record spi write hook
+ * @param[in] reg register address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      none
+ */
+static uint8_t a_bus_record_spi_write(uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    uint8_t res;
+    
+    res = gs_record_hook.spi_write(reg, buf, len);
+    bus_record_log(BUS_RECORD_TYPE_SPI | BUS_RECORD_TYPE_WRITE, 0, reg, buf, len, res);
+    
+    return res;
+}
+
+/**
+ * @brief     record delay hook
+ * @param[in] ms time
+ * @note      none
+ */
+static void a_bus_record_delay_ms(uint32_t ms)
+{
+    gs_record_hook.delay_ms(ms);
+    bus_record_log(BUS_RECORD_TYPE_DELAY, 0, 0, NULL, 0, 0);
+}
+
+/**
+ * @brief     bus record attach to a handle
+ * @param[in] *handle pointer to an adxl345 handle structure
+ * @param[in] *path pointer to a file path buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 attach failed
+ * @note      the bus hooks of the handle are wrapped to log every transaction,
+ *            call it after the link and before adxl345_init, only one handle can be attached
+ */
+uint8_t bus_record_attach(adxl345_handle_t *handle, const char *path)
+{
+    /* check the handle */
+    if ((handle == NULL) || (gs_record_hook.iic_read != NULL))
+    {
+        return 1;
+    }
+    
+    /* open the record */
+    if (bus_record_open(path) != 0)
+    {
+        return 1;
+    }
+    
+    /* wrap the hooks */
+    memcpy(&gs_record_hook, handle, sizeof(adxl345_handle_t));
+    handle->iic_read = a_bus_record_iic_read;
+    handle->iic_write = a_bus_record_iic_write;
+    handle->spi_read = a_bus_record_spi_read;
+    handle->spi_write = a_bus_record_spi_write;
+    handle->delay_ms = a_bus_record_delay_ms;
+    
+    return 0;
+}
+
+/**
+ * @brief     bus record detach from a handle
+ * @param[in] *handle pointer to an adxl345 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 detach failed
+ * @note      the bus hooks of the handle are restored and the file is closed
+ */
+uint8_t bus_record_detach(adxl345_handle_t *handle)
+{
+    /* check the handle */
+    if ((handle == NULL) || (gs_record_hook.iic_read == NULL))
+    {
+        return 1;
+    }
+    
+    /* restore the hooks */
+    handle->iic_read = gs_record_hook.iic_read;
+    handle->iic_write = gs_record_hook.iic_write;
+    handle->spi_read = gs_record_hook.spi_read;
+    handle->spi_write = gs_record_hook.spi_write;
+    handle->delay_ms = gs_record_hook.delay_ms;
+    memset(&gs_record_hook, 0, sizeof(adxl345_handle_t));
+    
+    return bus_record_close();
+}
+
+/**
+ * @brief     bus replay open
+ * @param[in] *path pointer to a file path buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 open failed
+ * @note      the whole file is loaded into the memory
+ */
+uint8_t bus_replay_open(const char *path)
+{
+    FILE *file;
+    long size;
+    uint32_t offset;
+    uint16_t len;
+    
+    /* check the replay */
+    if (gs_replay_buf != NULL)
+    {
+        return 1;
+    }
+    
+    /* load the file */
+    file = fopen(path, "rb");
+    if (file == NULL)
+    {
+        perror("bus replay: open failed");
+        
+        return 1;
+    }
+    if ((fseek(file, 0, SEEK_END) != 0) || ((size = ftell(file)) < BUS_RECORD_HEADER_LEN) ||
+        (fseek(file, 0, SEEK_SET) != 0))
+    {
+        (void)fprintf(stderr, "bus replay: file is invalid.\n");
+        (void)fclose(file);
+        
+        return 1;
+    }
+    gs_replay_buf = (uint8_t *)malloc((size_t)size);
+    if (gs_replay_buf == NULL)
+    {
+        (void)fclose(file);
+        
+        return 1;
+    }
+    if (fread(gs_replay_buf, 1, (size_t)size, file) != (size_t)size)
+    {
+        perror("bus replay: read failed");
+        (void)fclose(file);
+        (void)bus_replay_close();
+        
+        return 1;
+    }
+    (void)fclose(file);
+    gs_replay_size = (uint32_t)size;
+    
+    /* check the header */
+    if ((memcmp(gs_replay_buf, BUS_RECORD_MAGIC, 4) != 0) || (gs_replay_buf[4] != BUS_RECORD_VERSION))
+    {
+        (void)fprintf(stderr, "bus replay: file is invalid.\n");
+        (void)bus_replay_close();
+        
+        return 1;
+    }
+    
+    /* check every transaction */
+    gs_replay_total = 0;
+    offset = BUS_RECORD_HEADER_LEN;
+    while (offset < gs_replay_size)
+    {
+        if (offset + BUS_RECORD_ENTRY_LEN > gs_replay_size)
+        {
+            break;
+        }
+        len = (uint16_t)(gs_replay_buf[offset + 12] | (gs_replay_buf[offset + 13] << 8));
+        if (offset + BUS_RECORD_ENTRY_LEN + len > gs_replay_size)
+        {
+            break;
+        }
+        offset += BUS_RECORD_ENTRY_LEN + len;
+        gs_replay_total++;
+    }
+    if (offset != gs_replay_size)
+    {
+        /* a session cut short keeps the complete transactions */
+        (void)fprintf(stderr, "bus replay: file is truncated after %u transactions.\n", (unsigned int)gs_replay_total);
+        gs_replay_size = offset;
+    }
+    bus_replay_rewind();
+    
+    return 0;
+}
+
+/**
+ * @brief  bus replay close
+ * @return status code
+ *         - 0 success
+ * @note   none
+ */
+uint8_t bus_replay_close(void)
+{
+    free(gs_replay_buf);
+    gs_replay_buf = NULL;
+    gs_replay_size = 0;
+    gs_replay_total = 0;
+    bus_replay_rewind();
+    
+    return 0;
+}
+
+/**
+ * @brief  bus replay check
+ * @return 1 if the replay is opened, otherwise 0
+ * @note   none
+ */
+uint8_t bus_replay_is_open(void)
+{
+    return (gs_replay_buf != NULL) ? 1 : 0;
+}
+
+/**
+ * @brief  bus replay rewind
+ * @note   the next transaction is the first one again and the mismatch counter is cleared
+ */
+void bus_replay_rewind(void)
+{
+    gs_replay_offset = BUS_RECORD_HEADER_LEN;
+    gs_replay_pos = 0;
+    gs_replay_mismatch = 0;
+}
+
+/**
+ * @brief      bus replay get status
+ * @param[out] *pos pointer to a replayed transaction count buffer
+ * @param[out] *total pointer to a total transaction count buffer
+ * @param[out] *mismatch pointer to a mismatch count buffer
+ * @note       a mismatch is a transaction whose type, address, register, length or written payload
+ *             differs from the record, or one after the end of the record
+ */
+void bus_replay_get_status(uint32_t *pos, uint32_t *total, uint32_t *mismatch)
+{
+    *pos = gs_replay_pos;
+    *total = gs_replay_total;
+    *mismatch = gs_replay_mismatch;
+}
+
+/**
+ * @brief      bus replay peek the next transaction
+ * @param[out] *type pointer to a transaction type buffer
+ * @param[out] *addr pointer to an iic device write address buffer
+ * @param[out] *reg pointer to a register address buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 no more transactions
+ * @note       the transaction isn't consumed
+ */
+uint8_t bus_replay_peek(uint8_t *type, uint8_t *addr, uint8_t *reg)
+{
+    /* check the end */
+    if ((gs_replay_buf == NULL) || (gs_replay_offset >= gs_replay_size))
+    {
+        return 1;
+    }
+    
+    /* get the next transaction */
+    *type = gs_replay_buf[gs_replay_offset + 8];
+    *addr = gs_replay_buf[gs_replay_offset + 9];
+    *reg = gs_replay_buf[gs_replay_offset + 10];
+    
+    return 0;
+}
+
+/**
+ * @brief      bus replay transaction
+ * @param[in]  type transaction type
+ * @param[in]  addr iic device write address, 0 for spi
+ * @param[in]  reg register address
+ * @param[in]  *buf pointer to a payload buffer, filled for a read
+ * @param[in]  len payload length
+ * @return     recorded result or 1 on a mismatch
+ * @note       the transactions are served in the recorded order
+ */
+uint8_t bus_replay_transfer(uint8_t type, uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    uint8_t *entry;
+    uint16_t entry_len;
+    
+    /* check the end */
+    if ((gs_replay_buf == NULL) || (gs_replay_offset >= gs_replay_size))
+    {
+        gs_replay_mismatch++;
+        
+        return 1;
+    }
+    
+    /* get the next transaction */
+    entry = &gs_replay_buf[gs_replay_offset];
+    entry_len = (uint16_t)(entry[12] | (entry[13] << 8));
+    gs_replay_offset += BUS_RECORD_ENTRY_LEN + entry_len;
+    gs_replay_pos++;
+    
+    /* check the transaction */
+    if ((entry[8] != type) || (entry[9] != addr) || (entry[10] != reg) || (entry_len != len))
+    {
+        gs_replay_mismatch++;
+        
+        return 1;
+    }
+    if (((type & BUS_RECORD_TYPE_WRITE) != 0) && (len != 0))
+    {
+        if (memcmp(&entry[BUS_RECORD_ENTRY_LEN], buf, len) != 0)
+        {
+            gs_replay_mismatch++;
+        }
+    }
+    else if (len != 0)
+    {
+        memcpy(buf, &entry[BUS_RECORD_ENTRY_LEN], len);
+    }
+    else
+    {
+        /* nothing to copy */
+    }
+    
+    return entry[11];
+}
+
+/**
+ * @brief  replay bus init and deinit hook
+ * @return status code
+ *         - 0 success
+ * @note   none
+ */
+static uint8_t a_bus_replay_none(void)
+{
+    return 0;
+}
+
+/**
+ * @brief     replay delay hook
+ * @param[in] ms time
+ * @note      the recorded responses already contain the waited data
+ */
+static void a_bus_replay_delay_ms(uint32_t ms)
+{
+    (void)ms;
+    (void)bus_replay_transfer(BUS_RECORD_TYPE_DELAY, 0, 0, NULL, 0);
+}
+
+/**
+ * @brief      replay iic read hook
+ * @param[in]  addr iic device write address
+ * @param[in]  reg iic register address
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of the data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       none
+ */
+static uint8_t a_bus_replay_iic_read(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    return bus_replay_transfer(0, addr, reg, buf, len);
+}
+
+/**
+ * @brief     replay iic write hook
+ * @param[in] addr iic device write address
+ * @param[in] reg iic register address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      none
+ */
+static uint8_t a_bus_replay_iic_write(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    return bus_replay_transfer(BUS_RECORD_TYPE_WRITE, addr, reg, buf, len);
+}
+
+/**
+ * @brief      replay spi read hook
+ * @param[in]  reg register address
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of the data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       none
+ */
+static uint8_t a_bus_replay_spi_read(uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    return bus_replay_transfer(BUS_RECORD_TYPE_SPI, 0, reg, buf, len);
+}
+
+/**
+ * @brief     replay spi write hook
+ * @param[in] reg register address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      none
+ */
+static uint8_t a_bus_replay_spi_write(uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    return bus_replay_transfer(BUS_RECORD_TYPE_SPI | BUS_RECORD_TYPE_WRITE, 0, reg, buf, len);
+}
+
+/**
+ * @brief     bus replay attach to a handle
+ * @param[in] *handle pointer to an adxl345 handle structure
+ * @param[in] *path pointer to a file path buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 attach failed
+ * @note      the bus hooks of the handle are replaced by the replay, the bus init and deinit
+ *            do nothing and the delay returns at once, only one handle can be attached
+ */
+uint8_t bus_replay_attach(adxl345_handle_t *handle, const char *path)
+{
+    /* check the handle */
+    if ((handle == NULL) || (gs_replay_hook.iic_read != NULL))
+    {
+        return 1;
+    }
+    
+    /* open the replay */
+    if (bus_replay_open(path) != 0)
+    {
+        return 1;
+    }
+    
+    /* replace the hooks */
+    memcpy(&gs_replay_hook, handle, sizeof(adxl345_handle_t));
+    handle->iic_init = a_bus_replay_none;
+    handle->iic_deinit = a_bus_replay_none;
+    handle->iic_read = a_bus_replay_iic_read;
+    handle->iic_write = a_bus_replay_iic_write;
+    handle->spi_init = a_bus_replay_none;
+    handle->spi_deinit = a_bus_replay_none;
+    handle->spi_read = a_bus_replay_spi_read;
+    handle->spi_write = a_bus_replay_spi_write;
+    handle->delay_ms = a_bus_replay_delay_ms;
+    
+    return 0;
+}
+
+/**
+ * @brief     bus replay detach from a handle
+ * @param[in] *handle pointer to an adxl345 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 detach failed
+ * @note      the bus hooks of the handle are restored and the replay is closed
+ */
+uint8_t bus_replay_detach(adxl345_handle_t *handle)
+{
+    /* check the handle */
+    if ((handle == NULL) || (gs_replay_hook.iic_read == NULL))
+    {
+        return 1;
+    }
+    
+    /* restore the hooks */
+    handle->iic_init = gs_replay_hook.iic_init;
+    handle->iic_deinit = gs_replay_hook.iic_deinit;
+    handle->iic_read = gs_replay_hook.iic_read;
+    handle->iic_write = gs_replay_hook.iic_write;
+    handle->spi_init = gs_replay_hook.spi_init;
+    handle->spi_deinit = gs_replay_hook.spi_deinit;
+    handle->spi_read = gs_replay_hook.spi_read;
+    handle->spi_write = gs_replay_hook.spi_write;
+    handle->delay_ms = gs_replay_hook.delay_ms;
+    memset(&gs_replay_hook, 0, sizeof(adxl345_handle_t));
+    
+    return bus_replay_close();
+}
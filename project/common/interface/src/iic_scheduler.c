@@ -0,0 +1,486 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      iic_scheduler.c
+ * @brief     iic scheduler source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "iic_scheduler.h"
+#include "iic_scheduler_bus.h"
+#include <pthread.h>
+
+/**
+ * @brief chip register definition
+ */
+#define IIC_SCHEDULER_REG_INT_SOURCE         0x30        /**< interrupt source register */
+#define IIC_SCHEDULER_REG_DATA_FORMAT        0x31        /**< data format register */
+#define IIC_SCHEDULER_REG_DATAX0             0x32        /**< data X0 register */
+#define IIC_SCHEDULER_REG_FIFO_CTL           0x38        /**< fifo control register */
+#define IIC_SCHEDULER_REG_FIFO_STATUS        0x39        /**< fifo status register */
+
+/**
+ * @brief fifo depth definition
+ */
+#define IIC_SCHEDULER_FIFO_DEPTH             32          /**< fifo entries */
+
+/**
+ * @brief interrupt source watermark bit definition
+ */
+#define IIC_SCHEDULER_SOURCE_WATERMARK       0x02        /**< watermark bit */
+
+/**
+ * @brief iic scheduler device structure definition
+ */
+typedef struct iic_scheduler_device_s
+{
+    uint8_t addr;                                         /**< iic device write address */
+    uint8_t int_source;                                   /**< cached interrupt source */
+    uint8_t fifo_ctl;                                     /**< cached fifo control */
+    uint8_t fifo_status;                                  /**< cached fifo status */
+    uint8_t data_format;                                  /**< cached data format */
+    uint8_t source_valid;                                 /**< interrupt source cached flag */
+    uint8_t ctl_valid;                                    /**< fifo control cached flag */
+    uint8_t format_valid;                                 /**< data format cached flag */
+    uint8_t bypass;                                       /**< bypass mode flag */
+    uint8_t entries;                                      /**< cached entries */
+    uint8_t cursor;                                       /**< first unread entry */
+    uint8_t buf[IIC_SCHEDULER_FIFO_DEPTH * 6];            /**< cached samples */
+} iic_scheduler_device_t;
+
+/**
+ * @brief global var definition
+ */
+static pthread_mutex_t gs_mutex = PTHREAD_MUTEX_INITIALIZER;              /**< bus mutex */
+static uint32_t gs_ref;                                                   /**< init reference count */
+static iic_scheduler_device_t gs_device[IIC_SCHEDULER_MAX_DEVICE];        /**< device table */
+static uint8_t gs_device_count;                                           /**< device count */
+static uint32_t gs_prefetch;                                              /**< prefetch count */
+static uint32_t gs_sample;                                                /**< samples served from the cache */
+
+/**
+ * @brief     find or register a device
+ * @param[in] addr iic device write address
+ * @return    pointer to the device or NULL when the table is full
+ * @note      call with the bus mutex held
+ */
+static iic_scheduler_device_t *a_iic_scheduler_device(uint8_t addr)
+{
+    uint8_t i;
+    
+    /* find the device */
+    for (i = 0; i < gs_device_count; i++)
+    {
+        if (gs_device[i].addr == addr)
+        {
+            return &gs_device[i];
+        }
+    }
+    
+    /* check the table */
+    if (gs_device_count >= IIC_SCHEDULER_MAX_DEVICE)
+    {
+        return NULL;
+    }
+    
+    /* register the device */
+    memset(&gs_device[gs_device_count], 0, sizeof(iic_scheduler_device_t));
+    gs_device[gs_device_count].addr = addr;
+    gs_device_count++;
+    
+    return &gs_device[gs_device_count - 1];
+}
+
+/**
+ * @brief     serve a read from the cache
+ * @param[in] *device pointer to a device
+ * @param[in] reg iic register address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @return    served bytes
+ * @note      call with the bus mutex held
+ */
+static uint16_t a_iic_scheduler_cache_read(iic_scheduler_device_t *device, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    uint16_t n;
+    
+    /* check the cache */
+    if (device == NULL)
+    {
+        return 0;
+    }
+    
+    /* cached registers are used once */
+    if ((reg == IIC_SCHEDULER_REG_INT_SOURCE) && (len == 1) && (device->source_valid != 0))
+    {
+        device->source_valid = 0;
+        buf[0] = device->int_source;
+        
+        return 1;
+    }
+    if ((reg == IIC_SCHEDULER_REG_FIFO_CTL) && (len == 1) && (device->ctl_valid != 0))
+    {
+        device->ctl_valid = 0;
+        buf[0] = device->fifo_ctl;
+        
+        return 1;
+    }
+    if ((reg == IIC_SCHEDULER_REG_DATA_FORMAT) && (len == 1) && (device->format_valid != 0))
+    {
+        device->format_valid = 0;
+        buf[0] = device->data_format;
+        
+        return 1;
+    }
+    
+    /* the fifo status reports the cached entries which are older than the chip's */
+    if ((reg == IIC_SCHEDULER_REG_FIFO_STATUS) && (len == 1) &&
+        (device->bypass == 0) && (device->cursor < device->entries))
+    {
+        buf[0] = (device->fifo_status & 0x80) | (device->entries - device->cursor);
+        
+        return 1;
+    }
+    
+    /* serve the cached samples in the fifo order */
+    if ((reg == IIC_SCHEDULER_REG_DATAX0) && ((len % 6) == 0) && (device->cursor < device->entries))
+    {
+        n = device->entries - device->cursor;
+        n = ((len / 6) < n) ? (len / 6) : n;
+        memcpy(buf, &device->buf[device->cursor * 6], n * 6);
+        device->cursor += n;
+        gs_sample += n;
+        
+        return n * 6;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     iic scheduler init
+ * @param[in] *name pointer to an iic device name buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      the bus transport is opened once and shared by all the devices,
+ *            every init must be paired with a deinit
+ */
+uint8_t iic_scheduler_init(char *name)
+{
+    pthread_mutex_lock(&gs_mutex);
+    if (gs_ref == 0)
+    {
+        /* open the bus */
+        if (iic_scheduler_bus_open(name) != 0)
+        {
+            pthread_mutex_unlock(&gs_mutex);
+            
+            return 1;
+        }
+        
+        /* clear the device table */
+        memset(gs_device, 0, sizeof(iic_scheduler_device_t) * IIC_SCHEDULER_MAX_DEVICE);
+        gs_device_count = 0;
+        gs_prefetch = 0;
+        gs_sample = 0;
+    }
+    gs_ref++;
+    pthread_mutex_unlock(&gs_mutex);
+    
+    return 0;
+}
+
+/**
+ * @brief  iic scheduler deinit
+ * @return status code
+ *         - 0 success
+ *         - 1 deinit failed
+ * @note   the bus transport is closed by the last deinit
+ */
+uint8_t iic_scheduler_deinit(void)
+{
+    uint8_t res;
+    
+    res = 0;
+    pthread_mutex_lock(&gs_mutex);
+    if (gs_ref == 0)
+    {
+        pthread_mutex_unlock(&gs_mutex);
+        
+        return 1;
+    }
+    gs_ref--;
+    if (gs_ref == 0)
+    {
+        /* close the bus */
+        res = iic_scheduler_bus_close();
+        gs_device_count = 0;
+    }
+    pthread_mutex_unlock(&gs_mutex);
+    
+    return res;
+}
+
+/**
+ * @brief      iic scheduler read
+ * @param[in]  addr iic device write address
+ * @param[in]  reg iic register address
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of the data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       addr = device_address_7bits << 1,
+ *             the prefetched registers and samples are served from the cache
+ */
+uint8_t iic_scheduler_read(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    uint8_t res;
+    uint16_t served;
+    
+    pthread_mutex_lock(&gs_mutex);
+    
+    /* serve from the cache first */
+    served = a_iic_scheduler_cache_read(a_iic_scheduler_device(addr), reg, buf, len);
+    
+    /* read the rest from the bus */
+    res = 0;
+    if (served < len)
+    {
+        res = iic_scheduler_bus_read(addr, reg, buf + served, len - served);
+    }
+    pthread_mutex_unlock(&gs_mutex);
+    
+    return res;
+}
+
+/**
+ * @brief     iic scheduler write
+ * @param[in] addr iic device write address
+ * @param[in] reg iic register address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      addr = device_address_7bits << 1,
+ *            a write drops the prefetched cache of the device
+ */
+uint8_t iic_scheduler_write(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    uint8_t res;
+    iic_scheduler_device_t *device;
+    
+    pthread_mutex_lock(&gs_mutex);
+    device = a_iic_scheduler_device(addr);
+    if (device != NULL)
+    {
+        /* the cached config may be changed */
+        device->ctl_valid = 0;
+        device->format_valid = 0;
+        
+        /* the cached samples don't match the new mode or format */
+        if ((reg == IIC_SCHEDULER_REG_FIFO_CTL) || (reg == IIC_SCHEDULER_REG_DATA_FORMAT))
+        {
+            device->entries = 0;
+            device->cursor = 0;
+        }
+    }
+    res = iic_scheduler_bus_write(addr, reg, buf, len);
+    pthread_mutex_unlock(&gs_mutex);
+    
+    return res;
+}
+
+/**
+ * @brief  iic scheduler prefetch
+ * @return status code
+ *         - 0 success
+ *         - 1 prefetch failed
+ * @note   the interrupt source and the fifo registers of all the devices are read in one combined transfer,
+ *         then every fifo entry is read as a 6 bytes segment in one combined transfer with the fullest fifo first,
+ *         the next irq handler and adxl345_read of every device are served from the cache,
+ *         the interrupt source is cleared on the chip so the irq handler of every device must run after the prefetch
+ */
+uint8_t iic_scheduler_prefetch(void)
+{
+    iic_scheduler_segment_t segment[IIC_SCHEDULER_MAX_DEVICE * IIC_SCHEDULER_FIFO_DEPTH];
+    uint8_t status[IIC_SCHEDULER_MAX_DEVICE][4];
+    uint8_t order[IIC_SCHEDULER_MAX_DEVICE];
+    uint8_t cnt[IIC_SCHEDULER_MAX_DEVICE];
+    uint8_t level[IIC_SCHEDULER_MAX_DEVICE];
+    uint8_t i;
+    uint8_t j;
+    uint8_t t;
+    uint8_t left;
+    uint8_t watermark;
+    uint16_t n;
+    iic_scheduler_device_t *device;
+    
+    pthread_mutex_lock(&gs_mutex);
+    if (gs_device_count == 0)
+    {
+        pthread_mutex_unlock(&gs_mutex);
+        
+        return 0;
+    }
+    
+    /* read interrupt source, data format, fifo control and fifo status of every device */
+    for (i = 0; i < gs_device_count; i++)
+    {
+        segment[i * 2 + 0].addr = gs_device[i].addr;
+        segment[i * 2 + 0].reg = IIC_SCHEDULER_REG_INT_SOURCE;
+        segment[i * 2 + 0].buf = &status[i][0];
+        segment[i * 2 + 0].len = 2;
+        segment[i * 2 + 1].addr = gs_device[i].addr;
+        segment[i * 2 + 1].reg = IIC_SCHEDULER_REG_FIFO_CTL;
+        segment[i * 2 + 1].buf = &status[i][2];
+        segment[i * 2 + 1].len = 2;
+    }
+    if (iic_scheduler_bus_transfer(segment, gs_device_count * 2) != 0)
+    {
+        pthread_mutex_unlock(&gs_mutex);
+        
+        return 1;
+    }
+    
+    /* update the cached registers */
+    for (i = 0; i < gs_device_count; i++)
+    {
+        device = &gs_device[i];
+        device->int_source = status[i][0];
+        device->data_format = status[i][1];
+        device->fifo_ctl = status[i][2];
+        device->fifo_status = status[i][3];
+        device->source_valid = 1;
+        device->ctl_valid = 1;
+        device->format_valid = 1;
+        if ((status[i][2] >> 6) == 0)
+        {
+            /* bypass keeps only the latest sample */
+            device->bypass = 1;
+            device->entries = 0;
+            device->cursor = 0;
+            cnt[i] = 1;
+            level[i] = 0;
+        }
+        else
+        {
+            /* move the unread samples to the front */
+            left = device->entries - device->cursor;
+            if ((device->bypass != 0) || (left == 0))
+            {
+                left = 0;
+            }
+            else if (device->cursor != 0)
+            {
+                memmove(device->buf, &device->buf[device->cursor * 6], left * 6);
+            }
+            device->bypass = 0;
+            device->entries = left;
+            device->cursor = 0;
+            cnt[i] = status[i][3] & 0x3F;
+            cnt[i] = (cnt[i] < (IIC_SCHEDULER_FIFO_DEPTH - left)) ? cnt[i] : (IIC_SCHEDULER_FIFO_DEPTH - left);
+            level[i] = (status[i][3] & 0x3F) + 1;
+            
+            /* the watermark follows the cached entries the handler will read */
+            watermark = status[i][2] & 0x1F;
+            if ((watermark != 0) && ((left + cnt[i]) >= watermark))
+            {
+                device->int_source |= IIC_SCHEDULER_SOURCE_WATERMARK;
+            }
+            else
+            {
+                device->int_source &= ~IIC_SCHEDULER_SOURCE_WATERMARK;
+            }
+        }
+        order[i] = i;
+    }
+    
+    /* the fullest fifo is the closest to overflow, drain it first */
+    for (i = 1; i < gs_device_count; i++)
+    {
+        t = order[i];
+        for (j = i; (j > 0) && (level[order[j - 1]] < level[t]); j--)
+        {
+            order[j] = order[j - 1];
+        }
+        order[j] = t;
+    }
+    
+    /* every entry is a 6 bytes read, a longer burst would run into the fifo control register */
+    n = 0;
+    for (i = 0; i < gs_device_count; i++)
+    {
+        device = &gs_device[order[i]];
+        for (j = 0; j < cnt[order[i]]; j++)
+        {
+            segment[n].addr = device->addr;
+            segment[n].reg = IIC_SCHEDULER_REG_DATAX0;
+            segment[n].buf = &device->buf[(device->entries + j) * 6];
+            segment[n].len = 6;
+            n++;
+        }
+    }
+    
+    /* drain all the devices */
+    if (iic_scheduler_bus_transfer(segment, n) != 0)
+    {
+        pthread_mutex_unlock(&gs_mutex);
+        
+        return 1;
+    }
+    
+    /* update the cached entries */
+    for (i = 0; i < gs_device_count; i++)
+    {
+        gs_device[i].entries += cnt[i];
+    }
+    gs_prefetch++;
+    pthread_mutex_unlock(&gs_mutex);
+    
+    return 0;
+}
+
+/**
+ * @brief      iic scheduler get the status
+ * @param[out] *prefetch pointer to a prefetch count buffer
+ * @param[out] *sample pointer to a buffer of the samples served from the cache
+ * @note       the counters are cleared by the first init
+ */
+void iic_scheduler_get_status(uint32_t *prefetch, uint32_t *sample)
+{
+    pthread_mutex_lock(&gs_mutex);
+    *prefetch = gs_prefetch;
+    *sample = gs_sample;
+    pthread_mutex_unlock(&gs_mutex);
+}
@@ -36,9 +36,13 @@
  */
 
 #include "driver_adxl345_interface.h"
-#include "iic.h"
+#include "bus_fault.h"
+#include "bus_record.h"
+#include "iic_scheduler.h"
 #include "spi.h"
+#include "worker.h"
 #include <stdarg.h>
+#include <time.h>
 
 /**
  * @brief iic device name definition
@@ -51,14 +55,55 @@
 #define SPI_DEVICE_NAME "/dev/spidev0.0"    /**< spi device name */
 
 /**
- * @brief iic device handle definition
+ * @brief spi device handle definition
  */
-static int gs_iic_fd;                       /**< iic handle */
+static int gs_spi_fd;                       /**< spi handle */
 
 /**
- * @brief spi device handle definition
+ * @brief     bus fault latency
+ * @param[in] us time
+ * @note      none
  */
-static int gs_spi_fd;                       /**< spi handle */
+static void a_adxl345_interface_fault_delay_us(uint32_t us)
+{
+    usleep(us);
+}
+
+/**
+ * @brief      spi bus read with the bus fault signature
+ * @param[in]  addr unused address
+ * @param[in]  reg register address
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       none
+ */
+static uint8_t a_adxl345_interface_spi_read(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    (void)addr;
+    
+    return spi_read(gs_spi_fd, reg, buf, len);
+}
+
+/**
+ * @brief     spi bus write with the bus fault signature
+ * @param[in] addr unused address
+ * @param[in] reg register address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      none
+ */
+static uint8_t a_adxl345_interface_spi_write(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    (void)addr;
+    
+    return spi_write(gs_spi_fd, reg, buf, len);
+}
 
 /**
  * @brief  interface iic bus init
@@ -69,7 +114,10 @@ static int gs_spi_fd;                       /**< spi handle */
  */
 uint8_t adxl345_interface_iic_init(void)
 {
-    return iic_init(IIC_DEVICE_NAME, &gs_iic_fd);
+    bus_fault_set_delay(a_adxl345_interface_fault_delay_us);
+    bus_fault_set_clock(adxl345_interface_clock_us);
+    
+    return iic_scheduler_init(IIC_DEVICE_NAME);
 }
 
 /**
@@ -81,7 +129,13 @@ uint8_t adxl345_interface_iic_init(void)
  */
 uint8_t adxl345_interface_iic_deinit(void)
 {
-    return iic_deinit(gs_iic_fd);
+    /* finish the pending async works */
+    if (worker_deinit() != 0)
+    {
+        return 1;
+    }
+    
+    return iic_scheduler_deinit();
 }
 
 /**
@@ -93,11 +147,17 @@ uint8_t adxl345_interface_iic_deinit(void)
  * @return     status code
  *             - 0 success
  *             - 1 read failed
- * @note       none
+ * @note       the scripted faults are injected if the bus fault is opened,
+ *             the transaction is logged if the bus record is opened
  */
 uint8_t adxl345_interface_iic_read(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
 {
-    return iic_read(gs_iic_fd, addr, reg, buf, len);
+    uint8_t res;
+    
+    res = bus_fault_transfer(0, addr, reg, buf, len, iic_scheduler_read);
+    bus_record_log(0, addr, reg, buf, len, res);
+    
+    return res;
 }
 
 /**
@@ -109,11 +169,17 @@ uint8_t adxl345_interface_iic_read(uint8_t addr, uint8_t reg, uint8_t *buf, uint
  * @return    status code
  *            - 0 success
  *            - 1 write failed
- * @note      none
+ * @note      the scripted faults are injected if the bus fault is opened,
+ *            the transaction is logged if the bus record is opened
  */
 uint8_t adxl345_interface_iic_write(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
 {
-    return iic_write(gs_iic_fd, addr, reg, buf, len);
+    uint8_t res;
+    
+    res = bus_fault_transfer(BUS_FAULT_TYPE_WRITE, addr, reg, buf, len, iic_scheduler_write);
+    bus_record_log(BUS_RECORD_TYPE_WRITE, addr, reg, buf, len, res);
+    
+    return res;
 }
 
 /**
@@ -125,6 +191,9 @@ uint8_t adxl345_interface_iic_write(uint8_t addr, uint8_t reg, uint8_t *buf, uin
  */
 uint8_t adxl345_interface_spi_init(void)
 {
+    bus_fault_set_delay(a_adxl345_interface_fault_delay_us);
+    bus_fault_set_clock(adxl345_interface_clock_us);
+    
     return spi_init(SPI_DEVICE_NAME, &gs_spi_fd, SPI_MODE_TYPE_3, 1000 * 1000);
 }
 
@@ -137,6 +206,12 @@ uint8_t adxl345_interface_spi_init(void)
  */
 uint8_t adxl345_interface_spi_deinit(void)
 {   
+    /* finish the pending async works */
+    if (worker_deinit() != 0)
+    {
+        return 1;
+    }
+    
     return spi_deinit(gs_spi_fd);
 }
 
@@ -148,11 +223,17 @@ uint8_t adxl345_interface_spi_deinit(void)
  * @return     status code
  *             - 0 success
  *             - 1 read failed
- * @note       none
+ * @note       the scripted faults are injected if the bus fault is opened,
+ *             the transaction is logged if the bus record is opened
  */
 uint8_t adxl345_interface_spi_read(uint8_t reg, uint8_t *buf, uint16_t len)
 {
-    return spi_read(gs_spi_fd, reg, buf, len);
+    uint8_t res;
+    
+    res = bus_fault_transfer(0, 0, reg, buf, len, a_adxl345_interface_spi_read);
+    bus_record_log(BUS_RECORD_TYPE_SPI, 0, reg, buf, len, res);
+    
+    return res;
 }
 
 /**
@@ -163,21 +244,28 @@ uint8_t adxl345_interface_spi_read(uint8_t reg, uint8_t *buf, uint16_t len)
  * @return    status code
  *            - 0 success
  *            - 1 write failed
- * @note      none
+ * @note      the scripted faults are injected if the bus fault is opened,
+ *            the transaction is logged if the bus record is opened
  */
 uint8_t adxl345_interface_spi_write(uint8_t reg, uint8_t *buf, uint16_t len)
 {
-    return spi_write(gs_spi_fd, reg, buf, len);
+    uint8_t res;
+    
+    res = bus_fault_transfer(BUS_FAULT_TYPE_WRITE, 0, reg, buf, len, a_adxl345_interface_spi_write);
+    bus_record_log(BUS_RECORD_TYPE_SPI | BUS_RECORD_TYPE_WRITE, 0, reg, buf, len, res);
+    
+    return res;
 }
 
 /**
  * @brief     interface delay ms
  * @param[in] ms time
- * @note      none
+ * @note      the end of the delay is logged if the bus record is opened
  */
 void adxl345_interface_delay_ms(uint32_t ms)
 {
     usleep(1000 * ms);
+    bus_record_log(BUS_RECORD_TYPE_DELAY, 0, 0, NULL, 0, 0);
 }
 
 /**
@@ -198,6 +286,48 @@ void adxl345_interface_debug_print(const char *const fmt, ...)
     (void)printf((uint8_t *)str);
 }
 
+/**
+ * @brief     interface async submit
+ * @param[in] *work pointer to a work function address
+ * @param[in] *arg pointer to a work argument
+ * @return    status code
+ *            - 0 success
+ *            - 1 submit failed
+ * @note      the work runs on the io pthread
+ */
+uint8_t adxl345_interface_async_submit(void (*work)(void *arg), void *arg)
+{
+    return worker_submit(work, arg);
+}
+
+/**
+ * @brief     interface async complete
+ * @param[in] *done pointer to a completion function address
+ * @param[in] *arg pointer to a completion argument
+ * @return    status code
+ *            - 0 success
+ *            - 1 submit failed
+ * @note      the completion runs on the completion pthread outside the mutex
+ */
+uint8_t adxl345_interface_async_complete(void (*done)(void *arg), void *arg)
+{
+    return worker_complete(done, arg);
+}
+
+/**
+ * @brief  interface clock us
+ * @return free running time in us
+ * @note   the monotonic clock is used
+ */
+uint32_t adxl345_interface_clock_us(void)
+{
+    struct timespec ts;
+    
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    
+    return (uint32_t)((uint64_t)ts.tv_sec * 1000000ULL + (uint64_t)ts.tv_nsec / 1000);
+}
+
 /**
  * @brief     interface receive callback
  * @param[in] type irq type
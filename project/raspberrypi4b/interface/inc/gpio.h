@@ -38,8 +38,11 @@
 #define GPIO_H
 
 #include <unistd.h>
+#include <pthread.h>
 #include <stdint.h>
 #include <stdio.h>
+#include <time.h>
+#include "timing.h"
 
 #ifdef __cplusplus
  extern "C" {
@@ -51,6 +54,119 @@
  * @{
  */
 
+/**
+ * @brief gpio rt profile structure definition
+ */
+typedef struct gpio_rt_profile_s
+{
+    int priority;                   /**< SCHED_FIFO priority 1 - 99, 0 means SCHED_OTHER */
+    int cpu;                        /**< pinned cpu core, -1 means any core */
+    uint8_t lock_memory;            /**< lock all current and future pages with mlockall */
+    uint32_t stack_size;            /**< pthread stack size in bytes, 0 means the default size */
+    uint32_t prefault_size;         /**< stack bytes touched before the first wait, 0 means none */
+} gpio_rt_profile_t;
+
+/**
+ * @brief gpio latency structure definition
+ */
+typedef struct gpio_latency_s
+{
+    uint32_t count;                     /**< measured interrupt count */
+    uint32_t min_us;                    /**< min wake to submit latency in us */
+    uint32_t max_us;                    /**< max wake to submit latency in us */
+    uint32_t mean_us;                   /**< mean wake to submit latency in us */
+    uint32_t p50_us;                    /**< 50th percentile upper bound in us */
+    uint32_t p99_us;                    /**< 99th percentile upper bound in us */
+    uint32_t p999_us;                   /**< 99.9th percentile upper bound in us */
+    timing_histogram_t histogram;       /**< histogram of the latency */
+} gpio_latency_t;
+
+/**
+ * @brief     set the rt profile of the interrupt pthread
+ * @param[in] *profile pointer to an rt profile structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 set failed
+ * @note      call it before gpio_interrupt_init, the profile is applied to the next created pthread,
+ *            the prefault size must leave 16KB of the stack size or of the default one when it is 0
+ */
+uint8_t gpio_interrupt_set_rt_profile(const gpio_rt_profile_t *profile);
+
+/**
+ * @brief      build the pthread attribute from the rt profile
+ * @param[out] *attr pointer to an initialized pthread attribute
+ * @return     status code
+ *             - 0 success
+ *             - 1 build failed
+ * @note       the io pthread of worker.c is built with the same attribute
+ */
+uint8_t gpio_rt_profile_attr(pthread_attr_t *attr);
+
+/**
+ * @brief  prefault the stack of the calling pthread with the rt profile
+ * @note   call it at the start of a pthread built with gpio_rt_profile_attr
+ */
+void gpio_rt_profile_prefault(void);
+
+/**
+ * @brief      get the wake to submit latency of the interrupt pthread
+ * @param[out] *latency pointer to a latency structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 get failed
+ * @note       the latency is measured from the pthread wake up to the end of the irq callback,
+ *             the fifo irq only submits the drain to the io pthread, so the drain itself isn't included
+ */
+uint8_t gpio_interrupt_get_latency(gpio_latency_t *latency);
+
+/**
+ * @brief  reset the latency probe
+ * @return status code
+ *         - 0 success
+ * @note   none
+ */
+uint8_t gpio_interrupt_reset_latency(void);
+
+/**
+ * @brief      get the last falling edge of the interrupt pin
+ * @param[out] *ts pointer to a CLOCK_MONOTONIC time buffer
+ * @param[out] *count pointer to a falling edge counter buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get failed
+ * @note       the time is taken when the interrupt pthread wakes up,
+ *             the counter increases by one at every falling edge
+ */
+uint8_t gpio_interrupt_get_edge(struct timespec *ts, uint32_t *count);
+
+/**
+ * @brief      wait for a falling edge after a known one
+ * @param[in]  count falling edge counter already seen
+ * @param[in]  *until pointer to an absolute CLOCK_MONOTONIC time to give up
+ * @param[out] *ts pointer to a CLOCK_MONOTONIC time buffer
+ * @param[out] *new_count pointer to a falling edge counter buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 wait failed
+ *             - 2 timeout
+ * @note       it blocks on a condition signalled by the interrupt pthread and fails at once when
+ *             the interrupt pthread isn't running, the outputs hold the last edge even on timeout
+ */
+uint8_t gpio_interrupt_wait_edge(uint32_t count, const struct timespec *until,
+                                 struct timespec *ts, uint32_t *new_count);
+
+/**
+ * @brief      get the kernel and wake up time of the last falling edge
+ * @param[out] *event pointer to a kernel time buffer
+ * @param[out] *wake pointer to a CLOCK_MONOTONIC wake up time buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get failed
+ * @note       the kernel stamps the event in the interrupt, it is CLOCK_MONOTONIC since linux 5.7
+ *             and CLOCK_REALTIME before, call it in the irq function to get the edge being served
+ */
+uint8_t gpio_interrupt_get_event(struct timespec *event, struct timespec *wake);
+
 /**
  * @brief  gpio interrupt init
  * @return status code
@@ -65,7 +181,8 @@ uint8_t gpio_interrupt_init(void);
  * @return status code
  *         - 0 success
  *         - 1 deinit failed
- * @note   none
+ * @note   the irq being served and the works it submitted to the io pthread finish before it returns,
+ *         so the handle can be deinitialized right after it, the pthread stops within one poll period
  */
 uint8_t gpio_interrupt_deinit(void);
 
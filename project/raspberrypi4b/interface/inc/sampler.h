@@ -0,0 +1,104 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      sampler.h
+ * @brief     sampler header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef SAMPLER_H
+#define SAMPLER_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup sampler sampler function
+ * @brief    sampler function modules
+ * @{
+ */
+
+/**
+ * @brief sampler structure definition
+ */
+typedef struct sampler_s
+{
+    struct timespec deadline;        /**< next absolute CLOCK_MONOTONIC deadline */
+    uint64_t period_ns;              /**< sample period in ns */
+    uint64_t offset_ns;              /**< delay after the data ready edge in ns */
+    uint8_t phase_lock;              /**< lock the deadline to the data ready edge */
+    uint32_t edge_count;             /**< last used edge count */
+    uint32_t count;                  /**< passed deadline count */
+    uint32_t missed;                 /**< missed deadline or sample count */
+} sampler_t;
+
+/**
+ * @brief     sampler init
+ * @param[in] *sampler pointer to a sampler structure
+ * @param[in] period_us sample period in us
+ * @param[in] phase_lock lock the deadline to the data ready edge
+ * @param[in] offset_us delay after the data ready edge in us
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      the first deadline is one period from now,
+ *            the phase lock needs the gpio interrupt to be running with the data ready interrupt enabled
+ */
+uint8_t sampler_init(sampler_t *sampler, uint32_t period_us, uint8_t phase_lock, uint32_t offset_us);
+
+/**
+ * @brief     sampler wait
+ * @param[in] *sampler pointer to a sampler structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 wait failed
+ *            - 2 no new sample
+ * @note      sleep until the next absolute deadline and schedule the one after it,
+ *            late deadlines are skipped and counted as missed instead of being caught up,
+ *            in the phase lock mode it blocks until a new data ready edge and returns 2
+ *            if none comes within one period, the caller should skip the read then
+ */
+uint8_t sampler_wait(sampler_t *sampler);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,141 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      timing.h
+ * @brief     timing header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef TIMING_H
+#define TIMING_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup timing timing function
+ * @brief    timing function modules
+ * @{
+ */
+
+/**
+ * @brief timing histogram bucket number definition
+ */
+#define TIMING_BUCKETS 240        /**< 16 linear 1us buckets and 8 buckets per octave above 16us */
+
+/**
+ * @brief timing histogram structure definition
+ */
+typedef struct timing_histogram_s
+{
+    uint32_t count;                          /**< sample count */
+    uint32_t min_us;                         /**< min value in us */
+    uint32_t max_us;                         /**< max value in us */
+    uint64_t sum_us;                         /**< sum of the values in us */
+    uint32_t bucket[TIMING_BUCKETS];         /**< value histogram */
+} timing_histogram_t;
+
+/**
+ * @brief timing structure definition
+ */
+typedef struct timing_s
+{
+    uint64_t period_ns;                  /**< nominal sample period in ns */
+    uint16_t capacity;                   /**< samples the chip holds before it loses one */
+    uint8_t started;                     /**< first batch flag */
+    struct timespec edge;                /**< edge time of the last batch */
+    struct timespec first;               /**< edge time of the first batch */
+    uint32_t batches;                    /**< batch count */
+    uint64_t samples;                    /**< read sample count */
+    uint64_t missed;                     /**< missed sample count */
+    uint32_t unstamped;                  /**< edges without a usable kernel time */
+    timing_histogram_t irq;              /**< interrupt to handler latency */
+    timing_histogram_t handler;          /**< handler to data latency */
+    timing_histogram_t jitter;           /**< inter-batch jitter against the nominal period */
+} timing_t;
+
+/**
+ * @brief     init the timing analyzer
+ * @param[in] *timing pointer to a timing structure
+ * @param[in] period_ns nominal sample period in ns
+ * @param[in] capacity samples the chip holds before it loses one, 1 for the data ready mode and 32 for the fifo
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      none
+ */
+uint8_t timing_init(timing_t *timing, uint64_t period_ns, uint16_t capacity);
+
+/**
+ * @brief     add one batch to the timing analyzer
+ * @param[in] *timing pointer to a timing structure
+ * @param[in] *event pointer to a kernel edge time
+ * @param[in] *wake pointer to a CLOCK_MONOTONIC wake up time of the edge
+ * @param[in] *handler pointer to a CLOCK_MONOTONIC handler entry time
+ * @param[in] *data pointer to a CLOCK_MONOTONIC data read time
+ * @param[in] samples read samples of the batch
+ * @note      the wake up time replaces a kernel time that is not CLOCK_MONOTONIC,
+ *            a sample is only counted as missed when the batch filled the chip capacity
+ */
+void timing_add(timing_t *timing, const struct timespec *event, const struct timespec *wake,
+                const struct timespec *handler, const struct timespec *data, uint16_t samples);
+
+/**
+ * @brief     add one value to the histogram
+ * @param[in] *histogram pointer to a timing histogram structure
+ * @param[in] ns value in ns
+ * @note      a negative value counts as 0 and a value over the uint32 us range is clamped
+ */
+void timing_histogram_add(timing_histogram_t *histogram, int64_t ns);
+
+/**
+ * @brief     get the percentile upper bound from the histogram
+ * @param[in] *histogram pointer to a timing histogram structure
+ * @param[in] permille percentile in permille
+ * @return    upper bound in us
+ * @note      the bound is within 12.5 percent of the value
+ */
+uint32_t timing_percentile(const timing_histogram_t *histogram, uint32_t permille);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,112 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      worker.h
+ * @brief     worker header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef WORKER_H
+#define WORKER_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup worker worker function
+ * @brief    worker function modules
+ * @{
+ */
+
+/**
+ * @brief worker queue depth definition
+ */
+#define WORKER_QUEUE_DEPTH 16        /**< max pending works of one stage */
+
+/**
+ * @brief  worker init
+ * @return status code
+ *         - 0 success
+ *         - 1 init failed
+ * @note   start the io pthread with the rt profile of the gpio interrupt pthread and the completion
+ *         pthread with the default attribute, calling it again when they are running does nothing
+ */
+uint8_t worker_init(void);
+
+/**
+ * @brief  worker deinit
+ * @return status code
+ *         - 0 success
+ *         - 1 deinit failed
+ * @note   all pending works and completions finish before the pthreads exit,
+ *         don't call it from a work or a completion function
+ */
+uint8_t worker_deinit(void);
+
+/**
+ * @brief     worker submit
+ * @param[in] *work pointer to a work function address
+ * @param[in] *arg pointer to a work argument
+ * @return    status code
+ *            - 0 success
+ *            - 1 submit failed
+ * @note      the pthreads are started at the first submit, works run one by one in the submitted
+ *            order and each one runs between mutex_lock and mutex_unlock, so it never overlaps the
+ *            irq function, an irq that comes meanwhile runs at the unlock on the io pthread,
+ *            a work must not call mutex_lock
+ */
+uint8_t worker_submit(void (*work)(void *arg), void *arg);
+
+/**
+ * @brief     worker complete
+ * @param[in] *done pointer to a completion function address
+ * @param[in] *arg pointer to a completion argument
+ * @return    status code
+ *            - 0 success
+ *            - 1 submit failed
+ * @note      completions run one by one in the submitted order on the completion pthread outside
+ *            the mutex, so the io pthread can run the next work while a completion still runs
+ */
+uint8_t worker_complete(void (*done)(void *arg), void *arg);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
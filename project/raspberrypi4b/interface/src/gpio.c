@@ -34,10 +34,20 @@
  * </table>
  */
 
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
 #include "gpio.h"
 #include "mutex.h"
+#include "worker.h"
+#include <errno.h>
 #include <gpiod.h>
 #include <pthread.h>
+#include <sched.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <time.h>
+#include <unistd.h>
 
 /**
  * @brief gpio device name definition
@@ -49,6 +59,11 @@
  */
 #define GPIO_DEVICE_LINE 17                      /**< gpio device line */
 
+/**
+ * @brief gpio poll period definition
+ */
+#define GPIO_POLL_MS 100                         /**< stop flag poll period in ms */
+
 /**
  * @brief global var definition
  */
@@ -57,6 +72,93 @@ static struct gpiod_line *gs_line;        /**< gpio line handle */
 static pthread_t gs_pid;                  /**< gpio pthread pid */
 extern uint8_t (*g_gpio_irq)(void);       /**< interrupt flag */
 
+/**
+ * @brief rt profile and latency probe definition
+ */
+static gpio_rt_profile_t gs_profile = {0, -1, 0, 0, 0};                  /**< rt profile */
+static uint8_t gs_locked;                                                /**< memory locked flag */
+static pthread_mutex_t gs_latency_mutex = PTHREAD_MUTEX_INITIALIZER;     /**< latency mutex */
+static timing_histogram_t gs_latency;                                    /**< latency histogram */
+static struct timespec gs_edge;                                          /**< last falling edge time */
+static struct timespec gs_event;                                         /**< last falling edge kernel time */
+static uint32_t gs_edge_count;                                           /**< falling edge counter */
+static pthread_cond_t gs_edge_cond;                                      /**< falling edge condition */
+static pthread_once_t gs_edge_once = PTHREAD_ONCE_INIT;                  /**< falling edge condition once */
+static uint8_t gs_stop;                                                  /**< interrupt pthread stop flag */
+static uint8_t gs_running;                                               /**< interrupt pthread running flag */
+
+/**
+ * @brief init the falling edge condition on CLOCK_MONOTONIC
+ * @note  none
+ */
+static void a_gpio_edge_cond_init(void)
+{
+    pthread_condattr_t attr;
+    
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(&gs_edge_cond, &attr);
+    pthread_condattr_destroy(&attr);
+}
+
+/**
+ * @brief     add one sample to the latency probe
+ * @param[in] *start pointer to a wake up time
+ * @param[in] *stop pointer to an irq finished time
+ * @note      none
+ */
+static void a_gpio_latency_add(const struct timespec *start, const struct timespec *stop)
+{
+    int64_t ns;
+    
+    /* get the latency */
+    ns = (int64_t)(stop->tv_sec - start->tv_sec) * 1000000000LL + (stop->tv_nsec - start->tv_nsec);
+    
+    /* update the probe */
+    pthread_mutex_lock(&gs_latency_mutex);
+    timing_histogram_add(&gs_latency, ns);
+    pthread_mutex_unlock(&gs_latency_mutex);
+}
+
+/**
+ * @brief     touch the stack so that the first interrupt does not page fault
+ * @param[in] size prefault size in bytes
+ * @note      the pages are written through the volatile pointer, a memset through a cast
+ *            drops the volatile and the optimizer removes the whole fill
+ */
+static void a_gpio_prefault_stack(uint32_t size)
+{
+    uint8_t stack[size];
+    volatile uint8_t *touch = stack;
+    uint32_t page;
+    uint32_t i;
+    
+    /* write one byte of every page and the last byte */
+    page = (uint32_t)sysconf(_SC_PAGESIZE);
+    page = (page == 0) ? 4096 : page;
+    for (i = 0; i < size; i += page)
+    {
+        touch[i] = 0;
+    }
+    if (size != 0)
+    {
+        touch[size - 1] = 0;
+    }
+    __asm__ volatile("" ::: "memory");
+}
+
+/**
+ * @brief  prefault the stack of the calling pthread with the rt profile
+ * @note   call it at the start of a pthread built with gpio_rt_profile_attr
+ */
+void gpio_rt_profile_prefault(void)
+{
+    if (gs_profile.prefault_size != 0)
+    {
+        a_gpio_prefault_stack(gs_profile.prefault_size);
+    }
+}
+
 /**
  * @brief  gpio interrupt pthread
  * @param  *p pointer to an args buffer
@@ -67,20 +169,40 @@ static void *a_gpio_interrupt_pthread(void *p)
 {
     int res;
     struct gpiod_line_event event;
+    struct timespec wake;
+    struct timespec submit;
+    struct timespec timeout;
+    uint8_t stop;
+    
+    /* set the poll period */
+    timeout.tv_sec = GPIO_POLL_MS / 1000;
+    timeout.tv_nsec = (GPIO_POLL_MS % 1000) * 1000000L;
+    
+    /* pre-fault the stack */
+    gpio_rt_profile_prefault();
+    
+    /* never cancel the pthread, it stops at the stop flag so no lock is left held */
+    pthread_setcancelstate(PTHREAD_CANCEL_DISABLE, NULL);
     
-    /* enable catching cancel signal */
-    pthread_setcancelstate(PTHREAD_CANCEL_ENABLE, NULL);
-
-    /* cancel the pthread at once */
-    pthread_setcanceltype(PTHREAD_CANCEL_ASYNCHRONOUS, NULL);
-
     /* loop */
     while (1)
     {
+        /* check the stop flag */
+        pthread_mutex_lock(&gs_latency_mutex);
+        stop = gs_stop;
+        pthread_mutex_unlock(&gs_latency_mutex);
+        if (stop != 0)
+        {
+            break;
+        }
+        
         /* wait for the event */
-        res = gpiod_line_event_wait(gs_line, NULL);
+        res = gpiod_line_event_wait(gs_line, &timeout);
         if (res == 1)
         {
+            /* get the wake up time */
+            clock_gettime(CLOCK_MONOTONIC, &wake);
+            
             /* read the event */
             if (gpiod_line_event_read(gs_line, &event) != 0)
             {
@@ -90,11 +212,295 @@ static void *a_gpio_interrupt_pthread(void *p)
             /* if the falling edge */
             if (event.event_type == GPIOD_LINE_EVENT_FALLING_EDGE)
             {
+                /* stamp the edge */
+                pthread_mutex_lock(&gs_latency_mutex);
+                gs_edge = wake;
+                gs_event = event.ts;
+                gs_edge_count++;
+                pthread_cond_broadcast(&gs_edge_cond);
+                pthread_mutex_unlock(&gs_latency_mutex);
+                
                 /* run the callback in the mutex mode */
                 mutex_irq(g_gpio_irq);
+                
+                /* probe the wake to submit latency */
+                clock_gettime(CLOCK_MONOTONIC, &submit);
+                a_gpio_latency_add(&wake, &submit);
             }
         }
     }
+    
+    /* wake the edge waiters, no edge comes any more */
+    pthread_mutex_lock(&gs_latency_mutex);
+    gs_running = 0;
+    pthread_cond_broadcast(&gs_edge_cond);
+    pthread_mutex_unlock(&gs_latency_mutex);
+    
+    return NULL;
+}
+
+/**
+ * @brief     set the rt profile of the interrupt pthread
+ * @param[in] *profile pointer to an rt profile structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 set failed
+ * @note      call it before gpio_interrupt_init, the profile is applied to the next created pthread,
+ *            the prefault size must leave 16KB of the stack size or of the default one when it is 0
+ */
+uint8_t gpio_interrupt_set_rt_profile(const gpio_rt_profile_t *profile)
+{
+    pthread_attr_t attr;
+    size_t size;
+    uint64_t stack_size;
+    
+    /* check the profile */
+    if (profile == NULL)
+    {
+        return 1;
+    }
+    if ((profile->priority < 0) || (profile->priority > sched_get_priority_max(SCHED_FIFO)))
+    {
+        fprintf(stderr, "gpio: priority is invalid.\n");
+        
+        return 1;
+    }
+    
+    /* a zero stack size means the default size of a new pthread */
+    stack_size = profile->stack_size;
+    if (stack_size == 0)
+    {
+        pthread_attr_init(&attr);
+        if (pthread_attr_getstacksize(&attr, &size) != 0)
+        {
+            size = 0;
+        }
+        pthread_attr_destroy(&attr);
+        stack_size = (uint64_t)size;
+    }
+    if ((profile->prefault_size != 0) && ((uint64_t)profile->prefault_size + 16384 > stack_size))
+    {
+        fprintf(stderr, "gpio: prefault size is over the stack size.\n");
+        
+        return 1;
+    }
+    
+    /* save the profile */
+    memcpy(&gs_profile, profile, sizeof(gpio_rt_profile_t));
+    
+    return 0;
+}
+
+/**
+ * @brief      get the wake to submit latency of the interrupt pthread
+ * @param[out] *latency pointer to a latency structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 get failed
+ * @note       the latency is measured from the pthread wake up to the end of the irq callback,
+ *             the fifo irq only submits the drain to the io pthread, so the drain itself isn't included
+ */
+uint8_t gpio_interrupt_get_latency(gpio_latency_t *latency)
+{
+    if (latency == NULL)
+    {
+        return 1;
+    }
+    
+    /* copy the probe */
+    memset(latency, 0, sizeof(gpio_latency_t));
+    pthread_mutex_lock(&gs_latency_mutex);
+    latency->histogram = gs_latency;
+    pthread_mutex_unlock(&gs_latency_mutex);
+    latency->count = latency->histogram.count;
+    latency->min_us = latency->histogram.min_us;
+    latency->max_us = latency->histogram.max_us;
+    latency->mean_us = (latency->histogram.count != 0) ? (uint32_t)(latency->histogram.sum_us / latency->histogram.count) : 0;
+    
+    /* get the percentiles */
+    latency->p50_us = timing_percentile(&latency->histogram, 500);
+    latency->p99_us = timing_percentile(&latency->histogram, 990);
+    latency->p999_us = timing_percentile(&latency->histogram, 999);
+    
+    return 0;
+}
+
+/**
+ * @brief      get the last falling edge of the interrupt pin
+ * @param[out] *ts pointer to a CLOCK_MONOTONIC time buffer
+ * @param[out] *count pointer to a falling edge counter buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get failed
+ * @note       the time is taken when the interrupt pthread wakes up,
+ *             the counter increases by one at every falling edge
+ */
+uint8_t gpio_interrupt_get_edge(struct timespec *ts, uint32_t *count)
+{
+    if ((ts == NULL) || (count == NULL))
+    {
+        return 1;
+    }
+    
+    /* copy the edge */
+    pthread_mutex_lock(&gs_latency_mutex);
+    *ts = gs_edge;
+    *count = gs_edge_count;
+    pthread_mutex_unlock(&gs_latency_mutex);
+    
+    return 0;
+}
+
+/**
+ * @brief      wait for a falling edge after a known one
+ * @param[in]  count falling edge counter already seen
+ * @param[in]  *until pointer to an absolute CLOCK_MONOTONIC time to give up
+ * @param[out] *ts pointer to a CLOCK_MONOTONIC time buffer
+ * @param[out] *new_count pointer to a falling edge counter buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 wait failed
+ *             - 2 timeout
+ * @note       it blocks on a condition signalled by the interrupt pthread and fails at once when
+ *             the interrupt pthread isn't running, the outputs hold the last edge even on timeout
+ */
+uint8_t gpio_interrupt_wait_edge(uint32_t count, const struct timespec *until,
+                                 struct timespec *ts, uint32_t *new_count)
+{
+    int res;
+    
+    if ((until == NULL) || (ts == NULL) || (new_count == NULL))
+    {
+        return 1;
+    }
+    
+    /* wait for the counter to move */
+    (void)pthread_once(&gs_edge_once, a_gpio_edge_cond_init);
+    res = 0;
+    pthread_mutex_lock(&gs_latency_mutex);
+    while ((gs_edge_count == count) && (gs_running != 0) && (res == 0))
+    {
+        res = pthread_cond_timedwait(&gs_edge_cond, &gs_latency_mutex, until);
+    }
+    *ts = gs_edge;
+    *new_count = gs_edge_count;
+    pthread_mutex_unlock(&gs_latency_mutex);
+    
+    if (*new_count != count)
+    {
+        return 0;
+    }
+    
+    return (res == ETIMEDOUT) ? 2 : 1;
+}
+
+/**
+ * @brief      get the kernel and wake up time of the last falling edge
+ * @param[out] *event pointer to a kernel time buffer
+ * @param[out] *wake pointer to a CLOCK_MONOTONIC wake up time buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get failed
+ * @note       the kernel stamps the event in the interrupt, it is CLOCK_MONOTONIC since linux 5.7
+ *             and CLOCK_REALTIME before, call it in the irq function to get the edge being served
+ */
+uint8_t gpio_interrupt_get_event(struct timespec *event, struct timespec *wake)
+{
+    if ((event == NULL) || (wake == NULL))
+    {
+        return 1;
+    }
+    
+    /* copy the edge */
+    pthread_mutex_lock(&gs_latency_mutex);
+    *event = gs_event;
+    *wake = gs_edge;
+    pthread_mutex_unlock(&gs_latency_mutex);
+    
+    return 0;
+}
+
+/**
+ * @brief  reset the latency probe
+ * @return status code
+ *         - 0 success
+ * @note   none
+ */
+uint8_t gpio_interrupt_reset_latency(void)
+{
+    pthread_mutex_lock(&gs_latency_mutex);
+    memset(&gs_latency, 0, sizeof(timing_histogram_t));
+    pthread_mutex_unlock(&gs_latency_mutex);
+    
+    return 0;
+}
+
+/**
+ * @brief      build the pthread attribute from the rt profile
+ * @param[out] *attr pointer to an initialized pthread attribute
+ * @return     status code
+ *             - 0 success
+ *             - 1 build failed
+ * @note       the io pthread of worker.c is built with the same attribute
+ */
+uint8_t gpio_rt_profile_attr(pthread_attr_t *attr)
+{
+    struct sched_param param;
+    cpu_set_t cpus;
+    
+    /* set the stack size */
+    if (gs_profile.stack_size != 0)
+    {
+        if (pthread_attr_setstacksize(attr, gs_profile.stack_size) != 0)
+        {
+            fprintf(stderr, "gpio: set stack size failed.\n");
+            
+            return 1;
+        }
+    }
+    
+    /* set the fifo scheduling */
+    if (gs_profile.priority != 0)
+    {
+        memset(&param, 0, sizeof(struct sched_param));
+        param.sched_priority = gs_profile.priority;
+        if ((pthread_attr_setinheritsched(attr, PTHREAD_EXPLICIT_SCHED) != 0) ||
+            (pthread_attr_setschedpolicy(attr, SCHED_FIFO) != 0) ||
+            (pthread_attr_setschedparam(attr, &param) != 0))
+        {
+            fprintf(stderr, "gpio: set fifo scheduling failed.\n");
+            
+            return 1;
+        }
+    }
+    
+    /* set the cpu affinity */
+    if (gs_profile.cpu >= 0)
+    {
+        CPU_ZERO(&cpus);
+        CPU_SET(gs_profile.cpu, &cpus);
+        if (pthread_attr_setaffinity_np(attr, sizeof(cpu_set_t), &cpus) != 0)
+        {
+            fprintf(stderr, "gpio: set cpu affinity failed.\n");
+            
+            return 1;
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief unlock the memory locked by the rt profile
+ * @note  none
+ */
+static void a_gpio_unlock_memory(void)
+{
+    if (gs_locked != 0)
+    {
+        (void)munlockall();
+        gs_locked = 0;
+    }
 }
 
 /**
@@ -106,7 +512,8 @@ static void *a_gpio_interrupt_pthread(void *p)
  */
 uint8_t gpio_interrupt_init(void)
 {
-    uint8_t res;
+    int res;
+    pthread_attr_t attr;
     
     /* open the gpio group */
     gs_chip = gpiod_chip_open(GPIO_DEVICE_NAME);
@@ -136,11 +543,48 @@ uint8_t gpio_interrupt_init(void)
         return 1;
     }
 
+    /* lock the memory */
+    if (gs_profile.lock_memory != 0)
+    {
+        if (mlockall(MCL_CURRENT | MCL_FUTURE) != 0)
+        {
+            perror("gpio: lock memory failed.\n");
+            gpiod_chip_close(gs_chip);
+            
+            return 1;
+        }
+        gs_locked = 1;
+    }
+    
+    /* init the falling edge condition */
+    (void)pthread_once(&gs_edge_once, a_gpio_edge_cond_init);
+    pthread_mutex_lock(&gs_latency_mutex);
+    gs_stop = 0;
+    gs_running = 1;
+    pthread_mutex_unlock(&gs_latency_mutex);
+    
+    /* build the rt attribute */
+    pthread_attr_init(&attr);
+    if (gpio_rt_profile_attr(&attr) != 0)
+    {
+        pthread_attr_destroy(&attr);
+        a_gpio_unlock_memory();
+        gpiod_chip_close(gs_chip);
+        
+        return 1;
+    }
+    
     /* creat a gpio interrupt pthread */
-    res = pthread_create(&gs_pid, NULL, a_gpio_interrupt_pthread, NULL);
+    res = pthread_create(&gs_pid, &attr, a_gpio_interrupt_pthread, NULL);
+    pthread_attr_destroy(&attr);
     if (res != 0)
     {
+        errno = res;
         perror("gpio: creat pthread failed.\n");
+        pthread_mutex_lock(&gs_latency_mutex);
+        gs_running = 0;
+        pthread_mutex_unlock(&gs_latency_mutex);
+        a_gpio_unlock_memory();
         gpiod_chip_close(gs_chip);
 
         return 1;
@@ -154,23 +598,35 @@ uint8_t gpio_interrupt_init(void)
  * @return status code
  *         - 0 success
  *         - 1 deinit failed
- * @note   none
+ * @note   the irq being served and the works it submitted to the io pthread finish before it returns,
+ *         so the handle can be deinitialized right after it, the pthread stops within one poll period
  */
 uint8_t gpio_interrupt_deinit(void)
 {
-    uint8_t res;
+    /* flag stop, the pthread sees it within one poll period */
+    pthread_mutex_lock(&gs_latency_mutex);
+    gs_stop = 1;
+    pthread_mutex_unlock(&gs_latency_mutex);
     
-    /* close the gpio interrupt pthread */
-    res = pthread_cancel(gs_pid);
-    if (res != 0)
+    /* wait for the irq being served */
+    if (pthread_join(gs_pid, NULL) != 0)
+    {
+        perror("gpio: join pthread failed.\n");
+        
+        return 1;
+    }
+    
+    /* finish the works the irqs submitted to the io pthread */
+    if (worker_deinit() != 0)
     {
-        perror("gpio: delete pthread failed.\n");
-
         return 1;
     }
 
     /* close the gpio */
     gpiod_chip_close(gs_chip);
     
+    /* unlock the memory */
+    a_gpio_unlock_memory();
+    
     return 0;
 }
@@ -0,0 +1,164 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      iic_scheduler_bus.c
+ * @brief     iic scheduler bus source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "iic_scheduler_bus.h"
+#include "iic.h"
+#include <linux/i2c.h>
+#include <linux/i2c-dev.h>
+#include <sys/ioctl.h>
+
+/**
+ * @brief max messages of one combined transfer definition
+ */
+#define IIC_SCHEDULER_MAX_MSG                I2C_RDWR_IOCTL_MAX_MSGS        /**< kernel limit */
+
+/**
+ * @brief global var definition
+ */
+static int gs_fd;        /**< iic handle */
+
+/**
+ * @brief      iic scheduler bus open
+ * @param[in]  *name pointer to an iic device name buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 open failed
+ * @note       called by the first iic_scheduler_init
+ */
+uint8_t iic_scheduler_bus_open(char *name)
+{
+    return iic_init(name, &gs_fd);
+}
+
+/**
+ * @brief  iic scheduler bus close
+ * @return status code
+ *         - 0 success
+ *         - 1 close failed
+ * @note   called by the last iic_scheduler_deinit
+ */
+uint8_t iic_scheduler_bus_close(void)
+{
+    return iic_deinit(gs_fd);
+}
+
+/**
+ * @brief      iic scheduler bus read
+ * @param[in]  addr iic device write address
+ * @param[in]  reg iic register address
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of the data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       called with the scheduler mutex held
+ */
+uint8_t iic_scheduler_bus_read(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    return iic_read(gs_fd, addr, reg, buf, len);
+}
+
+/**
+ * @brief     iic scheduler bus write
+ * @param[in] addr iic device write address
+ * @param[in] reg iic register address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      called with the scheduler mutex held
+ */
+uint8_t iic_scheduler_bus_write(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    return iic_write(gs_fd, addr, reg, buf, len);
+}
+
+/**
+ * @brief     iic scheduler bus transfer
+ * @param[in] *segment pointer to a segment buffer
+ * @param[in] n segment number
+ * @return    status code
+ *            - 0 success
+ *            - 1 transfer failed
+ * @note      every segment is a register write and a read with a repeated start,
+ *            the segments are split by the kernel message limit,
+ *            called with the scheduler mutex held
+ */
+uint8_t iic_scheduler_bus_transfer(iic_scheduler_segment_t *segment, uint16_t n)
+{
+    struct i2c_rdwr_ioctl_data i2c_rdwr_data;
+    struct i2c_msg msgs[IIC_SCHEDULER_MAX_MSG];
+    uint16_t i;
+    uint16_t j;
+    uint16_t k;
+    
+    for (i = 0; i < n; i += k)
+    {
+        /* clear ioctl data */
+        memset(&i2c_rdwr_data, 0, sizeof(struct i2c_rdwr_ioctl_data));
+        
+        /* clear msgs data */
+        memset(msgs, 0, sizeof(struct i2c_msg) * IIC_SCHEDULER_MAX_MSG);
+        
+        /* set the msgs of the segments */
+        k = n - i;
+        k = (k < (IIC_SCHEDULER_MAX_MSG / 2)) ? k : (IIC_SCHEDULER_MAX_MSG / 2);
+        for (j = 0; j < k; j++)
+        {
+            msgs[j * 2 + 0].addr = segment[i + j].addr >> 1;
+            msgs[j * 2 + 0].flags = 0;
+            msgs[j * 2 + 0].buf = &segment[i + j].reg;
+            msgs[j * 2 + 0].len = 1;
+            msgs[j * 2 + 1].addr = segment[i + j].addr >> 1;
+            msgs[j * 2 + 1].flags = I2C_M_RD;
+            msgs[j * 2 + 1].buf = segment[i + j].buf;
+            msgs[j * 2 + 1].len = segment[i + j].len;
+        }
+        i2c_rdwr_data.msgs = msgs;
+        i2c_rdwr_data.nmsgs = k * 2;
+        
+        /* transmit */
+        if (ioctl(gs_fd, I2C_RDWR, &i2c_rdwr_data) < 0)
+        {
+            perror("iic scheduler: transfer failed.\n");
+            
+            return 1;
+        }
+    }
+    
+    return 0;
+}
@@ -35,35 +35,64 @@
  */
 
 #include "mutex.h"
+#include <pthread.h>
 
-static volatile uint8_t gs_locked = 0;                 /**< mutex locked flag */
-static volatile uint32_t gs_int_locked_cnt = 0;        /**< mutex interrupt locked counter */
-static uint8_t (*gs_irq)(void) = NULL;                 /**< mutex irq */
+static pthread_mutex_t gs_mutex = PTHREAD_MUTEX_INITIALIZER;       /**< mutex of the flags */
+static pthread_cond_t gs_cond = PTHREAD_COND_INITIALIZER;          /**< mutex released condition */
+static uint8_t gs_locked = 0;                                      /**< mutex locked flag */
+static uint32_t gs_int_locked_cnt = 0;                             /**< mutex interrupt locked counter */
+static uint8_t (*gs_irq)(void) = NULL;                             /**< mutex irq */
+
+/**
+ * @brief  release the mutex
+ * @note   the deferred irq runs on the releasing thread before the mutex is freed,
+ *         so the irq never overlaps the locked section, call it with gs_mutex held
+ */
+static void a_mutex_release(void)
+{
+    uint8_t (*irq)(void);
+    
+    /* run the irqs deferred while locked */
+    while (gs_int_locked_cnt != 0)
+    {
+        /* clear the interrupt counter */
+        gs_int_locked_cnt = 0;
+        irq = gs_irq;
+        
+        /* if having the irq */
+        if (irq != NULL)
+        {
+            /* run the callback outside the flag mutex */
+            pthread_mutex_unlock(&gs_mutex);
+            irq();
+            pthread_mutex_lock(&gs_mutex);
+        }
+    }
+    
+    /* flag unlocked */
+    gs_locked = 0;
+    pthread_cond_broadcast(&gs_cond);
+}
 
 /**
  * @brief  mutex lock
  * @return status code
  *         - 0 success
- * @note   none
+ * @note   it waits while an irq or another thread owns the mutex, it isn't recursive
  */
 uint8_t mutex_lock(void)
 {
-    /* check if find the interrupt mutex */
-    if (gs_int_locked_cnt != 0)
+    pthread_mutex_lock(&gs_mutex);
+    
+    /* wait for the owner */
+    while (gs_locked != 0)
     {
-        /* if having the irq */
-        if (gs_irq != NULL)
-        {
-            /* run the callback */
-            gs_irq();
-        }
-        
-        /* clear the interrupt counter */
-        gs_int_locked_cnt = 0;
+        pthread_cond_wait(&gs_cond, &gs_mutex);
     }
     
     /* flag locked */
     gs_locked = 1;
+    pthread_mutex_unlock(&gs_mutex);
     
     return 0;
 }
@@ -72,26 +101,13 @@ uint8_t mutex_lock(void)
  * @brief  mutex unlock
  * @return status code
  *         - 0 success
- * @note   none
+ * @note   the irqs deferred while locked run here
  */
 uint8_t mutex_unlock(void)
 {
-    /* check if find the interrupt mutex */
-    if (gs_int_locked_cnt != 0)
-    {
-        /* if having the irq */
-        if (gs_irq != NULL)
-        {
-            /* run the callback */
-            gs_irq();
-        }
-        
-        /* clear the interrupt counter */
-        gs_int_locked_cnt = 0;
-    }
-    
-    /* flag unlocked */
-    gs_locked = 0;
+    pthread_mutex_lock(&gs_mutex);
+    a_mutex_release();
+    pthread_mutex_unlock(&gs_mutex);
     
     return 0;
 }
@@ -99,19 +115,34 @@ uint8_t mutex_unlock(void)
 /**
  * @brief     mutex irq
  * @param[in] *irq pointer to an interrupt funtion
- * @note      none
+ * @note      when the mutex is free the irq owns it while it runs, else the irq is deferred
+ *            to the unlock of the owner, the pthread can't be cancelled inside
  */
 void mutex_irq(uint8_t (*irq)(void))
 {
+    int state;
+    
+    /* hold off the cancel while owning the mutex */
+    pthread_setcancelstate(PTHREAD_CANCEL_DISABLE, &state);
+    pthread_mutex_lock(&gs_mutex);
+    
     /* if not locked */
     if (gs_locked == 0)
     {
+        /* flag locked */
+        gs_locked = 1;
+        pthread_mutex_unlock(&gs_mutex);
+        
         /* if having the irq */
         if (irq != NULL)
         {
             /* run the callback */
             irq();
         }
+        
+        /* release the mutex */
+        pthread_mutex_lock(&gs_mutex);
+        a_mutex_release();
     }
     else
     {
@@ -121,4 +152,6 @@ void mutex_irq(uint8_t (*irq)(void))
         /* interrupt mutex counter increment */
         gs_int_locked_cnt++;
     }
+    pthread_mutex_unlock(&gs_mutex);
+    pthread_setcancelstate(state, NULL);
 }
@@ -0,0 +1,214 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      sampler.c
+ * @brief     sampler source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "sampler.h"
+#include "gpio.h"
+#include <errno.h>
+#include <string.h>
+
+/**
+ * @brief     add ns to a time
+ * @param[in] *ts pointer to a time
+ * @param[in] ns added ns
+ * @note      none
+ */
+static void a_sampler_add(struct timespec *ts, uint64_t ns)
+{
+    uint64_t nsec;
+    
+    nsec = (uint64_t)ts->tv_nsec + ns;
+    ts->tv_sec += (time_t)(nsec / 1000000000ULL);
+    ts->tv_nsec = (long)(nsec % 1000000000ULL);
+}
+
+/**
+ * @brief     get the ns from a to b
+ * @param[in] *a pointer to a start time
+ * @param[in] *b pointer to a stop time
+ * @return    signed ns
+ * @note      none
+ */
+static int64_t a_sampler_diff(const struct timespec *a, const struct timespec *b)
+{
+    return (int64_t)(b->tv_sec - a->tv_sec) * 1000000000LL + (int64_t)(b->tv_nsec - a->tv_nsec);
+}
+
+/**
+ * @brief     sleep until an absolute time
+ * @param[in] *ts pointer to an absolute CLOCK_MONOTONIC time
+ * @return    status code
+ *            - 0 success
+ *            - 1 sleep failed
+ * @note      restart after a signal
+ */
+static uint8_t a_sampler_sleep(const struct timespec *ts)
+{
+    int res;
+    
+    do
+    {
+        res = clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, ts, NULL);
+    } while (res == EINTR);
+    
+    return (res == 0) ? 0 : 1;
+}
+
+/**
+ * @brief     sampler init
+ * @param[in] *sampler pointer to a sampler structure
+ * @param[in] period_us sample period in us
+ * @param[in] phase_lock lock the deadline to the data ready edge
+ * @param[in] offset_us delay after the data ready edge in us
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      the first deadline is one period from now,
+ *            the phase lock needs the gpio interrupt to be running with the data ready interrupt enabled
+ */
+uint8_t sampler_init(sampler_t *sampler, uint32_t period_us, uint8_t phase_lock, uint32_t offset_us)
+{
+    struct timespec edge;
+    
+    if ((sampler == NULL) || (period_us == 0) || (offset_us >= period_us))
+    {
+        return 1;
+    }
+    
+    /* set the param */
+    memset(sampler, 0, sizeof(sampler_t));
+    sampler->period_ns = (uint64_t)period_us * 1000;
+    sampler->offset_ns = (uint64_t)offset_us * 1000;
+    sampler->phase_lock = phase_lock;
+    
+    /* the edges before now are already used */
+    if (phase_lock != 0)
+    {
+        if (gpio_interrupt_get_edge(&edge, &sampler->edge_count) != 0)
+        {
+            return 1;
+        }
+    }
+    
+    /* set the first deadline */
+    if (clock_gettime(CLOCK_MONOTONIC, &sampler->deadline) != 0)
+    {
+        return 1;
+    }
+    a_sampler_add(&sampler->deadline, sampler->period_ns);
+    
+    return 0;
+}
+
+/**
+ * @brief     sampler wait
+ * @param[in] *sampler pointer to a sampler structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 wait failed
+ *            - 2 no new sample
+ * @note      sleep until the next absolute deadline and schedule the one after it,
+ *            late deadlines are skipped and counted as missed instead of being caught up,
+ *            in the phase lock mode it blocks until a new data ready edge and returns 2
+ *            if none comes within one period, the caller should skip the read then
+ */
+uint8_t sampler_wait(sampler_t *sampler)
+{
+    struct timespec now;
+    struct timespec edge;
+    uint32_t count;
+    int64_t late;
+    uint64_t skip;
+    uint8_t res;
+    uint8_t status;
+    
+    if (sampler == NULL)
+    {
+        return 1;
+    }
+    
+    /* sleep until the deadline */
+    if (a_sampler_sleep(&sampler->deadline) != 0)
+    {
+        return 1;
+    }
+    sampler->count++;
+    status = 0;
+    
+    if (sampler->phase_lock != 0)
+    {
+        /* wait for a fresh sample, give up after one period */
+        now = sampler->deadline;
+        a_sampler_add(&now, sampler->period_ns);
+        res = gpio_interrupt_wait_edge(sampler->edge_count, &now, &edge, &count);
+        if (res == 0)
+        {
+            /* more than one new edge means the samples between were overwritten */
+            sampler->missed += count - sampler->edge_count - 1;
+            sampler->edge_count = count;
+            
+            /* the next sample is expected one period after this edge */
+            sampler->deadline = edge;
+            a_sampler_add(&sampler->deadline, sampler->period_ns + sampler->offset_ns);
+            
+            return 0;
+        }
+        if (res != 2)
+        {
+            return 1;
+        }
+        
+        /* no edge, free run on the period and report no new sample */
+        sampler->missed++;
+        status = 2;
+    }
+    
+    /* schedule the next deadline */
+    a_sampler_add(&sampler->deadline, sampler->period_ns);
+    if (clock_gettime(CLOCK_MONOTONIC, &now) != 0)
+    {
+        return 1;
+    }
+    late = a_sampler_diff(&sampler->deadline, &now);
+    if (late >= 0)
+    {
+        /* skip the passed deadlines */
+        skip = (uint64_t)late / sampler->period_ns + 1;
+        sampler->missed += (uint32_t)skip;
+        a_sampler_add(&sampler->deadline, skip * sampler->period_ns);
+    }
+    
+    return status;
+}
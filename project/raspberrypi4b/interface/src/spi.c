@@ -207,36 +207,31 @@ uint8_t spi_read_cmd(int fd, uint8_t *buf, uint16_t len)
  */
 uint8_t spi_read(int fd, uint8_t reg, uint8_t *buf, uint16_t len)
 {
-    struct spi_ioc_transfer k;
-    uint8_t command[len + 1];
-    uint8_t recv[len + 1];
+    struct spi_ioc_transfer k[2];
     int l;
     
-    /* set the command */
-    command[0] = reg;
-    memset(&command[1], 0x00, len);
-    
     /* clear ioc transfer */
-    memset(&k, 0, sizeof(struct spi_ioc_transfer));
+    memset(k, 0, sizeof(struct spi_ioc_transfer) * 2);
     
-    /* set the param */
-    k.tx_buf = (unsigned long)command;
-    k.rx_buf = (unsigned long)recv;
-    k.len = len + 1;
-    k.cs_change = 0;
+    /* set the command segment */
+    k[0].tx_buf = (unsigned long)&reg;
+    k[0].len = 1;
+    k[0].cs_change = 0;
+    
+    /* receive into the caller buffer, zeros are shifted out when tx_buf is null */
+    k[1].rx_buf = (unsigned long)buf;
+    k[1].len = len;
+    k[1].cs_change = 0;
     
     /* transmit */
-    l = ioctl(fd, SPI_IOC_MESSAGE(1), &k);
-    if (l != k.len)
+    l = ioctl(fd, SPI_IOC_MESSAGE(2), k);
+    if (l != (int)(k[0].len + k[1].len))
     {
         perror("spi: length check error.\n");
         
         return 1;
     }
     
-    /* copy the data */
-    memcpy(buf, recv + 1, len);
-    
     return 0;
 }
 
@@ -253,37 +248,36 @@ uint8_t spi_read(int fd, uint8_t reg, uint8_t *buf, uint16_t len)
  */
 uint8_t spi_read_address16(int fd, uint16_t reg, uint8_t *buf, uint16_t len)
 {
-    struct spi_ioc_transfer k;
-    uint8_t command[len + 2];
-    uint8_t recv[len + 2];
+    struct spi_ioc_transfer k[2];
+    uint8_t command[2];
     int l;
     
     /* set the command */
     command[0] = (reg >> 8) & 0xFF;
     command[1] = reg & 0xFF;
-    memset(&command[2], 0x00, len);
     
     /* clear ioc transfer */
-    memset(&k, 0, sizeof(struct spi_ioc_transfer));
+    memset(k, 0, sizeof(struct spi_ioc_transfer) * 2);
     
-    /* set the param */
-    k.tx_buf = (unsigned long)command;
-    k.rx_buf = (unsigned long)recv;
-    k.len = len + 2;
-    k.cs_change = 0;
+    /* set the command segment */
+    k[0].tx_buf = (unsigned long)command;
+    k[0].len = 2;
+    k[0].cs_change = 0;
+    
+    /* receive into the caller buffer, zeros are shifted out when tx_buf is null */
+    k[1].rx_buf = (unsigned long)buf;
+    k[1].len = len;
+    k[1].cs_change = 0;
     
     /* transmit */
-    l = ioctl(fd, SPI_IOC_MESSAGE(1), &k);
-    if (l != k.len)
+    l = ioctl(fd, SPI_IOC_MESSAGE(2), k);
+    if (l != (int)(k[0].len + k[1].len))
     {
         perror("spi: length check error.\n");
         
         return 1;
     }
     
-    /* copy the data */
-    memcpy(buf, recv + 2, len);
-    
     return 0;
 }
 
@@ -335,25 +329,25 @@ uint8_t spi_write_cmd(int fd, uint8_t *buf, uint16_t len)
  */
 uint8_t spi_write(int fd, uint8_t reg, uint8_t *buf, uint16_t len)
 {
-    struct spi_ioc_transfer k;
-    uint8_t command[len + 1];
+    struct spi_ioc_transfer k[2];
     int l;
     
-    /* set the command */
-    command[0] = reg;
-    memcpy(&command[1], buf, len);
-    
     /* clear ioc transfer */
-    memset(&k, 0, sizeof(struct spi_ioc_transfer));
+    memset(k, 0, sizeof(struct spi_ioc_transfer) * 2);
     
-    /* set the param */
-    k.tx_buf = (unsigned long)command;
-    k.len = len + 1;
-    k.cs_change = 0;
+    /* set the command segment */
+    k[0].tx_buf = (unsigned long)&reg;
+    k[0].len = 1;
+    k[0].cs_change = 0;
+    
+    /* send the caller buffer directly */
+    k[1].tx_buf = (unsigned long)buf;
+    k[1].len = len;
+    k[1].cs_change = 0;
     
     /* transmit */
-    l = ioctl(fd, SPI_IOC_MESSAGE(1), &k);
-    if (l != k.len)
+    l = ioctl(fd, SPI_IOC_MESSAGE(2), k);
+    if (l != (int)(k[0].len + k[1].len))
     {
         perror("spi: length check error.\n");
         
@@ -376,26 +370,30 @@ uint8_t spi_write(int fd, uint8_t reg, uint8_t *buf, uint16_t len)
  */
 uint8_t spi_write_address16(int fd, uint16_t reg, uint8_t *buf, uint16_t len)
 {
-    struct spi_ioc_transfer k;
-    uint8_t command[len + 2];
+    struct spi_ioc_transfer k[2];
+    uint8_t command[2];
     int l;
     
     /* set the command */
     command[0] = (reg >> 8) & 0xFF;
     command[1] = reg & 0xFF;
-    memcpy(&command[2], buf, len);
     
     /* clear ioc transfer */
-    memset(&k, 0, sizeof(struct spi_ioc_transfer));
+    memset(k, 0, sizeof(struct spi_ioc_transfer) * 2);
     
-    /* set the param */
-    k.tx_buf = (unsigned long)command;
-    k.len = len + 2;
-    k.cs_change = 0;
+    /* set the command segment */
+    k[0].tx_buf = (unsigned long)command;
+    k[0].len = 2;
+    k[0].cs_change = 0;
+    
+    /* send the caller buffer directly */
+    k[1].tx_buf = (unsigned long)buf;
+    k[1].len = len;
+    k[1].cs_change = 0;
     
     /* transmit */
-    l = ioctl(fd, SPI_IOC_MESSAGE(1), &k);
-    if (l != k.len)
+    l = ioctl(fd, SPI_IOC_MESSAGE(2), k);
+    if (l != (int)(k[0].len + k[1].len))
     {
         perror("spi: length check error.\n");
         
@@ -0,0 +1,224 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      timing.c
+ * @brief     timing source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "timing.h"
+#include <string.h>
+
+/**
+ * @brief     convert a time to ns
+ * @param[in] *ts pointer to a time
+ * @return    time in ns
+ * @note      none
+ */
+static int64_t a_timing_ns(const struct timespec *ts)
+{
+    return (int64_t)ts->tv_sec * 1000000000LL + ts->tv_nsec;
+}
+
+/**
+ * @brief     add one value to the histogram
+ * @param[in] *histogram pointer to a timing histogram structure
+ * @param[in] ns value in ns
+ * @note      a negative value counts as 0 and a value over the uint32 us range is clamped
+ */
+void timing_histogram_add(timing_histogram_t *histogram, int64_t ns)
+{
+    uint32_t us;
+    uint32_t octave;
+    uint32_t bucket;
+    
+    /* get the value in us */
+    if (ns <= 0)
+    {
+        us = 0;
+    }
+    else if (ns / 1000 > 0xFFFFFFFFLL)
+    {
+        us = 0xFFFFFFFFU;
+    }
+    else
+    {
+        us = (uint32_t)(ns / 1000);
+    }
+    
+    /* find the bucket, linear under 16us and 8 steps per octave above */
+    if (us < 16)
+    {
+        bucket = us;
+    }
+    else
+    {
+        octave = 31 - (uint32_t)__builtin_clz(us);
+        bucket = 16 + (octave - 4) * 8 + ((us >> (octave - 3)) & 7);
+    }
+    
+    /* update the histogram */
+    if ((histogram->count == 0) || (us < histogram->min_us))
+    {
+        histogram->min_us = us;
+    }
+    if (us > histogram->max_us)
+    {
+        histogram->max_us = us;
+    }
+    histogram->sum_us += us;
+    histogram->count++;
+    histogram->bucket[bucket]++;
+}
+
+/**
+ * @brief     init the timing analyzer
+ * @param[in] *timing pointer to a timing structure
+ * @param[in] period_ns nominal sample period in ns
+ * @param[in] capacity samples the chip holds before it loses one, 1 for the data ready mode and 32 for the fifo
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      none
+ */
+uint8_t timing_init(timing_t *timing, uint64_t period_ns, uint16_t capacity)
+{
+    /* check the params */
+    if ((timing == NULL) || (period_ns == 0) || (capacity == 0))
+    {
+        return 1;
+    }
+    
+    /* clear all */
+    memset(timing, 0, sizeof(timing_t));
+    timing->period_ns = period_ns;
+    timing->capacity = capacity;
+    
+    return 0;
+}
+
+/**
+ * @brief     add one batch to the timing analyzer
+ * @param[in] *timing pointer to a timing structure
+ * @param[in] *event pointer to a kernel edge time
+ * @param[in] *wake pointer to a CLOCK_MONOTONIC wake up time of the edge
+ * @param[in] *handler pointer to a CLOCK_MONOTONIC handler entry time
+ * @param[in] *data pointer to a CLOCK_MONOTONIC data read time
+ * @param[in] samples read samples of the batch
+ * @note      the wake up time replaces a kernel time that is not CLOCK_MONOTONIC,
+ *            a sample is only counted as missed when the batch filled the chip capacity
+ */
+void timing_add(timing_t *timing, const struct timespec *event, const struct timespec *wake,
+                const struct timespec *handler, const struct timespec *data, uint16_t samples)
+{
+    struct timespec edge;
+    int64_t interval;
+    int64_t nominal;
+    uint64_t slots;
+    
+    /* a realtime or future kernel stamp can't be compared with the monotonic clock */
+    edge = *event;
+    if ((a_timing_ns(event) > a_timing_ns(wake)) || 
+        (a_timing_ns(wake) - a_timing_ns(event) > 1000000000LL))
+    {
+        edge = *wake;
+        timing->unstamped++;
+    }
+    
+    /* add the latencies */
+    timing_histogram_add(&timing->irq, a_timing_ns(handler) - a_timing_ns(&edge));
+    timing_histogram_add(&timing->handler, a_timing_ns(data) - a_timing_ns(handler));
+    
+    /* compare the interval with the nominal period of the read samples */
+    if (timing->started != 0)
+    {
+        interval = a_timing_ns(&edge) - a_timing_ns(&timing->edge);
+        nominal = (int64_t)(timing->period_ns * samples);
+        timing_histogram_add(&timing->jitter, (interval > nominal) ? (interval - nominal) : (nominal - interval));
+        
+        /* the chip only drops samples when it is full */
+        slots = (interval > 0) ? ((uint64_t)interval + timing->period_ns / 2) / timing->period_ns : 0;
+        if ((samples >= timing->capacity) && (slots > samples))
+        {
+            timing->missed += slots - samples;
+        }
+    }
+    else
+    {
+        timing->first = edge;
+        timing->started = 1;
+    }
+    timing->edge = edge;
+    timing->batches++;
+    timing->samples += samples;
+}
+
+/**
+ * @brief     get the percentile upper bound from the histogram
+ * @param[in] *histogram pointer to a timing histogram structure
+ * @param[in] permille percentile in permille
+ * @return    upper bound in us
+ * @note      the bound is within 12.5 percent of the value
+ */
+uint32_t timing_percentile(const timing_histogram_t *histogram, uint32_t permille)
+{
+    uint64_t target;
+    uint64_t sum;
+    uint64_t bound;
+    uint32_t octave;
+    uint32_t i;
+    
+    /* get the target rank */
+    target = ((uint64_t)histogram->count * permille + 999) / 1000;
+    sum = 0;
+    for (i = 0; i < TIMING_BUCKETS; i++)
+    {
+        sum += histogram->bucket[i];
+        if ((sum >= target) && (sum != 0))
+        {
+            /* get the bucket upper bound */
+            if (i < 16)
+            {
+                bound = i;
+            }
+            else
+            {
+                octave = 4 + (i - 16) / 8;
+                bound = ((uint64_t)(8 + (i - 16) % 8 + 1) << (octave - 3)) - 1;
+            }
+            
+            /* never report more than the real max */
+            return (bound > histogram->max_us) ? histogram->max_us : (uint32_t)bound;
+        }
+    }
+    
+    return histogram->max_us;
+}
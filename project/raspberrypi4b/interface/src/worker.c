@@ -0,0 +1,344 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      worker.c
+ * @brief     worker source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "worker.h"
+#include "gpio.h"
+#include "mutex.h"
+#include <errno.h>
+#include <pthread.h>
+
+/**
+ * @brief worker item structure definition
+ */
+typedef struct worker_item_s
+{
+    void (*work)(void *arg);        /**< work function */
+    void *arg;                      /**< work argument */
+} worker_item_t;
+
+/**
+ * @brief worker stage structure definition
+ */
+typedef struct worker_stage_s
+{
+    const char *name;                               /**< stage name */
+    uint8_t io;                                     /**< run in the mutex with the rt profile */
+    pthread_mutex_t mutex;                          /**< queue mutex */
+    pthread_cond_t cond;                            /**< queue condition */
+    worker_item_t queue[WORKER_QUEUE_DEPTH];        /**< work queue */
+    uint32_t head;                                  /**< queue head */
+    uint32_t count;                                 /**< queue count */
+    uint8_t running;                                /**< running flag */
+    uint8_t stop;                                   /**< stop flag */
+    pthread_t pid;                                  /**< stage pthread pid */
+} worker_stage_t;
+
+/**
+ * @brief global var definition
+ */
+static worker_stage_t gs_io =                       /**< io stage */
+{
+    "io", 1, PTHREAD_MUTEX_INITIALIZER, PTHREAD_COND_INITIALIZER, {{NULL, NULL}}, 0, 0, 0, 0, 0,
+};
+static worker_stage_t gs_done =                     /**< completion stage */
+{
+    "completion", 0, PTHREAD_MUTEX_INITIALIZER, PTHREAD_COND_INITIALIZER, {{NULL, NULL}}, 0, 0, 0, 0, 0,
+};
+
+/**
+ * @brief  worker pthread
+ * @param  *p pointer to a worker stage structure
+ * @return NULL
+ * @note   none
+ */
+static void *a_worker_pthread(void *p)
+{
+    worker_stage_t *stage = (worker_stage_t *)p;
+    worker_item_t item;
+    
+    /* pre-fault the stack */
+    if (stage->io != 0)
+    {
+        gpio_rt_profile_prefault();
+    }
+    
+    /* loop */
+    while (1)
+    {
+        /* wait for a work */
+        pthread_mutex_lock(&stage->mutex);
+        while ((stage->count == 0) && (stage->stop == 0))
+        {
+            pthread_cond_wait(&stage->cond, &stage->mutex);
+        }
+        
+        /* exit when all works are done */
+        if (stage->count == 0)
+        {
+            pthread_mutex_unlock(&stage->mutex);
+            
+            break;
+        }
+        
+        /* pop the work */
+        item = stage->queue[stage->head];
+        stage->head = (stage->head + 1) % WORKER_QUEUE_DEPTH;
+        stage->count--;
+        pthread_mutex_unlock(&stage->mutex);
+        
+        /* run an io work in the mutex so it never overlaps the irq, a completion runs outside */
+        if (stage->io != 0)
+        {
+            mutex_lock();
+            item.work(item.arg);
+            mutex_unlock();
+        }
+        else
+        {
+            item.work(item.arg);
+        }
+    }
+    
+    return NULL;
+}
+
+/**
+ * @brief     start a worker stage
+ * @param[in] *stage pointer to a worker stage structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 start failed
+ * @note      the io stage is built with the rt profile, the completion stage with the default attribute
+ */
+static uint8_t a_worker_start(worker_stage_t *stage)
+{
+    pthread_attr_t attr;
+    uint8_t res;
+    int err;
+    
+    res = 0;
+    pthread_mutex_lock(&stage->mutex);
+    if (stage->running == 0)
+    {
+        /* creat the stage pthread */
+        stage->head = 0;
+        stage->count = 0;
+        stage->stop = 0;
+        pthread_attr_init(&attr);
+        if ((stage->io != 0) && (gpio_rt_profile_attr(&attr) != 0))
+        {
+            res = 1;
+        }
+        else
+        {
+            err = pthread_create(&stage->pid, &attr, a_worker_pthread, stage);
+            if (err != 0)
+            {
+                errno = err;
+                perror("worker: creat pthread failed.\n");
+                res = 1;
+            }
+            else
+            {
+                stage->running = 1;
+            }
+        }
+        pthread_attr_destroy(&attr);
+    }
+    pthread_mutex_unlock(&stage->mutex);
+    
+    return res;
+}
+
+/**
+ * @brief     stop a worker stage
+ * @param[in] *stage pointer to a worker stage structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 stop failed
+ * @note      all pending works finish before the stage pthread exits
+ */
+static uint8_t a_worker_stop(worker_stage_t *stage)
+{
+    /* check the running flag */
+    pthread_mutex_lock(&stage->mutex);
+    if (stage->running == 0)
+    {
+        pthread_mutex_unlock(&stage->mutex);
+        
+        return 0;
+    }
+    
+    /* flag stop */
+    stage->stop = 1;
+    pthread_cond_signal(&stage->cond);
+    pthread_mutex_unlock(&stage->mutex);
+    
+    /* wait for the pending works */
+    if (pthread_join(stage->pid, NULL) != 0)
+    {
+        perror("worker: join pthread failed.\n");
+        
+        return 1;
+    }
+    
+    /* flag stopped */
+    pthread_mutex_lock(&stage->mutex);
+    stage->running = 0;
+    pthread_mutex_unlock(&stage->mutex);
+    
+    return 0;
+}
+
+/**
+ * @brief     push a work to a worker stage
+ * @param[in] *stage pointer to a worker stage structure
+ * @param[in] *work pointer to a work function address
+ * @param[in] *arg pointer to a work argument
+ * @return    status code
+ *            - 0 success
+ *            - 1 push failed
+ * @note      none
+ */
+static uint8_t a_worker_push(worker_stage_t *stage, void (*work)(void *arg), void *arg)
+{
+    /* check the work */
+    if (work == NULL)
+    {
+        return 1;
+    }
+    
+    /* start the worker */
+    if (worker_init() != 0)
+    {
+        return 1;
+    }
+    
+    /* push the work */
+    pthread_mutex_lock(&stage->mutex);
+    if ((stage->count == WORKER_QUEUE_DEPTH) || (stage->stop != 0))
+    {
+        pthread_mutex_unlock(&stage->mutex);
+        
+        return 1;
+    }
+    stage->queue[(stage->head + stage->count) % WORKER_QUEUE_DEPTH].work = work;
+    stage->queue[(stage->head + stage->count) % WORKER_QUEUE_DEPTH].arg = arg;
+    stage->count++;
+    pthread_cond_signal(&stage->cond);
+    pthread_mutex_unlock(&stage->mutex);
+    
+    return 0;
+}
+
+/**
+ * @brief  worker init
+ * @return status code
+ *         - 0 success
+ *         - 1 init failed
+ * @note   start the io pthread with the rt profile of the gpio interrupt pthread and the completion
+ *         pthread with the default attribute, calling it again when they are running does nothing
+ */
+uint8_t worker_init(void)
+{
+    /* start the completion stage first, the io works hand their completions to it */
+    if (a_worker_start(&gs_done) != 0)
+    {
+        return 1;
+    }
+    if (a_worker_start(&gs_io) != 0)
+    {
+        (void)a_worker_stop(&gs_done);
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief  worker deinit
+ * @return status code
+ *         - 0 success
+ *         - 1 deinit failed
+ * @note   all pending works and completions finish before the pthreads exit,
+ *         don't call it from a work or a completion function
+ */
+uint8_t worker_deinit(void)
+{
+    uint8_t res;
+    
+    /* stop the io stage first, its last works still hand off completions */
+    res = a_worker_stop(&gs_io);
+    if (a_worker_stop(&gs_done) != 0)
+    {
+        res = 1;
+    }
+    
+    return res;
+}
+
+/**
+ * @brief     worker submit
+ * @param[in] *work pointer to a work function address
+ * @param[in] *arg pointer to a work argument
+ * @return    status code
+ *            - 0 success
+ *            - 1 submit failed
+ * @note      the pthreads are started at the first submit, works run one by one in the submitted
+ *            order and each one runs between mutex_lock and mutex_unlock, so it never overlaps the
+ *            irq function, an irq that comes meanwhile runs at the unlock on the io pthread,
+ *            a work must not call mutex_lock
+ */
+uint8_t worker_submit(void (*work)(void *arg), void *arg)
+{
+    return a_worker_push(&gs_io, work, arg);
+}
+
+/**
+ * @brief     worker complete
+ * @param[in] *done pointer to a completion function address
+ * @param[in] *arg pointer to a completion argument
+ * @return    status code
+ *            - 0 success
+ *            - 1 submit failed
+ * @note      completions run one by one in the submitted order on the completion pthread outside
+ *            the mutex, so the io pthread can run the next work while a completion still runs
+ */
+uint8_t worker_complete(void (*done)(void *arg), void *arg)
+{
+    return a_worker_push(&gs_done, done, arg);
+}
@@ -36,19 +36,67 @@
 
 #include "driver_adxl345_tap_action_fall_test.h"
 #include "driver_adxl345_fifo_test.h"
+#include "driver_adxl345_shared_test.h"
 #include "driver_adxl345_read_test.h"
 #include "driver_adxl345_register_test.h"
 #include "driver_adxl345_interrupt.h"
 #include "driver_adxl345_fifo.h"
 #include "driver_adxl345_basic.h"
+#include "bus_fault.h"
+#include "bus_record.h"
 #include "gpio.h"
+#include "iic_scheduler.h"
 #include "mutex.h"
+#include "sampler.h"
+#include "timing.h"
+#include "worker.h"
 #include <getopt.h>
+#include <pthread.h>
 #include <stdlib.h>
 
 volatile uint8_t g_flag;                   /**< interrupt flag */
 uint8_t (*g_gpio_irq)(void) = NULL;        /**< gpio irq function address */
 
+/**
+ * @brief timing test var definition
+ */
+static timing_t gs_timing;                                                /**< timing analyzer */
+static pthread_mutex_t gs_timing_mutex = PTHREAD_MUTEX_INITIALIZER;       /**< timing mutex */
+static struct timespec gs_timing_event;                                   /**< kernel time of the served edge */
+static struct timespec gs_timing_wake;                                    /**< wake up time of the served edge */
+static struct timespec gs_timing_handler;                                 /**< handler entry time of the served edge */
+static uint8_t gs_timing_pending;                                         /**< served edge waits for the data */
+
+/**
+ * @brief async test var definition
+ */
+#define ASYNC_TEST_DRAIN_MS       2         /**< simulated drain time */
+#define ASYNC_TEST_CALLBACK_MS    10        /**< simulated callback time */
+static struct timespec gs_async_drain[WORKER_QUEUE_DEPTH];           /**< drain start time */
+static struct timespec gs_async_callback[WORKER_QUEUE_DEPTH];        /**< callback end time */
+static uint8_t gs_async_index[WORKER_QUEUE_DEPTH];                   /**< batch index */
+
+/**
+ * @brief timing test rate table definition
+ */
+static const struct
+{
+    const char *name;                 /**< rate name in Hz */
+    adxl345_rate_t rate;              /**< rate */
+} gs_timing_rate[] =
+{
+    {"6.25", ADXL345_RATE_6P25},
+    {"12.5", ADXL345_RATE_12P5},
+    {"25", ADXL345_RATE_25},
+    {"50", ADXL345_RATE_50},
+    {"100", ADXL345_RATE_100},
+    {"200", ADXL345_RATE_200},
+    {"400", ADXL345_RATE_400},
+    {"800", ADXL345_RATE_800},
+    {"1600", ADXL345_RATE_1600},
+    {"3200", ADXL345_RATE_3200},
+};
+
 /**
  * @brief     fifo callback
  * @param[in] **g pointer to a converted data buffer
@@ -60,6 +108,34 @@ static void a_fifo_callback(float (*g)[3], uint16_t len)
     g_flag = 1;
 }
 
+/**
+ * @brief  data ready irq
+ * @return status code
+ *         - 0 success
+ * @note   the gpio pthread stamps the edge, the sampler reads the data
+ */
+static uint8_t a_data_ready_irq(void)
+{
+    return 0;
+}
+
+/**
+ * @brief  shared bus irq
+ * @return status code
+ *         - 0 success
+ *         - 1 run failed
+ * @note   both fifos are drained in one combined transfer before the handlers of both chips run
+ */
+static uint8_t a_shared_irq(void)
+{
+    if (iic_scheduler_prefetch() != 0)
+    {
+        return 1;
+    }
+    
+    return adxl345_shared_test_irq_handler();
+}
+
 /**
  * @brief     interrupt callback
  * @param[in] type irq type
@@ -114,6 +190,151 @@ static void a_interrupt_callback(uint8_t type)
     }
 }
 
+/**
+ * @brief  timing data ready irq
+ * @return status code
+ *         - 0 success
+ *         - 1 run failed
+ * @note   the data is read in the interrupt pthread
+ */
+static uint8_t a_timing_ready_irq(void)
+{
+    uint8_t res;
+    float g[3];
+    struct timespec event;
+    struct timespec wake;
+    struct timespec handler;
+    struct timespec data;
+    
+    /* stamp the handler */
+    clock_gettime(CLOCK_MONOTONIC, &handler);
+    (void)gpio_interrupt_get_event(&event, &wake);
+    
+    /* read the data */
+    res = adxl345_basic_read((float *)g);
+    if (res != 0)
+    {
+        return 1;
+    }
+    clock_gettime(CLOCK_MONOTONIC, &data);
+    
+    /* add the sample */
+    pthread_mutex_lock(&gs_timing_mutex);
+    timing_add(&gs_timing, &event, &wake, &handler, &data, 1);
+    pthread_mutex_unlock(&gs_timing_mutex);
+    
+    return 0;
+}
+
+/**
+ * @brief  timing watermark irq
+ * @return status code
+ *         - 0 success
+ *         - 1 run failed
+ * @note   the fifo is drained by the io pthread, the batch is added in the fifo callback
+ */
+static uint8_t a_timing_watermark_irq(void)
+{
+    struct timespec handler;
+    
+    /* stamp the handler */
+    clock_gettime(CLOCK_MONOTONIC, &handler);
+    pthread_mutex_lock(&gs_timing_mutex);
+    (void)gpio_interrupt_get_event(&gs_timing_event, &gs_timing_wake);
+    gs_timing_handler = handler;
+    gs_timing_pending = 1;
+    pthread_mutex_unlock(&gs_timing_mutex);
+    
+    return adxl345_fifo_irq_handler();
+}
+
+/**
+ * @brief     timing fifo callback
+ * @param[in] **g pointer to a converted data buffer
+ * @param[in] len is the data buffer
+ * @note      none
+ */
+static void a_timing_fifo_callback(float (*g)[3], uint16_t len)
+{
+    struct timespec data;
+    
+    (void)g;
+    
+    /* add the batch of the served edge */
+    clock_gettime(CLOCK_MONOTONIC, &data);
+    pthread_mutex_lock(&gs_timing_mutex);
+    if (gs_timing_pending != 0)
+    {
+        timing_add(&gs_timing, &gs_timing_event, &gs_timing_wake, &gs_timing_handler, &data, len);
+        gs_timing_pending = 0;
+    }
+    pthread_mutex_unlock(&gs_timing_mutex);
+}
+
+/**
+ * @brief     async test callback
+ * @param[in] *arg pointer to a batch index
+ * @note      stands for the user dsp on the completion pthread
+ */
+static void a_async_callback(void *arg)
+{
+    uint8_t i = *((uint8_t *)arg);
+    
+    adxl345_interface_delay_ms(ASYNC_TEST_CALLBACK_MS);
+    clock_gettime(CLOCK_MONOTONIC, &gs_async_callback[i]);
+}
+
+/**
+ * @brief     async test drain
+ * @param[in] *arg pointer to a batch index
+ * @note      stands for the fifo drain on the io pthread, it hands the callback off like adxl345_read_async
+ */
+static void a_async_drain(void *arg)
+{
+    uint8_t i = *((uint8_t *)arg);
+    
+    clock_gettime(CLOCK_MONOTONIC, &gs_async_drain[i]);
+    adxl345_interface_delay_ms(ASYNC_TEST_DRAIN_MS);
+    if (worker_complete(a_async_callback, arg) != 0)
+    {
+        a_async_callback(arg);
+    }
+}
+
+/**
+ * @brief     print one timing histogram
+ * @param[in] *name pointer to a histogram name
+ * @param[in] *histogram pointer to a timing histogram structure
+ * @note      none
+ */
+static void a_timing_histogram_print(const char *name, const timing_histogram_t *histogram)
+{
+    adxl345_interface_debug_print("adxl345: %s of %d: p50 <= %dus, p99 <= %dus, p99.9 <= %dus, max %dus.\n",
+                                  name, histogram->count, 
+                                  timing_percentile(histogram, 500), timing_percentile(histogram, 990),
+                                  timing_percentile(histogram, 999), histogram->max_us);
+}
+
+/**
+ * @brief print the wake to submit latency of the interrupt pthread
+ * @note  none
+ */
+static void a_latency_print(void)
+{
+    gpio_latency_t latency;
+    
+    /* get the latency */
+    if (gpio_interrupt_get_latency(&latency) != 0)
+    {
+        return;
+    }
+    
+    /* output */
+    adxl345_interface_debug_print("adxl345: wake to submit latency of %d interrupts.\n", latency.count);
+    adxl345_interface_debug_print("adxl345: min %dus, mean %dus, max %dus.\n", latency.min_us, latency.mean_us, latency.max_us);
+    adxl345_interface_debug_print("adxl345: p50 <= %dus, p99 <= %dus, p99.9 <= %dus.\n", latency.p50_us, latency.p99_us, latency.p999_us);
+}
+
 /**
  * @brief     adxl345 full function
  * @param[in] argc arg numbers
@@ -140,13 +361,30 @@ uint8_t adxl345(uint8_t argc, char **argv)
         {"interface", required_argument, NULL, 2},
         {"mask", required_argument, NULL, 3},
         {"times", required_argument, NULL, 4},
+        {"priority", required_argument, NULL, 5},
+        {"cpu", required_argument, NULL, 6},
+        {"period", required_argument, NULL, 7},
+        {"sync", required_argument, NULL, 8},
+        {"record", required_argument, NULL, 9},
+        {"mode", required_argument, NULL, 10},
+        {"seconds", required_argument, NULL, 11},
+        {"rate", required_argument, NULL, 12},
+        {"fault", required_argument, NULL, 13},
         {NULL, 0, NULL, 0},
     };
+    char *record = NULL;
+    char *fault = NULL;
     char type[33] = "unknown";
     uint32_t times = 3;
     uint32_t mask = 15;
     adxl345_address_t addr = ADXL345_ADDRESS_ALT_0;
     adxl345_interface_t interface = ADXL345_INTERFACE_IIC;
+    gpio_rt_profile_t profile = {0, -1, 0, 0, 0};
+    uint32_t period = 1000000;
+    uint8_t phase_lock = 0;
+    uint8_t watermark = 0;
+    uint32_t seconds = 10;
+    int rate = -1;
     
     /* if no params */
     if (argc == 1)
@@ -275,6 +513,130 @@ uint8_t adxl345(uint8_t argc, char **argv)
                 break;
             } 
             
+            /* rt priority */
+            case 5 :
+            {
+                /* set the priority */
+                profile.priority = atoi(optarg);
+                
+                /* lock the memory and pre-fault the stack in the rt mode */
+                if (profile.priority != 0)
+                {
+                    profile.lock_memory = 1;
+                    profile.stack_size = 256 * 1024;
+                    profile.prefault_size = 64 * 1024;
+                }
+                
+                break;
+            }
+            
+            /* cpu affinity */
+            case 6 :
+            {
+                /* set the cpu */
+                profile.cpu = atoi(optarg);
+                
+                break;
+            }
+            
+            /* sample period */
+            case 7 :
+            {
+                /* set the period */
+                period = atol(optarg);
+                
+                break;
+            }
+            
+            /* data ready sync */
+            case 8 :
+            {
+                /* set the phase lock */
+                if (strcmp("true", optarg) == 0)
+                {
+                    phase_lock = 1;
+                }
+                else if (strcmp("false", optarg) == 0)
+                {
+                    phase_lock = 0;
+                }
+                else
+                {
+                    return 5;
+                }
+                
+                break;
+            }
+            
+            /* record */
+            case 9 :
+            {
+                /* set the record file */
+                record = optarg;
+                
+                break;
+            }
+            
+            /* fault */
+            case 13 :
+            {
+                /* set the fault script */
+                fault = optarg;
+                
+                break;
+            }
+            
+            /* timing mode */
+            case 10 :
+            {
+                /* set the mode */
+                if (strcmp("ready", optarg) == 0)
+                {
+                    watermark = 0;
+                }
+                else if (strcmp("watermark", optarg) == 0)
+                {
+                    watermark = 1;
+                }
+                else
+                {
+                    return 5;
+                }
+                
+                break;
+            }
+            
+            /* running seconds */
+            case 11 :
+            {
+                /* set the seconds */
+                seconds = atol(optarg);
+                
+                break;
+            }
+            
+            /* output data rate */
+            case 12 :
+            {
+                uint32_t i;
+                
+                /* find the rate */
+                rate = -1;
+                for (i = 0; i < sizeof(gs_timing_rate) / sizeof(gs_timing_rate[0]); i++)
+                {
+                    if (strcmp(gs_timing_rate[i].name, optarg) == 0)
+                    {
+                        rate = (int)gs_timing_rate[i].rate;
+                    }
+                }
+                if (rate < 0)
+                {
+                    return 5;
+                }
+                
+                break;
+            }
+            
             /* the end */
             case -1 :
             {
@@ -288,6 +650,25 @@ uint8_t adxl345(uint8_t argc, char **argv)
             }
         }
     } while (c != -1);
+    
+    /* set the rt profile of the interrupt pthread */
+    if (gpio_interrupt_set_rt_profile(&profile) != 0)
+    {
+        return 5;
+    }
+    (void)gpio_interrupt_reset_latency();
+    
+    /* open the bus record */
+    if ((record != NULL) && (bus_record_open(record) != 0))
+    {
+        return 1;
+    }
+    
+    /* inject the scripted faults into the bus */
+    if ((fault != NULL) && (bus_fault_open(fault) != 0))
+    {
+        return 1;
+    }
 
     /* run the function */
     if (strcmp("t_reg", type) == 0)
@@ -348,6 +729,9 @@ uint8_t adxl345(uint8_t argc, char **argv)
         (void)gpio_interrupt_deinit();
         g_gpio_irq = NULL;
         
+        /* output the latency */
+        a_latency_print();
+        
         return 0;
     }
     else if (strcmp("t_int", type) == 0)
@@ -380,11 +764,250 @@ uint8_t adxl345(uint8_t argc, char **argv)
         
         return 0;
     }
+    else if (strcmp("t_shared", type) == 0)
+    {
+        uint8_t res;
+        uint32_t prefetch, sample;
+        
+        /* gpio init */
+        res = gpio_interrupt_init();
+        if (res != 0)
+        {
+            return 1;
+        }
+        
+        /* set the gpio irq */
+        g_gpio_irq = a_shared_irq;
+        
+        /* run shared bus test */
+        res = adxl345_shared_test(times);
+        if (res != 0)
+        {
+            (void)gpio_interrupt_deinit();
+            g_gpio_irq = NULL;
+            
+            return 1;
+        }
+        
+        /* gpio deinit */
+        (void)gpio_interrupt_deinit();
+        g_gpio_irq = NULL;
+        
+        /* the samples must come from the prefetch */
+        iic_scheduler_get_status(&prefetch, &sample);
+        adxl345_interface_debug_print("adxl345: iic scheduler %d prefetches, %d samples served from the cache.\n", prefetch, sample);
+        if (sample == 0)
+        {
+            return 1;
+        }
+        
+        return 0;
+    }
+    else if (strcmp("t_async", type) == 0)
+    {
+        uint32_t i;
+        uint32_t batch;
+        uint32_t overlap;
+        int64_t us;
+        
+        /* set the batches */
+        batch = times;
+        if (batch < 2)
+        {
+            batch = 2;
+        }
+        if (batch > WORKER_QUEUE_DEPTH)
+        {
+            batch = WORKER_QUEUE_DEPTH;
+        }
+        adxl345_interface_debug_print("adxl345: async test %d batches, %dms drain, %dms callback.\n",
+                                      batch, ASYNC_TEST_DRAIN_MS, ASYNC_TEST_CALLBACK_MS);
+        
+        /* submit the drains */
+        for (i = 0; i < batch; i++)
+        {
+            gs_async_index[i] = (uint8_t)i;
+            if (worker_submit(a_async_drain, &gs_async_index[i]) != 0)
+            {
+                (void)worker_deinit();
+                adxl345_interface_debug_print("adxl345: async submit failed.\n");
+                
+                return 1;
+            }
+        }
+        
+        /* wait for the drains and the callbacks */
+        if (worker_deinit() != 0)
+        {
+            return 1;
+        }
+        
+        /* drain n + 1 must start before callback n finishes */
+        overlap = 0;
+        for (i = 0; i < batch - 1; i++)
+        {
+            us = ((int64_t)(gs_async_callback[i].tv_sec - gs_async_drain[i + 1].tv_sec) * 1000000000LL +
+                  (int64_t)(gs_async_callback[i].tv_nsec - gs_async_drain[i + 1].tv_nsec)) / 1000;
+            adxl345_interface_debug_print("adxl345: drain %d started %dus before callback %d finished.\n",
+                                          i + 1, (int32_t)us, i);
+            if (us > 0)
+            {
+                overlap++;
+            }
+        }
+        if (overlap != batch - 1)
+        {
+            adxl345_interface_debug_print("adxl345: async test failed, %d of %d drains overlapped.\n", overlap, batch - 1);
+            
+            return 1;
+        }
+        adxl345_interface_debug_print("adxl345: finish async test.\n");
+        
+        return 0;
+    }
+    else if (strcmp("t_timing", type) == 0)
+    {
+        uint8_t res;
+        uint32_t i;
+        float g[3];
+        uint64_t period;
+        
+        /* use the default rate of the example */
+        if (rate < 0)
+        {
+            rate = (watermark != 0) ? (int)ADXL345_FIFO_DEFAULT_RATE : (int)ADXL345_BASIC_DEFAULT_RATE;
+        }
+        
+        /* the period of the rate code is 3200Hz halved per step */
+        period = 312500ULL << (ADXL345_RATE_3200 - rate);
+        if (timing_init(&gs_timing, period, (watermark != 0) ? 32 : 1) != 0)
+        {
+            return 1;
+        }
+        gs_timing_pending = 0;
+        adxl345_interface_debug_print("adxl345: timing %s mode, %0.2fHz, %d seconds.\n",
+                                      (watermark != 0) ? "watermark" : "data ready", 1000000000.0 / period, seconds);
+        
+        if (watermark != 0)
+        {
+            /* gpio init */
+            g_gpio_irq = a_timing_watermark_irq;
+            res = gpio_interrupt_init();
+            if (res != 0)
+            {
+                g_gpio_irq = NULL;
+                
+                return 1;
+            }
+            
+            /* fifo init */
+            res = adxl345_fifo_init(interface, addr, a_timing_fifo_callback);
+            if (res != 0)
+            {
+                (void)gpio_interrupt_deinit();
+                g_gpio_irq = NULL;
+                
+                return 1;
+            }
+            
+            /* set the rate */
+            mutex_lock();
+            res = adxl345_fifo_set_rate((adxl345_rate_t)rate);
+            mutex_unlock();
+            if (res != 0)
+            {
+                (void)gpio_interrupt_deinit();
+                (void)adxl345_fifo_deinit();
+                g_gpio_irq = NULL;
+                
+                return 1;
+            }
+        }
+        else
+        {
+            /* basic init */
+            res = adxl345_basic_init(interface, addr);
+            if (res != 0)
+            {
+                return 1;
+            }
+            res = adxl345_basic_set_rate((adxl345_rate_t)rate);
+            if (res != 0)
+            {
+                (void)adxl345_basic_deinit();
+                
+                return 1;
+            }
+            
+            /* gpio init */
+            g_gpio_irq = a_timing_ready_irq;
+            res = gpio_interrupt_init();
+            if (res != 0)
+            {
+                (void)adxl345_basic_deinit();
+                g_gpio_irq = NULL;
+                
+                return 1;
+            }
+            
+            /* enable the data ready edges and release the interrupt pin */
+            mutex_lock();
+            res = adxl345_basic_set_data_ready(ADXL345_BOOL_TRUE);
+            if (res == 0)
+            {
+                res = adxl345_basic_read((float *)g);
+            }
+            mutex_unlock();
+            if (res != 0)
+            {
+                (void)gpio_interrupt_deinit();
+                (void)adxl345_basic_deinit();
+                g_gpio_irq = NULL;
+                
+                return 1;
+            }
+        }
+        
+        /* run */
+        for (i = 0; i < seconds; i++)
+        {
+            adxl345_interface_delay_ms(1000);
+        }
+        
+        /* stop */
+        (void)gpio_interrupt_deinit();
+        g_gpio_irq = NULL;
+        if (watermark != 0)
+        {
+            (void)adxl345_fifo_deinit();
+        }
+        else
+        {
+            (void)adxl345_basic_set_data_ready(ADXL345_BOOL_FALSE);
+            (void)adxl345_basic_deinit();
+        }
+        
+        /* output */
+        pthread_mutex_lock(&gs_timing_mutex);
+        adxl345_interface_debug_print("adxl345: %d batches, %lld samples, %lld missed samples.\n",
+                                      gs_timing.batches, (long long)gs_timing.samples, (long long)gs_timing.missed);
+        if (gs_timing.unstamped != 0)
+        {
+            adxl345_interface_debug_print("adxl345: %d edges without a monotonic kernel time use the wake up time.\n", gs_timing.unstamped);
+        }
+        a_timing_histogram_print("interrupt to handler latency", &gs_timing.irq);
+        a_timing_histogram_print("handler to data latency", &gs_timing.handler);
+        a_timing_histogram_print("inter-batch jitter", &gs_timing.jitter);
+        pthread_mutex_unlock(&gs_timing_mutex);
+        
+        return 0;
+    }
     else if (strcmp("e_basic", type) == 0)
     {
         uint8_t res;
         uint32_t i;
         float g[3];
+        sampler_t sampler;
         
         /* basic init */
         res = adxl345_basic_init(interface, addr);
@@ -393,13 +1016,71 @@ uint8_t adxl345(uint8_t argc, char **argv)
             return 1;
         }
         
+        /* stamp the data ready edges */
+        if (phase_lock != 0)
+        {
+            g_gpio_irq = a_data_ready_irq;
+            res = gpio_interrupt_init();
+            if (res != 0)
+            {
+                (void)adxl345_basic_deinit();
+                g_gpio_irq = NULL;
+                
+                return 1;
+            }
+            res = adxl345_basic_set_data_ready(ADXL345_BOOL_TRUE);
+            if (res != 0)
+            {
+                (void)gpio_interrupt_deinit();
+                (void)adxl345_basic_deinit();
+                g_gpio_irq = NULL;
+                
+                return 1;
+            }
+            
+            /* release the interrupt pin */
+            (void)adxl345_basic_read((float *)g);
+        }
+        
+        /* start the deadlines, read 100us after the edge */
+        res = sampler_init(&sampler, period, phase_lock, 100);
+        if (res != 0)
+        {
+            adxl345_interface_debug_print("adxl345: period is invalid.\n");
+            if (phase_lock != 0)
+            {
+                (void)adxl345_basic_set_data_ready(ADXL345_BOOL_FALSE);
+                (void)gpio_interrupt_deinit();
+                g_gpio_irq = NULL;
+            }
+            (void)adxl345_basic_deinit();
+            
+            return 1;
+        }
+        
         /* loop */
         for (i = 0; i < times; i++)
         {
-            /* read data */
-            res = adxl345_basic_read((float *)g);
+            /* wait for the deadline */
+            res = sampler_wait(&sampler);
+            if (res == 2)
+            {
+                /* no new sample in this period, it is counted as missed */
+                continue;
+            }
+            if (res == 0)
+            {
+                /* read data */
+                res = adxl345_basic_read((float *)g);
+            }
             if (res != 0)
             {
+                if (phase_lock != 0)
+                {
+                    (void)adxl345_basic_set_data_ready(ADXL345_BOOL_FALSE);
+                    (void)gpio_interrupt_deinit();
+                    g_gpio_irq = NULL;
+                }
                 (void)adxl345_basic_deinit();
                 
                 return 1;
@@ -409,9 +1090,17 @@ uint8_t adxl345(uint8_t argc, char **argv)
             adxl345_interface_debug_print("adxl345: x is %0.3f.\n", g[0]);
             adxl345_interface_debug_print("adxl345: y is %0.3f.\n", g[1]);
             adxl345_interface_debug_print("adxl345: z is %0.3f.\n", g[2]);
-            
-            /* delay 1000ms */
-            adxl345_interface_delay_ms(1000);
+        }
+        
+        /* output the missed samples */
+        adxl345_interface_debug_print("adxl345: missed %d deadlines.\n", sampler.missed);
+        
+        /* stop the data ready edges */
+        if (phase_lock != 0)
+        {
+            (void)adxl345_basic_set_data_ready(ADXL345_BOOL_FALSE);
+            (void)gpio_interrupt_deinit();
+            g_gpio_irq = NULL;
         }
         
         /* basic deinit */
@@ -484,6 +1173,9 @@ uint8_t adxl345(uint8_t argc, char **argv)
         (void)adxl345_fifo_deinit();
         g_gpio_irq = NULL;
         
+        /* output the latency */
+        a_latency_print();
+        
         return 0;
     }
     else if (strcmp("e_int", type) == 0)
@@ -550,26 +1242,40 @@ uint8_t adxl345(uint8_t argc, char **argv)
         adxl345_interface_debug_print("  adxl345 (-i | --information)\n");
         adxl345_interface_debug_print("  adxl345 (-h | --help)\n");
         adxl345_interface_debug_print("  adxl345 (-p | --port)\n");
-        adxl345_interface_debug_print("  adxl345 (-t reg | --test=reg) [--addr=<0 | 1>] [--interface=<iic | spi>]\n");
-        adxl345_interface_debug_print("  adxl345 (-t read | --test=read) [--addr=<0 | 1>] [--interface=<iic | spi>] [--times=<num>]\n");
-        adxl345_interface_debug_print("  adxl345 (-t fifo | --test=fifo) [--addr=<0 | 1>] [--interface=<iic | spi>]\n");
-        adxl345_interface_debug_print("  adxl345 (-t int | --test=int) [--addr=<0 | 1>] [--interface=<iic | spi>]\n");
-        adxl345_interface_debug_print("  adxl345 (-e basic | --example=basic) [--addr=<0 | 1>] [--interface=<iic | spi>] [--times=<num>]\n");
-        adxl345_interface_debug_print("  adxl345 (-e fifo | --example=fifo) [--addr=<0 | 1>] [--interface=<iic | spi>] [--times=<num>]\n");
-        adxl345_interface_debug_print("  adxl345 (-e int | --example=int) [--addr=<0 | 1>] [--interface=<iic | spi>] [--mask=<msk>]\n");
+        adxl345_interface_debug_print("  adxl345 (-t reg | --test=reg) [--addr=<0 | 1>] [--interface=<iic | spi>] [--record=<path>] [--fault=<path>]\n");
+        adxl345_interface_debug_print("  adxl345 (-t read | --test=read) [--addr=<0 | 1>] [--interface=<iic | spi>] [--times=<num>] [--record=<path>] [--fault=<path>]\n");
+        adxl345_interface_debug_print("  adxl345 (-t fifo | --test=fifo) [--addr=<0 | 1>] [--interface=<iic | spi>] [--priority=<num>] [--cpu=<num>] [--record=<path>] [--fault=<path>]\n");
+        adxl345_interface_debug_print("  adxl345 (-t int | --test=int) [--addr=<0 | 1>] [--interface=<iic | spi>] [--record=<path>] [--fault=<path>]\n");
+        adxl345_interface_debug_print("  adxl345 (-t shared | --test=shared) [--times=<num>]\n");
+        adxl345_interface_debug_print("  adxl345 (-t async | --test=async) [--times=<num>]\n");
+        adxl345_interface_debug_print("  adxl345 (-t timing | --test=timing) [--addr=<0 | 1>] [--interface=<iic | spi>] [--mode=<ready | watermark>] [--rate=<hz>] [--seconds=<num>] [--priority=<num>] [--cpu=<num>] [--fault=<path>]\n");
+        adxl345_interface_debug_print("  adxl345 (-e basic | --example=basic) [--addr=<0 | 1>] [--interface=<iic | spi>] [--times=<num>] [--period=<us>] [--sync=<true | false>] [--record=<path>] [--fault=<path>]\n");
+        adxl345_interface_debug_print("  adxl345 (-e fifo | --example=fifo) [--addr=<0 | 1>] [--interface=<iic | spi>] [--times=<num>] [--priority=<num>] [--cpu=<num>] [--record=<path>] [--fault=<path>]\n");
+        adxl345_interface_debug_print("  adxl345 (-e int | --example=int) [--addr=<0 | 1>] [--interface=<iic | spi>] [--mask=<msk>] [--record=<path>] [--fault=<path>]\n");
         adxl345_interface_debug_print("\n");
         adxl345_interface_debug_print("Options:\n");
         adxl345_interface_debug_print("      --addr=<0 | 1>                 Set the chip address.([default: 0])\n");
+        adxl345_interface_debug_print("      --cpu=<num>                    Pin the interrupt pthread to the cpu core.([default: -1])\n");
         adxl345_interface_debug_print("  -e <basic | fifo | int>, --example=<basic | fifo | int>\n");
         adxl345_interface_debug_print("                                     Run the driver example.\n");
+        adxl345_interface_debug_print("      --fault=<path>                 Inject the faults of the script into the bus.\n");
         adxl345_interface_debug_print("  -h, --help                         Show the help.\n");
         adxl345_interface_debug_print("  -i, --information                  Show the chip information.\n");
         adxl345_interface_debug_print("      --interface=<iic | spi>        Set the chip interface.([default: iic])\n");
         adxl345_interface_debug_print("      --mask=<msk>                   Set the interrupt mask, bit 0 is the tap enable mask,\n");
         adxl345_interface_debug_print("                                     bit 1 is the action enable mask, bit 2 is the inaction enable mask,\n");
         adxl345_interface_debug_print("                                     bit 3 is the free fall enable mask.([default: 15])\n");
+        adxl345_interface_debug_print("      --mode=<ready | watermark>     Set the interrupt of the timing test, the data ready or the fifo watermark.([default: ready])\n");
+        adxl345_interface_debug_print("      --period=<us>                  Set the read period of the basic example in us.([default: 1000000])\n");
         adxl345_interface_debug_print("  -p, --port                         Display the pin connections of the current board.\n");
-        adxl345_interface_debug_print("  -t <reg | read | fifo | int>, --test=<reg | read | fifo | int>\n");
+        adxl345_interface_debug_print("      --priority=<num>               Set the SCHED_FIFO priority of the interrupt pthread, 0 means SCHED_OTHER,\n");
+        adxl345_interface_debug_print("                                     a non-zero priority also locks the memory and pre-faults the stack.([default: 0])\n");
+        adxl345_interface_debug_print("      --rate=<hz>                    Set the output data rate of the timing test, 6.25, 12.5, 25, 50, 100, 200, 400, 800, 1600 or 3200,\n");
+        adxl345_interface_debug_print("                                     the default is the rate of the basic or fifo example.\n");
+        adxl345_interface_debug_print("      --record=<path>                Record the bus traffic of the command to the file.\n");
+        adxl345_interface_debug_print("      --seconds=<num>                Set the running seconds of the timing test.([default: 10])\n");
+        adxl345_interface_debug_print("      --sync=<true | false>          Lock the reads to the data ready edge of the interrupt pin.([default: false])\n");
+        adxl345_interface_debug_print("  -t <reg | read | fifo | int | shared | async | timing>, --test=<reg | read | fifo | int | shared | async | timing>\n");
         adxl345_interface_debug_print("                                     Run the driver test.\n");
         adxl345_interface_debug_print("      --times=<num>                  Set the running times.([default: 3])\n");
 
@@ -625,6 +1331,22 @@ int main(uint8_t argc, char **argv)
     uint8_t res;
 
     res = adxl345(argc, argv);
+    (void)bus_record_close();
+    if (bus_fault_is_open() != 0)
+    {
+        uint32_t transfer, fail, truncate, stuck, delay;
+        bus_fault_recovery_t recovery;
+        
+        bus_fault_get_status(&transfer, &fail, &truncate, &stuck, &delay);
+        adxl345_interface_debug_print("adxl345: fault %d transactions, %d dropped, %d truncated, %d stuck, %dus latency.\n", 
+                                      transfer, fail, truncate, stuck, delay);
+        bus_fault_get_recovery(&recovery);
+        adxl345_interface_debug_print("adxl345: fault recovered %d times, mean %dus, max %dus to the next clean transaction.\n",
+                                      recovery.count, recovery.mean_us, recovery.max_us);
+        adxl345_interface_debug_print("adxl345: fault %d samples/s before the first fault, %d samples/s after the first recovery.\n",
+                                      recovery.before_sps, recovery.after_sps);
+        (void)bus_fault_close();
+    }
     if (res == 0)
     {
         /* run success */
@@ -0,0 +1,505 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      simulator_driver_adxl345_interface.c
+ * @brief     simulator driver interface source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_adxl345_interface.h"
+#include "adxl345_model.h"
+#include "bus_fault.h"
+#include "bus_record.h"
+#include "gpio.h"
+#include "iic_scheduler.h"
+#include <stdarg.h>
+#include <time.h>
+
+/**
+ * @brief chip register definition
+ */
+#define ADXL345_REG_INT_SOURCE        0x30        /**< interrupt source register */
+
+/**
+ * @brief simulated chip definition
+ */
+adxl345_model_t g_adxl345_model[2];       /**< chips with the addr pin connected to GND and VCC */
+static uint8_t gs_model_inited;           /**< chip init flag */
+static uint8_t gs_edge_hold;              /**< hold the edges inside a bus transaction */
+static uint8_t gs_edge_fall;              /**< held falling edge flag */
+static int8_t gs_edge_level = -1;         /**< held level, -1 means none */
+
+/**
+ * @brief     chip interrupt pin edge
+ * @param[in] pin 0 for int1 and 1 for int2
+ * @param[in] level electrical level after the edge
+ * @note      int1 of every chip drives the gpio interrupt line
+ */
+static void a_adxl345_interface_edge(uint8_t pin, uint8_t level)
+{
+    if (pin == 0)
+    {
+        if (gs_edge_hold != 0)
+        {
+            /* the irq can't run inside a bus transaction */
+            gs_edge_fall |= (level == 0) ? 1 : 0;
+            gs_edge_level = (int8_t)level;
+        }
+        else
+        {
+            gpio_interrupt_set_level(level);
+        }
+    }
+}
+
+/**
+ * @brief release the edges held inside a bus transaction
+ * @note  a held falling edge is delivered as a pulse
+ */
+static void a_adxl345_interface_edge_release(void)
+{
+    int8_t level = gs_edge_level;
+    
+    if (level >= 0)
+    {
+        gs_edge_level = -1;
+        if (gs_edge_fall != 0)
+        {
+            gs_edge_fall = 0;
+            gpio_interrupt_set_level(1);
+            gpio_interrupt_set_level(0);
+        }
+        gpio_interrupt_set_level((uint8_t)level);
+    }
+}
+
+/**
+ * @brief     bus fault latency
+ * @param[in] us time
+ * @note      the virtual clock of the chips advances inside the transaction,
+ *            the edges are held until the next delay
+ */
+static void a_adxl345_interface_fault_delay_us(uint32_t us)
+{
+    gs_edge_hold = 1;
+    adxl345_model_advance(&g_adxl345_model[0], (uint64_t)us * 1000ULL);
+    adxl345_model_advance(&g_adxl345_model[1], (uint64_t)us * 1000ULL);
+    gs_edge_hold = 0;
+}
+
+/**
+ * @brief  bus fault clock
+ * @return virtual time in us
+ * @note   the recovery of the bus fault is measured on the virtual clock its latency advances
+ */
+static uint32_t a_adxl345_interface_fault_clock_us(void)
+{
+    return (uint32_t)(g_adxl345_model[0].time_ns / 1000ULL);
+}
+
+/**
+ * @brief      simulated spi bus read
+ * @param[in]  addr unused address
+ * @param[in]  reg register address
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       none
+ */
+static uint8_t a_adxl345_interface_spi_read(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    (void)addr;
+    
+    return adxl345_model_spi_read(&g_adxl345_model[0], reg, buf, len);
+}
+
+/**
+ * @brief     simulated spi bus write
+ * @param[in] addr unused address
+ * @param[in] reg register address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      none
+ */
+static uint8_t a_adxl345_interface_spi_write(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    (void)addr;
+    
+    return adxl345_model_spi_write(&g_adxl345_model[0], reg, buf, len);
+}
+
+/**
+ * @brief power on the simulated chips
+ * @note  the chips keep their registers over the bus init and deinit like the real ones
+ */
+static void a_adxl345_interface_power_on(void)
+{
+    if (gs_model_inited == 0)
+    {
+        adxl345_model_init(&g_adxl345_model[0], ADXL345_ADDRESS_ALT_0);
+        adxl345_model_init(&g_adxl345_model[1], ADXL345_ADDRESS_ALT_1);
+        adxl345_model_set_edge_callback(&g_adxl345_model[0], a_adxl345_interface_edge);
+        adxl345_model_set_edge_callback(&g_adxl345_model[1], a_adxl345_interface_edge);
+        bus_fault_set_delay(a_adxl345_interface_fault_delay_us);
+        bus_fault_set_clock(a_adxl345_interface_fault_clock_us);
+        gs_model_inited = 1;
+    }
+}
+
+/**
+ * @brief  interface iic bus init
+ * @return status code
+ *         - 0 success
+ *         - 1 iic init failed
+ * @note   none
+ */
+uint8_t adxl345_interface_iic_init(void)
+{
+    a_adxl345_interface_power_on();
+    
+    return iic_scheduler_init(NULL);
+}
+
+/**
+ * @brief  interface iic bus deinit
+ * @return status code
+ *         - 0 success
+ *         - 1 iic deinit failed
+ * @note   none
+ */
+uint8_t adxl345_interface_iic_deinit(void)
+{
+    return iic_scheduler_deinit();
+}
+
+/**
+ * @brief      interface iic bus read
+ * @param[in]  addr iic device write address
+ * @param[in]  reg iic register address
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of the data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       a missing chip nacks
+ */
+uint8_t adxl345_interface_iic_read(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    uint8_t res;
+    
+    if (bus_replay_is_open() != 0)
+    {
+        return bus_replay_transfer(0, addr, reg, buf, len);
+    }
+    res = bus_fault_transfer(0, addr, reg, buf, len, iic_scheduler_read);
+    bus_record_log(0, addr, reg, buf, len, res);
+    
+    return res;
+}
+
+/**
+ * @brief     interface iic bus write
+ * @param[in] addr iic device write address
+ * @param[in] reg iic register address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      a missing chip nacks
+ */
+uint8_t adxl345_interface_iic_write(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    uint8_t res;
+    
+    if (bus_replay_is_open() != 0)
+    {
+        return bus_replay_transfer(BUS_RECORD_TYPE_WRITE, addr, reg, buf, len);
+    }
+    res = bus_fault_transfer(BUS_FAULT_TYPE_WRITE, addr, reg, buf, len, iic_scheduler_write);
+    bus_record_log(BUS_RECORD_TYPE_WRITE, addr, reg, buf, len, res);
+    
+    return res;
+}
+
+/**
+ * @brief  interface spi bus init
+ * @return status code
+ *         - 0 success
+ *         - 1 spi init failed
+ * @note   none
+ */
+uint8_t adxl345_interface_spi_init(void)
+{
+    a_adxl345_interface_power_on();
+    
+    return 0;
+}
+
+/**
+ * @brief  interface spi bus deinit
+ * @return status code
+ *         - 0 success
+ *         - 1 spi deinit failed
+ * @note   none
+ */
+uint8_t adxl345_interface_spi_deinit(void)
+{   
+    return 0;
+}
+
+/**
+ * @brief      interface spi bus read
+ * @param[in]  reg register address
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       the chip with the addr pin connected to GND is on the spi bus
+ */
+uint8_t adxl345_interface_spi_read(uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    uint8_t res;
+    
+    if (bus_replay_is_open() != 0)
+    {
+        return bus_replay_transfer(BUS_RECORD_TYPE_SPI, 0, reg, buf, len);
+    }
+    res = bus_fault_transfer(0, 0, reg, buf, len, a_adxl345_interface_spi_read);
+    bus_record_log(BUS_RECORD_TYPE_SPI, 0, reg, buf, len, res);
+    
+    return res;
+}
+
+/**
+ * @brief     interface spi bus write
+ * @param[in] reg register address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      the chip with the addr pin connected to GND is on the spi bus
+ */
+uint8_t adxl345_interface_spi_write(uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    uint8_t res;
+    
+    if (bus_replay_is_open() != 0)
+    {
+        return bus_replay_transfer(BUS_RECORD_TYPE_SPI | BUS_RECORD_TYPE_WRITE, 0, reg, buf, len);
+    }
+    res = bus_fault_transfer(BUS_FAULT_TYPE_WRITE, 0, reg, buf, len, a_adxl345_interface_spi_write);
+    bus_record_log(BUS_RECORD_TYPE_SPI | BUS_RECORD_TYPE_WRITE, 0, reg, buf, len, res);
+    
+    return res;
+}
+
+/**
+ * @brief     interface delay ms
+ * @param[in] ms time
+ * @note      the virtual clock of the chips advances, no real time passes,
+ *            during a replay the interrupt line is pulsed where the record read the interrupt source
+ */
+void adxl345_interface_delay_ms(uint32_t ms)
+{
+    uint8_t type, addr, reg;
+    uint32_t pos, prev, total, mismatch;
+    
+    if (bus_replay_is_open() != 0)
+    {
+        /* the recorded session read the interrupt source in the irq, so pulse the line */
+        while (bus_replay_peek(&type, &addr, &reg) == 0)
+        {
+            if ((type & BUS_RECORD_TYPE_DELAY) != 0)
+            {
+                /* the recorded delay ends here */
+                (void)bus_replay_transfer(BUS_RECORD_TYPE_DELAY, 0, 0, NULL, 0);
+                
+                break;
+            }
+            if (((type & BUS_RECORD_TYPE_WRITE) != 0) || ((reg & 0x3F) != ADXL345_REG_INT_SOURCE))
+            {
+                break;
+            }
+            bus_replay_get_status(&prev, &total, &mismatch);
+            gpio_interrupt_set_level(1);
+            gpio_interrupt_set_level(0);
+            bus_replay_get_status(&pos, &total, &mismatch);
+            if (pos == prev)
+            {
+                break;
+            }
+        }
+        
+        return;
+    }
+    a_adxl345_interface_edge_release();
+    adxl345_model_advance(&g_adxl345_model[0], (uint64_t)ms * 1000000ULL);
+    adxl345_model_advance(&g_adxl345_model[1], (uint64_t)ms * 1000000ULL);
+    bus_record_log(BUS_RECORD_TYPE_DELAY, 0, 0, NULL, 0, 0);
+}
+
+/**
+ * @brief     interface print format data
+ * @param[in] fmt format data
+ * @note      none
+ */
+void adxl345_interface_debug_print(const char *const fmt, ...)
+{
+    char str[256];
+    va_list args;
+    
+    memset((char *)str, 0, sizeof(char) * 256); 
+    va_start(args, fmt);
+    vsnprintf((char *)str, 255, (char const *)fmt, args);
+    va_end(args);
+    
+    (void)printf((uint8_t *)str);
+}
+
+/**
+ * @brief     interface async submit
+ * @param[in] *work pointer to a work function address
+ * @param[in] *arg pointer to a work argument
+ * @return    status code
+ *            - 0 success
+ *            - 1 submit failed
+ * @note      the work runs at once
+ */
+uint8_t adxl345_interface_async_submit(void (*work)(void *arg), void *arg)
+{
+    work(arg);
+    
+    return 0;
+}
+
+/**
+ * @brief     interface async complete
+ * @param[in] *done pointer to a completion function address
+ * @param[in] *arg pointer to a completion argument
+ * @return    status code
+ *            - 0 success
+ *            - 1 submit failed
+ * @note      the completion runs at once
+ */
+uint8_t adxl345_interface_async_complete(void (*done)(void *arg), void *arg)
+{
+    done(arg);
+    
+    return 0;
+}
+
+/**
+ * @brief  interface clock us
+ * @return free running time in us
+ * @note   the real monotonic clock is used, the bus calls don't advance the virtual clock
+ */
+uint32_t adxl345_interface_clock_us(void)
+{
+    struct timespec ts;
+    
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    
+    return (uint32_t)((uint64_t)ts.tv_sec * 1000000ULL + (uint64_t)ts.tv_nsec / 1000);
+}
+
+/**
+ * @brief     interface receive callback
+ * @param[in] type irq type
+ * @note      none
+ */
+void adxl345_interface_receive_callback(uint8_t type)
+{
+    switch (type)
+    {
+        case ADXL345_INTERRUPT_DATA_READY :
+        {
+            adxl345_interface_debug_print("adxl345: irq data ready.\n");
+            
+            break;
+        }
+        case ADXL345_INTERRUPT_SINGLE_TAP :
+        {
+            adxl345_interface_debug_print("adxl345: irq single tap.\n");
+            
+            break;
+        }
+        case ADXL345_INTERRUPT_DOUBLE_TAP :
+        {
+            adxl345_interface_debug_print("adxl345: irq double tap.\n");
+            
+            break;
+        }
+        case ADXL345_INTERRUPT_ACTIVITY :
+        {
+            adxl345_interface_debug_print("adxl345: irq activity.\n");
+            
+            break;
+        }
+        case ADXL345_INTERRUPT_INACTIVITY :
+        {
+            adxl345_interface_debug_print("adxl345: irq inactivity.\n");
+            
+            break;
+        }
+        case ADXL345_INTERRUPT_FREE_FALL :
+        {
+            adxl345_interface_debug_print("adxl345: irq free fall.\n");
+            
+            break;
+        }
+        case ADXL345_INTERRUPT_WATERMARK :
+        {
+            adxl345_interface_debug_print("adxl345: irq water mark.\n");
+            
+            break;
+        }
+        case ADXL345_INTERRUPT_OVERRUN :
+        {
+            adxl345_interface_debug_print("adxl345: irq overrun.\n");
+            
+            break;
+        }
+        default :
+        {
+            adxl345_interface_debug_print("adxl345: unknown code.\n");
+            
+            break;
+        }
+    }
+}
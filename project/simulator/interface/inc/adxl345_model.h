@@ -0,0 +1,226 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      adxl345_model.h
+ * @brief     adxl345 device model header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef ADXL345_MODEL_H
+#define ADXL345_MODEL_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup adxl345_model adxl345 model function
+ * @brief    adxl345 device model modules
+ * @{
+ */
+
+/**
+ * @brief adxl345 model definition
+ */
+#define ADXL345_MODEL_FIFO_DEPTH        32             /**< fifo entries */
+#define ADXL345_MODEL_TICK_NS           1000000        /**< tap, activity and free fall detection tick */
+
+/**
+ * @brief adxl345 model structure definition
+ */
+typedef struct adxl345_model_s
+{
+    uint8_t iic_addr;                                           /**< iic device write address */
+    uint8_t reg[64];                                            /**< register file */
+    uint8_t data[6];                                            /**< latest sample */
+    uint8_t fifo[ADXL345_MODEL_FIFO_DEPTH][6];                  /**< fifo entries */
+    uint8_t fifo_head;                                          /**< oldest fifo entry */
+    uint8_t fifo_count;                                         /**< fifo entry count */
+    uint8_t data_ready;                                         /**< unread sample flag in the bypass mode */
+    uint8_t overrun;                                            /**< overrun flag */
+    uint8_t triggered;                                          /**< trigger event flag in the trigger mode */
+    uint8_t events;                                             /**< latched tap, activity and free fall events */
+    uint64_t time_ns;                                           /**< virtual clock */
+    uint64_t next_sample_ns;                                    /**< next output data time */
+    uint64_t next_tick_ns;                                      /**< next detection tick */
+    uint8_t tap_above;                                          /**< tap threshold exceeded flag */
+    uint8_t tap_axis;                                           /**< tap axis of the current pulse */
+    uint8_t tap_wait;                                           /**< waiting for the second tap flag */
+    uint64_t tap_start_ns;                                      /**< current pulse start time */
+    uint64_t tap_end_ns;                                        /**< first tap end time */
+    float act_ref[3];                                           /**< ac coupled activity reference */
+    float inact_ref[3];                                         /**< ac coupled inactivity reference */
+    uint8_t inact_fired;                                        /**< inactivity reported flag */
+    uint64_t inact_start_ns;                                    /**< inactivity start time */
+    uint8_t ff_fired;                                           /**< free fall reported flag */
+    uint64_t ff_start_ns;                                       /**< free fall start time */
+    uint8_t ff_below;                                           /**< free fall threshold flag */
+    uint8_t pin_level[2];                                       /**< reported int1 and int2 level */
+    uint32_t seed;                                              /**< noise seed */
+    uint32_t protocol_error;                                    /**< bad address or spi flag count */
+    uint8_t busy;                                               /**< advancing flag */
+    uint64_t bus_transfer;                                      /**< bus transaction count */
+    uint64_t bus_byte;                                          /**< bytes on the wire */
+    uint64_t bus_ns;                                            /**< accumulated bus time */
+    uint32_t bus_latency_ns;                                    /**< fixed cost of one bus transaction */
+    uint32_t bus_byte_ns;                                       /**< time of one byte on the wire */
+    void (*motion)(uint64_t time_ns, float g[3]);               /**< point to a motion function address */
+    void (*edge)(uint8_t pin, uint8_t level);                   /**< point to an interrupt pin edge function address */
+} adxl345_model_t;
+
+/**
+ * @brief     model init
+ * @param[in] *model pointer to an adxl345 model structure
+ * @param[in] iic_addr iic device write address
+ * @note      all the registers are set to the reset values and the virtual clock starts at 0,
+ *            the motion is set to adxl345_model_default_motion
+ */
+void adxl345_model_init(adxl345_model_t *model, uint8_t iic_addr);
+
+/**
+ * @brief     set the motion
+ * @param[in] *model pointer to an adxl345 model structure
+ * @param[in] *motion pointer to a motion function address
+ * @note      the motion function returns the acceleration in g at the virtual time
+ */
+void adxl345_model_set_motion(adxl345_model_t *model, void (*motion)(uint64_t time_ns, float g[3]));
+
+/**
+ * @brief     set the interrupt pin edge callback
+ * @param[in] *model pointer to an adxl345 model structure
+ * @param[in] *edge pointer to an edge function address
+ * @note      pin is 0 for int1 and 1 for int2, level is the electrical level after the edge,
+ *            the callback runs from adxl345_model_advance only
+ */
+void adxl345_model_set_edge_callback(adxl345_model_t *model, void (*edge)(uint8_t pin, uint8_t level));
+
+/**
+ * @brief     set the bus timing
+ * @param[in] *model pointer to an adxl345 model structure
+ * @param[in] latency_ns fixed cost of one bus transaction
+ * @param[in] byte_ns time of one byte on the wire
+ * @note      the bus time is only accounted in bus_ns, the virtual clock doesn't advance
+ *            so that no interrupt edge is raised in the middle of a driver call
+ */
+void adxl345_model_set_bus_timing(adxl345_model_t *model, uint32_t latency_ns, uint32_t byte_ns);
+
+/**
+ * @brief     clear the bus counters
+ * @param[in] *model pointer to an adxl345 model structure
+ * @note      bus_transfer, bus_byte and bus_ns are cleared
+ */
+void adxl345_model_clear_bus(adxl345_model_t *model);
+
+/**
+ * @brief      default motion
+ * @param[in]  time_ns virtual time
+ * @param[out] *g pointer to an acceleration buffer
+ * @note       a 10s cycle at rest tilted on the y axis with a single tap at 1s,
+ *             a double tap at 2s, shaking from 3s to 4s and a free fall at 9s
+ */
+void adxl345_model_default_motion(uint64_t time_ns, float g[3]);
+
+/**
+ * @brief     advance the virtual clock
+ * @param[in] *model pointer to an adxl345 model structure
+ * @param[in] ns advanced time
+ * @note      the samples and the detection ticks are run in time order,
+ *            the pin edges are reported at the time they happen
+ */
+void adxl345_model_advance(adxl345_model_t *model, uint64_t ns);
+
+/**
+ * @brief      model iic read
+ * @param[in]  *model pointer to an adxl345 model structure
+ * @param[in]  addr iic device write address
+ * @param[in]  reg register address
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of the data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       the address auto increments
+ */
+uint8_t adxl345_model_iic_read(adxl345_model_t *model, uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len);
+
+/**
+ * @brief     model iic write
+ * @param[in] *model pointer to an adxl345 model structure
+ * @param[in] addr iic device write address
+ * @param[in] reg register address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      the address auto increments
+ */
+uint8_t adxl345_model_iic_write(adxl345_model_t *model, uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len);
+
+/**
+ * @brief      model spi read
+ * @param[in]  *model pointer to an adxl345 model structure
+ * @param[in]  reg command byte
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of the data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       bit 7 of the command must be set, bit 6 enables the address auto increment
+ */
+uint8_t adxl345_model_spi_read(adxl345_model_t *model, uint8_t reg, uint8_t *buf, uint16_t len);
+
+/**
+ * @brief     model spi write
+ * @param[in] *model pointer to an adxl345 model structure
+ * @param[in] reg command byte
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      bit 7 of the command must be cleared, bit 6 enables the address auto increment
+ */
+uint8_t adxl345_model_spi_write(adxl345_model_t *model, uint8_t reg, uint8_t *buf, uint16_t len);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
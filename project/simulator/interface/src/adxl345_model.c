@@ -0,0 +1,997 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      adxl345_model.c
+ * @brief     adxl345 device model source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "adxl345_model.h"
+#include <math.h>
+
+/**
+ * @brief chip register definition
+ */
+#define ADXL345_MODEL_REG_DEVID             0x00        /**< device id register */
+#define ADXL345_MODEL_REG_THRESH_TAP        0x1D        /**< tap threshold register */
+#define ADXL345_MODEL_REG_OFSX              0x1E        /**< x axis offset register */
+#define ADXL345_MODEL_REG_DUR               0x21        /**< tap duration register */
+#define ADXL345_MODEL_REG_LATENT            0x22        /**< tap latency register */
+#define ADXL345_MODEL_REG_WINDOW            0x23        /**< tap window register */
+#define ADXL345_MODEL_REG_THRESH_ACT        0x24        /**< activity threshold register */
+#define ADXL345_MODEL_REG_THRESH_INACT      0x25        /**< inactivity threshold register */
+#define ADXL345_MODEL_REG_TIME_INACT        0x26        /**< inactivity time register */
+#define ADXL345_MODEL_REG_ACT_INACT_CTL     0x27        /**< activity and inactivity control register */
+#define ADXL345_MODEL_REG_THRESH_FF         0x28        /**< free fall threshold register */
+#define ADXL345_MODEL_REG_TIME_FF           0x29        /**< free fall time register */
+#define ADXL345_MODEL_REG_TAP_AXES          0x2A        /**< tap axes register */
+#define ADXL345_MODEL_REG_ACT_TAP_STATUS    0x2B        /**< activity and tap status register */
+#define ADXL345_MODEL_REG_BW_RATE           0x2C        /**< data rate register */
+#define ADXL345_MODEL_REG_POWER_CTL         0x2D        /**< power control register */
+#define ADXL345_MODEL_REG_INT_ENABLE        0x2E        /**< interrupt enable register */
+#define ADXL345_MODEL_REG_INT_MAP           0x2F        /**< interrupt map register */
+#define ADXL345_MODEL_REG_INT_SOURCE        0x30        /**< interrupt source register */
+#define ADXL345_MODEL_REG_DATA_FORMAT       0x31        /**< data format register */
+#define ADXL345_MODEL_REG_DATAX0            0x32        /**< data X0 register */
+#define ADXL345_MODEL_REG_DATAZ1            0x37        /**< data Z1 register */
+#define ADXL345_MODEL_REG_FIFO_CTL          0x38        /**< fifo control register */
+#define ADXL345_MODEL_REG_FIFO_STATUS       0x39        /**< fifo status register */
+
+/**
+ * @brief interrupt source bit definition
+ */
+#define ADXL345_MODEL_INT_DATA_READY        0x80        /**< data ready */
+#define ADXL345_MODEL_INT_SINGLE_TAP        0x40        /**< single tap */
+#define ADXL345_MODEL_INT_DOUBLE_TAP        0x20        /**< double tap */
+#define ADXL345_MODEL_INT_ACTIVITY          0x10        /**< activity */
+#define ADXL345_MODEL_INT_INACTIVITY        0x08        /**< inactivity */
+#define ADXL345_MODEL_INT_FREE_FALL         0x04        /**< free fall */
+#define ADXL345_MODEL_INT_WATERMARK         0x02        /**< watermark */
+#define ADXL345_MODEL_INT_OVERRUN           0x01        /**< overrun */
+
+/**
+ * @brief fifo mode definition
+ */
+#define ADXL345_MODEL_MODE_BYPASS           0x00        /**< bypass mode */
+#define ADXL345_MODEL_MODE_FIFO             0x01        /**< fifo mode */
+#define ADXL345_MODEL_MODE_STREAM           0x02        /**< stream mode */
+#define ADXL345_MODEL_MODE_TRIGGER          0x03        /**< trigger mode */
+
+/**
+ * @brief     get the output data period
+ * @param[in] *model pointer to an adxl345 model structure
+ * @return    period in ns
+ * @note      3200Hz / 2^(15 - rate code)
+ */
+static uint64_t a_adxl345_model_period(adxl345_model_t *model)
+{
+    return 312500ULL << (15 - (model->reg[ADXL345_MODEL_REG_BW_RATE] & 0x0F));
+}
+
+/**
+ * @brief     get the fifo mode
+ * @param[in] *model pointer to an adxl345 model structure
+ * @return    fifo mode
+ * @note      none
+ */
+static uint8_t a_adxl345_model_mode(adxl345_model_t *model)
+{
+    return (model->reg[ADXL345_MODEL_REG_FIFO_CTL] >> 6) & 0x03;
+}
+
+/**
+ * @brief      get the acceleration with the offsets
+ * @param[in]  *model pointer to an adxl345 model structure
+ * @param[out] *g pointer to an acceleration buffer
+ * @note       the offset registers are 15.6mg/LSB
+ */
+static void a_adxl345_model_motion(adxl345_model_t *model, float g[3])
+{
+    uint8_t i;
+    
+    model->motion(model->time_ns, g);
+    for (i = 0; i < 3; i++)
+    {
+        g[i] += (float)((int8_t)model->reg[ADXL345_MODEL_REG_OFSX + i]) * 0.0156f;
+    }
+}
+
+/**
+ * @brief      convert an acceleration to the data registers
+ * @param[in]  *model pointer to an adxl345 model structure
+ * @param[in]  *g pointer to an acceleration buffer
+ * @param[out] *out pointer to a data register buffer
+ * @note       the full resolution mode is 3.9mg/LSB with 10 bits to 13 bits,
+ *             the 10 bits mode scales with the range, the left justify mode is msb aligned
+ */
+static void a_adxl345_model_format(adxl345_model_t *model, const float g[3], uint8_t out[6])
+{
+    uint8_t format;
+    uint8_t range;
+    uint8_t bits;
+    float lsb;
+    float v;
+    int32_t raw;
+    int32_t limit;
+    uint16_t word;
+    uint8_t i;
+    
+    format = model->reg[ADXL345_MODEL_REG_DATA_FORMAT];
+    range = format & 0x03;
+    if ((format & 0x08) != 0)
+    {
+        lsb = 256.0f;
+        bits = 10 + range;
+    }
+    else
+    {
+        lsb = 256.0f / (float)(1 << range);
+        bits = 10;
+    }
+    limit = 1 << (bits - 1);
+    for (i = 0; i < 3; i++)
+    {
+        /* round and saturate */
+        v = g[i] * lsb;
+        raw = (v >= 0.0f) ? (int32_t)(v + 0.5f) : (int32_t)(v - 0.5f);
+        if (raw > limit - 1)
+        {
+            raw = limit - 1;
+        }
+        if (raw < -limit)
+        {
+            raw = -limit;
+        }
+        
+        /* justify */
+        if ((format & 0x04) != 0)
+        {
+            word = (uint16_t)((uint32_t)raw << (16 - bits));
+        }
+        else
+        {
+            word = (uint16_t)raw;
+        }
+        out[i * 2 + 0] = word & 0xFF;
+        out[i * 2 + 1] = (word >> 8) & 0xFF;
+    }
+}
+
+/**
+ * @brief     get the interrupt source
+ * @param[in] *model pointer to an adxl345 model structure
+ * @return    interrupt source
+ * @note      data ready, watermark and overrun follow the data state,
+ *            the other bits are latched until the interrupt source is read
+ */
+static uint8_t a_adxl345_model_source(adxl345_model_t *model)
+{
+    uint8_t source;
+    
+    source = model->events;
+    if (a_adxl345_model_mode(model) == ADXL345_MODEL_MODE_BYPASS)
+    {
+        source |= (model->data_ready != 0) ? ADXL345_MODEL_INT_DATA_READY : 0;
+    }
+    else
+    {
+        source |= (model->fifo_count != 0) ? ADXL345_MODEL_INT_DATA_READY : 0;
+    }
+    if (model->fifo_count >= (model->reg[ADXL345_MODEL_REG_FIFO_CTL] & 0x1F))
+    {
+        source |= ADXL345_MODEL_INT_WATERMARK;
+    }
+    source |= (model->overrun != 0) ? ADXL345_MODEL_INT_OVERRUN : 0;
+    
+    return source;
+}
+
+/**
+ * @brief     get the electrical level of an interrupt pin
+ * @param[in] *model pointer to an adxl345 model structure
+ * @param[in] pin 0 for int1 and 1 for int2
+ * @return    level
+ * @note      the pin is active high unless the int invert bit is set
+ */
+static uint8_t a_adxl345_model_pin(adxl345_model_t *model, uint8_t pin)
+{
+    uint8_t active;
+    uint8_t map;
+    
+    active = a_adxl345_model_source(model) & model->reg[ADXL345_MODEL_REG_INT_ENABLE];
+    map = model->reg[ADXL345_MODEL_REG_INT_MAP];
+    active = (pin == 0) ? (active & (~map)) : (active & map);
+    if ((model->reg[ADXL345_MODEL_REG_DATA_FORMAT] & 0x20) != 0)
+    {
+        return (active != 0) ? 0 : 1;
+    }
+    else
+    {
+        return (active != 0) ? 1 : 0;
+    }
+}
+
+/**
+ * @brief     drop the oldest fifo entries
+ * @param[in] *model pointer to an adxl345 model structure
+ * @param[in] n entry number
+ * @note      none
+ */
+static void a_adxl345_model_pop(adxl345_model_t *model, uint8_t n)
+{
+    n = (n < model->fifo_count) ? n : model->fifo_count;
+    model->fifo_head = (model->fifo_head + n) % ADXL345_MODEL_FIFO_DEPTH;
+    model->fifo_count -= n;
+}
+
+/**
+ * @brief     push a fifo entry
+ * @param[in] *model pointer to an adxl345 model structure
+ * @param[in] *entry pointer to a data register buffer
+ * @note      the fifo must not be full
+ */
+static void a_adxl345_model_push(adxl345_model_t *model, const uint8_t entry[6])
+{
+    memcpy(model->fifo[(model->fifo_head + model->fifo_count) % ADXL345_MODEL_FIFO_DEPTH], entry, 6);
+    model->fifo_count++;
+}
+
+/**
+ * @brief     latch an event
+ * @param[in] *model pointer to an adxl345 model structure
+ * @param[in] bit interrupt source bit
+ * @note      an enabled event on the trigger pin triggers the fifo in the trigger mode
+ */
+static void a_adxl345_model_latch(adxl345_model_t *model, uint8_t bit)
+{
+    uint8_t pin;
+    
+    if ((model->reg[ADXL345_MODEL_REG_INT_ENABLE] & bit) == 0)
+    {
+        return;
+    }
+    model->events |= bit;
+    
+    /* keep the samples before the trigger */
+    if ((a_adxl345_model_mode(model) == ADXL345_MODEL_MODE_TRIGGER) && (model->triggered == 0))
+    {
+        pin = ((model->reg[ADXL345_MODEL_REG_INT_MAP] & bit) != 0) ? 1 : 0;
+        if (pin == ((model->reg[ADXL345_MODEL_REG_FIFO_CTL] >> 5) & 0x01))
+        {
+            model->triggered = 1;
+            if (model->fifo_count > (model->reg[ADXL345_MODEL_REG_FIFO_CTL] & 0x1F))
+            {
+                a_adxl345_model_pop(model, model->fifo_count - (model->reg[ADXL345_MODEL_REG_FIFO_CTL] & 0x1F));
+            }
+        }
+    }
+}
+
+/**
+ * @brief     run one output sample
+ * @param[in] *model pointer to an adxl345 model structure
+ * @note      none
+ */
+static void a_adxl345_model_sample(adxl345_model_t *model)
+{
+    float g[3];
+    uint8_t i;
+    
+    /* get the acceleration with about 4mg of noise */
+    a_adxl345_model_motion(model, g);
+    for (i = 0; i < 3; i++)
+    {
+        model->seed = model->seed * 1664525U + 1013904223U;
+        g[i] += ((float)((model->seed >> 16) & 0xFF) / 255.0f - 0.5f) * 0.008f;
+    }
+    a_adxl345_model_format(model, g, model->data);
+    
+    /* store the sample */
+    switch (a_adxl345_model_mode(model))
+    {
+        case ADXL345_MODEL_MODE_BYPASS :
+        {
+            model->overrun |= model->data_ready;
+            model->data_ready = 1;
+            
+            break;
+        }
+        case ADXL345_MODEL_MODE_FIFO :
+        {
+            if (model->fifo_count < ADXL345_MODEL_FIFO_DEPTH)
+            {
+                a_adxl345_model_push(model, model->data);
+            }
+            else
+            {
+                model->overrun = 1;
+            }
+            
+            break;
+        }
+        case ADXL345_MODEL_MODE_STREAM :
+        {
+            if (model->fifo_count == ADXL345_MODEL_FIFO_DEPTH)
+            {
+                a_adxl345_model_pop(model, 1);
+                model->overrun = 1;
+            }
+            a_adxl345_model_push(model, model->data);
+            
+            break;
+        }
+        default :
+        {
+            if (model->triggered == 0)
+            {
+                /* hold the latest samples before the trigger */
+                if (model->fifo_count == ADXL345_MODEL_FIFO_DEPTH)
+                {
+                    a_adxl345_model_pop(model, 1);
+                    model->overrun = 1;
+                }
+                a_adxl345_model_push(model, model->data);
+            }
+            else if (model->fifo_count < ADXL345_MODEL_FIFO_DEPTH)
+            {
+                /* collect until full after the trigger */
+                a_adxl345_model_push(model, model->data);
+            }
+            else
+            {
+                /* stop collecting */
+            }
+            
+            break;
+        }
+    }
+}
+
+/**
+ * @brief     run one detection tick
+ * @param[in] *model pointer to an adxl345 model structure
+ * @note      taps, activity, inactivity and free fall are detected at the tick rate,
+ *            not at the output data rate
+ */
+static void a_adxl345_model_tick(adxl345_model_t *model)
+{
+    float g[3];
+    float v;
+    float thresh;
+    uint64_t dur;
+    uint64_t latent;
+    uint64_t window;
+    uint8_t axes;
+    uint8_t ctl;
+    uint8_t hit;
+    uint8_t axis;
+    uint8_t i;
+    
+    a_adxl345_model_motion(model, g);
+    
+    /* tap */
+    thresh = (float)model->reg[ADXL345_MODEL_REG_THRESH_TAP] * 0.0625f;
+    dur = (uint64_t)model->reg[ADXL345_MODEL_REG_DUR] * 625000ULL;
+    latent = (uint64_t)model->reg[ADXL345_MODEL_REG_LATENT] * 1250000ULL;
+    window = (uint64_t)model->reg[ADXL345_MODEL_REG_WINDOW] * 1250000ULL;
+    axes = model->reg[ADXL345_MODEL_REG_TAP_AXES] & 0x07;
+    if ((thresh > 0.0f) && (dur != 0) && (axes != 0))
+    {
+        hit = 0;
+        axis = 0;
+        for (i = 0; i < 3; i++)
+        {
+            if (((axes & (0x04 >> i)) != 0) && (fabsf(g[i]) > thresh))
+            {
+                hit = 1;
+                axis = i;
+            }
+        }
+        if ((hit != 0) && (model->tap_above == 0))
+        {
+            /* pulse starts */
+            model->tap_above = 1;
+            model->tap_start_ns = model->time_ns;
+            model->tap_axis = axis;
+        }
+        else if ((hit == 0) && (model->tap_above != 0))
+        {
+            /* pulse ends, a tap is shorter than the duration */
+            model->tap_above = 0;
+            if (model->time_ns - model->tap_start_ns <= dur)
+            {
+                if ((model->tap_wait != 0) &&
+                    (model->tap_start_ns >= model->tap_end_ns + latent) &&
+                    (model->tap_start_ns <= model->tap_end_ns + latent + window))
+                {
+                    model->tap_wait = 0;
+                    a_adxl345_model_latch(model, ADXL345_MODEL_INT_DOUBLE_TAP);
+                }
+                else
+                {
+                    model->tap_wait = ((latent != 0) && (window != 0)) ? 1 : 0;
+                    model->tap_end_ns = model->time_ns;
+                    a_adxl345_model_latch(model, ADXL345_MODEL_INT_SINGLE_TAP);
+                }
+                model->reg[ADXL345_MODEL_REG_ACT_TAP_STATUS] &= ~0x07;
+                model->reg[ADXL345_MODEL_REG_ACT_TAP_STATUS] |= 0x04 >> model->tap_axis;
+            }
+        }
+        else
+        {
+            /* nothing changed */
+        }
+        if ((model->tap_wait != 0) && (model->time_ns > model->tap_end_ns + latent + window))
+        {
+            model->tap_wait = 0;
+        }
+    }
+    
+    /* activity */
+    ctl = model->reg[ADXL345_MODEL_REG_ACT_INACT_CTL];
+    axes = (ctl >> 4) & 0x07;
+    thresh = (float)model->reg[ADXL345_MODEL_REG_THRESH_ACT] * 0.0625f;
+    if ((axes != 0) && (thresh > 0.0f))
+    {
+        hit = 0;
+        for (i = 0; i < 3; i++)
+        {
+            v = ((ctl & 0x80) != 0) ? (g[i] - model->act_ref[i]) : g[i];
+            if (((axes & (0x04 >> i)) != 0) && (fabsf(v) > thresh))
+            {
+                hit |= 0x40 >> i;
+            }
+        }
+        if (hit != 0)
+        {
+            model->reg[ADXL345_MODEL_REG_ACT_TAP_STATUS] &= ~0x70;
+            model->reg[ADXL345_MODEL_REG_ACT_TAP_STATUS] |= hit;
+            memcpy(model->act_ref, g, sizeof(float) * 3);
+            a_adxl345_model_latch(model, ADXL345_MODEL_INT_ACTIVITY);
+        }
+    }
+    
+    /* inactivity */
+    axes = ctl & 0x07;
+    thresh = (float)model->reg[ADXL345_MODEL_REG_THRESH_INACT] * 0.0625f;
+    if (axes != 0)
+    {
+        hit = 0;
+        for (i = 0; i < 3; i++)
+        {
+            v = ((ctl & 0x08) != 0) ? (g[i] - model->inact_ref[i]) : g[i];
+            if (((axes & (0x04 >> i)) != 0) && (fabsf(v) > thresh))
+            {
+                hit = 1;
+            }
+        }
+        if (hit != 0)
+        {
+            /* restart the inactivity time */
+            model->inact_start_ns = model->time_ns;
+            model->inact_fired = 0;
+            memcpy(model->inact_ref, g, sizeof(float) * 3);
+        }
+        else if ((model->inact_fired == 0) &&
+                 (model->time_ns - model->inact_start_ns >= (uint64_t)model->reg[ADXL345_MODEL_REG_TIME_INACT] * 1000000000ULL))
+        {
+            model->inact_fired = 1;
+            a_adxl345_model_latch(model, ADXL345_MODEL_INT_INACTIVITY);
+        }
+        else
+        {
+            /* wait */
+        }
+    }
+    
+    /* free fall */
+    thresh = (float)model->reg[ADXL345_MODEL_REG_THRESH_FF] * 0.0625f;
+    if (thresh > 0.0f)
+    {
+        if ((fabsf(g[0]) < thresh) && (fabsf(g[1]) < thresh) && (fabsf(g[2]) < thresh))
+        {
+            if (model->ff_below == 0)
+            {
+                model->ff_below = 1;
+                model->ff_start_ns = model->time_ns;
+            }
+            if ((model->ff_fired == 0) &&
+                (model->time_ns - model->ff_start_ns >= (uint64_t)model->reg[ADXL345_MODEL_REG_TIME_FF] * 5000000ULL))
+            {
+                model->ff_fired = 1;
+                a_adxl345_model_latch(model, ADXL345_MODEL_INT_FREE_FALL);
+            }
+        }
+        else
+        {
+            model->ff_below = 0;
+            model->ff_fired = 0;
+        }
+    }
+}
+
+/**
+ * @brief     report the interrupt pin edges
+ * @param[in] *model pointer to an adxl345 model structure
+ * @note      an edge found while a callback is running is reported after it returns
+ */
+static void a_adxl345_model_report(adxl345_model_t *model)
+{
+    uint8_t pin;
+    uint8_t level;
+    
+    if (model->busy != 0)
+    {
+        return;
+    }
+    for (pin = 0; pin < 2; pin++)
+    {
+        level = a_adxl345_model_pin(model, pin);
+        if (level != model->pin_level[pin])
+        {
+            model->pin_level[pin] = level;
+            if (model->edge != NULL)
+            {
+                model->busy = 1;
+                model->edge(pin, level);
+                model->busy = 0;
+            }
+        }
+    }
+}
+
+/**
+ * @brief     start the measurement
+ * @param[in] *model pointer to an adxl345 model structure
+ * @note      none
+ */
+static void a_adxl345_model_start(adxl345_model_t *model)
+{
+    float g[3];
+    
+    model->next_sample_ns = model->time_ns + a_adxl345_model_period(model);
+    model->next_tick_ns = model->time_ns + ADXL345_MODEL_TICK_NS;
+    model->data_ready = 0;
+    model->tap_above = 0;
+    model->tap_wait = 0;
+    model->inact_fired = 0;
+    model->inact_start_ns = model->time_ns;
+    model->ff_below = 0;
+    model->ff_fired = 0;
+    a_adxl345_model_motion(model, g);
+    memcpy(model->act_ref, g, sizeof(float) * 3);
+    memcpy(model->inact_ref, g, sizeof(float) * 3);
+}
+
+/**
+ * @brief     write a register
+ * @param[in] *model pointer to an adxl345 model structure
+ * @param[in] addr register address
+ * @param[in] value register value
+ * @note      the read only and reserved registers ignore the writes
+ */
+static void a_adxl345_model_set(adxl345_model_t *model, uint8_t addr, uint8_t value)
+{
+    uint8_t prev;
+    
+    if (!(((addr >= ADXL345_MODEL_REG_THRESH_TAP) && (addr <= ADXL345_MODEL_REG_TAP_AXES)) ||
+          ((addr >= ADXL345_MODEL_REG_BW_RATE) && (addr <= ADXL345_MODEL_REG_INT_MAP)) ||
+          (addr == ADXL345_MODEL_REG_DATA_FORMAT) || (addr == ADXL345_MODEL_REG_FIFO_CTL)))
+    {
+        return;
+    }
+    prev = model->reg[addr];
+    model->reg[addr] = value;
+    
+    /* measure bit rising */
+    if ((addr == ADXL345_MODEL_REG_POWER_CTL) && ((prev & 0x08) == 0) && ((value & 0x08) != 0))
+    {
+        a_adxl345_model_start(model);
+    }
+    
+    /* a new fifo mode clears the fifo */
+    if ((addr == ADXL345_MODEL_REG_FIFO_CTL) && (((prev ^ value) & 0xC0) != 0))
+    {
+        model->fifo_head = 0;
+        model->fifo_count = 0;
+        model->triggered = 0;
+        model->overrun = 0;
+    }
+}
+
+/**
+ * @brief     read a register
+ * @param[in] *model pointer to an adxl345 model structure
+ * @param[in] addr register address
+ * @return    register value
+ * @note      none
+ */
+static uint8_t a_adxl345_model_get(adxl345_model_t *model, uint8_t addr)
+{
+    if (addr == ADXL345_MODEL_REG_INT_SOURCE)
+    {
+        return a_adxl345_model_source(model);
+    }
+    else if (addr == ADXL345_MODEL_REG_FIFO_STATUS)
+    {
+        return (uint8_t)((model->triggered << 7) | model->fifo_count);
+    }
+    else if ((addr >= ADXL345_MODEL_REG_DATAX0) && (addr <= ADXL345_MODEL_REG_DATAZ1))
+    {
+        if ((a_adxl345_model_mode(model) != ADXL345_MODEL_MODE_BYPASS) && (model->fifo_count != 0))
+        {
+            return model->fifo[model->fifo_head][addr - ADXL345_MODEL_REG_DATAX0];
+        }
+        else
+        {
+            return model->data[addr - ADXL345_MODEL_REG_DATAX0];
+        }
+    }
+    else if (addr < 64)
+    {
+        return model->reg[addr];
+    }
+    else
+    {
+        return 0x00;
+    }
+}
+
+/**
+ * @brief      run a read transfer
+ * @param[in]  *model pointer to an adxl345 model structure
+ * @param[in]  addr first register address
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of the data buffer
+ * @param[in]  increment address auto increment flag
+ * @note       the address runs on like the chip, a burst from DATAX0 goes on to FIFO_CTL and FIFO_STATUS
+ *             after DATAZ1 instead of the next fifo entry, a transfer touching the data registers pops
+ *             one fifo entry at its end and reading INT_SOURCE clears the latched events
+ */
+static void a_adxl345_model_read(adxl345_model_t *model, uint8_t addr, uint8_t *buf, uint16_t len, uint8_t increment)
+{
+    uint16_t i;
+    uint8_t data;
+    uint8_t source;
+    
+    data = 0;
+    source = 0;
+    for (i = 0; i < len; i++)
+    {
+        buf[i] = a_adxl345_model_get(model, addr);
+        if ((addr >= ADXL345_MODEL_REG_DATAX0) && (addr <= ADXL345_MODEL_REG_DATAZ1))
+        {
+            data = 1;
+        }
+        if (addr == ADXL345_MODEL_REG_INT_SOURCE)
+        {
+            source = 1;
+        }
+        if (increment != 0)
+        {
+            addr++;
+        }
+    }
+    
+    /* read side effects */
+    if (data != 0)
+    {
+        if (a_adxl345_model_mode(model) == ADXL345_MODEL_MODE_BYPASS)
+        {
+            model->data_ready = 0;
+        }
+        else
+        {
+            a_adxl345_model_pop(model, 1);
+        }
+        model->overrun = 0;
+    }
+    if (source != 0)
+    {
+        model->events = 0;
+    }
+}
+
+/**
+ * @brief     model init
+ * @param[in] *model pointer to an adxl345 model structure
+ * @param[in] iic_addr iic device write address
+ * @note      all the registers are set to the reset values and the virtual clock starts at 0,
+ *            the motion is set to adxl345_model_default_motion
+ */
+void adxl345_model_init(adxl345_model_t *model, uint8_t iic_addr)
+{
+    memset(model, 0, sizeof(adxl345_model_t));
+    model->iic_addr = iic_addr;
+    model->reg[ADXL345_MODEL_REG_DEVID] = 0xE5;
+    model->reg[ADXL345_MODEL_REG_BW_RATE] = 0x0A;
+    model->seed = 0x12345678U;
+    model->motion = adxl345_model_default_motion;
+    model->pin_level[0] = a_adxl345_model_pin(model, 0);
+    model->pin_level[1] = a_adxl345_model_pin(model, 1);
+}
+
+/**
+ * @brief     set the motion
+ * @param[in] *model pointer to an adxl345 model structure
+ * @param[in] *motion pointer to a motion function address
+ * @note      the motion function returns the acceleration in g at the virtual time
+ */
+void adxl345_model_set_motion(adxl345_model_t *model, void (*motion)(uint64_t time_ns, float g[3]))
+{
+    model->motion = (motion != NULL) ? motion : adxl345_model_default_motion;
+}
+
+/**
+ * @brief     set the interrupt pin edge callback
+ * @param[in] *model pointer to an adxl345 model structure
+ * @param[in] *edge pointer to an edge function address
+ * @note      pin is 0 for int1 and 1 for int2, level is the electrical level after the edge,
+ *            the callback runs from adxl345_model_advance only
+ */
+void adxl345_model_set_edge_callback(adxl345_model_t *model, void (*edge)(uint8_t pin, uint8_t level))
+{
+    model->edge = edge;
+}
+
+/**
+ * @brief      default motion
+ * @param[in]  time_ns virtual time
+ * @param[out] *g pointer to an acceleration buffer
+ * @note       a 10s cycle at rest tilted on the y axis with a single tap at 1s,
+ *             a double tap at 2s, shaking from 3s to 4s and a free fall at 9s
+ */
+void adxl345_model_default_motion(uint64_t time_ns, float g[3])
+{
+    uint32_t ms;
+    
+    /* at rest */
+    ms = (uint32_t)((time_ns / 1000000ULL) % 10000ULL);
+    g[0] = 0.0f;
+    g[1] = 0.4f;
+    g[2] = 0.9f;
+    
+    if (((ms >= 1003) && (ms < 1008)) || ((ms >= 2003) && (ms < 2008)) || ((ms >= 2053) && (ms < 2058)))
+    {
+        /* 5ms taps on z */
+        g[2] += 3.5f;
+    }
+    else if ((ms >= 3000) && (ms < 4000))
+    {
+        /* shake x */
+        g[0] = (((ms / 20) % 2) != 0) ? 2.5f : -2.5f;
+    }
+    else if ((ms >= 9000) && (ms < 9200))
+    {
+        /* free fall */
+        g[0] = 0.0f;
+        g[1] = 0.0f;
+        g[2] = 0.0f;
+    }
+    else
+    {
+        /* rest */
+    }
+}
+
+/**
+ * @brief     advance the virtual clock
+ * @param[in] *model pointer to an adxl345 model structure
+ * @param[in] ns advanced time
+ * @note      the samples and the detection ticks are run in time order,
+ *            the pin edges are reported at the time they happen
+ */
+void adxl345_model_advance(adxl345_model_t *model, uint64_t ns)
+{
+    uint64_t target;
+    uint64_t next;
+    uint8_t measure;
+    
+    target = model->time_ns + ns;
+    while (model->time_ns < target)
+    {
+        /* find the next event */
+        measure = model->reg[ADXL345_MODEL_REG_POWER_CTL] & 0x08;
+        next = target;
+        if (measure != 0)
+        {
+            next = (model->next_sample_ns < next) ? model->next_sample_ns : next;
+            next = (model->next_tick_ns < next) ? model->next_tick_ns : next;
+        }
+        model->time_ns = next;
+        
+        /* run the events */
+        if ((measure != 0) && (model->next_tick_ns == next))
+        {
+            a_adxl345_model_tick(model);
+            model->next_tick_ns += ADXL345_MODEL_TICK_NS;
+        }
+        if ((measure != 0) && (model->next_sample_ns == next))
+        {
+            a_adxl345_model_sample(model);
+            model->next_sample_ns += a_adxl345_model_period(model);
+        }
+        
+        /* report the edges */
+        a_adxl345_model_report(model);
+    }
+}
+
+/**
+ * @brief     account a bus transaction
+ * @param[in] *model pointer to an adxl345 model structure
+ * @param[in] byte bytes on the wire
+ * @note      none
+ */
+static void a_adxl345_model_bus(adxl345_model_t *model, uint32_t byte)
+{
+    model->bus_transfer++;
+    model->bus_byte += byte;
+    model->bus_ns += model->bus_latency_ns + (uint64_t)byte * model->bus_byte_ns;
+}
+
+/**
+ * @brief     set the bus timing
+ * @param[in] *model pointer to an adxl345 model structure
+ * @param[in] latency_ns fixed cost of one bus transaction
+ * @param[in] byte_ns time of one byte on the wire
+ * @note      the bus time is only accounted in bus_ns, the virtual clock doesn't advance
+ *            so that no interrupt edge is raised in the middle of a driver call
+ */
+void adxl345_model_set_bus_timing(adxl345_model_t *model, uint32_t latency_ns, uint32_t byte_ns)
+{
+    model->bus_latency_ns = latency_ns;
+    model->bus_byte_ns = byte_ns;
+}
+
+/**
+ * @brief     clear the bus counters
+ * @param[in] *model pointer to an adxl345 model structure
+ * @note      bus_transfer, bus_byte and bus_ns are cleared
+ */
+void adxl345_model_clear_bus(adxl345_model_t *model)
+{
+    model->bus_transfer = 0;
+    model->bus_byte = 0;
+    model->bus_ns = 0;
+}
+
+/**
+ * @brief      model iic read
+ * @param[in]  *model pointer to an adxl345 model structure
+ * @param[in]  addr iic device write address
+ * @param[in]  reg register address
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of the data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       the address auto increments
+ */
+uint8_t adxl345_model_iic_read(adxl345_model_t *model, uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    if (addr != model->iic_addr)
+    {
+        model->protocol_error++;
+        
+        return 1;
+    }
+    a_adxl345_model_bus(model, (uint32_t)len + 3);
+    a_adxl345_model_read(model, reg, buf, len, 1);
+    
+    return 0;
+}
+
+/**
+ * @brief     model iic write
+ * @param[in] *model pointer to an adxl345 model structure
+ * @param[in] addr iic device write address
+ * @param[in] reg register address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      the address auto increments
+ */
+uint8_t adxl345_model_iic_write(adxl345_model_t *model, uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    uint16_t i;
+    
+    if (addr != model->iic_addr)
+    {
+        model->protocol_error++;
+        
+        return 1;
+    }
+    a_adxl345_model_bus(model, (uint32_t)len + 2);
+    for (i = 0; i < len; i++)
+    {
+        a_adxl345_model_set(model, (uint8_t)(reg + i), buf[i]);
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief      model spi read
+ * @param[in]  *model pointer to an adxl345 model structure
+ * @param[in]  reg command byte
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of the data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       bit 7 of the command must be set, bit 6 enables the address auto increment
+ */
+uint8_t adxl345_model_spi_read(adxl345_model_t *model, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    if ((reg & 0x80) == 0)
+    {
+        model->protocol_error++;
+        
+        return 1;
+    }
+    a_adxl345_model_bus(model, (uint32_t)len + 1);
+    a_adxl345_model_read(model, reg & 0x3F, buf, len, (reg >> 6) & 0x01);
+    
+    return 0;
+}
+
+/**
+ * @brief     model spi write
+ * @param[in] *model pointer to an adxl345 model structure
+ * @param[in] reg command byte
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      bit 7 of the command must be cleared, bit 6 enables the address auto increment
+ */
+uint8_t adxl345_model_spi_write(adxl345_model_t *model, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    uint16_t i;
+    
+    if ((reg & 0x80) != 0)
+    {
+        model->protocol_error++;
+        
+        return 1;
+    }
+    a_adxl345_model_bus(model, (uint32_t)len + 1);
+    for (i = 0; i < len; i++)
+    {
+        a_adxl345_model_set(model, (uint8_t)((reg & 0x3F) + (((reg & 0x40) != 0) ? i : 0)), buf[i]);
+    }
+    
+    return 0;
+}
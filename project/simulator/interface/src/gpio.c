@@ -0,0 +1,89 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      gpio.c
+ * @brief     gpio source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "gpio.h"
+#include "mutex.h"
+
+/**
+ * @brief global var definition
+ */
+static uint8_t gs_enable;                 /**< interrupt enable flag */
+static uint8_t gs_level;                  /**< interrupt line level */
+extern uint8_t (*g_gpio_irq)(void);       /**< interrupt flag */
+
+/**
+ * @brief  gpio interrupt init
+ * @return status code
+ *         - 0 success
+ *         - 1 init failed
+ * @note   none
+ */
+uint8_t gpio_interrupt_init(void)
+{
+    gs_enable = 1;
+    
+    return 0;
+}
+
+/**
+ * @brief  gpio interrupt deinit
+ * @return status code
+ *         - 0 success
+ *         - 1 deinit failed
+ * @note   none
+ */
+uint8_t gpio_interrupt_deinit(void)
+{
+    gs_enable = 0;
+    
+    return 0;
+}
+
+/**
+ * @brief     set the level of the simulated interrupt line
+ * @param[in] level electrical level
+ * @note      a falling edge runs the irq when the interrupt is inited
+ */
+void gpio_interrupt_set_level(uint8_t level)
+{
+    /* if the falling edge */
+    if ((gs_enable != 0) && (gs_level != 0) && (level == 0))
+    {
+        /* run the callback in the mutex mode */
+        mutex_irq(g_gpio_irq);
+    }
+    gs_level = level;
+}
@@ -0,0 +1,147 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      iic_scheduler_bus.c
+ * @brief     iic scheduler bus source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "iic_scheduler_bus.h"
+#include "adxl345_model.h"
+
+/**
+ * @brief simulated chip definition
+ */
+extern adxl345_model_t g_adxl345_model[2];        /**< chips with the addr pin connected to GND and VCC */
+
+/**
+ * @brief      iic scheduler bus open
+ * @param[in]  *name unused iic device name
+ * @return     status code
+ *             - 0 success
+ * @note       the simulated chips share the bus
+ */
+uint8_t iic_scheduler_bus_open(char *name)
+{
+    (void)name;
+    
+    return 0;
+}
+
+/**
+ * @brief  iic scheduler bus close
+ * @return status code
+ *         - 0 success
+ * @note   none
+ */
+uint8_t iic_scheduler_bus_close(void)
+{
+    return 0;
+}
+
+/**
+ * @brief      iic scheduler bus read
+ * @param[in]  addr iic device write address
+ * @param[in]  reg iic register address
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of the data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       a missing chip nacks, called with the scheduler mutex held
+ */
+uint8_t iic_scheduler_bus_read(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    uint8_t i;
+    uint8_t res = 1;
+    
+    for (i = 0; i < 2; i++)
+    {
+        if (g_adxl345_model[i].iic_addr == addr)
+        {
+            res = adxl345_model_iic_read(&g_adxl345_model[i], addr, reg, buf, len);
+        }
+    }
+    
+    return res;
+}
+
+/**
+ * @brief     iic scheduler bus write
+ * @param[in] addr iic device write address
+ * @param[in] reg iic register address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      a missing chip nacks, called with the scheduler mutex held
+ */
+uint8_t iic_scheduler_bus_write(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    uint8_t i;
+    uint8_t res = 1;
+    
+    for (i = 0; i < 2; i++)
+    {
+        if (g_adxl345_model[i].iic_addr == addr)
+        {
+            res = adxl345_model_iic_write(&g_adxl345_model[i], addr, reg, buf, len);
+        }
+    }
+    
+    return res;
+}
+
+/**
+ * @brief     iic scheduler bus transfer
+ * @param[in] *segment pointer to a segment buffer
+ * @param[in] n segment number
+ * @return    status code
+ *            - 0 success
+ *            - 1 transfer failed
+ * @note      every segment is a register write and a read with a repeated start,
+ *            called with the scheduler mutex held
+ */
+uint8_t iic_scheduler_bus_transfer(iic_scheduler_segment_t *segment, uint16_t n)
+{
+    uint16_t i;
+    
+    for (i = 0; i < n; i++)
+    {
+        if (iic_scheduler_bus_read(segment[i].addr, segment[i].reg, segment[i].buf, segment[i].len) != 0)
+        {
+            return 1;
+        }
+    }
+    
+    return 0;
+}
@@ -0,0 +1,560 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      bench.c
+ * @brief     simulator benchmark source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_adxl345_interrupt.h"
+#include "driver_adxl345_fifo.h"
+#include "driver_adxl345_basic.h"
+#include "adxl345_model.h"
+#include <getopt.h>
+#include <stdlib.h>
+#include <time.h>
+
+/**
+ * @brief bench definition
+ */
+#define BENCH_BATCH_MS           5            /**< 16 samples at 3200Hz */
+#define BENCH_IIC_BYTE_NS        22500        /**< 9 clocks at 400KHz */
+#define BENCH_SPI_BYTE_NS        1600         /**< 8 clocks at 5MHz */
+
+/**
+ * @brief bench mode enumeration definition
+ */
+typedef enum
+{
+    BENCH_MODE_BYPASS = 0x00,        /**< one adxl345_read per sample in the bypass mode */
+    BENCH_MODE_FIFO   = 0x01,        /**< adxl345_read drains the fifo mode */
+    BENCH_MODE_STREAM = 0x02,        /**< adxl345_read drains the stream mode */
+    BENCH_MODE_IRQ    = 0x03,        /**< adxl345_irq_handler drains the fifo mode on the watermark */
+} bench_mode_t;
+
+uint8_t (*g_gpio_irq)(void) = NULL;               /**< gpio irq function address */
+extern adxl345_model_t g_adxl345_model[2];        /**< simulated chips */
+static adxl345_handle_t gs_handle;                /**< adxl345 handle */
+static int16_t gs_raw[32][3];                     /**< raw buffer */
+static float gs_g[32][3];                         /**< converted buffer */
+static uint32_t gs_sample;                        /**< decoded sample counter */
+static uint8_t gs_error;                          /**< read error flag */
+static const char *const gs_mode_name[] = {"bypass", "fifo", "stream", "irq"};
+static const char *const gs_range_name[] = {"2g", "4g", "8g", "16g"};
+
+/**
+ * @brief     bench receive callback
+ * @param[in] type irq type
+ * @note      the watermark drains the fifo like the fifo example
+ */
+static void a_bench_receive_callback(uint8_t type)
+{
+    uint16_t len;
+    
+    if (type == ADXL345_INTERRUPT_WATERMARK)
+    {
+        len = 32;
+        if (adxl345_read(&gs_handle, gs_raw, gs_g, &len) != 0)
+        {
+            gs_error = 1;
+        }
+        gs_sample += len;
+    }
+}
+
+/**
+ * @brief  monotonic time
+ * @return time in ns
+ * @note   none
+ */
+static uint64_t a_bench_now(void)
+{
+    struct timespec ts;
+    
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief     clear the bus counters of all the chips
+ * @param[in] latency_ns fixed cost of one bus transaction
+ * @param[in] byte_ns time of one byte on the wire
+ * @note      none
+ */
+static void a_bench_clear_bus(uint32_t latency_ns, uint32_t byte_ns)
+{
+    uint8_t i;
+    
+    for (i = 0; i < 2; i++)
+    {
+        adxl345_model_set_bus_timing(&g_adxl345_model[i], latency_ns, byte_ns);
+        adxl345_model_clear_bus(&g_adxl345_model[i]);
+    }
+}
+
+/**
+ * @brief      sum the bus counters of all the chips
+ * @param[out] *transfer pointer to a transaction count buffer
+ * @param[out] *byte pointer to a byte count buffer
+ * @param[out] *ns pointer to a bus time buffer
+ * @note       none
+ */
+static void a_bench_get_bus(uint64_t *transfer, uint64_t *byte, uint64_t *ns)
+{
+    uint8_t i;
+    
+    *transfer = 0;
+    *byte = 0;
+    *ns = 0;
+    for (i = 0; i < 2; i++)
+    {
+        *transfer += g_adxl345_model[i].bus_transfer;
+        *byte += g_adxl345_model[i].bus_byte;
+        *ns += g_adxl345_model[i].bus_ns;
+    }
+}
+
+/**
+ * @brief     run the example init sequences
+ * @param[in] interface chip interface
+ * @param[in] latency_ns fixed cost of one bus transaction
+ * @param[in] byte_ns time of one byte on the wire
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      none
+ */
+static uint8_t a_bench_init(adxl345_interface_t interface, uint32_t latency_ns, uint32_t byte_ns)
+{
+    uint8_t i;
+    uint8_t res;
+    uint64_t transfer, byte, ns;
+    const char *const name[] = {"basic", "fifo", "interrupt"};
+    
+    /* power on the chips before setting the bus timing */
+    if (adxl345_interface_iic_init() != 0)
+    {
+        return 1;
+    }
+    for (i = 0; i < 3; i++)
+    {
+        a_bench_clear_bus(latency_ns, byte_ns);
+        if (i == 0)
+        {
+            res = adxl345_basic_init(interface, ADXL345_ADDRESS_ALT_0);
+        }
+        else if (i == 1)
+        {
+            res = adxl345_fifo_init(interface, ADXL345_ADDRESS_ALT_0, NULL);
+        }
+        else
+        {
+            res = adxl345_interrupt_init(interface, ADXL345_ADDRESS_ALT_0, NULL,
+                                         ADXL345_BOOL_TRUE, ADXL345_BOOL_TRUE,
+                                         ADXL345_BOOL_TRUE, ADXL345_BOOL_TRUE);
+        }
+        if (res != 0)
+        {
+            adxl345_interface_debug_print("adxl345: %s init failed.\n", name[i]);
+            
+            return 1;
+        }
+        a_bench_get_bus(&transfer, &byte, &ns);
+        adxl345_interface_debug_print("adxl345: %-9s init %4d transfers %5d bytes %9.1fus.\n",
+                                      name[i], (int)transfer, (int)byte, (double)ns / 1000.0);
+        if (i == 0)
+        {
+            (void)adxl345_basic_deinit();
+        }
+        else if (i == 1)
+        {
+            (void)adxl345_fifo_deinit();
+        }
+        else
+        {
+            (void)adxl345_interrupt_deinit();
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     configure the chip for one bench row
+ * @param[in] mode bench mode
+ * @param[in] range chip range
+ * @param[in] full_res full resolution enable
+ * @param[in] justify data justify
+ * @return    status code
+ *            - 0 success
+ *            - 1 configure failed
+ * @note      the bypass mode is set first to empty the fifo
+ */
+static uint8_t a_bench_config(bench_mode_t mode, adxl345_range_t range, adxl345_bool_t full_res, adxl345_justify_t justify)
+{
+    uint8_t res = 0;
+    adxl345_bool_t irq = (mode == BENCH_MODE_IRQ) ? ADXL345_BOOL_TRUE : ADXL345_BOOL_FALSE;
+    
+    res |= adxl345_set_measure(&gs_handle, ADXL345_BOOL_FALSE);
+    res |= adxl345_set_mode(&gs_handle, ADXL345_MODE_BYPASS);
+    res |= adxl345_set_rate(&gs_handle, ADXL345_RATE_3200);
+    res |= adxl345_set_range(&gs_handle, range);
+    res |= adxl345_set_full_resolution(&gs_handle, full_res);
+    res |= adxl345_set_justify(&gs_handle, justify);
+    res |= adxl345_set_watermark(&gs_handle, 16);
+    res |= adxl345_set_interrupt_map(&gs_handle, ADXL345_INTERRUPT_WATERMARK, ADXL345_INTERRUPT_PIN1);
+    res |= adxl345_set_interrupt(&gs_handle, ADXL345_INTERRUPT_WATERMARK, irq);
+    if (mode == BENCH_MODE_STREAM)
+    {
+        res |= adxl345_set_mode(&gs_handle, ADXL345_MODE_STREAM);
+    }
+    else if (mode != BENCH_MODE_BYPASS)
+    {
+        res |= adxl345_set_mode(&gs_handle, ADXL345_MODE_FIFO);
+    }
+    res |= adxl345_set_measure(&gs_handle, ADXL345_BOOL_TRUE);
+    
+    return (res != 0) ? 1 : 0;
+}
+
+/**
+ * @brief     run one bench row
+ * @param[in] mode bench mode
+ * @param[in] range chip range
+ * @param[in] full_res full resolution enable
+ * @param[in] justify data justify
+ * @param[in] times iteration times
+ * @param[in] latency_ns fixed cost of one bus transaction
+ * @param[in] byte_ns time of one byte on the wire
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      the cpu time covers the driver and the in-process fake bus, not the sample generation
+ */
+static uint8_t a_bench_row(bench_mode_t mode, adxl345_range_t range, adxl345_bool_t full_res, adxl345_justify_t justify,
+                           uint32_t times, uint32_t latency_ns, uint32_t byte_ns)
+{
+    uint32_t i;
+    uint16_t len;
+    uint64_t start, cpu_ns;
+    uint64_t transfer, byte, ns;
+    double sample;
+    
+    if (a_bench_config(mode, range, full_res, justify) != 0)
+    {
+        adxl345_interface_debug_print("adxl345: config failed.\n");
+        
+        return 1;
+    }
+    
+    /* drop the first batch */
+    adxl345_interface_delay_ms(BENCH_BATCH_MS);
+    len = 32;
+    (void)adxl345_read(&gs_handle, gs_raw, gs_g, &len);
+    
+    a_bench_clear_bus(latency_ns, byte_ns);
+    gs_sample = 0;
+    gs_error = 0;
+    cpu_ns = 0;
+    for (i = 0; i < times; i++)
+    {
+        if (mode == BENCH_MODE_BYPASS)
+        {
+            adxl345_interface_delay_ms(1);
+            len = 1;
+            start = a_bench_now();
+            if (adxl345_read(&gs_handle, gs_raw, gs_g, &len) != 0)
+            {
+                gs_error = 1;
+            }
+            cpu_ns += a_bench_now() - start;
+            gs_sample += len;
+        }
+        else if (mode == BENCH_MODE_IRQ)
+        {
+            adxl345_interface_delay_ms(BENCH_BATCH_MS);
+            start = a_bench_now();
+            if (adxl345_irq_handler(&gs_handle) != 0)
+            {
+                gs_error = 1;
+            }
+            cpu_ns += a_bench_now() - start;
+        }
+        else
+        {
+            adxl345_interface_delay_ms(BENCH_BATCH_MS);
+            len = 32;
+            start = a_bench_now();
+            if (adxl345_read(&gs_handle, gs_raw, gs_g, &len) != 0)
+            {
+                gs_error = 1;
+            }
+            cpu_ns += a_bench_now() - start;
+            gs_sample += len;
+        }
+    }
+    if ((gs_error != 0) || (gs_sample == 0))
+    {
+        adxl345_interface_debug_print("adxl345: %s read failed.\n", gs_mode_name[mode]);
+        
+        return 1;
+    }
+    a_bench_get_bus(&transfer, &byte, &ns);
+    sample = (double)gs_sample;
+    adxl345_interface_debug_print("%-7s %-4s %-5s %-6s %8.2f %9.2f %11.2f %11.1f\n",
+                                  gs_mode_name[mode], gs_range_name[range],
+                                  (full_res == ADXL345_BOOL_TRUE) ? "full" : "10bit",
+                                  (justify == ADXL345_JUSTIFY_LEFT) ? "left" : "right",
+                                  (double)transfer / sample, (double)byte / sample,
+                                  (double)ns / 1000.0 / sample, (double)cpu_ns / sample);
+    
+    return 0;
+}
+
+/**
+ * @brief     adxl345 bench function
+ * @param[in] argc arg numbers
+ * @param[in] **argv arg address
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ *            - 5 param is invalid
+ * @note      none
+ */
+static uint8_t adxl345_bench(uint8_t argc, char **argv)
+{
+    int c;
+    int longindex = 0;
+    const char short_options[] = "h";
+    const struct option long_options[] =
+    {
+        {"help", no_argument, NULL, 'h'},
+        {"interface", required_argument, NULL, 1},
+        {"latency", required_argument, NULL, 2},
+        {"times", required_argument, NULL, 3},
+        {NULL, 0, NULL, 0},
+    };
+    adxl345_interface_t interface = ADXL345_INTERFACE_IIC;
+    uint32_t latency_ns = 0;
+    uint32_t times = 200;
+    uint32_t byte_ns;
+    uint8_t help = 0;
+    uint8_t mode, range, full_res, justify;
+    
+    /* init 0 */
+    optind = 0;
+    
+    /* parse */
+    do
+    {
+        /* parse the args */
+        c = getopt_long(argc, argv, short_options, long_options, &longindex);
+        
+        /* judge the result */
+        switch (c)
+        {
+            /* help */
+            case 'h' :
+            {
+                help = 1;
+                
+                break;
+            }
+            
+            /* interface */
+            case 1 :
+            {
+                /* set the interface */
+                if (strcmp("iic", optarg) == 0)
+                {
+                    interface = ADXL345_INTERFACE_IIC;
+                }
+                else if (strcmp("spi", optarg) == 0)
+                {
+                    interface = ADXL345_INTERFACE_SPI;
+                }
+                else
+                {
+                    return 5;
+                }
+                
+                break;
+            }
+            
+            /* latency */
+            case 2 :
+            {
+                /* set the latency */
+                latency_ns = (uint32_t)atol(optarg);
+                
+                break;
+            }
+            
+            /* running times */
+            case 3 :
+            {
+                /* set the times */
+                times = (uint32_t)atol(optarg);
+                if (times == 0)
+                {
+                    return 5;
+                }
+                
+                break;
+            }
+            
+            /* the end */
+            case -1 :
+            {
+                break;
+            }
+            
+            /* others */
+            default :
+            {
+                return 5;
+            }
+        }
+    } while (c != -1);
+    
+    if (help != 0)
+    {
+        adxl345_interface_debug_print("Usage:\n");
+        adxl345_interface_debug_print("  adxl345_bench [--interface=<iic | spi>] [--latency=<ns>] [--times=<num>]\n");
+        adxl345_interface_debug_print("  adxl345_bench (-h | --help)\n");
+        adxl345_interface_debug_print("\n");
+        adxl345_interface_debug_print("Options:\n");
+        adxl345_interface_debug_print("  -h, --help                         Show the help.\n");
+        adxl345_interface_debug_print("      --interface=<iic | spi>        Set the chip interface.([default: iic])\n");
+        adxl345_interface_debug_print("      --latency=<ns>                 Set the fixed cost of one bus transaction.([default: 0])\n");
+        adxl345_interface_debug_print("      --times=<num>                  Set the iteration times of every row.([default: 200])\n");
+        
+        return 0;
+    }
+    
+    byte_ns = (interface == ADXL345_INTERFACE_IIC) ? BENCH_IIC_BYTE_NS : BENCH_SPI_BYTE_NS;
+    adxl345_interface_debug_print("adxl345: bench %s, latency %dns, byte %dns, %d times.\n",
+                                  (interface == ADXL345_INTERFACE_IIC) ? "iic" : "spi",
+                                  (int)latency_ns, (int)byte_ns, (int)times);
+    
+    /* example init sequences */
+    if (a_bench_init(interface, latency_ns, byte_ns) != 0)
+    {
+        return 1;
+    }
+    
+    /* link the bench handle */
+    DRIVER_ADXL345_LINK_INIT(&gs_handle, adxl345_handle_t);
+    DRIVER_ADXL345_LINK_IIC_INIT(&gs_handle, adxl345_interface_iic_init);
+    DRIVER_ADXL345_LINK_IIC_DEINIT(&gs_handle, adxl345_interface_iic_deinit);
+    DRIVER_ADXL345_LINK_IIC_READ(&gs_handle, adxl345_interface_iic_read);
+    DRIVER_ADXL345_LINK_IIC_WRITE(&gs_handle, adxl345_interface_iic_write);
+    DRIVER_ADXL345_LINK_SPI_INIT(&gs_handle, adxl345_interface_spi_init);
+    DRIVER_ADXL345_LINK_SPI_DEINIT(&gs_handle, adxl345_interface_spi_deinit);
+    DRIVER_ADXL345_LINK_SPI_READ(&gs_handle, adxl345_interface_spi_read);
+    DRIVER_ADXL345_LINK_SPI_WRITE(&gs_handle, adxl345_interface_spi_write);
+    DRIVER_ADXL345_LINK_DELAY_MS(&gs_handle, adxl345_interface_delay_ms);
+    DRIVER_ADXL345_LINK_DEBUG_PRINT(&gs_handle, adxl345_interface_debug_print);
+    DRIVER_ADXL345_LINK_RECEIVE_CALLBACK(&gs_handle, a_bench_receive_callback);
+    DRIVER_ADXL345_LINK_ASYNC_SUBMIT(&gs_handle, adxl345_interface_async_submit);
+    DRIVER_ADXL345_LINK_ASYNC_COMPLETE(&gs_handle, adxl345_interface_async_complete);
+    if (adxl345_set_interface(&gs_handle, interface) != 0)
+    {
+        return 1;
+    }
+    if (adxl345_set_addr_pin(&gs_handle, ADXL345_ADDRESS_ALT_0) != 0)
+    {
+        return 1;
+    }
+    if (adxl345_init(&gs_handle) != 0)
+    {
+        return 1;
+    }
+    
+    /* every mode and data format */
+    adxl345_interface_debug_print("mode    rng  res   just   xfer/smp  byte/smp  bus us/smp  cpu ns/smp\n");
+    for (mode = BENCH_MODE_BYPASS; mode <= BENCH_MODE_IRQ; mode++)
+    {
+        for (range = ADXL345_RANGE_2G; range <= ADXL345_RANGE_16G; range++)
+        {
+            for (full_res = 0; full_res < 2; full_res++)
+            {
+                for (justify = 0; justify < 2; justify++)
+                {
+                    if (a_bench_row((bench_mode_t)mode, (adxl345_range_t)range, (adxl345_bool_t)full_res,
+                                    (adxl345_justify_t)justify, times, latency_ns, byte_ns) != 0)
+                    {
+                        (void)adxl345_deinit(&gs_handle);
+                        
+                        return 1;
+                    }
+                }
+            }
+        }
+    }
+    (void)adxl345_deinit(&gs_handle);
+    
+    return 0;
+}
+
+/**
+ * @brief     main function
+ * @param[in] argc arg numbers
+ * @param[in] **argv arg address
+ * @return    status code
+ *             - 0 success
+ * @note      none
+ */
+int main(uint8_t argc, char **argv)
+{
+    uint8_t res;
+
+    res = adxl345_bench(argc, argv);
+    if (res == 0)
+    {
+        /* run success */
+    }
+    else if (res == 1)
+    {
+        adxl345_interface_debug_print("adxl345: run failed.\n");
+    }
+    else if (res == 5)
+    {
+        adxl345_interface_debug_print("adxl345: param is invalid.\n");
+    }
+    else
+    {
+        adxl345_interface_debug_print("adxl345: unknown status code.\n");
+    }
+
+    return 0;
+}
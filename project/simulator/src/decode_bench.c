@@ -0,0 +1,782 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      decode_bench.c
+ * @brief     simulator decode benchmark source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_adxl345.h"
+#include <getopt.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+/**
+ * @brief decode bench definition
+ */
+#define DECODE_BLOCK              32          /**< samples of one full fifo drain */
+#define DECODE_REG_DEVID          0x00        /**< device id register */
+#define DECODE_REG_DATA_FORMAT    0x31        /**< data format register */
+#define DECODE_REG_DATAX0         0x32        /**< data x0 register */
+#define DECODE_REG_FIFO_CTL       0x38        /**< fifo control register */
+#define DECODE_REG_FIFO_STATUS    0x39        /**< fifo status register */
+
+/**
+ * @brief decode kernel definition
+ * @note  the kernel decodes len samples of 6 bytes with the data format register value,
+ *        it returns 0 on success like the driver
+ */
+typedef uint8_t (*decode_kernel_t)(const uint8_t *buf, uint16_t len, uint8_t format, int16_t (*raw)[3], float (*g)[3]);
+
+/**
+ * @brief decode candidate structure definition
+ */
+typedef struct decode_candidate_s
+{
+    const char *name;              /**< candidate name */
+    decode_kernel_t kernel;        /**< candidate kernel */
+} decode_candidate_t;
+
+static adxl345_handle_t gs_handle;                /**< adxl345 handle */
+static uint8_t gs_reg[64];                        /**< fake register file */
+static const uint8_t *gs_stream;                  /**< fake data registers */
+static const float gs_scale[4] = {0.0039f, 0.0078f, 0.0156f, 0.0312f};
+static const char *const gs_range_name[] = {"2g", "4g", "8g", "16g"};
+
+/**
+ * @brief      fake iic read
+ * @param[in]  addr iic device write address
+ * @param[in]  reg iic register address
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of the data buffer
+ * @return     status code
+ *             - 0 success
+ * @note       the data registers serve the synthetic stream, the fifo always holds a full block
+ */
+static uint8_t a_decode_iic_read(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    (void)addr;
+    if (reg == DECODE_REG_DATAX0)
+    {
+        memcpy(buf, gs_stream, len);
+        gs_stream += len;
+    }
+    else
+    {
+        memcpy(buf, &gs_reg[reg & 0x3F], len);
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     fake iic write
+ * @param[in] addr iic device write address
+ * @param[in] reg iic register address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ * @note      none
+ */
+static uint8_t a_decode_iic_write(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    (void)addr;
+    memcpy(&gs_reg[reg & 0x3F], buf, len);
+    
+    return 0;
+}
+
+/**
+ * @brief  fake spi read
+ * @return status code
+ *         - 1 read failed
+ * @note   the bench only uses the iic interface
+ */
+static uint8_t a_decode_spi_read(uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    (void)reg;
+    (void)buf;
+    (void)len;
+    
+    return 1;
+}
+
+/**
+ * @brief  fake bus init and deinit
+ * @return status code
+ *         - 0 success
+ * @note   none
+ */
+static uint8_t a_decode_none(void)
+{
+    return 0;
+}
+
+/**
+ * @brief     fake delay
+ * @param[in] ms time
+ * @note      none
+ */
+static void a_decode_delay_ms(uint32_t ms)
+{
+    (void)ms;
+}
+
+/**
+ * @brief     print format data
+ * @param[in] fmt format data
+ * @note      none
+ */
+static void a_decode_debug_print(const char *const fmt, ...)
+{
+    va_list args;
+    
+    va_start(args, fmt);
+    (void)vprintf(fmt, args);
+    va_end(args);
+}
+
+/**
+ * @brief     receive callback
+ * @param[in] type irq type
+ * @note      none
+ */
+static void a_decode_receive_callback(uint8_t type)
+{
+    (void)type;
+}
+
+/**
+ * @brief     get the significant bits of a data format
+ * @param[in] format data format register value
+ * @return    significant bits
+ * @note      10 bits, the full resolution adds one bit per range step
+ */
+static uint8_t a_decode_bits(uint8_t format)
+{
+    return (uint8_t)((((format >> 3) & 0x01) != 0) ? (10 + (format & 0x03)) : 10);
+}
+
+/**
+ * @brief     get the left justify shift of a data format
+ * @param[in] format data format register value
+ * @return    shift
+ * @note      the left justified value sits in the upper bits
+ */
+static uint8_t a_decode_shift(uint8_t format)
+{
+    return (uint8_t)((((format >> 2) & 0x01) != 0) ? (16 - a_decode_bits(format)) : 0);
+}
+
+/**
+ * @brief     get the g per lsb of a data format
+ * @param[in] format data format register value
+ * @return    scale
+ * @note      the full resolution keeps 3.9mg per lsb on every range
+ */
+static float a_decode_scale(uint8_t format)
+{
+    return (((format >> 3) & 0x01) != 0) ? gs_scale[0] : gs_scale[format & 0x03];
+}
+
+/**
+ * @brief      driver kernel in the bypass mode
+ * @param[in]  *buf pointer to a raw buffer
+ * @param[in]  len sample length
+ * @param[in]  format data format register value
+ * @param[out] *raw pointer to a raw data buffer
+ * @param[out] *g pointer to a converted data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       one adxl345_read per sample, the time includes the fake bus
+ */
+static uint8_t a_decode_driver_bypass(const uint8_t *buf, uint16_t len, uint8_t format, int16_t (*raw)[3], float (*g)[3])
+{
+    uint16_t i;
+    uint16_t n;
+    
+    gs_stream = buf;
+    gs_reg[DECODE_REG_DATA_FORMAT] = format;
+    gs_reg[DECODE_REG_FIFO_CTL] = 0x00;
+    for (i = 0; i < len; i++)
+    {
+        n = 1;
+        if (adxl345_read(&gs_handle, &raw[i], &g[i], &n) != 0)
+        {
+            return 1;
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief      driver kernel in the fifo mode
+ * @param[in]  *buf pointer to a raw buffer
+ * @param[in]  len sample length
+ * @param[in]  format data format register value
+ * @param[out] *raw pointer to a raw data buffer
+ * @param[out] *g pointer to a converted data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       one adxl345_read per block, the time includes the fake bus
+ */
+static uint8_t a_decode_driver_fifo(const uint8_t *buf, uint16_t len, uint8_t format, int16_t (*raw)[3], float (*g)[3])
+{
+    uint16_t n = len;
+    
+    gs_stream = buf;
+    gs_reg[DECODE_REG_DATA_FORMAT] = format;
+    gs_reg[DECODE_REG_FIFO_CTL] = 0x40;
+    gs_reg[DECODE_REG_FIFO_STATUS] = (uint8_t)len;
+    if ((adxl345_read(&gs_handle, raw, g, &n) != 0) || (n != len))
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief      shift kernel
+ * @param[in]  *buf pointer to a raw buffer
+ * @param[in]  len sample length
+ * @param[in]  format data format register value
+ * @param[out] *raw pointer to a raw data buffer
+ * @param[out] *g pointer to a converted data buffer
+ * @return     status code
+ *             - 0 success
+ * @note       the format is resolved once per block and the arithmetic shift of the signed word
+ *             sign extends the left justified value without a branch
+ */
+static uint8_t a_decode_shift_kernel(const uint8_t *buf, uint16_t len, uint8_t format, int16_t (*raw)[3], float (*g)[3])
+{
+    uint16_t i;
+    uint8_t j;
+    uint8_t shift = a_decode_shift(format);
+    float scale = a_decode_scale(format);
+    
+    for (i = 0; i < len; i++)
+    {
+        for (j = 0; j < 3; j++)
+        {
+            raw[i][j] = (int16_t)((int16_t)((buf[i * 6 + j * 2 + 1] << 8) | buf[i * 6 + j * 2]) >> shift);
+            g[i][j] = (float)raw[i][j] * scale;
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief      xor kernel
+ * @param[in]  *buf pointer to a raw buffer
+ * @param[in]  len sample length
+ * @param[in]  format data format register value
+ * @param[out] *raw pointer to a raw data buffer
+ * @param[out] *g pointer to a converted data buffer
+ * @return     status code
+ *             - 0 success
+ * @note       the value is masked and sign extended with an xor and a subtraction,
+ *             it doesn't rely on the implementation defined right shift of a negative value
+ */
+static uint8_t a_decode_xor_kernel(const uint8_t *buf, uint16_t len, uint8_t format, int16_t (*raw)[3], float (*g)[3])
+{
+    uint16_t i;
+    uint8_t j;
+    uint8_t shift = a_decode_shift(format);
+    uint16_t mask = (uint16_t)((1U << a_decode_bits(format)) - 1);
+    int32_t sign = (int32_t)(1U << (a_decode_bits(format) - 1));
+    float scale = a_decode_scale(format);
+    uint16_t u;
+    
+    for (i = 0; i < len; i++)
+    {
+        for (j = 0; j < 3; j++)
+        {
+            u = (uint16_t)(((buf[i * 6 + j * 2 + 1] << 8) | buf[i * 6 + j * 2]) >> shift) & mask;
+            raw[i][j] = (int16_t)((int32_t)(u ^ (uint16_t)sign) - sign);
+            g[i][j] = (float)raw[i][j] * scale;
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief decode candidate list
+ * @note  add a faster decoder here, it must pass the golden check before it replaces the driver path
+ */
+static const decode_candidate_t gs_candidate[] =
+{
+    {"driver-bypass", a_decode_driver_bypass},
+    {"driver-fifo", a_decode_driver_fifo},
+    {"shift", a_decode_shift_kernel},
+    {"xor", a_decode_xor_kernel},
+};
+
+/**
+ * @brief      generate the synthetic raw buffer of a data format
+ * @param[in]  format data format register value
+ * @param[out] *buf pointer to a raw buffer
+ * @param[out] *ref pointer to a golden value buffer
+ * @param[in]  n sample length
+ * @note       every code of the format comes first, then pseudo random codes,
+ *             the bytes are laid out like the chip with the unused left justified bits cleared
+ */
+static void a_decode_generate(uint8_t format, uint8_t *buf, int16_t (*ref)[3], uint32_t n)
+{
+    uint32_t i, k;
+    uint32_t seed = 0x12345678;
+    uint32_t code;
+    uint8_t bits = a_decode_bits(format);
+    uint8_t shift = a_decode_shift(format);
+    uint32_t mask = (1U << bits) - 1;
+    uint16_t word;
+    int32_t v;
+    
+    for (i = 0; i < n; i++)
+    {
+        for (k = 0; k < 3; k++)
+        {
+            if ((i * 3 + k) <= mask)
+            {
+                code = i * 3 + k;
+            }
+            else
+            {
+                seed = seed * 1664525U + 1013904223U;
+                code = (seed >> 8) & mask;
+            }
+            v = (int32_t)code - (int32_t)(1U << (bits - 1));
+            if (shift != 0)
+            {
+                word = (uint16_t)(((uint32_t)v & mask) << shift);
+            }
+            else
+            {
+                word = (uint16_t)(int16_t)v;
+            }
+            buf[i * 6 + k * 2 + 0] = (uint8_t)(word >> 0);
+            buf[i * 6 + k * 2 + 1] = (uint8_t)(word >> 8);
+            ref[i][k] = (int16_t)v;
+        }
+    }
+}
+
+/**
+ * @brief     get the ulp distance of two floats
+ * @param[in] a first float
+ * @param[in] b second float
+ * @return    ulp distance
+ * @note      none
+ */
+static uint32_t a_decode_ulp(float a, float b)
+{
+    int32_t ia, ib;
+    int64_t d;
+    
+    memcpy(&ia, &a, sizeof(int32_t));
+    memcpy(&ib, &b, sizeof(int32_t));
+    if (ia < 0)
+    {
+        ia = INT32_MIN - ia;
+    }
+    if (ib < 0)
+    {
+        ib = INT32_MIN - ib;
+    }
+    d = (int64_t)ia - (int64_t)ib;
+    
+    return (uint32_t)((d < 0) ? -d : d);
+}
+
+/**
+ * @brief  monotonic time
+ * @return time in ns
+ * @note   none
+ */
+static uint64_t a_decode_now(void)
+{
+    struct timespec ts;
+    
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief  cycle counter
+ * @return cycles, 0 if the cpu has no user readable counter
+ * @note   the x86 time stamp counter runs at the nominal clock
+ */
+static uint64_t a_decode_cycles(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return (uint64_t)__rdtsc();
+#else
+    return 0;
+#endif
+}
+
+/**
+ * @brief     run one candidate on one data format
+ * @param[in] *candidate pointer to a decode candidate
+ * @param[in] format data format register value
+ * @param[in] *buf pointer to a raw buffer
+ * @param[in] *ref pointer to a golden value buffer
+ * @param[in] *raw pointer to a raw data buffer
+ * @param[in] *g pointer to a converted data buffer
+ * @param[in] n sample length
+ * @param[in] times iteration times
+ * @param[in] ulp float tolerance in ulp
+ * @param[in] mhz cpu clock for the cycle estimate without a cycle counter
+ * @return    status code
+ *            - 0 success
+ *            - 1 check failed
+ * @note      the raw output must be bit exact and the float output within the ulp tolerance
+ */
+static uint8_t a_decode_row(const decode_candidate_t *candidate, uint8_t format, const uint8_t *buf, int16_t (*ref)[3],
+                            int16_t (*raw)[3], float (*g)[3], uint32_t n, uint32_t times, uint32_t ulp, uint32_t mhz)
+{
+    uint32_t i, t;
+    uint8_t k;
+    uint64_t start, cycle, ns, cyc;
+    uint32_t d, max_ulp = 0;
+    float scale = a_decode_scale(format);
+    double sample = (double)n * (double)times;
+    
+    memset(raw, 0, sizeof(int16_t) * 3 * n);
+    memset(g, 0, sizeof(float) * 3 * n);
+    start = a_decode_now();
+    cycle = a_decode_cycles();
+    for (t = 0; t < times; t++)
+    {
+        for (i = 0; i < n; i += DECODE_BLOCK)
+        {
+            if (candidate->kernel(&buf[i * 6], DECODE_BLOCK, format, &raw[i], &g[i]) != 0)
+            {
+                a_decode_debug_print("adxl345: decode %s read failed.\n", candidate->name);
+                
+                return 1;
+            }
+        }
+    }
+    cyc = a_decode_cycles() - cycle;
+    ns = a_decode_now() - start;
+    if (cycle == 0)
+    {
+        cyc = ns * mhz / 1000;
+    }
+    
+    /* golden check */
+    for (i = 0; i < n; i++)
+    {
+        for (k = 0; k < 3; k++)
+        {
+            if (raw[i][k] != ref[i][k])
+            {
+                a_decode_debug_print("adxl345: decode %s %s %s %s raw failed at sample %d axis %d, 0x%02X%02X gives %d, expected %d.\n",
+                                     candidate->name, gs_range_name[format & 0x03],
+                                     (((format >> 3) & 0x01) != 0) ? "full" : "10bit",
+                                     (((format >> 2) & 0x01) != 0) ? "left" : "right",
+                                     (int)i, (int)k, buf[i * 6 + k * 2 + 1], buf[i * 6 + k * 2],
+                                     raw[i][k], ref[i][k]);
+                
+                return 1;
+            }
+            d = a_decode_ulp(g[i][k], (float)ref[i][k] * scale);
+            max_ulp = (d > max_ulp) ? d : max_ulp;
+        }
+    }
+    a_decode_debug_print("%-13s %-4s %-5s %-6s %8.2f %8.2f %7d\n",
+                         candidate->name, gs_range_name[format & 0x03],
+                         (((format >> 3) & 0x01) != 0) ? "full" : "10bit",
+                         (((format >> 2) & 0x01) != 0) ? "left" : "right",
+                         (double)ns / sample, (double)cyc / sample, (int)max_ulp);
+    if (max_ulp > ulp)
+    {
+        a_decode_debug_print("adxl345: decode %s g failed with %d ulp.\n", candidate->name, (int)max_ulp);
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     adxl345 decode bench function
+ * @param[in] argc arg numbers
+ * @param[in] **argv arg address
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ *            - 5 param is invalid
+ * @note      none
+ */
+static uint8_t adxl345_decode_bench(uint8_t argc, char **argv)
+{
+    int c;
+    int longindex = 0;
+    const char short_options[] = "h";
+    const struct option long_options[] =
+    {
+        {"help", no_argument, NULL, 'h'},
+        {"mhz", required_argument, NULL, 1},
+        {"samples", required_argument, NULL, 2},
+        {"times", required_argument, NULL, 3},
+        {"ulp", required_argument, NULL, 4},
+        {NULL, 0, NULL, 0},
+    };
+    uint32_t mhz = 1500;
+    uint32_t n = 65536;
+    uint32_t times = 20;
+    uint32_t ulp = 1;
+    uint8_t help = 0;
+    uint8_t format, i;
+    uint8_t failed = 0;
+    uint8_t *buf;
+    int16_t (*ref)[3];
+    int16_t (*raw)[3];
+    float (*g)[3];
+    
+    /* init 0 */
+    optind = 0;
+    
+    /* parse */
+    do
+    {
+        /* parse the args */
+        c = getopt_long(argc, argv, short_options, long_options, &longindex);
+        
+        /* judge the result */
+        switch (c)
+        {
+            /* help */
+            case 'h' :
+            {
+                help = 1;
+                
+                break;
+            }
+            
+            /* cpu clock */
+            case 1 :
+            {
+                /* set the clock */
+                mhz = (uint32_t)atol(optarg);
+                
+                break;
+            }
+            
+            /* samples */
+            case 2 :
+            {
+                /* set the samples in whole blocks */
+                n = (uint32_t)atol(optarg);
+                n = (n + DECODE_BLOCK - 1) / DECODE_BLOCK * DECODE_BLOCK;
+                if (n == 0)
+                {
+                    return 5;
+                }
+                
+                break;
+            }
+            
+            /* running times */
+            case 3 :
+            {
+                /* set the times */
+                times = (uint32_t)atol(optarg);
+                if (times == 0)
+                {
+                    return 5;
+                }
+                
+                break;
+            }
+            
+            /* ulp */
+            case 4 :
+            {
+                /* set the tolerance */
+                ulp = (uint32_t)atol(optarg);
+                
+                break;
+            }
+            
+            /* the end */
+            case -1 :
+            {
+                break;
+            }
+            
+            /* others */
+            default :
+            {
+                return 5;
+            }
+        }
+    } while (c != -1);
+    
+    if (help != 0)
+    {
+        a_decode_debug_print("Usage:\n");
+        a_decode_debug_print("  adxl345_decode_bench [--samples=<num>] [--times=<num>] [--ulp=<num>] [--mhz=<num>]\n");
+        a_decode_debug_print("  adxl345_decode_bench (-h | --help)\n");
+        a_decode_debug_print("\n");
+        a_decode_debug_print("Options:\n");
+        a_decode_debug_print("  -h, --help                         Show the help.\n");
+        a_decode_debug_print("      --mhz=<num>                    Set the cpu clock for the cycle estimate\n");
+        a_decode_debug_print("                                     without a cycle counter.([default: 1500])\n");
+        a_decode_debug_print("      --samples=<num>                Set the samples of every data format.([default: 65536])\n");
+        a_decode_debug_print("      --times=<num>                  Set the iteration times of every row.([default: 20])\n");
+        a_decode_debug_print("      --ulp=<num>                    Set the float tolerance in ulp.([default: 1])\n");
+        
+        return 0;
+    }
+    
+    /* link the handle to the fake bus */
+    DRIVER_ADXL345_LINK_INIT(&gs_handle, adxl345_handle_t);
+    DRIVER_ADXL345_LINK_IIC_INIT(&gs_handle, a_decode_none);
+    DRIVER_ADXL345_LINK_IIC_DEINIT(&gs_handle, a_decode_none);
+    DRIVER_ADXL345_LINK_IIC_READ(&gs_handle, a_decode_iic_read);
+    DRIVER_ADXL345_LINK_IIC_WRITE(&gs_handle, a_decode_iic_write);
+    DRIVER_ADXL345_LINK_SPI_INIT(&gs_handle, a_decode_none);
+    DRIVER_ADXL345_LINK_SPI_DEINIT(&gs_handle, a_decode_none);
+    DRIVER_ADXL345_LINK_SPI_READ(&gs_handle, a_decode_spi_read);
+    DRIVER_ADXL345_LINK_SPI_WRITE(&gs_handle, a_decode_spi_read);
+    DRIVER_ADXL345_LINK_DELAY_MS(&gs_handle, a_decode_delay_ms);
+    DRIVER_ADXL345_LINK_DEBUG_PRINT(&gs_handle, a_decode_debug_print);
+    DRIVER_ADXL345_LINK_RECEIVE_CALLBACK(&gs_handle, a_decode_receive_callback);
+    gs_reg[DECODE_REG_DEVID] = 0xE5;
+    if (adxl345_set_interface(&gs_handle, ADXL345_INTERFACE_IIC) != 0)
+    {
+        return 1;
+    }
+    if (adxl345_set_addr_pin(&gs_handle, ADXL345_ADDRESS_ALT_0) != 0)
+    {
+        return 1;
+    }
+    if (adxl345_init(&gs_handle) != 0)
+    {
+        return 1;
+    }
+    
+    /* the buffers */
+    buf = (uint8_t *)malloc((size_t)n * 6);
+    ref = (int16_t (*)[3])malloc(sizeof(int16_t) * 3 * n);
+    raw = (int16_t (*)[3])malloc(sizeof(int16_t) * 3 * n);
+    g = (float (*)[3])malloc(sizeof(float) * 3 * n);
+    if ((buf == NULL) || (ref == NULL) || (raw == NULL) || (g == NULL))
+    {
+        free(buf);
+        free(ref);
+        free(raw);
+        free(g);
+        (void)adxl345_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* every data format against every candidate */
+    a_decode_debug_print("adxl345: decode %d samples, %d times, cycles from %s.\n", (int)n, (int)times,
+                         (a_decode_cycles() != 0) ? "tsc" : "--mhz");
+    a_decode_debug_print("kernel        rng  res   just     ns/smp  cyc/smp   g ulp\n");
+    for (format = 0; format < 16; format++)
+    {
+        a_decode_generate(format, buf, ref, n);
+        for (i = 0; i < sizeof(gs_candidate) / sizeof(gs_candidate[0]); i++)
+        {
+            if (a_decode_row(&gs_candidate[i], format, buf, ref, raw, g, n, times, ulp, mhz) != 0)
+            {
+                failed++;
+            }
+        }
+    }
+    free(buf);
+    free(ref);
+    free(raw);
+    free(g);
+    (void)adxl345_deinit(&gs_handle);
+    if (failed != 0)
+    {
+        a_decode_debug_print("adxl345: decode check failed in %d rows.\n", (int)failed);
+        
+        return 1;
+    }
+    a_decode_debug_print("adxl345: decode check passed.\n");
+    
+    return 0;
+}
+
+/**
+ * @brief     main function
+ * @param[in] argc arg numbers
+ * @param[in] **argv arg address
+ * @return    status code
+ *             - 0 success
+ *             - 1 run failed
+ * @note      the status is returned so a failed check stops a script
+ */
+int main(uint8_t argc, char **argv)
+{
+    uint8_t res;
+
+    res = adxl345_decode_bench(argc, argv);
+    if (res == 0)
+    {
+        /* run success */
+    }
+    else if (res == 1)
+    {
+        a_decode_debug_print("adxl345: run failed.\n");
+    }
+    else if (res == 5)
+    {
+        a_decode_debug_print("adxl345: param is invalid.\n");
+    }
+    else
+    {
+        a_decode_debug_print("adxl345: unknown status code.\n");
+    }
+
+    return (res == 0) ? 0 : 1;
+}
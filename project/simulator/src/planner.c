@@ -0,0 +1,767 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      planner.c
+ * @brief     simulator bus capacity planner source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_adxl345_interface.h"
+#include "adxl345_model.h"
+#include <getopt.h>
+#include <stdlib.h>
+
+/**
+ * @brief planner definition
+ */
+#define PLANNER_FIFO_DEPTH        32               /**< fifo entries */
+#define PLANNER_IIC_MAX_HZ        400000           /**< fastest iic clock of the chip */
+#define PLANNER_SPI_MAX_HZ        5000000          /**< fastest spi clock of the chip */
+#define PLANNER_IIC_BYTE_CLOCK    9                /**< 8 bits and the ack */
+#define PLANNER_SPI_BYTE_CLOCK    8                /**< 8 bits */
+
+/**
+ * @brief planner mode enumeration definition
+ */
+typedef enum
+{
+    PLANNER_MODE_BYPASS = 0x00,        /**< adxl345_read of one sample on the data ready interrupt */
+    PLANNER_MODE_FIFO   = 0x01,        /**< adxl345_read drains the fifo mode on the watermark interrupt */
+    PLANNER_MODE_STREAM = 0x02,        /**< adxl345_read drains the stream mode on the watermark interrupt */
+} planner_mode_t;
+
+/**
+ * @brief planner result structure definition
+ */
+typedef struct planner_result_s
+{
+    planner_mode_t mode;         /**< fifo mode */
+    uint8_t watermark;           /**< fifo watermark */
+    uint32_t clock_hz;           /**< bus clock */
+    double drain;                /**< samples per interrupt */
+    double irq_rate;             /**< interrupts per second */
+    double transfer;             /**< bus transactions per interrupt */
+    double byte;                 /**< bytes on the wire per interrupt */
+    double bus_us;               /**< bus time per interrupt */
+    double load;                 /**< bus occupancy */
+    double margin_us;            /**< time left before the fifo or the data registers overrun */
+    uint32_t lost;               /**< lost samples of the validation */
+    uint8_t feasible;            /**< feasible flag */
+} planner_result_t;
+
+uint8_t (*g_gpio_irq)(void) = NULL;               /**< gpio irq function address */
+extern adxl345_model_t g_adxl345_model[2];        /**< simulated chips */
+static adxl345_handle_t gs_handle;                /**< adxl345 handle */
+static int16_t gs_raw[32][3];                     /**< raw buffer */
+static float gs_g[32][3];                         /**< converted buffer */
+static uint8_t gs_error;                          /**< read error flag */
+static planner_mode_t gs_mode;                    /**< configured planner mode */
+static const char *const gs_mode_name[] = {"bypass", "fifo", "stream"};
+static const char *const gs_rate_name[] =
+{
+    "0.1", "0.2", "0.39", "0.78", "1.56", "3.13", "6.25", "12.5",
+    "25", "50", "100", "200", "400", "800", "1600", "3200",
+};
+
+/**
+ * @brief     planner receive callback
+ * @param[in] type irq type
+ * @note      the watermark drains the fifo like the fifo example, the data ready reads one sample
+ */
+static void a_planner_receive_callback(uint8_t type)
+{
+    uint16_t len;
+    
+    if ((type == ADXL345_INTERRUPT_WATERMARK) ||
+        ((type == ADXL345_INTERRUPT_DATA_READY) && (gs_mode == PLANNER_MODE_BYPASS)))
+    {
+        len = (type == ADXL345_INTERRUPT_WATERMARK) ? 32 : 1;
+        if (adxl345_read(&gs_handle, gs_raw, gs_g, &len) != 0)
+        {
+            gs_error = 1;
+        }
+    }
+}
+
+/**
+ * @brief     get the output data rate
+ * @param[in] rate chip rate
+ * @return    rate in Hz
+ * @note      none
+ */
+static double a_planner_hz(adxl345_rate_t rate)
+{
+    return 3200.0 / (double)(1U << (15 - (rate & 0x0F)));
+}
+
+/**
+ * @brief     configure the chip for one plan
+ * @param[in] mode planner mode
+ * @param[in] rate chip rate
+ * @param[in] watermark fifo watermark
+ * @return    status code
+ *            - 0 success
+ *            - 1 configure failed
+ * @note      the bypass mode is set first to empty the fifo
+ */
+static uint8_t a_planner_config(planner_mode_t mode, adxl345_rate_t rate, uint8_t watermark)
+{
+    uint8_t res = 0;
+    adxl345_bool_t fifo = (mode == PLANNER_MODE_BYPASS) ? ADXL345_BOOL_FALSE : ADXL345_BOOL_TRUE;
+    
+    gs_mode = mode;
+    res |= adxl345_set_measure(&gs_handle, ADXL345_BOOL_FALSE);
+    res |= adxl345_set_mode(&gs_handle, ADXL345_MODE_BYPASS);
+    res |= adxl345_set_rate(&gs_handle, rate);
+    res |= adxl345_set_watermark(&gs_handle, watermark);
+    res |= adxl345_set_interrupt_map(&gs_handle, ADXL345_INTERRUPT_WATERMARK, ADXL345_INTERRUPT_PIN1);
+    res |= adxl345_set_interrupt_map(&gs_handle, ADXL345_INTERRUPT_DATA_READY, ADXL345_INTERRUPT_PIN1);
+    res |= adxl345_set_interrupt(&gs_handle, ADXL345_INTERRUPT_WATERMARK, fifo);
+    res |= adxl345_set_interrupt(&gs_handle, ADXL345_INTERRUPT_DATA_READY,
+                                 (fifo == ADXL345_BOOL_TRUE) ? ADXL345_BOOL_FALSE : ADXL345_BOOL_TRUE);
+    if (mode == PLANNER_MODE_STREAM)
+    {
+        res |= adxl345_set_mode(&gs_handle, ADXL345_MODE_STREAM);
+    }
+    else if (mode == PLANNER_MODE_FIFO)
+    {
+        res |= adxl345_set_mode(&gs_handle, ADXL345_MODE_FIFO);
+    }
+    else
+    {
+        /* keep the bypass mode */
+    }
+    res |= adxl345_set_measure(&gs_handle, ADXL345_BOOL_TRUE);
+    
+    return (res != 0) ? 1 : 0;
+}
+
+/**
+ * @brief      measure the driver transactions of one interrupt
+ * @param[in]  mode planner mode
+ * @param[in]  watermark fifo watermark
+ * @param[in]  drain samples in the fifo when the interrupt is served
+ * @param[out] *transfer pointer to a transaction count buffer
+ * @param[out] *byte pointer to a byte count buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 measure failed
+ * @note       adxl345_irq_handler runs against the simulated chip, so the plan follows the driver
+ */
+static uint8_t a_planner_measure(planner_mode_t mode, uint8_t watermark, uint8_t drain,
+                                 double *transfer, double *byte)
+{
+    adxl345_model_t *model = &g_adxl345_model[0];
+    adxl345_stats_t stats;
+    uint8_t i;
+    
+    if (a_planner_config(mode, ADXL345_RATE_3200, watermark) != 0)
+    {
+        return 1;
+    }
+    for (i = 0; i < drain; i++)
+    {
+        adxl345_model_advance(model, model->next_sample_ns - model->time_ns);
+    }
+    adxl345_model_clear_bus(model);
+    (void)adxl345_reset_stats(&gs_handle);
+    gs_error = 0;
+    if ((adxl345_irq_handler(&gs_handle) != 0) || (gs_error != 0))
+    {
+        return 1;
+    }
+    (void)adxl345_get_stats(&gs_handle, &stats);
+    if (stats.sample != drain)
+    {
+        adxl345_interface_debug_print("adxl345: drained %d of %d samples.\n", (int)stats.sample, (int)drain);
+        
+        return 1;
+    }
+    *transfer = (double)model->bus_transfer;
+    *byte = (double)model->bus_byte;
+    
+    return 0;
+}
+
+/**
+ * @brief      predict one plan
+ * @param[in]  interface chip interface
+ * @param[in]  clock_hz bus clock
+ * @param[in]  rate chip rate
+ * @param[in]  mode planner mode
+ * @param[in]  watermark fifo watermark
+ * @param[in]  latency_ns fixed cost of one bus transaction
+ * @param[in]  irq_ns time from the interrupt edge to the handler
+ * @param[in]  load maximum bus occupancy
+ * @param[out] *result pointer to a planner result structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 predict failed
+ * @note       the handler drains the watermark and the samples of the interrupt latency,
+ *             the drain must end before the fifo, or the data registers in the bypass mode, overrun
+ */
+static uint8_t a_planner_predict(adxl345_interface_t interface, uint32_t clock_hz, adxl345_rate_t rate,
+                                 planner_mode_t mode, uint8_t watermark, uint32_t latency_ns, uint32_t irq_ns,
+                                 double load, planner_result_t *result)
+{
+    double hz = a_planner_hz(rate);
+    double byte_ns;
+    double drain;
+    double room;
+    
+    byte_ns = 1e9 * ((interface == ADXL345_INTERFACE_IIC) ? PLANNER_IIC_BYTE_CLOCK : PLANNER_SPI_BYTE_CLOCK) / (double)clock_hz;
+    if (mode == PLANNER_MODE_BYPASS)
+    {
+        drain = 1.0;
+        room = 1.0;
+    }
+    else
+    {
+        drain = (double)watermark + (double)(uint32_t)((double)irq_ns * hz / 1e9);
+        drain = (drain > PLANNER_FIFO_DEPTH) ? PLANNER_FIFO_DEPTH : drain;
+        room = (double)(PLANNER_FIFO_DEPTH + 1 - watermark);
+    }
+    memset(result, 0, sizeof(planner_result_t));
+    result->mode = mode;
+    result->watermark = watermark;
+    result->clock_hz = clock_hz;
+    result->drain = drain;
+    if (a_planner_measure(mode, watermark, (uint8_t)drain, &result->transfer, &result->byte) != 0)
+    {
+        return 1;
+    }
+    result->irq_rate = hz / drain;
+    result->bus_us = (result->transfer * (double)latency_ns + result->byte * byte_ns) / 1000.0;
+    result->load = result->bus_us * result->irq_rate / 1e6;
+    result->margin_us = room / hz * 1e6 - (double)irq_ns / 1000.0 - result->bus_us;
+    result->feasible = ((result->load <= load) && (result->margin_us > 0.0)) ? 1 : 0;
+    
+    return 0;
+}
+
+/**
+ * @brief      validate one plan on the simulated bus
+ * @param[in]  interface chip interface
+ * @param[in]  clock_hz bus clock
+ * @param[in]  rate chip rate
+ * @param[in]  mode planner mode
+ * @param[in]  watermark fifo watermark
+ * @param[in]  latency_ns fixed cost of one bus transaction
+ * @param[in]  irq_ns time from the interrupt edge to the handler
+ * @param[in]  seconds virtual run time
+ * @param[out] *result pointer to a planner result structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 validate failed
+ * @note       the virtual clock waits the interrupt latency before the handler and the bus time of the
+ *             handler after it, the samples made meanwhile stay in the fifo or overrun like on the chip
+ */
+static uint8_t a_planner_validate(adxl345_interface_t interface, uint32_t clock_hz, adxl345_rate_t rate,
+                                  planner_mode_t mode, uint8_t watermark, uint32_t latency_ns, uint32_t irq_ns,
+                                  uint32_t seconds, planner_result_t *result)
+{
+    adxl345_model_t *model = &g_adxl345_model[0];
+    adxl345_stats_t stats;
+    uint64_t start, end, bus_ns, produced;
+    uint32_t byte_ns;
+    uint32_t irq = 0;
+    double elapsed;
+    
+    byte_ns = (uint32_t)((1000000000ULL * ((interface == ADXL345_INTERFACE_IIC) ? PLANNER_IIC_BYTE_CLOCK : PLANNER_SPI_BYTE_CLOCK)) / clock_hz);
+    if (a_planner_config(mode, rate, watermark) != 0)
+    {
+        return 1;
+    }
+    adxl345_model_set_bus_timing(model, latency_ns, byte_ns);
+    adxl345_model_clear_bus(model);
+    (void)adxl345_reset_stats(&gs_handle);
+    gs_error = 0;
+    start = model->time_ns;
+    end = start + (uint64_t)seconds * 1000000000ULL;
+    while (model->time_ns < end)
+    {
+        /* wait for the next sample */
+        adxl345_model_advance(model, model->next_sample_ns - model->time_ns);
+        if (model->pin_level[0] != 0)
+        {
+            adxl345_model_advance(model, irq_ns);
+            bus_ns = model->bus_ns;
+            if ((adxl345_irq_handler(&gs_handle) != 0) || (gs_error != 0))
+            {
+                return 1;
+            }
+            adxl345_model_advance(model, model->bus_ns - bus_ns);
+            irq++;
+        }
+    }
+    (void)adxl345_get_stats(&gs_handle, &stats);
+    elapsed = (double)(model->time_ns - start) / 1e9;
+    produced = (uint64_t)(elapsed * a_planner_hz(rate));
+    memset(result, 0, sizeof(planner_result_t));
+    result->mode = mode;
+    result->watermark = watermark;
+    result->clock_hz = clock_hz;
+    if (irq != 0)
+    {
+        result->drain = (double)stats.sample / (double)irq;
+        result->transfer = (double)model->bus_transfer / (double)irq;
+        result->byte = (double)model->bus_byte / (double)irq;
+        result->bus_us = (double)model->bus_ns / 1000.0 / (double)irq;
+    }
+    result->irq_rate = (double)irq / elapsed;
+    result->load = (double)model->bus_ns / 1e9 / elapsed;
+    result->lost = (produced > stats.sample + model->fifo_count + 1) ?
+                   (uint32_t)(produced - stats.sample - model->fifo_count) : 0;
+    result->feasible = ((result->lost == 0) && (stats.overrun == 0)) ? 1 : 0;
+    
+    return 0;
+}
+
+/**
+ * @brief     print one plan
+ * @param[in] *name pointer to a row name
+ * @param[in] *result pointer to a planner result structure
+ * @param[in] sim simulated result flag
+ * @note      a predicted row ends with the overrun margin, a simulated row with the lost samples,
+ *            the load is in percent
+ */
+static void a_planner_print(const char *name, const planner_result_t *result, uint8_t sim)
+{
+    adxl345_interface_debug_print("%-8s %-6s %2d %7d %6.2f %8.1f %5.2f %6.1f %9.1f %6.1f %9.1f  %s\n",
+                                  name, gs_mode_name[result->mode], (int)result->watermark, (int)result->clock_hz,
+                                  result->drain, result->irq_rate, result->transfer, result->byte,
+                                  result->bus_us, result->load * 100.0,
+                                  (sim != 0) ? (double)result->lost : result->margin_us,
+                                  (result->feasible != 0) ? "ok" : "overrun");
+}
+
+/**
+ * @brief      find the cheapest feasible plan
+ * @param[in]  interface chip interface
+ * @param[in]  clock_hz bus clock
+ * @param[in]  rate chip rate
+ * @param[in]  mode requested planner mode
+ * @param[in]  latency_ns fixed cost of one bus transaction
+ * @param[in]  irq_ns time from the interrupt edge to the handler
+ * @param[in]  load maximum bus occupancy
+ * @param[out] *best pointer to a planner result structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 no feasible plan
+ * @note       the lowest bus occupancy wins, which is also the lowest interrupt rate,
+ *             the fifo keeps the requested fifo mode and the stream mode stands for the bypass mode
+ */
+static uint8_t a_planner_search(adxl345_interface_t interface, uint32_t clock_hz, adxl345_rate_t rate,
+                                planner_mode_t mode, uint32_t latency_ns, uint32_t irq_ns,
+                                double load, planner_result_t *best)
+{
+    planner_result_t result;
+    planner_mode_t fifo = (mode == PLANNER_MODE_FIFO) ? PLANNER_MODE_FIFO : PLANNER_MODE_STREAM;
+    uint8_t watermark;
+    uint8_t found = 0;
+    
+    for (watermark = 0; watermark < PLANNER_FIFO_DEPTH; watermark++)
+    {
+        if (a_planner_predict(interface, clock_hz, rate, (watermark == 0) ? PLANNER_MODE_BYPASS : fifo,
+                              (watermark == 0) ? 1 : watermark, latency_ns, irq_ns, load, &result) != 0)
+        {
+            return 1;
+        }
+        if ((result.feasible != 0) &&
+            ((found == 0) || (result.load < best->load) ||
+            ((result.load == best->load) && (result.margin_us > best->margin_us))))
+        {
+            memcpy(best, &result, sizeof(planner_result_t));
+            found = 1;
+        }
+    }
+    
+    return (found != 0) ? 0 : 1;
+}
+
+/**
+ * @brief     adxl345 planner function
+ * @param[in] argc arg numbers
+ * @param[in] **argv arg address
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ *            - 5 param is invalid
+ * @note      none
+ */
+static uint8_t adxl345_planner(uint8_t argc, char **argv)
+{
+    int c;
+    int longindex = 0;
+    const char short_options[] = "h";
+    const struct option long_options[] =
+    {
+        {"help", no_argument, NULL, 'h'},
+        {"clock", required_argument, NULL, 1},
+        {"interface", required_argument, NULL, 2},
+        {"irq", required_argument, NULL, 3},
+        {"latency", required_argument, NULL, 4},
+        {"load", required_argument, NULL, 5},
+        {"mode", required_argument, NULL, 6},
+        {"rate", required_argument, NULL, 7},
+        {"validate", required_argument, NULL, 8},
+        {"watermark", required_argument, NULL, 9},
+        {NULL, 0, NULL, 0},
+    };
+    adxl345_interface_t interface = ADXL345_INTERFACE_IIC;
+    adxl345_rate_t rate = ADXL345_RATE_3200;
+    planner_mode_t mode = PLANNER_MODE_STREAM;
+    planner_result_t request, best, sim;
+    uint32_t clock_hz = 0;
+    uint32_t max_hz;
+    uint32_t irq_ns = 100000;
+    uint32_t latency_ns = 0;
+    uint32_t load = 80;
+    uint32_t seconds = 0;
+    uint32_t watermark = 16;
+    uint8_t help = 0;
+    uint8_t found;
+    uint8_t i;
+    
+    /* init 0 */
+    optind = 0;
+    
+    /* parse */
+    do
+    {
+        /* parse the args */
+        c = getopt_long(argc, argv, short_options, long_options, &longindex);
+        
+        /* judge the result */
+        switch (c)
+        {
+            /* help */
+            case 'h' :
+            {
+                help = 1;
+                
+                break;
+            }
+            
+            /* bus clock */
+            case 1 :
+            {
+                /* set the clock */
+                clock_hz = (uint32_t)atol(optarg);
+                if (clock_hz == 0)
+                {
+                    return 5;
+                }
+                
+                break;
+            }
+            
+            /* interface */
+            case 2 :
+            {
+                /* set the interface */
+                if (strcmp("iic", optarg) == 0)
+                {
+                    interface = ADXL345_INTERFACE_IIC;
+                }
+                else if (strcmp("spi", optarg) == 0)
+                {
+                    interface = ADXL345_INTERFACE_SPI;
+                }
+                else
+                {
+                    return 5;
+                }
+                
+                break;
+            }
+            
+            /* interrupt latency */
+            case 3 :
+            {
+                /* set the latency */
+                irq_ns = (uint32_t)atol(optarg);
+                
+                break;
+            }
+            
+            /* transaction latency */
+            case 4 :
+            {
+                /* set the latency */
+                latency_ns = (uint32_t)atol(optarg);
+                
+                break;
+            }
+            
+            /* bus load */
+            case 5 :
+            {
+                /* set the load */
+                load = (uint32_t)atol(optarg);
+                if ((load == 0) || (load > 100))
+                {
+                    return 5;
+                }
+                
+                break;
+            }
+            
+            /* fifo mode */
+            case 6 :
+            {
+                /* set the mode */
+                for (i = 0; i < 3; i++)
+                {
+                    if (strcmp(gs_mode_name[i], optarg) == 0)
+                    {
+                        break;
+                    }
+                }
+                if (i == 3)
+                {
+                    return 5;
+                }
+                mode = (planner_mode_t)i;
+                
+                break;
+            }
+            
+            /* output data rate */
+            case 7 :
+            {
+                /* set the rate */
+                for (i = 0; i < 16; i++)
+                {
+                    if (strcmp(gs_rate_name[i], optarg) == 0)
+                    {
+                        break;
+                    }
+                }
+                if (i == 16)
+                {
+                    return 5;
+                }
+                rate = (adxl345_rate_t)i;
+                
+                break;
+            }
+            
+            /* validate */
+            case 8 :
+            {
+                /* set the virtual run time */
+                seconds = (uint32_t)atol(optarg);
+                
+                break;
+            }
+            
+            /* watermark */
+            case 9 :
+            {
+                /* set the watermark */
+                watermark = (uint32_t)atol(optarg);
+                if ((watermark == 0) || (watermark >= PLANNER_FIFO_DEPTH))
+                {
+                    return 5;
+                }
+                
+                break;
+            }
+            
+            /* the end */
+            case -1 :
+            {
+                break;
+            }
+            
+            /* others */
+            default :
+            {
+                return 5;
+            }
+        }
+    } while (c != -1);
+    
+    if (help != 0)
+    {
+        adxl345_interface_debug_print("Usage:\n");
+        adxl345_interface_debug_print("  adxl345_planner [--interface=<iic | spi>] [--clock=<hz>] [--rate=<hz>] [--mode=<bypass | fifo | stream>]\n");
+        adxl345_interface_debug_print("                  [--watermark=<num>] [--latency=<ns>] [--irq=<ns>] [--load=<percent>] [--validate=<seconds>]\n");
+        adxl345_interface_debug_print("  adxl345_planner (-h | --help)\n");
+        adxl345_interface_debug_print("\n");
+        adxl345_interface_debug_print("Options:\n");
+        adxl345_interface_debug_print("      --clock=<hz>                   Set the bus clock.([default: 400000 for iic, 5000000 for spi])\n");
+        adxl345_interface_debug_print("  -h, --help                         Show the help.\n");
+        adxl345_interface_debug_print("      --interface=<iic | spi>        Set the chip interface.([default: iic])\n");
+        adxl345_interface_debug_print("      --irq=<ns>                     Set the time from the interrupt edge to the handler.([default: 100000])\n");
+        adxl345_interface_debug_print("      --latency=<ns>                 Set the fixed cost of one bus transaction.([default: 0])\n");
+        adxl345_interface_debug_print("      --load=<percent>               Set the highest feasible bus occupancy.([default: 80])\n");
+        adxl345_interface_debug_print("      --mode=<bypass | fifo | stream>\n");
+        adxl345_interface_debug_print("                                     Set the fifo mode.([default: stream])\n");
+        adxl345_interface_debug_print("      --rate=<hz>                    Set the output data rate, 0.1, 0.2, 0.39, 0.78, 1.56, 3.13, 6.25, 12.5,\n");
+        adxl345_interface_debug_print("                                     25, 50, 100, 200, 400, 800, 1600 or 3200.([default: 3200])\n");
+        adxl345_interface_debug_print("      --validate=<seconds>           Run the plans on the simulated bus for the virtual seconds.([default: 0])\n");
+        adxl345_interface_debug_print("      --watermark=<num>              Set the fifo watermark from 1 to 31.([default: 16])\n");
+        
+        return 0;
+    }
+    
+    max_hz = (interface == ADXL345_INTERFACE_IIC) ? PLANNER_IIC_MAX_HZ : PLANNER_SPI_MAX_HZ;
+    clock_hz = (clock_hz == 0) ? max_hz : clock_hz;
+    watermark = (mode == PLANNER_MODE_BYPASS) ? 1 : watermark;
+    
+    /* power on the chips */
+    if (adxl345_interface_iic_init() != 0)
+    {
+        return 1;
+    }
+    
+    /* link the planner handle */
+    DRIVER_ADXL345_LINK_INIT(&gs_handle, adxl345_handle_t);
+    DRIVER_ADXL345_LINK_IIC_INIT(&gs_handle, adxl345_interface_iic_init);
+    DRIVER_ADXL345_LINK_IIC_DEINIT(&gs_handle, adxl345_interface_iic_deinit);
+    DRIVER_ADXL345_LINK_IIC_READ(&gs_handle, adxl345_interface_iic_read);
+    DRIVER_ADXL345_LINK_IIC_WRITE(&gs_handle, adxl345_interface_iic_write);
+    DRIVER_ADXL345_LINK_SPI_INIT(&gs_handle, adxl345_interface_spi_init);
+    DRIVER_ADXL345_LINK_SPI_DEINIT(&gs_handle, adxl345_interface_spi_deinit);
+    DRIVER_ADXL345_LINK_SPI_READ(&gs_handle, adxl345_interface_spi_read);
+    DRIVER_ADXL345_LINK_SPI_WRITE(&gs_handle, adxl345_interface_spi_write);
+    DRIVER_ADXL345_LINK_DELAY_MS(&gs_handle, adxl345_interface_delay_ms);
+    DRIVER_ADXL345_LINK_DEBUG_PRINT(&gs_handle, adxl345_interface_debug_print);
+    DRIVER_ADXL345_LINK_RECEIVE_CALLBACK(&gs_handle, a_planner_receive_callback);
+    if (adxl345_set_interface(&gs_handle, interface) != 0)
+    {
+        return 1;
+    }
+    if (adxl345_set_addr_pin(&gs_handle, ADXL345_ADDRESS_ALT_0) != 0)
+    {
+        return 1;
+    }
+    if (adxl345_init(&gs_handle) != 0)
+    {
+        return 1;
+    }
+    
+    /* the requested plan */
+    adxl345_interface_debug_print("adxl345: plan %s, %sHz, latency %dns, irq %dns, load limit %d percent.\n",
+                                  (interface == ADXL345_INTERFACE_IIC) ? "iic" : "spi", gs_rate_name[rate],
+                                  (int)latency_ns, (int)irq_ns, (int)load);
+    adxl345_interface_debug_print("plan     mode   wm   clock  drain    irq/s  xfer   byte    bus us   load margin/lost\n");
+    if (a_planner_predict(interface, clock_hz, rate, mode, (uint8_t)watermark, latency_ns, irq_ns,
+                          (double)load / 100.0, &request) != 0)
+    {
+        (void)adxl345_deinit(&gs_handle);
+        
+        return 1;
+    }
+    a_planner_print("request", &request, 0);
+    
+    /* the cheapest feasible plan, a faster bus clock only when the requested one can't keep up */
+    found = (a_planner_search(interface, clock_hz, rate, mode, latency_ns, irq_ns, (double)load / 100.0, &best) == 0) ? 1 : 0;
+    if ((found == 0) && (clock_hz < max_hz))
+    {
+        found = (a_planner_search(interface, max_hz, rate, mode, latency_ns, irq_ns, (double)load / 100.0, &best) == 0) ? 1 : 0;
+    }
+    if (found != 0)
+    {
+        a_planner_print("best", &best, 0);
+    }
+    else
+    {
+        adxl345_interface_debug_print("adxl345: no feasible plan up to %dHz.\n", (int)max_hz);
+    }
+    
+    /* run the plans on the simulated bus */
+    if (seconds != 0)
+    {
+        if (a_planner_validate(interface, clock_hz, rate, mode, (uint8_t)watermark, latency_ns, irq_ns, seconds, &sim) != 0)
+        {
+            (void)adxl345_deinit(&gs_handle);
+            
+            return 1;
+        }
+        a_planner_print("sim", &sim, 1);
+        adxl345_interface_debug_print("adxl345: request %s, simulated %s with %d lost samples.\n",
+                                      (request.feasible != 0) ? "ok" : "overrun",
+                                      (sim.feasible != 0) ? "ok" : "overrun", (int)sim.lost);
+        if (found != 0)
+        {
+            if (a_planner_validate(interface, best.clock_hz, rate, best.mode, best.watermark, latency_ns, irq_ns, seconds, &sim) != 0)
+            {
+                (void)adxl345_deinit(&gs_handle);
+                
+                return 1;
+            }
+            a_planner_print("sim best", &sim, 1);
+            if (sim.feasible == 0)
+            {
+                adxl345_interface_debug_print("adxl345: best plan failed with %d lost samples.\n", (int)sim.lost);
+            }
+        }
+    }
+    (void)adxl345_deinit(&gs_handle);
+    
+    return 0;
+}
+
+/**
+ * @brief     main function
+ * @param[in] argc arg numbers
+ * @param[in] **argv arg address
+ * @return    status code
+ *             - 0 success
+ * @note      none
+ */
+int main(uint8_t argc, char **argv)
+{
+    uint8_t res;
+
+    res = adxl345_planner(argc, argv);
+    if (res == 0)
+    {
+        /* run success */
+    }
+    else if (res == 1)
+    {
+        adxl345_interface_debug_print("adxl345: run failed.\n");
+    }
+    else if (res == 5)
+    {
+        adxl345_interface_debug_print("adxl345: param is invalid.\n");
+    }
+    else
+    {
+        adxl345_interface_debug_print("adxl345: unknown status code.\n");
+    }
+
+    return 0;
+}
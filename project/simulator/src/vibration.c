@@ -0,0 +1,2038 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      vibration.c
+ * @brief     simulator vibration analysis source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_adxl345_interface.h"
+#include "driver_adxl345_metrics.h"
+#include "driver_adxl345_fft.h"
+#include "driver_adxl345_goertzel.h"
+#include "driver_adxl345_biquad.h"
+#include "driver_adxl345_envelope.h"
+#include "driver_adxl345_velocity.h"
+#include "driver_adxl345_welford.h"
+#include "driver_adxl345_srs.h"
+#include "driver_adxl345_rainflow.h"
+#include "adxl345_model.h"
+#include <getopt.h>
+#include <math.h>
+#include <stdlib.h>
+#include <time.h>
+
+/**
+ * @brief vibration definition
+ */
+#define VIBRATION_RATE_HZ          3200.0        /**< output data rate */
+#define VIBRATION_WATERMARK        16            /**< fifo watermark */
+#define VIBRATION_TOLERANCE        1e-4          /**< largest difference to the reference in g */
+#define VIBRATION_FFT_TOLERANCE    1e-4          /**< largest fft difference to the dft relative to the peak */
+#define VIBRATION_POWER_TOLERANCE  0.05          /**< largest psd power difference to the variance */
+#define VIBRATION_NOTCH_TOLERANCE  0.05          /**< largest rms left by the notch relative to the input */
+#define VIBRATION_RATIO_TOLERANCE  1e-3          /**< largest crest factor and kurtosis difference relative to the reference */
+#define VIBRATION_SPEED_TOLERANCE  0.01          /**< largest velocity rms difference relative to the sine */
+#define VIBRATION_GRAVITY          9806.65       /**< standard gravity in mm/s2 */
+#define VIBRATION_MOMENT_TOLERANCE 1e-9          /**< largest mean and variance difference to the two pass reference */
+#define VIBRATION_SAMPLE_NS        312500        /**< virtual time of one sample in ns */
+#define VIBRATION_SPIKE_AMP        5.0           /**< injected spike relative to the amplitude */
+#define VIBRATION_HOLD_TOLERANCE   0.02          /**< noise and quantization allowed around a held sample in g */
+#define VIBRATION_SRS_Q            10.0          /**< quality factor of the srs oscillators */
+#define VIBRATION_SRS_TOLERANCE    0.05          /**< largest srs difference to the steady state resonance */
+#define VIBRATION_RAINFLOW_GATE    0.125         /**< rainflow hysteresis relative to the amplitude */
+#define VIBRATION_LSB              0.0039        /**< full resolution scale of the chip in g */
+
+/**
+ * @brief vibration stage enumeration definition
+ */
+typedef enum
+{
+    VIBRATION_STAGE_METRICS = 0x00,        /**< rms, peak, peak to peak and crest factor windows */
+    VIBRATION_STAGE_WELCH   = 0x01,        /**< fft and welch psd */
+    VIBRATION_STAGE_GOERTZEL = 0x02,       /**< goertzel bank of the tone and its harmonics */
+    VIBRATION_STAGE_BIQUAD   = 0x03,       /**< high pass, notch and low pass biquad cascade */
+    VIBRATION_STAGE_ENVELOPE = 0x04,       /**< envelope, crest factor and kurtosis of a high band */
+    VIBRATION_STAGE_VELOCITY = 0x05,       /**< velocity rms and severity zones */
+    VIBRATION_STAGE_WELFORD  = 0x06,       /**< running and merged mean, variance, min and max */
+    VIBRATION_STAGE_HAMPEL   = 0x07,       /**< spike rejection of the driver read */
+    VIBRATION_STAGE_SRS      = 0x08,       /**< shock response spectrum */
+    VIBRATION_STAGE_RAINFLOW = 0x09,       /**< rainflow cycle counting */
+} vibration_stage_t;
+
+uint8_t (*g_gpio_irq)(void) = NULL;               /**< gpio irq function address */
+extern adxl345_model_t g_adxl345_model[2];        /**< simulated chips */
+
+static adxl345_handle_t gs_handle;                /**< adxl345 handle */
+static int16_t gs_raw[32][3];                     /**< raw buffer */
+static float gs_g[32][3];                         /**< converted buffer */
+static uint8_t gs_error;                          /**< read error flag */
+static vibration_stage_t gs_stage;                /**< analysed stage */
+static double gs_tone_hz;                         /**< tone of the motion */
+static double gs_amp;                             /**< amplitude of the motion in g */
+static float (*gs_trace)[3];                      /**< every sample of the run */
+static uint32_t gs_trace_len;                     /**< samples in the trace */
+static uint32_t gs_trace_size;                    /**< trace capacity */
+static void *gs_buffer;                           /**< stage buffer */
+static adxl345_metrics_t gs_metrics;              /**< metrics stage */
+static adxl345_fft_t gs_fft;                      /**< fft of the welch stage */
+static adxl345_welch_t gs_welch;                  /**< welch stage */
+static adxl345_goertzel_t gs_goertzel;            /**< goertzel stage */
+static adxl345_biquad_t gs_biquad;                /**< biquad stage */
+static adxl345_envelope_t gs_envelope;            /**< envelope stage */
+static adxl345_envelope_result_t *gs_results;     /**< every block result */
+static adxl345_velocity_t gs_velocity;            /**< velocity stage */
+static adxl345_velocity_result_t *gs_velocity_results;        /**< every velocity block result */
+static adxl345_welford_t gs_welford;              /**< welford stage */
+static adxl345_srs_t gs_srs;                      /**< srs stage */
+static adxl345_rainflow_t gs_rainflow[2];         /**< rainflow stage of the axes and the magnitude */
+static uint32_t gs_spike_period;                  /**< samples between two injected spikes */
+static uint32_t gs_spike;                         /**< samples flagged by the spike filter */
+static uint32_t gs_window;                        /**< checked windows */
+static double gs_max_error;                       /**< largest difference to the reference */
+static adxl345_metrics_result_t gs_result;        /**< last window result */
+static const char *const gs_stage_name[] = {"metrics", "welch", "goertzel", "biquad", "envelope", "velocity", "welford", "hampel", "srs", "rainflow"};
+static const char *const gs_taper_name[] = {"rect", "hann", "hamming", "blackman"};
+static const char gs_axis_name[] = {'x', 'y', 'z'};
+
+/**
+ * @brief      vibration motion
+ * @param[in]  time_ns virtual time
+ * @param[out] *g pointer to an acceleration buffer
+ * @note       a sine of the tone on the x axis, a sine of twice the tone and half the amplitude on the y axis,
+ *             a square wave of the tone and a quarter of the amplitude on the z axis over the gravity
+ */
+static void a_vibration_motion(uint64_t time_ns, float g[3])
+{
+    double phase = 2.0 * M_PI * gs_tone_hz * (double)time_ns / 1e9;
+    
+    g[0] = (float)(gs_amp * sin(phase));
+    g[1] = (float)(0.5 * gs_amp * sin(2.0 * phase));
+    g[2] = (float)(1.0 + ((sin(phase) >= 0.0) ? 0.25 : -0.25) * gs_amp);
+    if (gs_stage == VIBRATION_STAGE_HAMPEL)
+    {
+        g[2] = 1.0f;
+        if (((time_ns / VIBRATION_SAMPLE_NS) % gs_spike_period) == 0)
+        {
+            g[0] += (float)(((g[0] >= 0.0f) ? VIBRATION_SPIKE_AMP : -VIBRATION_SPIKE_AMP) * gs_amp);
+        }
+    }
+}
+
+/**
+ * @brief     metrics window callback
+ * @param[in] *metrics pointer to an adxl345 metrics structure
+ * @param[in] *result pointer to an adxl345 metrics result structure
+ * @note      the window is computed again from the trace with two passes and compared with the streaming result
+ */
+static void a_vibration_metrics_callback(adxl345_metrics_t *metrics, const adxl345_metrics_result_t *result)
+{
+    uint32_t n = (uint32_t)metrics->hops * metrics->hop;
+    uint32_t end = ((uint32_t)metrics->hops + gs_window) * metrics->hop;
+    uint32_t i;
+    uint8_t j;
+    double mean, var, min, max, peak, error;
+    
+    for (j = 0; j < 3; j++)
+    {
+        mean = 0.0;
+        min = gs_trace[end - n][j];
+        max = min;
+        for (i = end - n; i < end; i++)
+        {
+            mean += gs_trace[i][j];
+            min = (gs_trace[i][j] < min) ? gs_trace[i][j] : min;
+            max = (gs_trace[i][j] > max) ? gs_trace[i][j] : max;
+        }
+        mean /= (double)n;
+        var = 0.0;
+        for (i = end - n; i < end; i++)
+        {
+            var += (gs_trace[i][j] - mean) * (gs_trace[i][j] - mean);
+        }
+        var /= (double)n;
+        peak = ((max - mean) > (mean - min)) ? (max - mean) : (mean - min);
+        error = fabs(result->mean[j] - mean);
+        error = fmax(error, fabs(result->rms[j] - sqrt(var)));
+        error = fmax(error, fabs(result->peak[j] - peak));
+        error = fmax(error, fabs(result->peak_to_peak[j] - (max - min)));
+        if (var > 0.0)
+        {
+            error = fmax(error, fabs(result->crest[j] - peak / sqrt(var)) * sqrt(var));
+        }
+        gs_max_error = fmax(gs_max_error, error);
+    }
+    gs_result = *result;
+    gs_window++;
+}
+
+/**
+ * @brief     goertzel block callback
+ * @param[in] *goertzel pointer to an adxl345 goertzel structure
+ * @param[in] **amplitude pointer to the amplitudes of the block
+ * @note      the amplitude of every tone is computed again from the trace with a double precision dtft
+ */
+static void a_vibration_goertzel_callback(adxl345_goertzel_t *goertzel, float (*amplitude)[3])
+{
+    uint32_t start = (goertzel->blocks - 1) * goertzel->block;
+    uint32_t i;
+    uint8_t k;
+    uint8_t j;
+    double w, re, im;
+    
+    for (k = 0; k < goertzel->tones; k++)
+    {
+        w = 2.0 * M_PI * goertzel->tone[k].hz / goertzel->rate_hz;
+        for (j = 0; j < 3; j++)
+        {
+            re = 0.0;
+            im = 0.0;
+            for (i = 0; i < goertzel->block; i++)
+            {
+                re += gs_trace[start + i][j] * cos(w * (double)i);
+                im -= gs_trace[start + i][j] * sin(w * (double)i);
+            }
+            gs_max_error = fmax(gs_max_error, fabs(amplitude[k][j] - 2.0 * sqrt(re * re + im * im) / (double)goertzel->block));
+        }
+    }
+    gs_window++;
+}
+
+/**
+ * @brief     envelope block callback
+ * @param[in] *envelope pointer to an adxl345 envelope structure
+ * @param[in] *result pointer to an adxl345 envelope result structure
+ * @note      the results are kept and checked after the run, the filters carry their state over the blocks
+ */
+static void a_vibration_envelope_callback(adxl345_envelope_t *envelope, const adxl345_envelope_result_t *result)
+{
+    gs_results[envelope->blocks - 1] = *result;
+    gs_window = envelope->blocks;
+}
+
+/**
+ * @brief     velocity block callback
+ * @param[in] *velocity pointer to an adxl345 velocity structure
+ * @param[in] *result pointer to an adxl345 velocity result structure
+ * @note      the results are kept and checked after the run
+ */
+static void a_vibration_velocity_callback(adxl345_velocity_t *velocity, const adxl345_velocity_result_t *result)
+{
+    gs_velocity_results[velocity->blocks - 1] = *result;
+    gs_window = velocity->blocks;
+}
+
+/**
+ * @brief     vibration receive callback
+ * @param[in] type irq type
+ * @note      the watermark drains the fifo like the fifo example and the samples feed the stage
+ */
+static void a_vibration_receive_callback(uint8_t type)
+{
+    uint16_t len;
+    
+    if (type == ADXL345_INTERRUPT_WATERMARK)
+    {
+        len = 32;
+        if (adxl345_read(&gs_handle, gs_raw, gs_g, &len) != 0)
+        {
+            gs_error = 1;
+            
+            return;
+        }
+        if (gs_trace_len + len > gs_trace_size)
+        {
+            len = (uint16_t)(gs_trace_size - gs_trace_len);
+        }
+        memcpy(gs_trace[gs_trace_len], gs_g, sizeof(float) * 3 * len);
+        gs_trace_len += len;
+        switch (gs_stage)
+        {
+            case VIBRATION_STAGE_METRICS :
+            {
+                (void)adxl345_metrics_update(&gs_metrics, gs_g, len);
+                
+                break;
+            }
+            case VIBRATION_STAGE_WELCH :
+            {
+                (void)adxl345_welch_update(&gs_welch, gs_g, len);
+                
+                break;
+            }
+            case VIBRATION_STAGE_GOERTZEL :
+            {
+                (void)adxl345_goertzel_update(&gs_goertzel, gs_g, len);
+                
+                break;
+            }
+            case VIBRATION_STAGE_BIQUAD :
+            {
+                (void)adxl345_biquad_process(&gs_biquad, gs_g, len);
+                memcpy((float (*)[3])gs_buffer + (gs_trace_len - len), gs_g, sizeof(float) * 3 * len);
+                
+                break;
+            }
+            case VIBRATION_STAGE_ENVELOPE :
+            {
+                (void)adxl345_envelope_update(&gs_envelope, gs_g, len);
+                memcpy((float (*)[3])gs_buffer + (gs_trace_len - len), gs_g, sizeof(float) * 3 * len);
+                
+                break;
+            }
+            case VIBRATION_STAGE_VELOCITY :
+            {
+                (void)adxl345_velocity_update(&gs_velocity, gs_g, len);
+                memcpy((float (*)[3])gs_buffer + (gs_trace_len - len), gs_g, sizeof(float) * 3 * len);
+                
+                break;
+            }
+            case VIBRATION_STAGE_WELFORD :
+            {
+                (void)adxl345_welford_update(&gs_welford, gs_g, len);
+                
+                break;
+            }
+            case VIBRATION_STAGE_SRS :
+            {
+                (void)adxl345_srs_update(&gs_srs, gs_g, len);
+                
+                break;
+            }
+            case VIBRATION_STAGE_RAINFLOW :
+            {
+                (void)adxl345_rainflow_update(&gs_rainflow[0], gs_g, len);
+                (void)adxl345_rainflow_update(&gs_rainflow[1], gs_g, len);
+                
+                break;
+            }
+            case VIBRATION_STAGE_HAMPEL :
+            {
+                uint32_t mask;
+                uint16_t i;
+                
+                (void)adxl345_get_spike(&gs_handle, &mask);
+                for (i = 0; i < len; i++)
+                {
+                    ((uint8_t *)gs_buffer)[gs_trace_len - len + i] = (uint8_t)((mask >> i) & 0x01);
+                    gs_spike += (mask >> i) & 0x01;
+                }
+                
+                break;
+            }
+            default :
+            {
+                break;
+            }
+        }
+    }
+}
+
+/**
+ * @brief     run the chip in the stream mode
+ * @param[in] seconds virtual run time
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      the watermark interrupt is served as soon as the pin rises
+ */
+static uint8_t a_vibration_run(uint32_t seconds)
+{
+    adxl345_model_t *model = &g_adxl345_model[0];
+    uint64_t end;
+    uint8_t res = 0;
+    
+    res |= adxl345_set_measure(&gs_handle, ADXL345_BOOL_FALSE);
+    res |= adxl345_set_mode(&gs_handle, ADXL345_MODE_BYPASS);
+    res |= adxl345_set_rate(&gs_handle, ADXL345_RATE_3200);
+    res |= adxl345_set_range(&gs_handle, ADXL345_RANGE_16G);
+    res |= adxl345_set_full_resolution(&gs_handle, ADXL345_BOOL_TRUE);
+    res |= adxl345_set_justify(&gs_handle, ADXL345_JUSTIFY_RIGHT);
+    res |= adxl345_set_watermark(&gs_handle, VIBRATION_WATERMARK);
+    res |= adxl345_set_interrupt_map(&gs_handle, ADXL345_INTERRUPT_WATERMARK, ADXL345_INTERRUPT_PIN1);
+    res |= adxl345_set_interrupt(&gs_handle, ADXL345_INTERRUPT_WATERMARK, ADXL345_BOOL_TRUE);
+    res |= adxl345_set_mode(&gs_handle, ADXL345_MODE_STREAM);
+    res |= adxl345_set_measure(&gs_handle, ADXL345_BOOL_TRUE);
+    if (res != 0)
+    {
+        return 1;
+    }
+    gs_error = 0;
+    end = model->time_ns + (uint64_t)seconds * 1000000000ULL;
+    while ((model->time_ns < end) && (gs_trace_len < gs_trace_size))
+    {
+        /* wait for the next sample */
+        adxl345_model_advance(model, model->next_sample_ns - model->time_ns);
+        if (model->pin_level[0] != 0)
+        {
+            if ((adxl345_irq_handler(&gs_handle) != 0) || (gs_error != 0))
+            {
+                return 1;
+            }
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     init the stage
+ * @param[in] window window in samples
+ * @param[in] hop hop in samples
+ * @param[in] taper welch window
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      the stage modules don't allocate, the buffers are allocated here and freed by the caller
+ */
+static uint8_t a_vibration_stage_init(uint32_t window, uint32_t hop, adxl345_welch_window_t taper)
+{
+    gs_window = 0;
+    gs_max_error = 0.0;
+    if (gs_stage == VIBRATION_STAGE_METRICS)
+    {
+        gs_buffer = malloc(sizeof(adxl345_metrics_entry_t) * (window / hop));
+        if (gs_buffer == NULL)
+        {
+            return 1;
+        }
+        
+        return adxl345_metrics_init(&gs_metrics, (adxl345_metrics_entry_t *)gs_buffer, (uint16_t)(window / hop),
+                                    hop, a_vibration_metrics_callback);
+    }
+    else if (gs_stage == VIBRATION_STAGE_GOERTZEL)
+    {
+        const double harmonic[4] = {1.0, 1.5, 2.0, 3.0};
+        uint8_t i;
+        
+        if (adxl345_goertzel_init(&gs_goertzel, ADXL345_RATE_3200, window, a_vibration_goertzel_callback) != 0)
+        {
+            return 1;
+        }
+        for (i = 0; i < 4; i++)
+        {
+            if (harmonic[i] * gs_tone_hz < VIBRATION_RATE_HZ / 2.0)
+            {
+                (void)adxl345_goertzel_add_tone(&gs_goertzel, (float)(harmonic[i] * gs_tone_hz));
+            }
+        }
+        
+        return 0;
+    }
+    else if (gs_stage == VIBRATION_STAGE_BIQUAD)
+    {
+        uint8_t res = 0;
+        
+        gs_buffer = malloc(sizeof(float) * 3 * gs_trace_size);
+        if (gs_buffer == NULL)
+        {
+            return 1;
+        }
+        if (adxl345_biquad_init(&gs_biquad, ADXL345_RATE_3200) != 0)
+        {
+            return 1;
+        }
+        res |= adxl345_biquad_add_section(&gs_biquad, ADXL345_BIQUAD_TYPE_HIGH_PASS, 10.0f, 0.7071f);
+        res |= adxl345_biquad_add_section(&gs_biquad, ADXL345_BIQUAD_TYPE_NOTCH, (float)gs_tone_hz, 5.0f);
+        if (4.0 * gs_tone_hz < VIBRATION_RATE_HZ / 2.0)
+        {
+            res |= adxl345_biquad_add_section(&gs_biquad, ADXL345_BIQUAD_TYPE_LOW_PASS, (float)(4.0 * gs_tone_hz), 0.7071f);
+        }
+        
+        return (res != 0) ? 1 : 0;
+    }
+    else if (gs_stage == VIBRATION_STAGE_ENVELOPE)
+    {
+        gs_buffer = malloc(sizeof(float) * 3 * gs_trace_size +
+                           sizeof(adxl345_envelope_result_t) * (gs_trace_size / window));
+        if (gs_buffer == NULL)
+        {
+            return 1;
+        }
+        gs_results = (adxl345_envelope_result_t *)((float (*)[3])gs_buffer + gs_trace_size);
+        
+        return adxl345_envelope_init(&gs_envelope, ADXL345_RATE_3200, (float)(5.0 * gs_tone_hz),
+                                     (float)(2.5 * gs_tone_hz), window, a_vibration_envelope_callback);
+    }
+    else if (gs_stage == VIBRATION_STAGE_VELOCITY)
+    {
+        gs_buffer = malloc(sizeof(float) * 3 * gs_trace_size +
+                           sizeof(adxl345_velocity_result_t) * (gs_trace_size / window));
+        if (gs_buffer == NULL)
+        {
+            return 1;
+        }
+        gs_velocity_results = (adxl345_velocity_result_t *)((float (*)[3])gs_buffer + gs_trace_size);
+        if (adxl345_velocity_init(&gs_velocity, ADXL345_RATE_3200, 10.0f, 1000.0f, window,
+                                  a_vibration_velocity_callback) != 0)
+        {
+            return 1;
+        }
+        
+        return adxl345_velocity_set_zone(&gs_velocity, 1.4f, 2.8f, 4.5f);
+    }
+    else if (gs_stage == VIBRATION_STAGE_WELFORD)
+    {
+        return adxl345_welford_clear(&gs_welford);
+    }
+    else if (gs_stage == VIBRATION_STAGE_SRS)
+    {
+        if (adxl345_srs_init(&gs_srs, ADXL345_RATE_3200, (float)VIBRATION_SRS_Q) != 0)
+        {
+            return 1;
+        }
+        
+        return adxl345_srs_set_grid(&gs_srs, 10.0f, 1000.0f, (uint16_t)window);
+    }
+    else if (gs_stage == VIBRATION_STAGE_RAINFLOW)
+    {
+        uint8_t res = 0;
+        
+        gs_buffer = malloc(sizeof(float) * 2 * (gs_trace_size + 1));
+        if (gs_buffer == NULL)
+        {
+            return 1;
+        }
+        res |= adxl345_rainflow_init(&gs_rainflow[0], ADXL345_RAINFLOW_SOURCE_AXES, (float)(VIBRATION_RAINFLOW_GATE * gs_amp));
+        res |= adxl345_rainflow_init(&gs_rainflow[1], ADXL345_RAINFLOW_SOURCE_MAGNITUDE, (float)(VIBRATION_RAINFLOW_GATE * gs_amp));
+        res |= adxl345_rainflow_set_bins(&gs_rainflow[0], (float)(2.5 * gs_amp), -1.6f, 2.4f);
+        res |= adxl345_rainflow_set_bins(&gs_rainflow[1], (float)(2.5 * gs_amp), -1.6f, 2.4f);
+        
+        return (res != 0) ? 1 : 0;
+    }
+    else if (gs_stage == VIBRATION_STAGE_HAMPEL)
+    {
+        gs_buffer = calloc(gs_trace_size, sizeof(uint8_t));
+        if (gs_buffer == NULL)
+        {
+            return 1;
+        }
+        gs_spike = 0;
+        
+        return adxl345_set_spike_filter(&gs_handle, (uint8_t)window, 3.0f);
+    }
+    else
+    {
+        gs_buffer = malloc(sizeof(float) * (ADXL345_FFT_BUFFER_SIZE(window) + ADXL345_WELCH_BUFFER_SIZE(window)));
+        if (gs_buffer == NULL)
+        {
+            return 1;
+        }
+        if (adxl345_fft_init(&gs_fft, (uint16_t)window, (float *)gs_buffer) != 0)
+        {
+            return 1;
+        }
+        
+        return adxl345_welch_init(&gs_welch, &gs_fft, taper, (uint16_t)(window - hop), (float)VIBRATION_RATE_HZ,
+                                  (float *)gs_buffer + ADXL345_FFT_BUFFER_SIZE(window));
+    }
+}
+
+/**
+ * @brief     check the metrics stage
+ * @param[in] window window in samples
+ * @param[in] hop hop in samples
+ * @return    status code
+ *            - 0 success
+ *            - 1 check failed
+ * @note      the expected values come from the motion without the noise and the quantization of the chip
+ */
+static uint8_t a_vibration_metrics_check(uint32_t window, uint32_t hop)
+{
+    const double rms[3] = {gs_amp / sqrt(2.0), 0.5 * gs_amp / sqrt(2.0), 0.25 * gs_amp};
+    const double crest[3] = {sqrt(2.0), sqrt(2.0), 1.0};
+    uint8_t i;
+    
+    adxl345_interface_debug_print("adxl345: metrics window %d samples, hop %d samples, %d windows.\n",
+                                  (int)window, (int)hop, (int)gs_window);
+    if (gs_window == 0)
+    {
+        return 1;
+    }
+    adxl345_interface_debug_print("axis     mean      rms     peak      p2p   crest  expect rms crest\n");
+    for (i = 0; i < 3; i++)
+    {
+        adxl345_interface_debug_print("%c    %8.4f %8.4f %8.4f %8.4f %7.3f    %8.4f %5.3f\n",
+                                      gs_axis_name[i], gs_result.mean[i], gs_result.rms[i], gs_result.peak[i],
+                                      gs_result.peak_to_peak[i], gs_result.crest[i], rms[i], crest[i]);
+    }
+    adxl345_interface_debug_print("adxl345: metrics largest error %.6fg.\n", gs_max_error);
+    
+    return (gs_max_error > VIBRATION_TOLERANCE) ? 1 : 0;
+}
+
+/**
+ * @brief     check the welch stage
+ * @param[in] window fft size
+ * @param[in] hop hop in samples
+ * @param[in] taper welch window
+ * @return    status code
+ *            - 0 success
+ *            - 1 check failed
+ * @note      the fft of the first segment is compared with a double precision dft, the psd power of every axis
+ *            with the variance of the averaged samples and the psd peak of the x axis with the tone
+ */
+static uint8_t a_vibration_welch_check(uint32_t window, uint32_t hop, adxl345_welch_window_t taper)
+{
+    const double rms[3] = {gs_amp / sqrt(2.0), 0.5 * gs_amp / sqrt(2.0), 0.25 * gs_amp};
+    uint32_t bins = window / 2 + 1;
+    uint32_t used, segments, i, k, peak;
+    float *in, *re, *im, *psd;
+    double dr, di, scale, error, mean, var, power, df;
+    uint8_t axis;
+    uint8_t res = 0;
+    
+    in = (float *)malloc(sizeof(float) * (window + 3 * bins));
+    if (in == NULL)
+    {
+        return 1;
+    }
+    re = &in[window];
+    im = &re[bins];
+    psd = &im[bins];
+    
+    /* fft against the dft */
+    for (i = 0; i < window; i++)
+    {
+        in[i] = gs_trace[i][0];
+    }
+    (void)adxl345_fft_forward(&gs_fft, in, re, im);
+    scale = 0.0;
+    error = 0.0;
+    for (k = 0; k < bins; k++)
+    {
+        dr = 0.0;
+        di = 0.0;
+        for (i = 0; i < window; i++)
+        {
+            dr += in[i] * cos(2.0 * M_PI * (double)((k * i) % window) / (double)window);
+            di -= in[i] * sin(2.0 * M_PI * (double)((k * i) % window) / (double)window);
+        }
+        scale = fmax(scale, sqrt(dr * dr + di * di));
+        error = fmax(error, sqrt((re[k] - dr) * (re[k] - dr) + (im[k] - di) * (im[k] - di)));
+    }
+    error /= scale;
+    adxl345_interface_debug_print("adxl345: welch %d point fft, %s window, hop %d samples, fft error %.2e of the peak.\n",
+                                  (int)window, gs_taper_name[taper], (int)hop, error);
+    res |= (error > VIBRATION_FFT_TOLERANCE) ? 1 : 0;
+    
+    /* psd against the variance */
+    df = VIBRATION_RATE_HZ / (double)window;
+    adxl345_interface_debug_print("axis  peak hz      peak g2/hz   psd rms  sample rms  expect rms\n");
+    for (axis = 0; axis < 3; axis++)
+    {
+        if (adxl345_welch_get(&gs_welch, axis, psd, &segments) != 0)
+        {
+            free(in);
+            
+            return 1;
+        }
+        used = (segments - 1) * hop + window;
+        mean = 0.0;
+        for (i = 0; i < used; i++)
+        {
+            mean += gs_trace[i][axis];
+        }
+        mean /= (double)used;
+        var = 0.0;
+        for (i = 0; i < used; i++)
+        {
+            var += (gs_trace[i][axis] - mean) * (gs_trace[i][axis] - mean);
+        }
+        var /= (double)used;
+        power = 0.0;
+        peak = 1;
+        for (k = 0; k < bins; k++)
+        {
+            power += psd[k] * df;
+            if ((k != 0) && (psd[k] > psd[peak]))
+            {
+                peak = k;
+            }
+        }
+        adxl345_interface_debug_print("%c    %8.2f  %14.6e  %8.4f    %8.4f    %8.4f\n", gs_axis_name[axis],
+                                      (double)peak * df, psd[peak], sqrt(power), sqrt(var), rms[axis]);
+        res |= (fabs(power - var) > VIBRATION_POWER_TOLERANCE * var) ? 1 : 0;
+        if (axis == 0)
+        {
+            res |= (fabs((double)peak * df - gs_tone_hz) > df) ? 1 : 0;
+        }
+    }
+    gs_window = segments;
+    adxl345_interface_debug_print("adxl345: welch %d segments averaged.\n", (int)segments);
+    free(in);
+    
+    return res;
+}
+
+/**
+ * @brief     check the goertzel stage
+ * @param[in] window block in samples
+ * @return    status code
+ *            - 0 success
+ *            - 1 check failed
+ * @note      the tones are the tone, 1.5, 2 and 3 times the tone, the square wave of the z axis has
+ *            4 / pi and 4 / 3pi of its amplitude at the tone and its third harmonic
+ */
+static uint8_t a_vibration_goertzel_check(uint32_t window)
+{
+    float amplitude[ADXL345_GOERTZEL_MAX_TONE][3];
+    double expect[3];
+    double hz;
+    uint8_t tones;
+    uint8_t k;
+    
+    adxl345_interface_debug_print("adxl345: goertzel block %d samples, %.2fHz resolution, %d blocks.\n",
+                                  (int)window, VIBRATION_RATE_HZ / (double)window, (int)gs_window);
+    if (adxl345_goertzel_get(&gs_goertzel, amplitude, &tones) != 0)
+    {
+        return 1;
+    }
+    adxl345_interface_debug_print("tone hz        x        y        z    expect x        y        z\n");
+    for (k = 0; k < tones; k++)
+    {
+        hz = gs_goertzel.tone[k].hz;
+        expect[0] = (fabs(hz - gs_tone_hz) < 1e-3) ? gs_amp : 0.0;
+        expect[1] = (fabs(hz - 2.0 * gs_tone_hz) < 1e-3) ? 0.5 * gs_amp : 0.0;
+        expect[2] = (fabs(hz - gs_tone_hz) < 1e-3) ? gs_amp / M_PI :
+                    ((fabs(hz - 3.0 * gs_tone_hz) < 1e-3) ? gs_amp / (3.0 * M_PI) : 0.0);
+        adxl345_interface_debug_print("%7.2f  %8.4f %8.4f %8.4f    %8.4f %8.4f %8.4f\n", hz,
+                                      amplitude[k][0], amplitude[k][1], amplitude[k][2],
+                                      expect[0], expect[1], expect[2]);
+    }
+    adxl345_interface_debug_print("adxl345: goertzel largest error %.6fg.\n", gs_max_error);
+    
+    return (gs_max_error > VIBRATION_TOLERANCE) ? 1 : 0;
+}
+
+/**
+ * @brief  get the time
+ * @return time in ns
+ * @note   none
+ */
+static uint64_t a_vibration_now(void)
+{
+    struct timespec ts;
+    
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief         run a cascade in double precision
+ * @param[in]     *biquad pointer to an adxl345 biquad structure
+ * @param[in,out] *z1 pointer to the first state of every section
+ * @param[in,out] *z2 pointer to the second state of every section
+ * @param[in]     x input sample
+ * @return        output sample
+ * @note          the coefficients of the current rate are used as they are
+ */
+static double a_vibration_cascade(const adxl345_biquad_t *biquad, double *z1, double *z2, double x)
+{
+    const adxl345_biquad_coeff_t *coeff;
+    double y;
+    uint8_t k;
+    
+    for (k = 0; k < biquad->sections; k++)
+    {
+        coeff = &biquad->cache[biquad->rate][k];
+        y = coeff->b0 * x + z1[k];
+        z1[k] = coeff->b1 * x - coeff->a1 * y + z2[k];
+        z2[k] = coeff->b2 * x - coeff->a2 * y;
+        x = y;
+    }
+    
+    return x;
+}
+
+/**
+ * @brief  check the biquad stage
+ * @return status code
+ *         - 0 success
+ *         - 1 check failed
+ * @note   the streamed output is compared with a double precision filter of every axis with the same
+ *         coefficients, the notch must remove the tone of the x axis after the first half second and
+ *         the whole trace is filtered again in blocks of 1024 samples to time the cascade
+ */
+static uint8_t a_vibration_biquad_check(void)
+{
+    const double gravity[3] = {0.0, 0.0, 1.0};
+    float (*out)[3] = (float (*)[3])gs_buffer;
+    float (*copy)[3];
+    double z1[ADXL345_BIQUAD_MAX_SECTION];
+    double z2[ADXL345_BIQUAD_MAX_SECTION];
+    double rms_in[3];
+    double rms_out[3];
+    double x;
+    uint64_t start, ns;
+    uint32_t settle = (uint32_t)(VIBRATION_RATE_HZ / 2.0);
+    uint32_t i, n;
+    uint8_t j;
+    uint8_t res = 0;
+    
+    if (gs_trace_len <= settle)
+    {
+        return 1;
+    }
+    for (j = 0; j < 3; j++)
+    {
+        memset(z1, 0, sizeof(z1));
+        memset(z2, 0, sizeof(z2));
+        rms_in[j] = 0.0;
+        rms_out[j] = 0.0;
+        for (i = 0; i < gs_trace_len; i++)
+        {
+            x = a_vibration_cascade(&gs_biquad, z1, z2, gs_trace[i][j]);
+            gs_max_error = fmax(gs_max_error, fabs(out[i][j] - x));
+            if (i >= settle)
+            {
+                rms_in[j] += (gs_trace[i][j] - gravity[j]) * (gs_trace[i][j] - gravity[j]);
+                rms_out[j] += out[i][j] * out[i][j];
+            }
+        }
+        rms_in[j] = sqrt(rms_in[j] / (double)(gs_trace_len - settle));
+        rms_out[j] = sqrt(rms_out[j] / (double)(gs_trace_len - settle));
+    }
+    adxl345_interface_debug_print("adxl345: biquad %d sections, %d samples.\n", (int)gs_biquad.sections, (int)gs_trace_len);
+    adxl345_interface_debug_print("axis   rms in  rms out\n");
+    for (j = 0; j < 3; j++)
+    {
+        adxl345_interface_debug_print("%c    %8.4f %8.4f\n", gs_axis_name[j], rms_in[j], rms_out[j]);
+    }
+    res |= (rms_out[0] > VIBRATION_NOTCH_TOLERANCE * rms_in[0]) ? 1 : 0;
+    
+    /* time the cascade */
+    copy = (float (*)[3])malloc(sizeof(float) * 3 * gs_trace_len);
+    if (copy == NULL)
+    {
+        return 1;
+    }
+    memcpy(copy, gs_trace, sizeof(float) * 3 * gs_trace_len);
+    if (adxl345_biquad_set_rate(&gs_biquad, ADXL345_RATE_3200) != 0)
+    {
+        free(copy);
+        
+        return 1;
+    }
+    start = a_vibration_now();
+    for (i = 0; i < gs_trace_len; i += n)
+    {
+        n = ((gs_trace_len - i) > 1024) ? 1024 : (gs_trace_len - i);
+        (void)adxl345_biquad_process(&gs_biquad, &copy[i], (uint16_t)n);
+    }
+    ns = a_vibration_now() - start;
+    for (i = 0; i < gs_trace_len; i++)
+    {
+        for (j = 0; j < 3; j++)
+        {
+            res |= (copy[i][j] != out[i][j]) ? 1 : 0;
+        }
+    }
+    free(copy);
+    adxl345_interface_debug_print("adxl345: biquad %.2fns per sample of three axes.\n", (double)ns / (double)gs_trace_len);
+    adxl345_interface_debug_print("adxl345: biquad largest error %.6fg.\n", gs_max_error);
+    res |= (gs_max_error > VIBRATION_TOLERANCE) ? 1 : 0;
+    
+    return res;
+}
+
+/**
+ * @brief     check the envelope stage
+ * @param[in] window block in samples
+ * @return    status code
+ *            - 0 success
+ *            - 1 check failed
+ * @note      the band and the envelope are made again in double precision with the same coefficients and
+ *            the moments of every block are taken in two passes, the band of the z square wave is a train of
+ *            decaying pulses at the edges, so its kurtosis is far above the 3 of gaussian noise, and the whole
+ *            trace is run again in blocks of 1024 samples to time the stage
+ */
+static uint8_t a_vibration_envelope_check(uint32_t window)
+{
+    float (*out)[3] = (float (*)[3])gs_buffer;
+    double band_z1[ADXL345_BIQUAD_MAX_SECTION];
+    double band_z2[ADXL345_BIQUAD_MAX_SECTION];
+    double smooth_z1[ADXL345_BIQUAD_MAX_SECTION];
+    double smooth_z2[ADXL345_BIQUAD_MAX_SECTION];
+    float (*copy)[3];
+    double *band;
+    double mean, m2, m4, peak, sum, d;
+    double ratio = 0.0;
+    const adxl345_envelope_result_t *result;
+    uint64_t start, ns;
+    uint32_t i, b, n;
+    uint8_t j;
+    
+    adxl345_interface_debug_print("adxl345: envelope block %d samples, band above %.1fHz, envelope below %.1fHz, %d blocks.\n",
+                                  (int)window, 5.0 * gs_tone_hz, 2.5 * gs_tone_hz, (int)gs_window);
+    if (gs_window == 0)
+    {
+        return 1;
+    }
+    band = (double *)malloc(sizeof(double) * window);
+    if (band == NULL)
+    {
+        return 1;
+    }
+    for (j = 0; j < 3; j++)
+    {
+        memset(band_z1, 0, sizeof(band_z1));
+        memset(band_z2, 0, sizeof(band_z2));
+        memset(smooth_z1, 0, sizeof(smooth_z1));
+        memset(smooth_z2, 0, sizeof(smooth_z2));
+        for (b = 0; b < gs_window; b++)
+        {
+            sum = 0.0;
+            mean = 0.0;
+            peak = 0.0;
+            for (i = 0; i < window; i++)
+            {
+                band[i] = a_vibration_cascade(&gs_envelope.band, band_z1, band_z2, gs_trace[b * window + i][j]);
+                d = a_vibration_cascade(&gs_envelope.smooth, smooth_z1, smooth_z2, fabs(band[i]));
+                gs_max_error = fmax(gs_max_error, fabs(out[b * window + i][j] - d));
+                sum += d;
+                mean += band[i];
+                peak = fmax(peak, fabs(band[i]));
+            }
+            mean /= (double)window;
+            m2 = 0.0;
+            m4 = 0.0;
+            for (i = 0; i < window; i++)
+            {
+                d = (band[i] - mean) * (band[i] - mean);
+                m2 += d;
+                m4 += d * d;
+            }
+            m2 /= (double)window;
+            m4 /= (double)window;
+            result = &gs_results[b];
+            gs_max_error = fmax(gs_max_error, fabs(result->rms[j] - sqrt(m2)));
+            gs_max_error = fmax(gs_max_error, fabs(result->peak[j] - peak));
+            gs_max_error = fmax(gs_max_error, fabs(result->envelope[j] - sum / (double)window));
+            ratio = fmax(ratio, fabs(result->crest[j] - peak / sqrt(m2)) / (peak / sqrt(m2)));
+            ratio = fmax(ratio, fabs(result->kurtosis[j] - m4 / (m2 * m2)) / (m4 / (m2 * m2)));
+        }
+    }
+    free(band);
+    
+    /* time the stage */
+    copy = (float (*)[3])malloc(sizeof(float) * 3 * gs_trace_len);
+    if (copy == NULL)
+    {
+        return 1;
+    }
+    memcpy(copy, gs_trace, sizeof(float) * 3 * gs_trace_len);
+    gs_envelope.callback = NULL;
+    (void)adxl345_envelope_reset(&gs_envelope);
+    start = a_vibration_now();
+    for (i = 0; i < gs_trace_len; i += n)
+    {
+        n = ((gs_trace_len - i) > 1024) ? 1024 : (gs_trace_len - i);
+        (void)adxl345_envelope_update(&gs_envelope, &copy[i], (uint16_t)n);
+    }
+    ns = a_vibration_now() - start;
+    free(copy);
+    result = &gs_results[gs_window - 1];
+    adxl345_interface_debug_print("axis      rms     peak   crest  kurtosis  envelope\n");
+    for (j = 0; j < 3; j++)
+    {
+        adxl345_interface_debug_print("%c    %8.4f %8.4f %7.3f %9.3f  %8.4f\n", gs_axis_name[j], result->rms[j],
+                                      result->peak[j], result->crest[j], result->kurtosis[j], result->envelope[j]);
+    }
+    adxl345_interface_debug_print("adxl345: envelope %.2fns per sample of three axes.\n", (double)ns / (double)gs_trace_len);
+    adxl345_interface_debug_print("adxl345: envelope largest error %.6fg, largest ratio error %.2e.\n", gs_max_error, ratio);
+    
+    return ((gs_max_error > VIBRATION_TOLERANCE) || (ratio > VIBRATION_RATIO_TOLERANCE) ||
+            (result->kurtosis[2] <= 3.0f)) ? 1 : 0;
+}
+
+/**
+ * @brief     check the velocity stage
+ * @param[in] window block in samples
+ * @return    status code
+ *            - 0 success
+ *            - 1 check failed
+ * @note      the velocity is made again in double precision with the same coefficients, the rms of the
+ *            last block of the x and y sines must match a / 2pif / sqrt(2) times the gain of the trapezoid
+ *            integration pif / fs / tan(pif / fs), the z square wave integrates to a triangle wave
+ */
+static uint8_t a_vibration_velocity_check(uint32_t window)
+{
+    const char zone_name[] = {'-', 'A', 'B', 'C', 'D'};
+    float (*out)[3] = (float (*)[3])gs_buffer;
+    double pre_z1[ADXL345_BIQUAD_MAX_SECTION];
+    double pre_z2[ADXL345_BIQUAD_MAX_SECTION];
+    double post_z1[ADXL345_BIQUAD_MAX_SECTION];
+    double post_z2[ADXL345_BIQUAD_MAX_SECTION];
+    double expect[3];
+    double a, last, integral, v, sum, peak, theta;
+    double ratio = 0.0;
+    const adxl345_velocity_result_t *result;
+    uint32_t i, b;
+    uint8_t j;
+    uint8_t res = 0;
+    
+    adxl345_interface_debug_print("adxl345: velocity block %d samples, band 10Hz to 1000Hz, %d blocks.\n",
+                                  (int)window, (int)gs_window);
+    if (gs_window == 0)
+    {
+        return 1;
+    }
+    for (j = 0; j < 3; j++)
+    {
+        memset(pre_z1, 0, sizeof(pre_z1));
+        memset(pre_z2, 0, sizeof(pre_z2));
+        memset(post_z1, 0, sizeof(post_z1));
+        memset(post_z2, 0, sizeof(post_z2));
+        last = 0.0;
+        integral = 0.0;
+        for (b = 0; b < gs_window; b++)
+        {
+            sum = 0.0;
+            peak = 0.0;
+            for (i = b * window; i < (b + 1) * window; i++)
+            {
+                a = a_vibration_cascade(&gs_velocity.pre, pre_z1, pre_z2, gs_trace[i][j]);
+                integral += VIBRATION_GRAVITY / 2.0 / VIBRATION_RATE_HZ * (a + last);
+                last = a;
+                v = a_vibration_cascade(&gs_velocity.post, post_z1, post_z2, integral);
+                gs_max_error = fmax(gs_max_error, fabs(out[i][j] - v));
+                sum += v * v;
+                peak = fmax(peak, fabs(v));
+            }
+            result = &gs_velocity_results[b];
+            ratio = fmax(ratio, fabs(result->rms[j] - sqrt(sum / (double)window)) / sqrt(sum / (double)window));
+            ratio = fmax(ratio, fabs(result->peak[j] - peak) / peak);
+        }
+    }
+    result = &gs_velocity_results[gs_window - 1];
+    theta = M_PI * gs_tone_hz / VIBRATION_RATE_HZ;
+    expect[0] = gs_amp * VIBRATION_GRAVITY / (2.0 * M_PI * gs_tone_hz) / sqrt(2.0) * theta / tan(theta);
+    expect[1] = 0.5 * gs_amp * VIBRATION_GRAVITY / (4.0 * M_PI * gs_tone_hz) / sqrt(2.0) * 2.0 * theta / tan(2.0 * theta);
+    expect[2] = 0.25 * gs_amp * VIBRATION_GRAVITY / (4.0 * gs_tone_hz) / sqrt(3.0);
+    adxl345_interface_debug_print("axis  rms mm/s  peak mm/s  zone  expect rms\n");
+    for (j = 0; j < 3; j++)
+    {
+        adxl345_interface_debug_print("%c     %8.4f   %8.4f     %c    %8.4f\n", gs_axis_name[j], result->rms[j],
+                                      result->peak[j], zone_name[result->zone[j]], expect[j]);
+    }
+    adxl345_interface_debug_print("adxl345: velocity worst zone %c.\n", zone_name[result->worst]);
+    adxl345_interface_debug_print("adxl345: velocity largest error %.6fmm/s, largest ratio error %.2e.\n", gs_max_error, ratio);
+    res |= (ratio > VIBRATION_RATIO_TOLERANCE) ? 1 : 0;
+    res |= (gs_max_error > VIBRATION_RATIO_TOLERANCE * result->peak[0]) ? 1 : 0;
+    for (j = 0; j < 2; j++)
+    {
+        res |= (fabs(result->rms[j] - expect[j]) > VIBRATION_SPEED_TOLERANCE * expect[j]) ? 1 : 0;
+    }
+    
+    return res;
+}
+
+/**
+ * @brief     check the welford stage
+ * @param[in] window samples of one part
+ * @return    status code
+ *            - 0 success
+ *            - 1 check failed
+ * @note      the running accumulator is compared with a two pass mean and variance in double precision,
+ *            then the trace is cut into parts of window samples as if every part ran on its own thread and
+ *            the parts are merged pairwise into one accumulator which must match the running one
+ */
+static uint8_t a_vibration_welford_check(uint32_t window)
+{
+    const double std[3] = {gs_amp / sqrt(2.0), 0.5 * gs_amp / sqrt(2.0), 0.25 * gs_amp};
+    adxl345_welford_t *part;
+    adxl345_welford_result_t result;
+    adxl345_welford_result_t merged;
+    double mean, var, error;
+    double merge_error = 0.0;
+    uint32_t parts = (gs_trace_len + window - 1) / window;
+    uint32_t i, n, end, step;
+    uint8_t j;
+    uint8_t res = 0;
+    
+    if (adxl345_welford_compute(&gs_welford, &result) != 0)
+    {
+        return 1;
+    }
+    res |= (result.count != gs_trace_len) ? 1 : 0;
+    for (j = 0; j < 3; j++)
+    {
+        mean = 0.0;
+        for (i = 0; i < gs_trace_len; i++)
+        {
+            mean += gs_trace[i][j];
+        }
+        mean /= (double)gs_trace_len;
+        var = 0.0;
+        for (i = 0; i < gs_trace_len; i++)
+        {
+            var += (gs_trace[i][j] - mean) * (gs_trace[i][j] - mean);
+        }
+        var /= (double)(gs_trace_len - 1);
+        error = fmax(fabs(gs_welford.mean[j] - mean), fabs(gs_welford.m2[j] / (double)(gs_trace_len - 1) - var) / var);
+        gs_max_error = fmax(gs_max_error, error);
+    }
+    
+    /* merge the parts */
+    part = (adxl345_welford_t *)malloc(sizeof(adxl345_welford_t) * parts);
+    if (part == NULL)
+    {
+        return 1;
+    }
+    for (i = 0; i < parts; i++)
+    {
+        res |= (adxl345_welford_clear(&part[i]) != 0) ? 1 : 0;
+    }
+    for (i = 0; i < gs_trace_len; i += n)
+    {
+        end = (i / window + 1) * window;
+        end = (end < gs_trace_len) ? end : gs_trace_len;
+        n = ((end - i) > 32) ? 32 : (end - i);
+        res |= (adxl345_welford_update(&part[i / window], &gs_trace[i], (uint16_t)n) != 0) ? 1 : 0;
+    }
+    for (step = 1; step < parts; step *= 2)
+    {
+        for (i = 0; i + step < parts; i += 2 * step)
+        {
+            res |= (adxl345_welford_merge(&part[i], &part[i + step], &part[i]) != 0) ? 1 : 0;
+        }
+    }
+    if (adxl345_welford_compute(&part[0], &merged) != 0)
+    {
+        free(part);
+        
+        return 1;
+    }
+    res |= (merged.count != result.count) ? 1 : 0;
+    for (j = 0; j < 3; j++)
+    {
+        merge_error = fmax(merge_error, fabs(part[0].mean[j] - gs_welford.mean[j]));
+        merge_error = fmax(merge_error, fabs(part[0].m2[j] - gs_welford.m2[j]) / gs_welford.m2[j]);
+        res |= ((merged.min[j] != result.min[j]) || (merged.max[j] != result.max[j])) ? 1 : 0;
+    }
+    free(part);
+    
+    adxl345_interface_debug_print("adxl345: welford %d samples, %d parts of %d samples merged.\n",
+                                  (int)result.count, (int)parts, (int)window);
+    adxl345_interface_debug_print("axis     mean      std      min      max  expect std\n");
+    for (j = 0; j < 3; j++)
+    {
+        adxl345_interface_debug_print("%c    %8.4f %8.4f %8.4f %8.4f    %8.4f\n", gs_axis_name[j], result.mean[j],
+                                      result.std[j], result.min[j], result.max[j], std[j]);
+    }
+    adxl345_interface_debug_print("adxl345: welford largest error %.2e, largest merge error %.2e.\n", gs_max_error, merge_error);
+    res |= (gs_max_error > VIBRATION_MOMENT_TOLERANCE) ? 1 : 0;
+    res |= (merge_error > VIBRATION_MOMENT_TOLERANCE) ? 1 : 0;
+    
+    return res;
+}
+
+/**
+ * @brief     check the hampel stage
+ * @param[in] window samples of the spike filter history
+ * @param[in] hop samples between two injected spikes
+ * @return    status code
+ *            - 0 success
+ *            - 1 check failed
+ * @note      the motion adds a spike of 5 times the amplitude to the x axis every hop samples and holds the z axis
+ *            at the gravity, so the flagged samples must be hop apart, match the stats counter, leave no residue
+ *            and hold the sample before them
+ */
+static uint8_t a_vibration_hampel_check(uint32_t window, uint32_t hop)
+{
+    const uint8_t *flag = (const uint8_t *)gs_buffer;
+    adxl345_stats_t stats;
+    double step = gs_amp * 2.0 * M_PI * gs_tone_hz / VIBRATION_RATE_HZ;
+    double peak = 0.0;
+    double jump = 0.0;
+    uint32_t first = 0;
+    uint32_t last = 0;
+    uint32_t n = 0;
+    uint32_t i;
+    uint8_t res = 0;
+    
+    if (adxl345_get_stats(&gs_handle, &stats) != 0)
+    {
+        return 1;
+    }
+    for (i = 0; i < gs_trace_len; i++)
+    {
+        peak = fmax(peak, fabs(gs_trace[i][0]));
+        if (flag[i] == 0)
+        {
+            continue;
+        }
+        if (n == 0)
+        {
+            first = i;
+        }
+        else if (i - last != hop)
+        {
+            res = 1;
+        }
+        if ((i == 0) || (gs_trace[i][0] != gs_trace[i - 1][0]))
+        {
+            res = 1;
+        }
+        if (i + 1 < gs_trace_len)
+        {
+            jump = fmax(jump, fabs(gs_trace[i + 1][0] - gs_trace[i][0]));
+        }
+        last = i;
+        n++;
+    }
+    
+    adxl345_interface_debug_print("adxl345: hampel window %d, threshold 3.0, a spike every %d samples.\n", (int)window, (int)hop);
+    adxl345_interface_debug_print("adxl345: hampel %d samples, %d flagged from sample %d, %d replaced in the stats.\n",
+                                  (int)gs_trace_len, (int)gs_spike, (int)first, (int)stats.spike);
+    adxl345_interface_debug_print("adxl345: hampel largest x %.4fg, largest step after a hold %.4fg, expect below %.4fg.\n",
+                                  peak, jump, 2.0 * step + VIBRATION_HOLD_TOLERANCE);
+    res |= (n != gs_spike) ? 1 : 0;
+    res |= (stats.spike != gs_spike) ? 1 : 0;
+    res |= ((n == 0) || (first >= window + hop) || (last + hop < gs_trace_len)) ? 1 : 0;
+    res |= (peak > gs_amp + VIBRATION_HOLD_TOLERANCE) ? 1 : 0;
+    res |= (jump > 2.0 * step + VIBRATION_HOLD_TOLERANCE) ? 1 : 0;
+    
+    return res;
+}
+
+/**
+ * @brief     check the srs stage
+ * @return    status code
+ *            - 0 success
+ *            - 1 check failed
+ * @note      every oscillator is run again in double precision with its own design and compared with the stream,
+ *            the whole trace is timed again as one capture, and the oscillators nearest the x and the y tones
+ *            must ring at the steady state transmissibility of a q of 10 over the pre event offset
+ */
+static uint8_t a_vibration_srs_check(void)
+{
+    const double tone[2] = {gs_tone_hz, 2.0 * gs_tone_hz};
+    const double amp[2] = {gs_amp, 0.5 * gs_amp};
+    float hz[ADXL345_SRS_MAX_FREQ];
+    float maximax[ADXL345_SRS_MAX_FREQ][3];
+    float again[ADXL345_SRS_MAX_FREQ][3];
+    double zeta = 0.5 / VIBRATION_SRS_Q;
+    double wn, e, k, c, sp, b0, b1, b2, a1, a2;
+    double x, x1, x2, y, y1, y2, peak, largest, r, expect, error;
+    uint64_t start, ns;
+    uint16_t count;
+    uint16_t near;
+    uint32_t i;
+    uint16_t f;
+    uint8_t j;
+    uint8_t res = 0;
+    
+    if (adxl345_srs_get(&gs_srs, hz, maximax, &count) != 0)
+    {
+        return 1;
+    }
+    
+    /* run every oscillator again in double precision */
+    largest = 0.0;
+    for (f = 0; f < count; f++)
+    {
+        wn = 2.0 * M_PI * (double)hz[f];
+        e = exp(-zeta * wn / VIBRATION_RATE_HZ);
+        k = wn * sqrt(1.0 - zeta * zeta) / VIBRATION_RATE_HZ;
+        c = e * cos(k);
+        sp = e * sin(k) / k;
+        b0 = 1.0 - sp;
+        b1 = 2.0 * (sp - c);
+        b2 = e * e - sp;
+        a1 = 2.0 * c;
+        a2 = -e * e;
+        for (j = 0; j < 3; j++)
+        {
+            x1 = 0.0;
+            x2 = 0.0;
+            y1 = 0.0;
+            y2 = 0.0;
+            peak = 0.0;
+            for (i = 0; i < gs_trace_len; i++)
+            {
+                x = (double)gs_trace[i][j] - (double)gs_trace[0][j];
+                y = b0 * x + b1 * x1 + b2 * x2 + a1 * y1 + a2 * y2;
+                x2 = x1;
+                x1 = x;
+                y2 = y1;
+                y1 = y;
+                peak = fmax(peak, fabs(y));
+            }
+            gs_max_error = fmax(gs_max_error, fabs(maximax[f][j] - peak));
+            largest = fmax(largest, peak);
+        }
+    }
+    gs_max_error /= largest;
+    
+    /* time the trace again as one capture */
+    (void)adxl345_srs_reset(&gs_srs);
+    start = a_vibration_now();
+    (void)adxl345_srs_update(&gs_srs, gs_trace, (uint16_t)gs_trace_len);
+    ns = a_vibration_now() - start;
+    (void)adxl345_srs_get(&gs_srs, hz, again, &count);
+    for (f = 0; f < count; f++)
+    {
+        for (j = 0; j < 3; j++)
+        {
+            res |= (again[f][j] != maximax[f][j]) ? 1 : 0;
+        }
+    }
+    
+    adxl345_interface_debug_print("adxl345: srs %d frequencies from %.1fHz to %.1fHz, q %.0f, %d samples.\n",
+                                  (int)count, hz[0], hz[count - 1], VIBRATION_SRS_Q, (int)gs_trace_len);
+    adxl345_interface_debug_print("      hz        x        y        z\n");
+    for (f = 0; f < count; f += (count + 7) / 8)
+    {
+        adxl345_interface_debug_print("%8.1f %8.4f %8.4f %8.4f\n", hz[f], maximax[f][0], maximax[f][1], maximax[f][2]);
+    }
+    
+    /* the steady state resonance of the x and the y sines */
+    for (j = 0; j < 2; j++)
+    {
+        near = 0;
+        for (f = 1; f < count; f++)
+        {
+            near = (fabs(log(hz[f] / tone[j])) < fabs(log(hz[near] / tone[j]))) ? f : near;
+        }
+        r = tone[j] / (double)hz[near];
+        expect = amp[j] * sqrt((1.0 + (2.0 * zeta * r) * (2.0 * zeta * r)) /
+                               ((1.0 - r * r) * (1.0 - r * r) + (2.0 * zeta * r) * (2.0 * zeta * r))) +
+                 fabs(gs_trace[0][j]);
+        error = fabs(maximax[near][j] - expect) / expect;
+        adxl345_interface_debug_print("adxl345: srs %c at %.1fHz %.4fg, expect %.4fg.\n", gs_axis_name[j], hz[near],
+                                      maximax[near][j], expect);
+        res |= (error > VIBRATION_SRS_TOLERANCE) ? 1 : 0;
+    }
+    adxl345_interface_debug_print("adxl345: srs %d samples of three axes in %.3fms.\n", (int)gs_trace_len, (double)ns / 1e6);
+    adxl345_interface_debug_print("adxl345: srs largest error %.2e of the largest response.\n", gs_max_error);
+    res |= (gs_max_error > VIBRATION_RATIO_TOLERANCE) ? 1 : 0;
+    
+    return res;
+}
+
+/**
+ * @brief      get the rainflow bins of a range
+ * @param[in]  *rainflow pointer to an adxl345 rainflow structure
+ * @param[in]  a first turning point in g
+ * @param[in]  b second turning point in g
+ * @param[out] *r pointer to a range bin buffer
+ * @param[out] *m pointer to a mean bin buffer
+ * @note       the bins are taken in float like the driver so both histograms match exactly
+ */
+static void a_vibration_rainflow_bin(adxl345_rainflow_t *rainflow, float a, float b, uint8_t *r, uint8_t *m)
+{
+    float fr = fabsf(a - b) / rainflow->range_max * (float)ADXL345_RAINFLOW_RANGE_BINS;
+    float fm = (0.5f * (a + b) - rainflow->mean_min) /
+               (rainflow->mean_max - rainflow->mean_min) * (float)ADXL345_RAINFLOW_MEAN_BINS;
+    
+    *r = (fr < (float)ADXL345_RAINFLOW_RANGE_BINS) ? (uint8_t)fr : (ADXL345_RAINFLOW_RANGE_BINS - 1);
+    *m = (!(fm > 0.0f)) ? 0 : ((fm < (float)ADXL345_RAINFLOW_MEAN_BINS) ? (uint8_t)fm : (ADXL345_RAINFLOW_MEAN_BINS - 1));
+}
+
+/**
+ * @brief      count a channel of the trace offline
+ * @param[in]  *rainflow pointer to an adxl345 rainflow structure of the gate and the bins
+ * @param[in]  ch channel, 3 for the magnitude
+ * @param[out] **half pointer to a half cycle histogram buffer
+ * @note       the turning points of the whole trace are found first and counted with the three point rule
+ *             of astm e1049, a range with the start point is a half cycle and the ranges left in the stack
+ *             are half cycles, the driver with its residue as half cycles must count the same
+ */
+static void a_vibration_rainflow_reference(adxl345_rainflow_t *rainflow, uint8_t ch,
+                                           uint32_t (*half)[ADXL345_RAINFLOW_MEAN_BINS])
+{
+    float *point = (float *)gs_buffer;
+    float *stack = point + gs_trace_size + 1;
+    float gate = rainflow->gate;
+    float v, x, y;
+    float extreme = 0.0f;
+    int8_t direction = 0;
+    uint32_t n = 0;
+    uint32_t len = 0;
+    uint32_t i;
+    uint8_t r;
+    uint8_t m;
+    
+    memset(half, 0, sizeof(uint32_t) * ADXL345_RAINFLOW_RANGE_BINS * ADXL345_RAINFLOW_MEAN_BINS);
+    
+    /* the turning points past the gate */
+    for (i = 0; i < gs_trace_len; i++)
+    {
+        v = (ch < 3) ? gs_trace[i][ch] :
+            sqrtf(gs_trace[i][0] * gs_trace[i][0] + gs_trace[i][1] * gs_trace[i][1] + gs_trace[i][2] * gs_trace[i][2]);
+        if (i == 0)
+        {
+            point[n++] = v;
+            extreme = v;
+        }
+        else if (direction == 0)
+        {
+            if ((v - point[0] > gate) || (point[0] - v > gate))
+            {
+                direction = (v > point[0]) ? 1 : -1;
+                extreme = v;
+            }
+        }
+        else if (((direction > 0) && (v > extreme)) || ((direction < 0) && (v < extreme)))
+        {
+            extreme = v;
+        }
+        else if (((direction > 0) && (extreme - v > gate)) || ((direction < 0) && (v - extreme > gate)))
+        {
+            point[n++] = extreme;
+            direction = -direction;
+            extreme = v;
+        }
+        else
+        {
+            /* inside the gate */
+        }
+    }
+    if (direction != 0)
+    {
+        point[n++] = extreme;
+    }
+    
+    /* the three point rule */
+    for (i = 0; i < n; i++)
+    {
+        stack[len++] = point[i];
+        while (len >= 3)
+        {
+            x = fabsf(stack[len - 1] - stack[len - 2]);
+            y = fabsf(stack[len - 2] - stack[len - 3]);
+            if (x < y)
+            {
+                break;
+            }
+            a_vibration_rainflow_bin(rainflow, stack[len - 3], stack[len - 2], &r, &m);
+            if (len == 3)
+            {
+                half[r][m] += 1;
+                stack[0] = stack[1];
+                stack[1] = stack[2];
+                len = 2;
+            }
+            else
+            {
+                half[r][m] += 2;
+                stack[len - 3] = stack[len - 1];
+                len -= 2;
+            }
+        }
+    }
+    for (i = 1; i < len; i++)
+    {
+        a_vibration_rainflow_bin(rainflow, stack[i - 1], stack[i], &r, &m);
+        half[r][m] += 1;
+    }
+}
+
+/**
+ * @brief     check the rainflow stage
+ * @param[in] seconds virtual run time
+ * @return    status code
+ *            - 0 success
+ *            - 1 check failed
+ * @note      every channel is counted again offline and must match the stream bin by bin, the trace is
+ *            timed again as one capture, and the closed cycles of every axis must sit in the bins of the
+ *            sampled peaks of its motion with one cycle per period
+ */
+static uint8_t a_vibration_rainflow_check(uint32_t seconds)
+{
+    const char *const name[4] = {"x", "y", "z", "magnitude"};
+    const double amp[3] = {gs_amp, 0.5 * gs_amp, 0.25 * gs_amp};
+    const double tone[3] = {gs_tone_hz, 2.0 * gs_tone_hz, gs_tone_hz};
+    const double mean[3] = {0.0, 0.0, 1.0};
+    static uint32_t reference[ADXL345_RAINFLOW_RANGE_BINS][ADXL345_RAINFLOW_MEAN_BINS];
+    static float stream[4][ADXL345_RAINFLOW_RANGE_BINS][ADXL345_RAINFLOW_MEAN_BINS];
+    float closed[ADXL345_RAINFLOW_RANGE_BINS][ADXL345_RAINFLOW_MEAN_BINS];
+    float again[ADXL345_RAINFLOW_RANGE_BINS][ADXL345_RAINFLOW_MEAN_BINS];
+    float point[ADXL345_RAINFLOW_MAX_RESIDUE + 1];
+    adxl345_rainflow_t *rainflow;
+    double w, mw, droop, lo, hi, spread;
+    double range_lo, range_hi, mean_lo, mean_hi;
+    float total, cycles;
+    uint64_t start, ns;
+    uint32_t mismatch, outside, i;
+    uint16_t len;
+    uint8_t c, ch, r, m;
+    uint8_t res = 0;
+    
+    for (c = 0; c < 4; c++)
+    {
+        rainflow = (c < 3) ? &gs_rainflow[0] : &gs_rainflow[1];
+        ch = (c < 3) ? c : 0;
+        if ((adxl345_rainflow_get(rainflow, ch, ADXL345_BOOL_TRUE, stream[c], &total) != 0) ||
+            (adxl345_rainflow_get(rainflow, ch, ADXL345_BOOL_FALSE, closed, &cycles) != 0) ||
+            (adxl345_rainflow_get_residue(rainflow, ch, point, &len) != 0))
+        {
+            return 1;
+        }
+        
+        /* count the channel again offline */
+        a_vibration_rainflow_reference(rainflow, (c < 3) ? c : 3, reference);
+        mismatch = 0;
+        for (r = 0; r < ADXL345_RAINFLOW_RANGE_BINS; r++)
+        {
+            for (m = 0; m < ADXL345_RAINFLOW_MEAN_BINS; m++)
+            {
+                mismatch += ((uint32_t)(2.0f * stream[c][r][m]) != reference[r][m]) ? 1 : 0;
+            }
+        }
+        
+        /* the occupied bins of the closed cycles */
+        w = (double)rainflow->range_max / ADXL345_RAINFLOW_RANGE_BINS;
+        mw = (double)(rainflow->mean_max - rainflow->mean_min) / ADXL345_RAINFLOW_MEAN_BINS;
+        range_lo = (double)rainflow->range_max;
+        range_hi = 0.0;
+        mean_lo = (double)rainflow->mean_max;
+        mean_hi = (double)rainflow->mean_min;
+        outside = 0;
+        lo = 0.0;
+        hi = 0.0;
+        spread = 0.0;
+        if (c < 3)
+        {
+            droop = (c < 2) ? cos(M_PI * tone[c] / VIBRATION_RATE_HZ) : 1.0;
+            lo = 2.0 * amp[c] * droop - 4.0 * VIBRATION_LSB;
+            hi = 2.0 * amp[c] + 4.0 * VIBRATION_LSB;
+            spread = amp[c] * (1.0 - droop) + 4.0 * VIBRATION_LSB;
+        }
+        for (r = 0; r < ADXL345_RAINFLOW_RANGE_BINS; r++)
+        {
+            for (m = 0; m < ADXL345_RAINFLOW_MEAN_BINS; m++)
+            {
+                if (closed[r][m] > 0.0f)
+                {
+                    range_lo = fmin(range_lo, r * w);
+                    range_hi = fmax(range_hi, (r + 1) * w);
+                    mean_lo = fmin(mean_lo, rainflow->mean_min + m * mw);
+                    mean_hi = fmax(mean_hi, rainflow->mean_min + (m + 1) * mw);
+                    if ((c < 3) &&
+                        (((r + 1) * w < lo) || (r * w > hi) ||
+                         (rainflow->mean_min + (m + 1) * mw < mean[c] - spread) ||
+                         (rainflow->mean_min + m * mw > mean[c] + spread)))
+                    {
+                        outside += (uint32_t)closed[r][m];
+                    }
+                }
+            }
+        }
+        adxl345_interface_debug_print("adxl345: rainflow %s %.1f cycles, %d closed in ranges %.3fg to %.3fg and means %.3fg to %.3fg.\n",
+                                      name[c], total, (int)cycles, range_lo, range_hi, mean_lo, mean_hi);
+        adxl345_interface_debug_print("adxl345: rainflow %s residue of %d points, %d bins differ from the offline count.\n",
+                                      name[c], (int)len, (int)mismatch);
+        res |= ((mismatch != 0) || (rainflow->overflow[ch] != 0)) ? 1 : 0;
+        if (c < 3)
+        {
+            adxl345_interface_debug_print("adxl345: rainflow %s expect %.1f cycles of %.3fg to %.3fg around %.3fg, %d outside.\n",
+                                          name[c], tone[c] * seconds, lo, hi, mean[c], (int)outside);
+            res |= ((outside != 0) || (fabs(total - tone[c] * seconds) > 1.0)) ? 1 : 0;
+        }
+    }
+    
+    /* time the trace again as one capture */
+    (void)adxl345_rainflow_reset(&gs_rainflow[0]);
+    (void)adxl345_rainflow_reset(&gs_rainflow[1]);
+    start = a_vibration_now();
+    for (i = 0; i < gs_trace_len; i += len)
+    {
+        len = (gs_trace_len - i > 3200) ? 3200 : (uint16_t)(gs_trace_len - i);
+        (void)adxl345_rainflow_update(&gs_rainflow[0], gs_trace + i, len);
+        (void)adxl345_rainflow_update(&gs_rainflow[1], gs_trace + i, len);
+    }
+    ns = a_vibration_now() - start;
+    for (c = 0; c < 4; c++)
+    {
+        (void)adxl345_rainflow_get((c < 3) ? &gs_rainflow[0] : &gs_rainflow[1], (c < 3) ? c : 0,
+                                   ADXL345_BOOL_TRUE, again, &total);
+        res |= (memcmp(again, stream[c], sizeof(again)) != 0) ? 1 : 0;
+    }
+    adxl345_interface_debug_print("adxl345: rainflow %d samples of the axes and the magnitude in %.3fms.\n",
+                                  (int)gs_trace_len, (double)ns / 1e6);
+    adxl345_interface_debug_print("adxl345: rainflow keeps %d bytes, the raw recording takes %d bytes.\n",
+                                  (int)sizeof(gs_rainflow), (int)(gs_trace_len * 3 * sizeof(int16_t)));
+    
+    return res;
+}
+
+/**
+ * @brief     vibration analysis
+ * @param[in] argc arg numbers
+ * @param[in] **argv arg address
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ *            - 5 param is invalid
+ * @note      none
+ */
+static uint8_t adxl345_vibration(uint8_t argc, char **argv)
+{
+    int c;
+    int longindex = 0;
+    const char short_options[] = "h";
+    const struct option long_options[] =
+    {
+        {"help", no_argument, NULL, 'h'},
+        {"amp", required_argument, NULL, 1},
+        {"hop", required_argument, NULL, 2},
+        {"interface", required_argument, NULL, 3},
+        {"seconds", required_argument, NULL, 4},
+        {"stage", required_argument, NULL, 5},
+        {"tone", required_argument, NULL, 6},
+        {"taper", required_argument, NULL, 7},
+        {"window", required_argument, NULL, 8},
+        {NULL, 0, NULL, 0},
+    };
+    adxl345_interface_t interface = ADXL345_INTERFACE_IIC;
+    adxl345_welch_window_t taper = ADXL345_WELCH_WINDOW_HANN;
+    uint32_t seconds = 2;
+    uint32_t window = 0;
+    uint32_t hop = 0;
+    uint8_t help = 0;
+    uint8_t check;
+    uint8_t res;
+    uint8_t i;
+    
+    /* init the defaults */
+    gs_stage = VIBRATION_STAGE_METRICS;
+    gs_tone_hz = 120.0;
+    gs_amp = 0.5;
+    
+    /* init 0 */
+    optind = 0;
+    
+    /* parse */
+    do
+    {
+        /* parse the args */
+        c = getopt_long(argc, argv, short_options, long_options, &longindex);
+        
+        /* judge the result */
+        switch (c)
+        {
+            /* help */
+            case 'h' :
+            {
+                help = 1;
+                
+                break;
+            }
+            
+            /* amplitude */
+            case 1 :
+            {
+                /* set the amplitude */
+                gs_amp = atof(optarg);
+                if ((gs_amp <= 0.0) || (gs_amp > 8.0))
+                {
+                    return 5;
+                }
+                
+                break;
+            }
+            
+            /* hop */
+            case 2 :
+            {
+                /* set the hop */
+                hop = (uint32_t)atol(optarg);
+                
+                break;
+            }
+            
+            /* interface */
+            case 3 :
+            {
+                /* set the interface */
+                if (strcmp("iic", optarg) == 0)
+                {
+                    interface = ADXL345_INTERFACE_IIC;
+                }
+                else if (strcmp("spi", optarg) == 0)
+                {
+                    interface = ADXL345_INTERFACE_SPI;
+                }
+                else
+                {
+                    return 5;
+                }
+                
+                break;
+            }
+            
+            /* virtual run time */
+            case 4 :
+            {
+                /* set the seconds */
+                seconds = (uint32_t)atol(optarg);
+                if ((seconds == 0) || (seconds > 60))
+                {
+                    return 5;
+                }
+                
+                break;
+            }
+            
+            /* stage */
+            case 5 :
+            {
+                /* set the stage */
+                for (i = 0; i < sizeof(gs_stage_name) / sizeof(gs_stage_name[0]); i++)
+                {
+                    if (strcmp(gs_stage_name[i], optarg) == 0)
+                    {
+                        break;
+                    }
+                }
+                if (i == sizeof(gs_stage_name) / sizeof(gs_stage_name[0]))
+                {
+                    return 5;
+                }
+                gs_stage = (vibration_stage_t)i;
+                
+                break;
+            }
+            
+            /* tone */
+            case 6 :
+            {
+                /* set the tone */
+                gs_tone_hz = atof(optarg);
+                if ((gs_tone_hz <= 0.0) || (gs_tone_hz >= VIBRATION_RATE_HZ / 2.0))
+                {
+                    return 5;
+                }
+                
+                break;
+            }
+            
+            /* welch window */
+            case 7 :
+            {
+                /* set the taper */
+                for (i = 0; i < 4; i++)
+                {
+                    if (strcmp(gs_taper_name[i], optarg) == 0)
+                    {
+                        break;
+                    }
+                }
+                if (i == 4)
+                {
+                    return 5;
+                }
+                taper = (adxl345_welch_window_t)i;
+                
+                break;
+            }
+            
+            /* window */
+            case 8 :
+            {
+                /* set the window */
+                window = (uint32_t)atol(optarg);
+                
+                break;
+            }
+            
+            /* the end */
+            case -1 :
+            {
+                break;
+            }
+            
+            /* others */
+            default :
+            {
+                return 5;
+            }
+        }
+    } while (c != -1);
+    
+    if (help != 0)
+    {
+        adxl345_interface_debug_print("Usage:\n");
+        adxl345_interface_debug_print("  adxl345_vibration [--stage=<metrics | welch | goertzel | biquad | envelope | velocity | welford | hampel | srs | rainflow>] [--interface=<iic | spi>] [--tone=<hz>] [--amp=<g>] [--seconds=<num>]\n");
+        adxl345_interface_debug_print("                    [--window=<num>] [--hop=<num>] [--taper=<rect | hann | hamming | blackman>]\n");
+        adxl345_interface_debug_print("  adxl345_vibration (-h | --help)\n");
+        adxl345_interface_debug_print("\n");
+        adxl345_interface_debug_print("Options:\n");
+        adxl345_interface_debug_print("      --amp=<g>                      Set the amplitude of the motion, up to 3 for hampel,\n");
+        adxl345_interface_debug_print("                                     from 0.1 to 4 for rainflow.([default: 0.5])\n");
+        adxl345_interface_debug_print("  -h, --help                         Show the help.\n");
+        adxl345_interface_debug_print("      --hop=<num>                    Set the samples between two windows, between two spikes for hampel.\n");
+        adxl345_interface_debug_print("                                     ([default: 320 for metrics, half the window for welch, 97 for hampel])\n");
+        adxl345_interface_debug_print("      --interface=<iic | spi>        Set the chip interface.([default: iic])\n");
+        adxl345_interface_debug_print("      --seconds=<num>                Set the virtual run time.([default: 2])\n");
+        adxl345_interface_debug_print("      --stage=<metrics | welch | goertzel | biquad | envelope | velocity | welford | hampel | srs | rainflow>\n");
+        adxl345_interface_debug_print("                                     Set the analysed stage.([default: metrics])\n");
+        adxl345_interface_debug_print("      --taper=<rect | hann | hamming | blackman>\n");
+        adxl345_interface_debug_print("                                     Set the window of the welch segments.([default: hann])\n");
+        adxl345_interface_debug_print("      --tone=<hz>                    Set the tone of the motion, above 20 for biquad,\n");
+        adxl345_interface_debug_print("                                     below 320 for envelope, from 20 to 500 for velocity,\n");
+        adxl345_interface_debug_print("                                     below 600 for hampel, from 20 to 160 for srs,\n");
+        adxl345_interface_debug_print("                                     up to 400 for rainflow.([default: 120])\n");
+        adxl345_interface_debug_print("      --window=<num>                 Set the samples of one window, a multiple of the hop for metrics,\n");
+        adxl345_interface_debug_print("                                     a power of two from 256 to 4096 for welch, the spike filter history\n");
+        adxl345_interface_debug_print("                                     from 9 to 15 for hampel, the natural frequencies from 64 to 256 for srs,\n");
+        adxl345_interface_debug_print("                                     the block for the others.\n");
+        adxl345_interface_debug_print("                                     ([default: 1024 for welch, 9 for hampel, 128 for srs, 3200 for the others])\n");
+        
+        return 0;
+    }
+    if (gs_stage == VIBRATION_STAGE_METRICS)
+    {
+        window = (window == 0) ? 3200 : window;
+        hop = (hop == 0) ? 320 : hop;
+        if ((window < hop) || ((window % hop) != 0) || ((window / hop) > 0xFFFF))
+        {
+            return 5;
+        }
+    }
+    else if (gs_stage == VIBRATION_STAGE_GOERTZEL)
+    {
+        window = (window == 0) ? 3200 : window;
+        if ((window < 2) || (window > seconds * VIBRATION_RATE_HZ))
+        {
+            return 5;
+        }
+    }
+    else if (gs_stage == VIBRATION_STAGE_BIQUAD)
+    {
+        if ((window != 0) || (hop != 0) || (gs_tone_hz <= 20.0))
+        {
+            return 5;
+        }
+    }
+    else if (gs_stage == VIBRATION_STAGE_ENVELOPE)
+    {
+        window = (window == 0) ? 3200 : window;
+        if ((window < 2) || (window > seconds * VIBRATION_RATE_HZ) || (hop != 0) ||
+            (5.0 * gs_tone_hz >= VIBRATION_RATE_HZ / 2.0))
+        {
+            return 5;
+        }
+    }
+    else if (gs_stage == VIBRATION_STAGE_VELOCITY)
+    {
+        window = (window == 0) ? 3200 : window;
+        if ((window < 2) || (window > seconds * VIBRATION_RATE_HZ) || (hop != 0) ||
+            (gs_tone_hz <= 20.0) || (2.0 * gs_tone_hz >= 1000.0))
+        {
+            return 5;
+        }
+    }
+    else if (gs_stage == VIBRATION_STAGE_WELFORD)
+    {
+        window = (window == 0) ? 3200 : window;
+        if ((window == 0) || (window > seconds * VIBRATION_RATE_HZ) || (hop != 0))
+        {
+            return 5;
+        }
+    }
+    else if (gs_stage == VIBRATION_STAGE_HAMPEL)
+    {
+        window = (window == 0) ? 9 : window;
+        hop = (hop == 0) ? 97 : hop;
+        if ((window < 9) || (window > ADXL345_SPIKE_MAX_WINDOW) || (hop < 2) ||
+            (hop > seconds * VIBRATION_RATE_HZ) || (gs_amp > 3.0) || (gs_tone_hz >= 600.0))
+        {
+            return 5;
+        }
+        gs_spike_period = hop;
+    }
+    else if (gs_stage == VIBRATION_STAGE_SRS)
+    {
+        window = (window == 0) ? 128 : window;
+        if ((window < 64) || (window > ADXL345_SRS_MAX_FREQ) || (hop != 0) ||
+            (gs_tone_hz <= 20.0) || (gs_tone_hz > 160.0) || (seconds * VIBRATION_RATE_HZ > 0xFFFF))
+        {
+            return 5;
+        }
+    }
+    else if (gs_stage == VIBRATION_STAGE_RAINFLOW)
+    {
+        if ((window != 0) || (hop != 0) || (gs_amp < 0.1) || (gs_amp > 4.0) || (gs_tone_hz > 400.0))
+        {
+            return 5;
+        }
+    }
+    else
+    {
+        window = (window == 0) ? 1024 : window;
+        hop = (hop == 0) ? window / 2 : hop;
+        if ((window < ADXL345_FFT_MIN_SIZE) || (window > ADXL345_FFT_MAX_SIZE) ||
+            ((window & (window - 1)) != 0) || (hop > window) || (window > seconds * VIBRATION_RATE_HZ))
+        {
+            return 5;
+        }
+    }
+    
+    /* power on the chips */
+    if (adxl345_interface_iic_init() != 0)
+    {
+        return 1;
+    }
+    adxl345_model_set_motion(&g_adxl345_model[0], a_vibration_motion);
+    
+    /* link the vibration handle */
+    DRIVER_ADXL345_LINK_INIT(&gs_handle, adxl345_handle_t);
+    DRIVER_ADXL345_LINK_IIC_INIT(&gs_handle, adxl345_interface_iic_init);
+    DRIVER_ADXL345_LINK_IIC_DEINIT(&gs_handle, adxl345_interface_iic_deinit);
+    DRIVER_ADXL345_LINK_IIC_READ(&gs_handle, adxl345_interface_iic_read);
+    DRIVER_ADXL345_LINK_IIC_WRITE(&gs_handle, adxl345_interface_iic_write);
+    DRIVER_ADXL345_LINK_SPI_INIT(&gs_handle, adxl345_interface_spi_init);
+    DRIVER_ADXL345_LINK_SPI_DEINIT(&gs_handle, adxl345_interface_spi_deinit);
+    DRIVER_ADXL345_LINK_SPI_READ(&gs_handle, adxl345_interface_spi_read);
+    DRIVER_ADXL345_LINK_SPI_WRITE(&gs_handle, adxl345_interface_spi_write);
+    DRIVER_ADXL345_LINK_DELAY_MS(&gs_handle, adxl345_interface_delay_ms);
+    DRIVER_ADXL345_LINK_DEBUG_PRINT(&gs_handle, adxl345_interface_debug_print);
+    DRIVER_ADXL345_LINK_RECEIVE_CALLBACK(&gs_handle, a_vibration_receive_callback);
+    if (adxl345_set_interface(&gs_handle, interface) != 0)
+    {
+        return 1;
+    }
+    if (adxl345_set_addr_pin(&gs_handle, ADXL345_ADDRESS_ALT_0) != 0)
+    {
+        return 1;
+    }
+    if (adxl345_init(&gs_handle) != 0)
+    {
+        return 1;
+    }
+    
+    /* init the stage */
+    gs_trace_size = (uint32_t)(seconds * VIBRATION_RATE_HZ);
+    gs_trace_len = 0;
+    gs_trace = (float (*)[3])malloc(sizeof(float) * 3 * gs_trace_size);
+    gs_buffer = NULL;
+    if ((gs_trace == NULL) || (a_vibration_stage_init(window, hop, taper) != 0))
+    {
+        free(gs_trace);
+        free(gs_buffer);
+        (void)adxl345_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* run */
+    adxl345_interface_debug_print("adxl345: %s stage, %s, %.1fHz tone, %.3fg amplitude, %d seconds.\n",
+                                  gs_stage_name[gs_stage], (interface == ADXL345_INTERFACE_IIC) ? "iic" : "spi",
+                                  gs_tone_hz, gs_amp, (int)seconds);
+    res = a_vibration_run(seconds);
+    if (res == 0)
+    {
+        if (gs_stage == VIBRATION_STAGE_METRICS)
+        {
+            check = a_vibration_metrics_check(window, hop);
+        }
+        else if (gs_stage == VIBRATION_STAGE_GOERTZEL)
+        {
+            check = a_vibration_goertzel_check(window);
+        }
+        else if (gs_stage == VIBRATION_STAGE_BIQUAD)
+        {
+            check = a_vibration_biquad_check();
+        }
+        else if (gs_stage == VIBRATION_STAGE_ENVELOPE)
+        {
+            check = a_vibration_envelope_check(window);
+        }
+        else if (gs_stage == VIBRATION_STAGE_VELOCITY)
+        {
+            check = a_vibration_velocity_check(window);
+        }
+        else if (gs_stage == VIBRATION_STAGE_WELFORD)
+        {
+            check = a_vibration_welford_check(window);
+        }
+        else if (gs_stage == VIBRATION_STAGE_HAMPEL)
+        {
+            check = a_vibration_hampel_check(window, hop);
+        }
+        else if (gs_stage == VIBRATION_STAGE_SRS)
+        {
+            check = a_vibration_srs_check();
+        }
+        else if (gs_stage == VIBRATION_STAGE_RAINFLOW)
+        {
+            check = a_vibration_rainflow_check(seconds);
+        }
+        else
+        {
+            check = a_vibration_welch_check(window, hop, taper);
+        }
+        adxl345_interface_debug_print("adxl345: %s check %s.\n", gs_stage_name[gs_stage], (check == 0) ? "passed" : "failed");
+    }
+    free(gs_trace);
+    free(gs_buffer);
+    (void)adxl345_deinit(&gs_handle);
+    
+    return res;
+}
+
+/**
+ * @brief     main function
+ * @param[in] argc arg numbers
+ * @param[in] **argv arg address
+ * @return    status code
+ *             - 0 success
+ * @note      none
+ */
+int main(uint8_t argc, char **argv)
+{
+    uint8_t res;
+
+    res = adxl345_vibration(argc, argv);
+    if (res == 0)
+    {
+        /* run success */
+    }
+    else if (res == 1)
+    {
+        adxl345_interface_debug_print("adxl345: run failed.\n");
+    }
+    else if (res == 5)
+    {
+        adxl345_interface_debug_print("adxl345: param is invalid.\n");
+    }
+    else
+    {
+        adxl345_interface_debug_print("adxl345: unknown status code.\n");
+    }
+
+    return 0;
+}
@@ -206,6 +206,48 @@ void adxl345_interface_debug_print(const char *const fmt, ...)
     (void)uart_write((uint8_t *)str, len);
 }
 
+/**
+ * @brief     interface async submit
+ * @param[in] *work pointer to a work function address
+ * @param[in] *arg pointer to a work argument
+ * @return    status code
+ *            - 0 success
+ *            - 1 submit failed
+ * @note      no io pthread on this board, so the work runs directly
+ */
+uint8_t adxl345_interface_async_submit(void (*work)(void *arg), void *arg)
+{
+    work(arg);
+    
+    return 0;
+}
+
+/**
+ * @brief     interface async complete
+ * @param[in] *done pointer to a completion function address
+ * @param[in] *arg pointer to a completion argument
+ * @return    status code
+ *            - 0 success
+ *            - 1 submit failed
+ * @note      no io pthread on this board, so the completion runs directly
+ */
+uint8_t adxl345_interface_async_complete(void (*done)(void *arg), void *arg)
+{
+    done(arg);
+    
+    return 0;
+}
+
+/**
+ * @brief  interface clock us
+ * @return free running time in us
+ * @note   the resolution is the 1ms hal tick
+ */
+uint32_t adxl345_interface_clock_us(void)
+{
+    return HAL_GetTick() * 1000;
+}
+
 /**
  * @brief     interface receive callback
  * @param[in] type irq type
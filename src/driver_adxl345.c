@@ -37,6 +37,22 @@
 
 #include "driver_adxl345.h"
 
+/**
+ * @brief static tracepoint definition
+ * @note  the tracepoints expand to nothing unless ADXL345_TRACE_USDT is defined, then they are usdt probes
+ *        of the provider adxl345, which are single nops until perf or bpftrace attaches to them
+ */
+#if defined(ADXL345_TRACE_USDT)
+#include <sys/sdt.h>
+#define ADXL345_TRACE1(name, a)          DTRACE_PROBE1(adxl345, name, a)          /**< tracepoint with 1 argument */
+#define ADXL345_TRACE2(name, a, b)       DTRACE_PROBE2(adxl345, name, a, b)       /**< tracepoint with 2 arguments */
+#define ADXL345_TRACE3(name, a, b, c)    DTRACE_PROBE3(adxl345, name, a, b, c)    /**< tracepoint with 3 arguments */
+#else
+#define ADXL345_TRACE1(name, a)          do { } while (0)                         /**< tracepoint with 1 argument */
+#define ADXL345_TRACE2(name, a, b)       do { } while (0)                         /**< tracepoint with 2 arguments */
+#define ADXL345_TRACE3(name, a, b, c)    do { } while (0)                         /**< tracepoint with 3 arguments */
+#endif
+
 /**
  * @brief chip register definition
  */
@@ -84,7 +100,34 @@
 #define ADXL345_REG_FIFO_STATUS           0x39        /**< fifo status register */
 
 /**
- * @brief      iic or spi interface read bytes
+ * @brief     update the bus stats
+ * @param[in] *handle pointer to an adxl345 handle structure
+ * @param[in] start clock_us value before the transaction
+ * @param[in] res transaction result
+ * @param[in] read_len bytes read
+ * @param[in] write_len bytes written
+ * @note      none
+ */
+static void a_adxl345_bus_stats(adxl345_handle_t *handle, uint32_t start, uint8_t res, uint16_t read_len, uint16_t write_len)
+{
+    handle->stats.transfer++;                                                    /* count transaction */
+    if (res != 0)                                                                /* check result */
+    {
+        handle->stats.fail++;                                                    /* count failure */
+    }
+    else
+    {
+        handle->stats.read_byte += read_len;                                     /* count read bytes */
+        handle->stats.write_byte += write_len;                                   /* count written bytes */
+    }
+    if (handle->clock_us != NULL)                                                /* if clock */
+    {
+        handle->stats.bus_us += (uint32_t)(handle->clock_us() - start);          /* add bus time */
+    }
+}
+
+/**
+ * @brief      iic or spi interface read bytes once
  * @param[in]  *handle pointer to an adxl345 handle structure
  * @param[in]  reg iic register address
  * @param[out] *buf pointer to a data buffer
@@ -94,18 +137,19 @@
  *             - 1 read failed
  * @note       none
  */
-static uint8_t a_adxl345_iic_spi_read(adxl345_handle_t *handle, uint8_t reg, uint8_t *buf, uint16_t len)
+static uint8_t a_adxl345_iic_spi_read_once(adxl345_handle_t *handle, uint8_t reg, uint8_t *buf, uint16_t len)
 {
+    uint8_t res;
+    uint32_t start = 0;
+    
+    ADXL345_TRACE3(read_begin, handle, reg, len);                        /* trace read begin */
+    if (handle->clock_us != NULL)                                        /* if clock */
+    {
+        start = handle->clock_us();                                      /* get start time */
+    }
     if (handle->iic_spi == ADXL345_INTERFACE_IIC)                        /* iic interface */
     {
-        if (handle->iic_read(handle->iic_addr, reg, buf, len) != 0)      /* read data */
-        {
-            return 1;                                                    /* return error */
-        }
-        else
-        {
-            return 0;                                                    /* success return 0 */
-        }
+        res = handle->iic_read(handle->iic_addr, reg, buf, len);         /* read data */
     }
     else                                                                 /* spi interface */
     {
@@ -115,17 +159,107 @@ static uint8_t a_adxl345_iic_spi_read(adxl345_handle_t *handle, uint8_t reg, uin
         }
         reg |= 1 << 7;                                                   /* flag read */
         
-        if (handle->spi_read(reg, buf, len) != 0)                        /* read data */
-        {
-            return 1;                                                    /* return error */
-        }
-        else
+        res = handle->spi_read(reg, buf, len);                           /* read data */
+    }
+    a_adxl345_bus_stats(handle, start, res, len, 0);                     /* update stats */
+    ADXL345_TRACE3(read_end, handle, reg & 0x3F, res);                   /* trace read end */
+    if (res != 0)                                                        /* check result */
+    {
+        return 1;                                                        /* return error */
+    }
+    else
+    {
+        return 0;                                                        /* success return 0 */
+    }
+}
+
+/**
+ * @brief     iic or spi interface write bytes once
+ * @param[in] *handle pointer to an adxl345 handle structure
+ * @param[in] reg iic register address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of data
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      none
+ */
+static uint8_t a_adxl345_iic_spi_write_once(adxl345_handle_t *handle, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    uint8_t res;
+    uint32_t start = 0;
+    
+    ADXL345_TRACE3(write_begin, handle, reg, len);                        /* trace write begin */
+    if (handle->clock_us != NULL)                                         /* if clock */
+    {
+        start = handle->clock_us();                                       /* get start time */
+    }
+    if (handle->iic_spi == ADXL345_INTERFACE_IIC)                         /* iic interface */
+    {
+        res = handle->iic_write(handle->iic_addr, reg, buf, len);         /* write data */
+    }
+    else                                                                  /* spi interface */
+    {
+        if (len > 1)                                                      /* if length > 1 */
         {
-            return 0;                                                    /* success return 0 */
+            reg |= 1 << 6;                                                /* flag length > 1 */
         }
+        
+        res = handle->spi_write(reg, buf, len);                           /* write data */
+    }
+    a_adxl345_bus_stats(handle, start, res, 0, len);                      /* update stats */
+    ADXL345_TRACE3(write_end, handle, reg & 0x3F, res);                   /* trace write end */
+    if (res != 0)                                                         /* check result */
+    {
+        return 1;                                                         /* return error */
+    }
+    else
+    {
+        return 0;                                                         /* success return 0 */
+    }
+}
+
+/**
+ * @brief     wait before a bus retry
+ * @param[in] *handle pointer to an adxl345 handle structure
+ * @param[in] attempt retry index from 0
+ * @note      the backoff doubles on every retry
+ */
+static void a_adxl345_backoff(adxl345_handle_t *handle, uint8_t attempt)
+{
+    handle->stats.retry++;                                                               /* count retry */
+    if (handle->backoff_ms != 0)                                                         /* if backoff */
+    {
+        handle->delay_ms((uint32_t)handle->backoff_ms << ((attempt < 8) ? attempt : 8)); /* delay */
     }
 }
 
+/**
+ * @brief      iic or spi interface read bytes
+ * @param[in]  *handle pointer to an adxl345 handle structure
+ * @param[in]  reg iic register address
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of data
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       a failed read is retried up to the retry times
+ */
+static uint8_t a_adxl345_iic_spi_read(adxl345_handle_t *handle, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    uint8_t res;
+    uint8_t i;
+    
+    res = a_adxl345_iic_spi_read_once(handle, reg, buf, len);     /* read data */
+    for (i = 0; (res != 0) && (i < handle->retry); i++)           /* retry */
+    {
+        a_adxl345_backoff(handle, i);                             /* wait */
+        res = a_adxl345_iic_spi_read_once(handle, reg, buf, len); /* read data */
+    }
+    
+    return res;                                                   /* return result */
+}
+
 /**
  * @brief     iic or spi interface write bytes
  * @param[in] *handle pointer to an adxl345 handle structure
@@ -135,35 +269,235 @@ static uint8_t a_adxl345_iic_spi_read(adxl345_handle_t *handle, uint8_t reg, uin
  * @return    status code
  *            - 0 success
  *            - 1 write failed
- * @note      none
+ * @note      a failed write is retried up to the retry times
  */
 static uint8_t a_adxl345_iic_spi_write(adxl345_handle_t *handle, uint8_t reg, uint8_t *buf, uint16_t len)
 {
-    if (handle->iic_spi == ADXL345_INTERFACE_IIC)                         /* iic interface */
+    uint8_t res;
+    uint8_t i;
+    
+    res = a_adxl345_iic_spi_write_once(handle, reg, buf, len);     /* write data */
+    for (i = 0; (res != 0) && (i < handle->retry); i++)            /* retry */
     {
-        if (handle->iic_write(handle->iic_addr, reg, buf, len) != 0)      /* write data */
+        a_adxl345_backoff(handle, i);                              /* wait */
+        res = a_adxl345_iic_spi_write_once(handle, reg, buf, len); /* write data */
+    }
+    
+    return res;                                                    /* return result */
+}
+
+/**
+ * @brief          drain the fifo entries
+ * @param[in]      *handle pointer to an adxl345 handle structure
+ * @param[out]     *buf pointer to a data buffer
+ * @param[in, out] *len pointer to a length buffer, the wanted entries before and the read entries after
+ * @param[in]      cnt fifo entries
+ * @return         status code
+ *                 - 0 success
+ *                 - 1 read failed
+ * @note           every entry is read in its own 6 bytes transaction, a longer burst runs from DATAZ1 into
+ *                 FIFO_CTL instead of the next entry and the chip pops one entry per transaction only,
+ *                 a failed read may have popped its entry, so it isn't retried blindly, the fifo status
+ *                 is read at once before the backoff lets new entries cover the popped ones, the entries
+ *                 already read are kept, the popped entries are added to the gap and the backoff runs
+ *                 only before the next data read, the retry times count per entry, the gap is a lower
+ *                 bound since the entries made between the failed read and the status read hide the
+ *                 popped ones, it saturates at 0xFFFF
+ */
+static uint8_t a_adxl345_fifo_drain(adxl345_handle_t *handle, uint8_t *buf, uint16_t *len, uint8_t cnt)
+{
+    uint8_t res, prev;
+    uint8_t i;
+    uint8_t lost;
+    uint16_t n;
+    uint16_t want = *len;
+    
+    ADXL345_TRACE3(drain_begin, handle, cnt, want);                                     /* trace drain begin */
+    res = 0;                                                                            /* init 0 */
+    n = 0;                                                                              /* init 0 */
+    i = 0;                                                                              /* init 0 */
+    while ((n < want) && (cnt != 0))                                                    /* loop all entries */
+    {
+        res = a_adxl345_iic_spi_read_once(handle, ADXL345_REG_DATAX0, buf + 6 * n, 6);  /* read one entry */
+        if (res == 0)                                                                   /* check result */
+        {
+            n++;                                                                        /* next entry */
+            cnt--;                                                                      /* one popped */
+            i = 0;                                                                      /* reset retry */
+            
+            continue;                                                                   /* next */
+        }
+        if (i >= handle->retry)                                                         /* check retry */
         {
-            return 1;                                                     /* return error */
+            break;                                                                      /* give up */
         }
-        else
+        res = a_adxl345_iic_spi_read_once(handle, ADXL345_REG_FIFO_STATUS, &prev, 1);   /* read fifo status at once */
+        while ((res != 0) && (i < handle->retry))                                       /* retry the status */
+        {
+            a_adxl345_backoff(handle, i);                                               /* wait */
+            i++;                                                                        /* retry index */
+            res = a_adxl345_iic_spi_read_once(handle, ADXL345_REG_FIFO_STATUS, &prev, 1);/* read fifo status */
+        }
+        if (res != 0)                                                                   /* check result */
+        {
+            break;                                                                      /* give up */
+        }
+        prev &= 0x3F;                                                                   /* get cnt */
+        handle->stats.resync++;                                                         /* count resync */
+        if (prev < cnt)                                                                 /* if entries popped */
+        {
+            lost = cnt - prev;                                                          /* get lost entries */
+            handle->stats.gap += lost;                                                  /* count gap */
+            if (handle->gap > (0xFFFF - lost))                                          /* check the gap range */
+            {
+                lost = (uint8_t)(0xFFFF - handle->gap);                                 /* saturate the gap */
+            }
+            handle->gap += lost;                                                        /* add gap */
+        }
+        cnt = prev;                                                                     /* set cnt */
+        if (cnt == 0)                                                                   /* if empty */
+        {
+            break;                                                                      /* nothing to read */
+        }
+        if (i >= handle->retry)                                                         /* check retry */
         {
-            return 0;                                                     /* success return 0 */
+            res = 1;                                                                    /* set failed */
+            
+            break;                                                                      /* give up */
         }
+        a_adxl345_backoff(handle, i);                                                   /* wait before the data read */
+        i++;                                                                            /* retry index */
     }
-    else                                                                  /* spi interface */
+    *len = n;                                                                           /* set read entries */
+    if ((res == 0) && (handle->gap != 0))                                               /* if resynced */
     {
-        if (len > 1)                                                      /* if length > 1 */
+        handle->debug_print("adxl345: fifo resynced, %d samples lost.\n", handle->gap); /* resynced */
+    }
+    ADXL345_TRACE3(drain_end, handle, *len, handle->gap);                               /* trace drain end */
+    
+    return res;                                                                         /* return result */
+}
+
+/**
+ * @brief     clear the spike filter history
+ * @param[in] *handle pointer to an adxl345 handle structure
+ * @note      the history holds raw samples, so it is restarted when the raw scale changes
+ */
+static void a_adxl345_spike_clear(adxl345_handle_t *handle)
+{
+    handle->spike_fill = 0;                                          /* clear fill */
+    handle->spike_pos = 0;                                           /* clear position */
+    memset(handle->spike_history, 0, sizeof(handle->spike_history)); /* clear history */
+    memset(handle->spike_run, 0, sizeof(handle->spike_run));         /* clear run */
+}
+
+/**
+ * @brief         get the median of the spike samples
+ * @param[in,out] *buf pointer to a sample buffer, sorted on return
+ * @param[in]     len length of the sample buffer
+ * @return        median sample
+ * @note          the window is short so the insertion sort beats a selection
+ */
+static int16_t a_adxl345_spike_median(int16_t *buf, uint8_t len)
+{
+    uint8_t i, j;
+    int16_t v;
+    
+    for (i = 1; i < len; i++)               /* loop all samples */
+    {
+        v = buf[i];                         /* get sample */
+        j = i;                              /* set position */
+        while ((j > 0) && (buf[j - 1] > v)) /* find the slot */
         {
-            reg |= 1 << 6;                                                /* flag length > 1 */
+            buf[j] = buf[j - 1];            /* shift sample */
+            j--;                            /* previous slot */
         }
-        
-        if (handle->spi_write(reg, buf, len) != 0)                        /* write data */
+        buf[j] = v;                         /* insert sample */
+    }
+    
+    return buf[len / 2];                    /* return median */
+}
+
+/**
+ * @brief         reject the spikes of a read
+ * @param[in]     *handle pointer to an adxl345 handle structure
+ * @param[in,out] **raw pointer to a raw data buffer
+ * @param[in,out] **g pointer to a converted data buffer
+ * @param[in]     len length of the data buffer
+ * @param[in]     lsb g of one raw count
+ * @note          the distance is taken outside the band of the trailing samples rather than from their median,
+ *                so the lag of a trailing median on a steep waveform isn't flagged, the scale is the mad floored
+ *                at the largest step of the history so a window sitting on a flat peak doesn't flag the slope
+ *                after it, the held samples go into the history and a run longer than half the window is a real
+ *                step which is let through
+ */
+static void a_adxl345_spike_filter(adxl345_handle_t *handle, int16_t (*raw)[3], float (*g)[3], uint16_t len, float lsb)
+{
+    uint16_t i;
+    uint8_t j, k, last;
+    uint8_t window = handle->spike_window;
+    int16_t sort[ADXL345_SPIKE_MAX_WINDOW];
+    int16_t *history;
+    int16_t median, mad;
+    int32_t dist, diff, step;
+    float limit;
+    
+    for (i = 0; i < len; i++)                                                                          /* loop all samples */
+    {
+        last = (handle->spike_pos == 0) ? (uint8_t)(window - 1) : (uint8_t)(handle->spike_pos - 1);    /* get last delivered slot */
+        for (j = 0; j < 3; j++)                                                                        /* loop all axes */
         {
-            return 1;                                                     /* return error */
+            history = handle->spike_history[j];                                                        /* get history */
+            if (handle->spike_fill == window)                                                          /* if history is full */
+            {
+                memcpy(sort, history, sizeof(int16_t) * window);                                       /* copy history */
+                median = a_adxl345_spike_median(sort, window);                                         /* get median */
+                if (raw[i][j] > sort[window - 1])                                                      /* if above the band */
+                {
+                    dist = (int32_t)raw[i][j] - sort[window - 1];                                      /* get distance */
+                }
+                else if (raw[i][j] < sort[0])                                                          /* if below the band */
+                {
+                    dist = (int32_t)sort[0] - raw[i][j];                                               /* get distance */
+                }
+                else                                                                                   /* inside the band */
+                {
+                    dist = 0;                                                                          /* no distance */
+                }
+                for (k = 0; k < window; k++)                                                           /* loop history */
+                {
+                    sort[k] = (int16_t)((sort[k] > median) ? (sort[k] - median) : (median - sort[k])); /* set absolute deviation */
+                }
+                mad = a_adxl345_spike_median(sort, window);                                            /* get median absolute deviation */
+                step = 1;                                                                              /* at least one count */
+                for (k = 1; k < window; k++)                                                           /* loop history in time order */
+                {
+                    diff = (int32_t)history[(handle->spike_pos + k) % window] -
+                           history[(handle->spike_pos + k - 1) % window];                              /* get step */
+                    diff = (diff < 0) ? -diff : diff;                                                  /* get absolute step */
+                    step = (diff > step) ? diff : step;                                                /* keep the largest */
+                }
+                limit = 1.4826f * (float)mad;                                                          /* scale mad */
+                limit = handle->spike_threshold * (((float)step > limit) ? (float)step : limit);       /* get limit */
+                if (((float)dist > limit) && (handle->spike_run[j] < window / 2))                      /* if spike */
+                {
+                    raw[i][j] = history[last];                                                         /* hold last delivered sample */
+                    g[i][j] = (float)(raw[i][j]) * lsb;                                                /* convert again */
+                    handle->spike |= (uint32_t)1 << i;                                                 /* flag sample */
+                    handle->stats.spike++;                                                             /* count spike */
+                    handle->spike_run[j]++;                                                            /* count run */
+                }
+                else                                                                                   /* a real sample or step */
+                {
+                    handle->spike_run[j] = 0;                                                          /* clear run */
+                }
+            }
+            history[handle->spike_pos] = raw[i][j];                                                    /* save delivered sample */
         }
-        else
+        handle->spike_pos = (handle->spike_pos + 1 == window) ? 0 : (uint8_t)(handle->spike_pos + 1);  /* next slot */
+        if (handle->spike_fill < window)                                                               /* if history isn't full */
         {
-            return 0;                                                     /* success return 0 */
+            handle->spike_fill++;                                                                      /* fill history */
         }
     }
 }
@@ -2225,7 +2559,7 @@ uint8_t adxl345_get_interrupt_active_level(adxl345_handle_t *handle, adxl345_int
  *            - 1 set full resolution failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- * @note      none
+ * @note      the spike filter history is restarted on the new raw scale
  */
 uint8_t adxl345_set_full_resolution(adxl345_handle_t *handle, adxl345_bool_t enable)
 {
@@ -2250,7 +2584,14 @@ uint8_t adxl345_set_full_resolution(adxl345_handle_t *handle, adxl345_bool_t ena
     prev &= ~(1 << 3);                                                                          /* clear resolution */
     prev |= (enable << 3);                                                                      /* set resolution */
     
-    return a_adxl345_iic_spi_write(handle, ADXL345_REG_DATA_FORMAT, (uint8_t *)&prev, 1);       /* write config */
+    res = a_adxl345_iic_spi_write(handle, ADXL345_REG_DATA_FORMAT, (uint8_t *)&prev, 1);        /* write config */
+    if (res != 0)                                                                               /* check result */
+    {
+        return 1;                                                                               /* return error */
+    }
+    a_adxl345_spike_clear(handle);                                                              /* restart the spike history */
+    
+    return 0;                                                                                   /* success return 0 */
 }
 
 /**
@@ -2299,7 +2640,7 @@ uint8_t adxl345_get_full_resolution(adxl345_handle_t *handle, adxl345_bool_t *en
  *            - 1 set justify failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- * @note      none
+ * @note      the spike filter history is restarted on the new raw scale
  */
 uint8_t adxl345_set_justify(adxl345_handle_t *handle, adxl345_justify_t enable)
 {
@@ -2324,7 +2665,14 @@ uint8_t adxl345_set_justify(adxl345_handle_t *handle, adxl345_justify_t enable)
     prev &= ~(1 << 2);                                                                          /* clear config */
     prev |= (enable << 2);                                                                      /* set justify */
     
-    return a_adxl345_iic_spi_write(handle, ADXL345_REG_DATA_FORMAT, (uint8_t *)&prev, 1);       /* write config */
+    res = a_adxl345_iic_spi_write(handle, ADXL345_REG_DATA_FORMAT, (uint8_t *)&prev, 1);        /* write config */
+    if (res != 0)                                                                               /* check result */
+    {
+        return 1;                                                                               /* return error */
+    }
+    a_adxl345_spike_clear(handle);                                                              /* restart the spike history */
+    
+    return 0;                                                                                   /* success return 0 */
 }
 
 /**
@@ -2373,7 +2721,7 @@ uint8_t adxl345_get_justify(adxl345_handle_t *handle, adxl345_justify_t *enable)
  *            - 1 set range failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- * @note      none
+ * @note      the spike filter history is restarted on the new raw scale
  */
 uint8_t adxl345_set_range(adxl345_handle_t *handle, adxl345_range_t range)
 {
@@ -2398,7 +2746,14 @@ uint8_t adxl345_set_range(adxl345_handle_t *handle, adxl345_range_t range)
     prev &= ~(3 << 0);                                                                          /* clear config */
     prev |= (range << 0);                                                                       /* set range */
 
-    return a_adxl345_iic_spi_write(handle, ADXL345_REG_DATA_FORMAT, (uint8_t *)&prev, 1);       /* write config */
+    res = a_adxl345_iic_spi_write(handle, ADXL345_REG_DATA_FORMAT, (uint8_t *)&prev, 1);        /* write config */
+    if (res != 0)                                                                               /* check result */
+    {
+        return 1;                                                                               /* return error */
+    }
+    a_adxl345_spike_clear(handle);                                                              /* restart the spike history */
+    
+    return 0;                                                                                   /* success return 0 */
 }
 
 /**
@@ -3226,6 +3581,7 @@ uint8_t adxl345_init(adxl345_handle_t *handle)
         return 3;                                                                   /* return error */
     }
     
+    memset(&handle->stats, 0, sizeof(adxl345_stats_t));                             /* clear stats */
     if (handle->iic_spi == ADXL345_INTERFACE_IIC)                                   /* iic interface */
     {
         if (handle->iic_init() != 0)                                                /* initialize iic bus */
@@ -3338,6 +3694,7 @@ uint8_t adxl345_read(adxl345_handle_t *handle, int16_t (*raw)[3], float (*g)[3],
     uint8_t mode, cnt, i;
     uint8_t justify, full_res, range;
     uint8_t buf[32 * 6];
+    float lsb;
     
     if (handle == NULL)                                                                           /* check handle */
     {
@@ -3354,6 +3711,8 @@ uint8_t adxl345_read(adxl345_handle_t *handle, int16_t (*raw)[3], float (*g)[3],
        
         return 1;                                                                                 /* return error */
     }
+    handle->gap = 0;                                                                              /* clear gap */
+    handle->spike = 0;                                                                            /* clear spike */
     res = a_adxl345_iic_spi_read(handle, ADXL345_REG_FIFO_CTL, (uint8_t *)&prev, 1);              /* read config */
     if (res != 0)                                                                                 /* check result */
     {
@@ -3420,7 +3779,7 @@ uint8_t adxl345_read(adxl345_handle_t *handle, int16_t (*raw)[3], float (*g)[3],
                 {
                     if ((raw[0][0] & (1 << 15)) != 0)                                             /* check sigend bit */
                     {
-                        raw[0][0] = ((uint16_t)0xF3 << 8) | ((raw[0][0] >> 5) & 0x7FF);           /* negative */
+                        raw[0][0] = ((uint16_t)0xF8 << 8) | ((raw[0][0] >> 5) & 0x7FF);           /* negative */
                     }
                     else
                     {
@@ -3428,7 +3787,7 @@ uint8_t adxl345_read(adxl345_handle_t *handle, int16_t (*raw)[3], float (*g)[3],
                     }
                     if ((raw[0][1] & (1 << 15)) != 0)                                             /* check sigend bit */
                     {
-                        raw[0][1] = ((uint16_t)0xF3 << 8) | ((raw[0][1] >> 5) & 0x7FF);           /* negative */
+                        raw[0][1] = ((uint16_t)0xF8 << 8) | ((raw[0][1] >> 5) & 0x7FF);           /* negative */
                     }
                     else
                     {
@@ -3436,7 +3795,7 @@ uint8_t adxl345_read(adxl345_handle_t *handle, int16_t (*raw)[3], float (*g)[3],
                     }
                     if ((raw[0][2] & (1 << 15)) != 0)                                             /* check sigend bit */
                     {
-                        raw[0][2] = ((uint16_t)0xF3 << 8) | ((raw[0][2] >> 5) & 0x7FF);           /* negative */
+                        raw[0][2] = ((uint16_t)0xF8 << 8) | ((raw[0][2] >> 5) & 0x7FF);           /* negative */
                     }
                     else
                     {
@@ -3567,8 +3926,7 @@ uint8_t adxl345_read(adxl345_handle_t *handle, int16_t (*raw)[3], float (*g)[3],
             return 1;                                                                             /* return error */
         }
         cnt = prev & 0x3F;                                                                        /* get cnt */
-        *len = ((*len) < cnt) ? (*len) : cnt;                                                     /* get min cnt */
-        res = a_adxl345_iic_spi_read(handle, ADXL345_REG_DATAX0, (uint8_t *)buf, 6*(*len));       /* read data */
+        res = a_adxl345_fifo_drain(handle, (uint8_t *)buf, len, cnt);                             /* read data */
         if (res != 0)                                                                             /* check result */
         {
             handle->debug_print("adxl345: read failed.\n");                                       /* read failed */
@@ -3615,7 +3973,7 @@ uint8_t adxl345_read(adxl345_handle_t *handle, int16_t (*raw)[3], float (*g)[3],
                     {
                         if ((raw[i][0] & (1 << 15)) != 0)                                         /* check sigend bit */
                         {
-                            raw[i][0] = ((uint16_t)0xF3 << 8) | ((raw[i][0] >> 5) & 0x7FF);       /* negative */
+                            raw[i][0] = ((uint16_t)0xF8 << 8) | ((raw[i][0] >> 5) & 0x7FF);       /* negative */
                         }
                         else
                         {
@@ -3623,7 +3981,7 @@ uint8_t adxl345_read(adxl345_handle_t *handle, int16_t (*raw)[3], float (*g)[3],
                         }
                         if ((raw[i][1] & (1 << 15)) != 0)                                         /* check sigend bit */
                         {
-                            raw[i][1] = ((uint16_t)0xF3 << 8) | ((raw[i][1] >> 5) & 0x7FF);       /* negative */
+                            raw[i][1] = ((uint16_t)0xF8 << 8) | ((raw[i][1] >> 5) & 0x7FF);       /* negative */
                         }
                         else
                         {
@@ -3631,7 +3989,7 @@ uint8_t adxl345_read(adxl345_handle_t *handle, int16_t (*raw)[3], float (*g)[3],
                         }
                         if ((raw[i][2] & (1 << 15)) != 0)                                         /* check sigend bit */
                         {
-                            raw[i][2] = ((uint16_t)0xF3 << 8) | ((raw[i][2] >> 5) & 0x7FF);       /* negative */
+                            raw[i][2] = ((uint16_t)0xF8 << 8) | ((raw[i][2] >> 5) & 0x7FF);       /* negative */
                         }
                         else
                         {
@@ -3754,6 +4112,13 @@ uint8_t adxl345_read(adxl345_handle_t *handle, int16_t (*raw)[3], float (*g)[3],
         }
     }
     
+    if (handle->spike_window != 0)                                                                /* if spike filter */
+    {
+        lsb = (full_res == 1) ? 0.0039f : (0.0039f * (float)(1 << range));                       /* get lsb */
+        a_adxl345_spike_filter(handle, raw, g, *len, lsb);                                        /* reject spikes */
+    }
+    handle->stats.sample += *len;                                                                 /* count samples */
+    
     return 0;                                                                                     /* success return 0 */
 }
 
@@ -3770,6 +4135,7 @@ uint8_t adxl345_read(adxl345_handle_t *handle, int16_t (*raw)[3], float (*g)[3],
 uint8_t adxl345_irq_handler(adxl345_handle_t *handle)
 {
     uint8_t res, prev;
+    uint8_t i;
     
     if (handle == NULL)                                                                      /* check handle */
     {
@@ -3780,6 +4146,7 @@ uint8_t adxl345_irq_handler(adxl345_handle_t *handle)
         return 3;                                                                            /* return error */
     }
     
+    ADXL345_TRACE1(irq_entry, handle);                                                       /* trace irq entry */
     res = a_adxl345_iic_spi_read(handle, ADXL345_REG_INT_SOURCE, (uint8_t *)&prev, 1);       /* read config */
     if (res != 0)                                                                            /* check result */
     {
@@ -3787,6 +4154,19 @@ uint8_t adxl345_irq_handler(adxl345_handle_t *handle)
         
         return 1;                                                                            /* return error */
     }
+    for (i = 0; i < 8; i++)                                                                  /* count interrupts */
+    {
+        if ((prev & (1 << i)) != 0)                                                          /* if set */
+        {
+            handle->stats.irq[i]++;                                                          /* count type */
+        }
+    }
+    if ((prev & (1 << ADXL345_INTERRUPT_OVERRUN)) != 0)                                      /* if overrun */
+    {
+        handle->stats.overrun++;                                                             /* count overrun */
+        ADXL345_TRACE2(overrun, handle, handle->stats.overrun);                              /* trace overrun */
+    }
+    ADXL345_TRACE2(irq_dispatch, handle, prev);                                              /* trace irq dispatch */
     if ((prev & (1 << ADXL345_INTERRUPT_DATA_READY)) != 0)                                   /* if data ready */
     {
         if (handle->receive_callback != NULL)                                                /* if receive callback */
@@ -3847,6 +4227,307 @@ uint8_t adxl345_irq_handler(adxl345_handle_t *handle)
     return 0;                                                                                /* success return 0 */
 }
 
+/**
+ * @brief     complete an async read request
+ * @param[in] *arg pointer to an async request structure
+ * @note      none
+ */
+static void a_adxl345_async_done(void *arg)
+{
+    adxl345_async_request_t *request = (adxl345_async_request_t *)arg;
+    
+    request->callback(request);                                                                        /* run callback */
+}
+
+/**
+ * @brief     run an async read request
+ * @param[in] *arg pointer to an async request structure
+ * @note      none
+ */
+static void a_adxl345_async_work(void *arg)
+{
+    adxl345_async_request_t *request = (adxl345_async_request_t *)arg;
+    adxl345_handle_t *handle = request->handle;
+    
+    request->status = adxl345_read(handle, request->raw, request->g, &request->len);                 /* read data */
+    request->gap = handle->gap;                                                                        /* get gap */
+    request->spike = handle->spike;                                                                    /* get spike */
+    if ((handle->async_complete == NULL) ||
+        (handle->async_complete(a_adxl345_async_done, request) != 0))                                  /* hand off the callback */
+    {
+        a_adxl345_async_done(request);                                                                 /* run callback here */
+    }
+}
+
+/**
+ * @brief         submit an async read request
+ * @param[in]     *handle pointer to an adxl345 handle structure
+ * @param[in,out] *request pointer to an async request structure
+ * @return        status code
+ *                - 0 success
+ *                - 1 submit failed
+ *                - 2 handle is NULL
+ *                - 3 handle is not initialized
+ *                - 4 request is invalid
+ * @note          the request runs adxl345_read on the async_submit context and then hands request->callback
+ *                to async_complete, so the next read can start while the callback still runs,
+ *                if async_complete is not linked or fails the callback runs on the async_submit context,
+ *                if async_submit is not linked the request completes before this function returns,
+ *                the request and its buffers must stay valid until the callback and the handle must not
+ *                be used by other threads while a request is pending
+ */
+uint8_t adxl345_read_async(adxl345_handle_t *handle, adxl345_async_request_t *request)
+{
+    if (handle == NULL)                                                                   /* check handle */
+    {
+        return 2;                                                                         /* return error */
+    }
+    if (handle->inited != 1)                                                              /* check handle initialization */
+    {
+        return 3;                                                                         /* return error */
+    }
+    if ((request == NULL) || (request->callback == NULL) ||
+        (request->raw == NULL) || (request->g == NULL))                                   /* check request */
+    {
+        handle->debug_print("adxl345: request is invalid.\n");                            /* request is invalid */
+        
+        return 4;                                                                         /* return error */
+    }
+    
+    request->handle = handle;                                                             /* set handle */
+    if (handle->async_submit == NULL)                                                     /* no async support */
+    {
+        a_adxl345_async_work(request);                                                    /* run synchronously */
+        
+        return 0;                                                                         /* success return 0 */
+    }
+    if (handle->async_submit(a_adxl345_async_work, request) != 0)                         /* submit the request */
+    {
+        handle->debug_print("adxl345: async submit failed.\n");                           /* async submit failed */
+        
+        return 1;                                                                         /* return error */
+    }
+    
+    return 0;                                                                             /* success return 0 */
+}
+
+/**
+ * @brief      get the stats
+ * @param[in]  *handle pointer to an adxl345 handle structure
+ * @param[out] *stats pointer to an adxl345 stats structure
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       the counters are kept since adxl345_init or the last adxl345_reset_stats
+ */
+uint8_t adxl345_get_stats(adxl345_handle_t *handle, adxl345_stats_t *stats)
+{
+    if (handle == NULL)                                                 /* check handle */
+    {
+        return 2;                                                       /* return error */
+    }
+    if (handle->inited != 1)                                            /* check handle initialization */
+    {
+        return 3;                                                       /* return error */
+    }
+    
+    memcpy(stats, &handle->stats, sizeof(adxl345_stats_t));            /* copy stats */
+    
+    return 0;                                                           /* success return 0 */
+}
+
+/**
+ * @brief     reset the stats
+ * @param[in] *handle pointer to an adxl345 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t adxl345_reset_stats(adxl345_handle_t *handle)
+{
+    if (handle == NULL)                                                 /* check handle */
+    {
+        return 2;                                                       /* return error */
+    }
+    if (handle->inited != 1)                                            /* check handle initialization */
+    {
+        return 3;                                                       /* return error */
+    }
+    
+    memset(&handle->stats, 0, sizeof(adxl345_stats_t));                /* clear stats */
+    
+    return 0;                                                           /* success return 0 */
+}
+
+/**
+ * @brief     set the bus retry
+ * @param[in] *handle pointer to an adxl345 handle structure
+ * @param[in] times retry times of a failed transaction, 0 disables the retry
+ * @param[in] backoff_ms delay before the first retry, it doubles on every retry, 0 retries at once
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ * @note      it can be set before adxl345_init,
+ *            a failed fifo drain isn't retried blindly, the fifo is resynced with the fifo status read before the backoff
+ *            and the lost entries are reported by adxl345_get_gap
+ */
+uint8_t adxl345_set_retry(adxl345_handle_t *handle, uint8_t times, uint8_t backoff_ms)
+{
+    if (handle == NULL)                       /* check handle */
+    {
+        return 2;                             /* return error */
+    }
+    
+    handle->retry = times;                    /* set retry times */
+    handle->backoff_ms = backoff_ms;          /* set backoff */
+    
+    return 0;                                 /* success return 0 */
+}
+
+/**
+ * @brief      get the bus retry
+ * @param[in]  *handle pointer to an adxl345 handle structure
+ * @param[out] *times pointer to a retry times buffer
+ * @param[out] *backoff_ms pointer to a backoff buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ * @note       none
+ */
+uint8_t adxl345_get_retry(adxl345_handle_t *handle, uint8_t *times, uint8_t *backoff_ms)
+{
+    if (handle == NULL)                       /* check handle */
+    {
+        return 2;                             /* return error */
+    }
+    
+    *times = handle->retry;                   /* get retry times */
+    *backoff_ms = handle->backoff_ms;         /* get backoff */
+    
+    return 0;                                 /* success return 0 */
+}
+
+/**
+ * @brief      get the stream gap of the last read
+ * @param[in]  *handle pointer to an adxl345 handle structure
+ * @param[out] *gap pointer to a lost entries buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       the gap counts the entries popped by the failed reads of the last adxl345_read,
+ *             the samples made during the recovery stay in the fifo and aren't counted,
+ *             it is a lower bound, a sample that comes before the fifo status is read hides a popped
+ *             entry, check ADXL345_INTERRUPT_OVERRUN for the samples lost to a full fifo
+ */
+uint8_t adxl345_get_gap(adxl345_handle_t *handle, uint16_t *gap)
+{
+    if (handle == NULL)                       /* check handle */
+    {
+        return 2;                             /* return error */
+    }
+    if (handle->inited != 1)                  /* check handle initialization */
+    {
+        return 3;                             /* return error */
+    }
+    
+    *gap = handle->gap;                       /* get gap */
+    
+    return 0;                                 /* success return 0 */
+}
+
+/**
+ * @brief     set the spike filter
+ * @param[in] *handle pointer to an adxl345 handle structure
+ * @param[in] window samples of the history from 3 to ADXL345_SPIKE_MAX_WINDOW, 0 disables the filter
+ * @param[in] threshold largest distance from the history median in scaled median absolute deviations
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 4 param is invalid
+ * @note      it can be set before adxl345_init and clears the history, adxl345_set_range, adxl345_set_justify
+ *            and adxl345_set_full_resolution clear the history too because they change the scale of the data,
+ *            every axis of a read sample is compared with the band of the last window delivered samples,
+ *            a sample further outside than threshold times 1.4826 mads or the largest step of the history,
+ *            at least one lsb, is replaced by the last delivered sample, the filter is causal so it adds no
+ *            delay but a real step is held for half the window, 3 is the usual threshold and a window of 9 or
+ *            more lets through a sine below a sixth of the rate
+ */
+uint8_t adxl345_set_spike_filter(adxl345_handle_t *handle, uint8_t window, float threshold)
+{
+    if (handle == NULL)                                                         /* check handle */
+    {
+        return 2;                                                               /* return error */
+    }
+    if ((window != 0) && ((window < 3) || (window > ADXL345_SPIKE_MAX_WINDOW))) /* check window */
+    {
+        return 4;                                                               /* return error */
+    }
+    if ((window != 0) && (!(threshold > 0.0f)))                                 /* check threshold */
+    {
+        return 4;                                                               /* return error */
+    }
+    
+    handle->spike_window = window;                                              /* set window */
+    handle->spike_threshold = threshold;                                        /* set threshold */
+    handle->spike = 0;                                                          /* clear spike */
+    a_adxl345_spike_clear(handle);                                              /* clear history */
+    
+    return 0;                                                                   /* success return 0 */
+}
+
+/**
+ * @brief      get the spike filter
+ * @param[in]  *handle pointer to an adxl345 handle structure
+ * @param[out] *window pointer to a window buffer
+ * @param[out] *threshold pointer to a threshold buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ * @note       none
+ */
+uint8_t adxl345_get_spike_filter(adxl345_handle_t *handle, uint8_t *window, float *threshold)
+{
+    if (handle == NULL)                       /* check handle */
+    {
+        return 2;                             /* return error */
+    }
+    
+    *window = handle->spike_window;           /* get window */
+    *threshold = handle->spike_threshold;     /* get threshold */
+    
+    return 0;                                 /* success return 0 */
+}
+
+/**
+ * @brief      get the replaced samples of the last read
+ * @param[in]  *handle pointer to an adxl345 handle structure
+ * @param[out] *mask pointer to a sample mask buffer, bit i for sample i
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       a set bit means at least one axis of the sample was replaced by the spike filter
+ */
+uint8_t adxl345_get_spike(adxl345_handle_t *handle, uint32_t *mask)
+{
+    if (handle == NULL)                       /* check handle */
+    {
+        return 2;                             /* return error */
+    }
+    if (handle->inited != 1)                  /* check handle initialization */
+    {
+        return 3;                             /* return error */
+    }
+    
+    *mask = handle->spike;                    /* get spike */
+    
+    return 0;                                 /* success return 0 */
+}
+
 /**
  * @brief     set the chip register
  * @param[in] *handle pointer to an adxl345 handle structure
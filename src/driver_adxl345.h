@@ -270,6 +270,30 @@ typedef enum
  * @{
  */
 
+/**
+ * @brief adxl345 spike definition
+ */
+#define ADXL345_SPIKE_MAX_WINDOW        15        /**< longest spike filter history */
+
+/**
+ * @brief adxl345 stats structure definition
+ */
+typedef struct adxl345_stats_s
+{
+    uint32_t transfer;        /**< bus transaction count */
+    uint32_t read_byte;       /**< bytes read from the bus */
+    uint32_t write_byte;      /**< bytes written to the bus */
+    uint32_t fail;            /**< failed bus transaction count */
+    uint32_t retry;           /**< bus retry count */
+    uint32_t resync;          /**< fifo resync count after a failed drain */
+    uint32_t gap;             /**< fifo entries lost by the failed drains */
+    uint64_t bus_us;          /**< time spent in the bus calls, 0 without the clock_us hook */
+    uint32_t sample;          /**< samples delivered by adxl345_read */
+    uint32_t overrun;         /**< overruns seen in the interrupt source */
+    uint32_t spike;           /**< axis samples replaced by the spike filter */
+    uint32_t irq[8];          /**< interrupts seen by adxl345_irq_handler, indexed by adxl345_interrupt_t */
+} adxl345_stats_t;
+
 /**
  * @brief adxl345 handle structure definition
  */
@@ -287,10 +311,40 @@ typedef struct adxl345_handle_s
     void (*receive_callback)(uint8_t type);                                             /**< point to a receive_callback function address */
     void (*delay_ms)(uint32_t ms);                                                      /**< point to a delay_ms function address */
     void (*debug_print)(const char *const fmt, ...);                                    /**< point to a debug_print function address */
+    uint8_t (*async_submit)(void (*work)(void *arg), void *arg);                        /**< point to an async_submit function address */
+    uint8_t (*async_complete)(void (*done)(void *arg), void *arg);                      /**< point to an async_complete function address */
+    uint32_t (*clock_us)(void);                                                         /**< point to a clock_us function address */
     uint8_t inited;                                                                     /**< inited flag */
     uint8_t iic_spi;                                                                    /**< iic spi interface type */
+    uint8_t retry;                                                                      /**< bus retry times */
+    uint8_t backoff_ms;                                                                 /**< first retry backoff in ms */
+    uint16_t gap;                                                                       /**< fifo entries lost before the last read */
+    uint32_t spike;                                                                     /**< samples of the last read with a replaced axis, bit i for sample i */
+    uint8_t spike_window;                                                               /**< spike filter history length, 0 disables the filter */
+    uint8_t spike_fill;                                                                 /**< samples in the spike filter history */
+    uint8_t spike_pos;                                                                  /**< next slot of the spike filter history */
+    float spike_threshold;                                                              /**< spike threshold in scaled median absolute deviations */
+    int16_t spike_history[3][ADXL345_SPIKE_MAX_WINDOW];                                 /**< last delivered raw samples of every axis */
+    uint8_t spike_run[3];                                                               /**< replaced samples in a row of every axis */
+    adxl345_stats_t stats;                                                              /**< bus and event counters */
 } adxl345_handle_t;
 
+/**
+ * @brief adxl345 async request structure definition
+ */
+typedef struct adxl345_async_request_s
+{
+    adxl345_handle_t *handle;                                         /**< handle which runs the request */
+    int16_t (*raw)[3];                                                /**< raw data buffer */
+    float (*g)[3];                                                    /**< converted data buffer */
+    uint16_t len;                                                     /**< buffer length before, read length after */
+    uint8_t status;                                                   /**< adxl345_read status code */
+    uint16_t gap;                                                     /**< fifo entries lost before the read */
+    uint32_t spike;                                                   /**< samples with a replaced axis, bit i for sample i */
+    void (*callback)(struct adxl345_async_request_s *request);        /**< completion callback */
+    void *user;                                                       /**< user data */
+} adxl345_async_request_t;
+
 /**
  * @brief adxl345 information structure definition
  */
@@ -414,6 +468,30 @@ typedef struct adxl345_info_s
  */
 #define DRIVER_ADXL345_LINK_RECEIVE_CALLBACK(HANDLE, FUC)  (HANDLE)->receive_callback = FUC
 
+/**
+ * @brief     link async_submit function
+ * @param[in] HANDLE pointer to an adxl345 handle structure
+ * @param[in] FUC pointer to an async_submit function address
+ * @note      optional, the async requests run synchronously if it is not linked
+ */
+#define DRIVER_ADXL345_LINK_ASYNC_SUBMIT(HANDLE, FUC)      (HANDLE)->async_submit = FUC
+
+/**
+ * @brief     link async_complete function
+ * @param[in] HANDLE pointer to an adxl345 handle structure
+ * @param[in] FUC pointer to an async_complete function address
+ * @note      optional, the callbacks run on the async_submit context if it is not linked
+ */
+#define DRIVER_ADXL345_LINK_ASYNC_COMPLETE(HANDLE, FUC)    (HANDLE)->async_complete = FUC
+
+/**
+ * @brief     link clock_us function
+ * @param[in] HANDLE pointer to an adxl345 handle structure
+ * @param[in] FUC pointer to a clock_us function address
+ * @note      optional, the bus time isn't counted if it is not linked
+ */
+#define DRIVER_ADXL345_LINK_CLOCK_US(HANDLE, FUC)          (HANDLE)->clock_us = FUC
+
 /**
  * @}
  */
@@ -1290,7 +1368,7 @@ uint8_t adxl345_get_spi_wire(adxl345_handle_t *handle, adxl345_spi_wire_t *wire)
  *            - 1 set full resolution failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- * @note      none
+ * @note      the spike filter history is restarted on the new raw scale
  */
 uint8_t adxl345_set_full_resolution(adxl345_handle_t *handle, adxl345_bool_t enable);
 
@@ -1316,7 +1394,7 @@ uint8_t adxl345_get_full_resolution(adxl345_handle_t *handle, adxl345_bool_t *en
  *            - 1 set justify failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- * @note      none
+ * @note      the spike filter history is restarted on the new raw scale
  */
 uint8_t adxl345_set_justify(adxl345_handle_t *handle, adxl345_justify_t enable);
 
@@ -1342,7 +1420,7 @@ uint8_t adxl345_get_justify(adxl345_handle_t *handle, adxl345_justify_t *enable)
  *            - 1 set range failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- * @note      none
+ * @note      the spike filter history is restarted on the new raw scale
  */
 uint8_t adxl345_set_range(adxl345_handle_t *handle, adxl345_range_t range);
 
@@ -1723,6 +1801,165 @@ uint8_t adxl345_get_watermark(adxl345_handle_t *handle, uint8_t *level);
  */
 uint8_t adxl345_get_watermark_level(adxl345_handle_t *handle, uint8_t *level);
 
+/**
+ * @}
+ */
+
+/**
+ * @defgroup adxl345_async_driver adxl345 async driver function
+ * @brief    adxl345 async driver modules
+ * @ingroup  adxl345_driver
+ * @{
+ */
+
+/**
+ * @brief         submit an async read request
+ * @param[in]     *handle pointer to an adxl345 handle structure
+ * @param[in,out] *request pointer to an async request structure
+ * @return        status code
+ *                - 0 success
+ *                - 1 submit failed
+ *                - 2 handle is NULL
+ *                - 3 handle is not initialized
+ *                - 4 request is invalid
+ * @note          the request runs adxl345_read on the async_submit context and then hands request->callback
+ *                to async_complete, so the next read can start while the callback still runs,
+ *                if async_complete is not linked or fails the callback runs on the async_submit context,
+ *                if async_submit is not linked the request completes before this function returns,
+ *                the request and its buffers must stay valid until the callback and the handle must not
+ *                be used by other threads while a request is pending
+ */
+uint8_t adxl345_read_async(adxl345_handle_t *handle, adxl345_async_request_t *request);
+
+/**
+ * @}
+ */
+
+/**
+ * @defgroup adxl345_stats_driver adxl345 stats driver function
+ * @brief    adxl345 stats driver modules
+ * @ingroup  adxl345_driver
+ * @{
+ */
+
+/**
+ * @brief      get the stats
+ * @param[in]  *handle pointer to an adxl345 handle structure
+ * @param[out] *stats pointer to an adxl345 stats structure
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       the counters are kept since adxl345_init or the last adxl345_reset_stats
+ */
+uint8_t adxl345_get_stats(adxl345_handle_t *handle, adxl345_stats_t *stats);
+
+/**
+ * @brief     reset the stats
+ * @param[in] *handle pointer to an adxl345 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t adxl345_reset_stats(adxl345_handle_t *handle);
+
+/**
+ * @}
+ */
+
+/**
+ * @defgroup adxl345_recovery_driver adxl345 recovery driver function
+ * @brief    adxl345 recovery driver modules
+ * @ingroup  adxl345_driver
+ * @{
+ */
+
+/**
+ * @brief     set the bus retry
+ * @param[in] *handle pointer to an adxl345 handle structure
+ * @param[in] times retry times of a failed transaction, 0 disables the retry
+ * @param[in] backoff_ms delay before the first retry, it doubles on every retry, 0 retries at once
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ * @note      it can be set before adxl345_init,
+ *            a failed fifo drain isn't retried blindly, the fifo is resynced with the fifo status read before the backoff
+ *            and the lost entries are reported by adxl345_get_gap
+ */
+uint8_t adxl345_set_retry(adxl345_handle_t *handle, uint8_t times, uint8_t backoff_ms);
+
+/**
+ * @brief      get the bus retry
+ * @param[in]  *handle pointer to an adxl345 handle structure
+ * @param[out] *times pointer to a retry times buffer
+ * @param[out] *backoff_ms pointer to a backoff buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ * @note       none
+ */
+uint8_t adxl345_get_retry(adxl345_handle_t *handle, uint8_t *times, uint8_t *backoff_ms);
+
+/**
+ * @brief      get the stream gap of the last read
+ * @param[in]  *handle pointer to an adxl345 handle structure
+ * @param[out] *gap pointer to a lost entries buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       the gap counts the entries popped by the failed reads of the last adxl345_read,
+ *             the samples made during the recovery stay in the fifo and aren't counted,
+ *             it is a lower bound, a sample that comes before the fifo status is read hides a popped
+ *             entry, check ADXL345_INTERRUPT_OVERRUN for the samples lost to a full fifo
+ */
+uint8_t adxl345_get_gap(adxl345_handle_t *handle, uint16_t *gap);
+
+/**
+ * @brief     set the spike filter
+ * @param[in] *handle pointer to an adxl345 handle structure
+ * @param[in] window samples of the history from 3 to ADXL345_SPIKE_MAX_WINDOW, 0 disables the filter
+ * @param[in] threshold largest distance from the history median in scaled median absolute deviations
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 4 param is invalid
+ * @note      it can be set before adxl345_init and clears the history, adxl345_set_range, adxl345_set_justify
+ *            and adxl345_set_full_resolution clear the history too because they change the scale of the data,
+ *            every axis of a read sample is compared with the band of the last window delivered samples,
+ *            a sample further outside than threshold times 1.4826 mads or the largest step of the history,
+ *            at least one lsb, is replaced by the last delivered sample, the filter is causal so it adds no
+ *            delay but a real step is held for half the window, 3 is the usual threshold and a window of 9 or
+ *            more lets through a sine below a sixth of the rate
+ */
+uint8_t adxl345_set_spike_filter(adxl345_handle_t *handle, uint8_t window, float threshold);
+
+/**
+ * @brief      get the spike filter
+ * @param[in]  *handle pointer to an adxl345 handle structure
+ * @param[out] *window pointer to a window buffer
+ * @param[out] *threshold pointer to a threshold buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ * @note       none
+ */
+uint8_t adxl345_get_spike_filter(adxl345_handle_t *handle, uint8_t *window, float *threshold);
+
+/**
+ * @brief      get the replaced samples of the last read
+ * @param[in]  *handle pointer to an adxl345 handle structure
+ * @param[out] *mask pointer to a sample mask buffer, bit i for sample i
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       a set bit means at least one axis of the sample was replaced by the spike filter
+ */
+uint8_t adxl345_get_spike(adxl345_handle_t *handle, uint32_t *mask);
+
 /**
  * @}
  */
@@ -0,0 +1,358 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_adxl345_biquad.c
+ * @brief     driver adxl345 biquad source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_adxl345_biquad.h"
+#include <math.h>
+
+/**
+ * @brief pi definition
+ */
+#define ADXL345_BIQUAD_PI        3.14159265358979323846        /**< pi */
+
+/**
+ * @brief     check a rate
+ * @param[in] rate output data rate of the chip
+ * @return    status code
+ *            - 0 rate is valid
+ *            - 1 rate is invalid
+ * @note      none
+ */
+static uint8_t a_adxl345_biquad_check_rate(adxl345_rate_t rate)
+{
+    if ((rate > ADXL345_LOW_POWER_RATE_400) ||
+        ((rate > ADXL345_RATE_3200) && (rate < ADXL345_LOW_POWER_RATE_12P5))) /* check range */
+    {
+        return 1;                                                             /* return error */
+    }
+    
+    return 0;                                                                 /* success return 0 */
+}
+
+/**
+ * @brief      design a section
+ * @param[in]  *section pointer to an adxl345 biquad section structure
+ * @param[in]  rate_hz output data rate
+ * @param[out] *coeff pointer to an adxl345 biquad coefficient structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 frequency is above half the rate
+ * @note       the coefficients follow the audio eq cookbook and are normalized by a0
+ */
+static uint8_t a_adxl345_biquad_design(const adxl345_biquad_section_t *section, double rate_hz,
+                                       adxl345_biquad_coeff_t *coeff)
+{
+    double w0, cw, alpha, a0;
+    double b0, b1, b2;
+    
+    if ((double)section->hz >= rate_hz / 2.0)                     /* check frequency */
+    {
+        return 1;                                                 /* return error */
+    }
+    
+    w0 = 2.0 * ADXL345_BIQUAD_PI * (double)section->hz / rate_hz; /* get angular frequency */
+    cw = cos(w0);                                                 /* get cos */
+    alpha = sin(w0) / (2.0 * (double)section->q);                 /* get alpha */
+    if (section->type == ADXL345_BIQUAD_TYPE_LOW_PASS)            /* low pass */
+    {
+        b0 = (1.0 - cw) / 2.0;                                    /* set b0 */
+        b1 = 1.0 - cw;                                            /* set b1 */
+        b2 = (1.0 - cw) / 2.0;                                    /* set b2 */
+    }
+    else if (section->type == ADXL345_BIQUAD_TYPE_HIGH_PASS)      /* high pass */
+    {
+        b0 = (1.0 + cw) / 2.0;                                    /* set b0 */
+        b1 = -(1.0 + cw);                                         /* set b1 */
+        b2 = (1.0 + cw) / 2.0;                                    /* set b2 */
+    }
+    else if (section->type == ADXL345_BIQUAD_TYPE_BAND_PASS)      /* band pass */
+    {
+        b0 = alpha;                                               /* set b0 */
+        b1 = 0.0;                                                 /* set b1 */
+        b2 = -alpha;                                              /* set b2 */
+    }
+    else                                                          /* notch */
+    {
+        b0 = 1.0;                                                 /* set b0 */
+        b1 = -2.0 * cw;                                           /* set b1 */
+        b2 = 1.0;                                                 /* set b2 */
+    }
+    a0 = 1.0 + alpha;                                             /* get a0 */
+    coeff->b0 = (float)(b0 / a0);                                 /* normalize b0 */
+    coeff->b1 = (float)(b1 / a0);                                 /* normalize b1 */
+    coeff->b2 = (float)(b2 / a0);                                 /* normalize b2 */
+    coeff->a1 = (float)(-2.0 * cw / a0);                          /* normalize a1 */
+    coeff->a2 = (float)((1.0 - alpha) / a0);                      /* normalize a2 */
+    
+    return 0;                                                     /* success return 0 */
+}
+
+/**
+ * @brief         run a section over a block
+ * @param[in]     *coeff pointer to an adxl345 biquad coefficient structure
+ * @param[in,out] *z1 pointer to the first state of the 3 axes
+ * @param[in,out] *z2 pointer to the second state of the 3 axes
+ * @param[in,out] **g pointer to a converted data buffer
+ * @param[in]     len length of the data buffer
+ * @note          the states live in registers for the whole block, every output waits for the one before so
+ *                the three axes are interleaved to keep three independent chains in flight
+ */
+static void a_adxl345_biquad_section(const adxl345_biquad_coeff_t *restrict coeff,
+                                     float *restrict z1, float *restrict z2,
+                                     float (*restrict g)[3], uint16_t len)
+{
+    const float b0 = coeff->b0;
+    const float b1 = coeff->b1;
+    const float b2 = coeff->b2;
+    const float a1 = coeff->a1;
+    const float a2 = coeff->a2;
+    float s1[3];
+    float s2[3];
+    float x;
+    float y;
+    uint16_t n;
+    uint8_t j;
+    
+    for (j = 0; j < 3; j++)                  /* run all axes */
+    {
+        s1[j] = z1[j];                       /* load state */
+        s2[j] = z2[j];                       /* load state */
+    }
+    for (n = 0; n < len; n++)                /* run all samples */
+    {
+        for (j = 0; j < 3; j++)              /* run all axes */
+        {
+            x = g[n][j];                     /* input */
+            y = b0 * x + s1[j];              /* output */
+            s1[j] = b1 * x - a1 * y + s2[j]; /* update first state */
+            s2[j] = b2 * x - a2 * y;         /* update second state */
+            g[n][j] = y;                     /* write back */
+        }
+    }
+    for (j = 0; j < 3; j++)                  /* run all axes */
+    {
+        z1[j] = s1[j];                       /* save state */
+        z2[j] = s2[j];                       /* save state */
+    }
+}
+
+/**
+ * @brief     initialize the biquad cascade
+ * @param[in] *biquad pointer to an adxl345 biquad structure
+ * @param[in] rate output data rate of the chip
+ * @return    status code
+ *            - 0 success
+ *            - 2 biquad is NULL
+ *            - 4 rate is invalid
+ * @note      the cascade starts without sections and passes the samples unchanged
+ */
+uint8_t adxl345_biquad_init(adxl345_biquad_t *biquad, adxl345_rate_t rate)
+{
+    if (biquad == NULL)                              /* check biquad */
+    {
+        return 2;                                    /* return error */
+    }
+    if (a_adxl345_biquad_check_rate(rate) != 0)      /* check rate */
+    {
+        return 4;                                    /* return error */
+    }
+    
+    memset(biquad, 0, sizeof(adxl345_biquad_t));     /* clear the cascade */
+    biquad->rate = (uint8_t)(rate & 0x0F);           /* set rate row */
+    biquad->cached = (uint16_t)(1U << biquad->rate); /* the empty row is designed */
+    biquad->inited = 1;                              /* flag finish initialization */
+    
+    return 0;                                        /* success return 0 */
+}
+
+/**
+ * @brief     add a section to the biquad cascade
+ * @param[in] *biquad pointer to an adxl345 biquad structure
+ * @param[in] type filter type
+ * @param[in] hz corner or center frequency
+ * @param[in] q quality factor, 0.7071 for a butterworth low or high pass
+ * @return    status code
+ *            - 0 success
+ *            - 1 cascade is full
+ *            - 2 biquad is NULL
+ *            - 3 biquad is not initialized
+ *            - 4 param is invalid
+ * @note      hz is above 0 and below half the current rate, the coefficients of the other rates are
+ *            designed again on the next adxl345_biquad_set_rate and the states are cleared
+ */
+uint8_t adxl345_biquad_add_section(adxl345_biquad_t *biquad, adxl345_biquad_type_t type, float hz, float q)
+{
+    adxl345_biquad_section_t *section;
+    
+    if (biquad == NULL)                                                               /* check biquad */
+    {
+        return 2;                                                                     /* return error */
+    }
+    if (biquad->inited != 1)                                                          /* check biquad initialization */
+    {
+        return 3;                                                                     /* return error */
+    }
+    if (biquad->sections >= ADXL345_BIQUAD_MAX_SECTION)                               /* check sections */
+    {
+        return 1;                                                                     /* return error */
+    }
+    if ((type > ADXL345_BIQUAD_TYPE_NOTCH) || (hz <= 0.0f) || (q <= 0.0f))            /* check param */
+    {
+        return 4;                                                                     /* return error */
+    }
+    
+    section = &biquad->section[biquad->sections];                                     /* get section */
+    section->type = type;                                                             /* set type */
+    section->hz = hz;                                                                 /* set frequency */
+    section->q = q;                                                                   /* set quality factor */
+    if (a_adxl345_biquad_design(section, 3200.0 / (double)(1U << (15 - biquad->rate)),
+                                &biquad->cache[biquad->rate][biquad->sections]) != 0) /* design the current rate */
+    {
+        return 4;                                                                     /* return error */
+    }
+    biquad->sections++;                                                               /* sections++ */
+    biquad->cached = (uint16_t)(1U << biquad->rate);                                  /* only the current rate is designed */
+    
+    return adxl345_biquad_reset(biquad);                                              /* clear the states */
+}
+
+/**
+ * @brief     set the output data rate of the biquad cascade
+ * @param[in] *biquad pointer to an adxl345 biquad structure
+ * @param[in] rate output data rate of the chip
+ * @return    status code
+ *            - 0 success
+ *            - 2 biquad is NULL
+ *            - 3 biquad is not initialized
+ *            - 4 rate is invalid
+ * @note      a rate is designed once and its coefficients are cached, the low power rates share the
+ *            coefficients of the same normal rate, a rate whose half is below a section frequency is invalid
+ *            and the states are cleared
+ */
+uint8_t adxl345_biquad_set_rate(adxl345_biquad_t *biquad, adxl345_rate_t rate)
+{
+    uint8_t row;
+    uint8_t i;
+    
+    if (biquad == NULL)                                               /* check biquad */
+    {
+        return 2;                                                     /* return error */
+    }
+    if (biquad->inited != 1)                                          /* check biquad initialization */
+    {
+        return 3;                                                     /* return error */
+    }
+    if (a_adxl345_biquad_check_rate(rate) != 0)                       /* check rate */
+    {
+        return 4;                                                     /* return error */
+    }
+    
+    row = (uint8_t)(rate & 0x0F);                                     /* get rate row */
+    if ((biquad->cached & (1U << row)) == 0)                          /* if not designed */
+    {
+        for (i = 0; i < biquad->sections; i++)                        /* run all sections */
+        {
+            if (a_adxl345_biquad_design(&biquad->section[i], 3200.0 / (double)(1U << (15 - row)),
+                                        &biquad->cache[row][i]) != 0) /* design the section */
+            {
+                return 4;                                             /* return error */
+            }
+        }
+        biquad->cached |= (uint16_t)(1U << row);                      /* flag designed */
+    }
+    biquad->rate = row;                                               /* set rate row */
+    
+    return adxl345_biquad_reset(biquad);                              /* clear the states */
+}
+
+/**
+ * @brief     reset the biquad cascade
+ * @param[in] *biquad pointer to an adxl345 biquad structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 biquad is NULL
+ *            - 3 biquad is not initialized
+ * @note      the states are cleared
+ */
+uint8_t adxl345_biquad_reset(adxl345_biquad_t *biquad)
+{
+    if (biquad == NULL)                        /* check biquad */
+    {
+        return 2;                              /* return error */
+    }
+    if (biquad->inited != 1)                   /* check biquad initialization */
+    {
+        return 3;                              /* return error */
+    }
+    
+    memset(biquad->z1, 0, sizeof(biquad->z1)); /* clear first states */
+    memset(biquad->z2, 0, sizeof(biquad->z2)); /* clear second states */
+    
+    return 0;                                  /* success return 0 */
+}
+
+/**
+ * @brief         run the biquad cascade
+ * @param[in]     *biquad pointer to an adxl345 biquad structure
+ * @param[in,out] **g pointer to a converted data buffer
+ * @param[in]     len length of the data buffer
+ * @return        status code
+ *                - 0 success
+ *                - 2 biquad is NULL
+ *                - 3 biquad is not initialized
+ * @note          the samples are filtered in place in the transposed direct form II, one section over the whole
+ *                block at a time with the three axes interleaved
+ */
+uint8_t adxl345_biquad_process(adxl345_biquad_t *biquad, float (*g)[3], uint16_t len)
+{
+    uint8_t i;
+    
+    if (biquad == NULL)                                                 /* check biquad */
+    {
+        return 2;                                                       /* return error */
+    }
+    if (biquad->inited != 1)                                            /* check biquad initialization */
+    {
+        return 3;                                                       /* return error */
+    }
+    
+    for (i = 0; i < biquad->sections; i++)                              /* run all sections */
+    {
+        a_adxl345_biquad_section(&biquad->cache[biquad->rate][i],
+                                 biquad->z1[i], biquad->z2[i], g, len); /* run the section */
+    }
+    
+    return 0;                                                           /* success return 0 */
+}
@@ -0,0 +1,183 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_adxl345_biquad.h
+ * @brief     driver adxl345 biquad header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_ADXL345_BIQUAD_H
+#define DRIVER_ADXL345_BIQUAD_H
+
+#include "driver_adxl345.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup adxl345_biquad_driver adxl345 biquad driver function
+ * @brief    adxl345 biquad driver modules
+ * @ingroup  adxl345_driver
+ * @{
+ */
+
+/**
+ * @brief biquad section definition
+ */
+#define ADXL345_BIQUAD_MAX_SECTION        8        /**< largest section count of a cascade */
+
+/**
+ * @brief adxl345 biquad type enumeration definition
+ */
+typedef enum
+{
+    ADXL345_BIQUAD_TYPE_LOW_PASS  = 0x00,        /**< low pass */
+    ADXL345_BIQUAD_TYPE_HIGH_PASS = 0x01,        /**< high pass */
+    ADXL345_BIQUAD_TYPE_BAND_PASS = 0x02,        /**< band pass with 0dB at the center */
+    ADXL345_BIQUAD_TYPE_NOTCH     = 0x03,        /**< notch */
+} adxl345_biquad_type_t;
+
+/**
+ * @brief adxl345 biquad coefficient structure definition
+ */
+typedef struct adxl345_biquad_coeff_s
+{
+    float b0;        /**< feed forward coefficient 0 */
+    float b1;        /**< feed forward coefficient 1 */
+    float b2;        /**< feed forward coefficient 2 */
+    float a1;        /**< feedback coefficient 1 */
+    float a2;        /**< feedback coefficient 2 */
+} adxl345_biquad_coeff_t;
+
+/**
+ * @brief adxl345 biquad section structure definition
+ */
+typedef struct adxl345_biquad_section_s
+{
+    adxl345_biquad_type_t type;        /**< filter type */
+    float hz;                          /**< corner or center frequency */
+    float q;                           /**< quality factor */
+} adxl345_biquad_section_t;
+
+/**
+ * @brief adxl345 biquad structure definition
+ */
+typedef struct adxl345_biquad_s
+{
+    adxl345_biquad_section_t section[ADXL345_BIQUAD_MAX_SECTION];                /**< section designs */
+    adxl345_biquad_coeff_t cache[16][ADXL345_BIQUAD_MAX_SECTION];                /**< coefficients of every output data rate */
+    uint16_t cached;                                                             /**< designed rate mask */
+    uint8_t sections;                                                            /**< section count */
+    uint8_t rate;                                                                /**< cache row of the current rate */
+    float z1[ADXL345_BIQUAD_MAX_SECTION][3];                                     /**< first state of every section and axis */
+    float z2[ADXL345_BIQUAD_MAX_SECTION][3];                                     /**< second state of every section and axis */
+    uint8_t inited;                                                              /**< inited flag */
+} adxl345_biquad_t;
+
+/**
+ * @brief     initialize the biquad cascade
+ * @param[in] *biquad pointer to an adxl345 biquad structure
+ * @param[in] rate output data rate of the chip
+ * @return    status code
+ *            - 0 success
+ *            - 2 biquad is NULL
+ *            - 4 rate is invalid
+ * @note      the cascade starts without sections and passes the samples unchanged
+ */
+uint8_t adxl345_biquad_init(adxl345_biquad_t *biquad, adxl345_rate_t rate);
+
+/**
+ * @brief     add a section to the biquad cascade
+ * @param[in] *biquad pointer to an adxl345 biquad structure
+ * @param[in] type filter type
+ * @param[in] hz corner or center frequency
+ * @param[in] q quality factor, 0.7071 for a butterworth low or high pass
+ * @return    status code
+ *            - 0 success
+ *            - 1 cascade is full
+ *            - 2 biquad is NULL
+ *            - 3 biquad is not initialized
+ *            - 4 param is invalid
+ * @note      hz is above 0 and below half the current rate, the coefficients of the other rates are
+ *            designed again on the next adxl345_biquad_set_rate and the states are cleared
+ */
+uint8_t adxl345_biquad_add_section(adxl345_biquad_t *biquad, adxl345_biquad_type_t type, float hz, float q);
+
+/**
+ * @brief     set the output data rate of the biquad cascade
+ * @param[in] *biquad pointer to an adxl345 biquad structure
+ * @param[in] rate output data rate of the chip
+ * @return    status code
+ *            - 0 success
+ *            - 2 biquad is NULL
+ *            - 3 biquad is not initialized
+ *            - 4 rate is invalid
+ * @note      a rate is designed once and its coefficients are cached, the low power rates share the
+ *            coefficients of the same normal rate, a rate whose half is below a section frequency is invalid
+ *            and the states are cleared
+ */
+uint8_t adxl345_biquad_set_rate(adxl345_biquad_t *biquad, adxl345_rate_t rate);
+
+/**
+ * @brief     reset the biquad cascade
+ * @param[in] *biquad pointer to an adxl345 biquad structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 biquad is NULL
+ *            - 3 biquad is not initialized
+ * @note      the states are cleared
+ */
+uint8_t adxl345_biquad_reset(adxl345_biquad_t *biquad);
+
+/**
+ * @brief         run the biquad cascade
+ * @param[in]     *biquad pointer to an adxl345 biquad structure
+ * @param[in,out] **g pointer to a converted data buffer
+ * @param[in]     len length of the data buffer
+ * @return        status code
+ *                - 0 success
+ *                - 2 biquad is NULL
+ *                - 3 biquad is not initialized
+ * @note          the samples are filtered in place in the transposed direct form II, one section over the whole
+ *                block at a time with the three axes interleaved
+ */
+uint8_t adxl345_biquad_process(adxl345_biquad_t *biquad, float (*g)[3], uint16_t len);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,316 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_adxl345_envelope.c
+ * @brief     driver adxl345 envelope source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_adxl345_envelope.h"
+#include <math.h>
+
+/**
+ * @brief butterworth definition
+ */
+#define ADXL345_ENVELOPE_Q_0        0.5411961f        /**< quality factor of the first fourth order butterworth section */
+#define ADXL345_ENVELOPE_Q_1        1.3065630f        /**< quality factor of the second fourth order butterworth section */
+
+/**
+ * @brief     clear the block sums
+ * @param[in] *envelope pointer to an adxl345 envelope structure
+ * @note      none
+ */
+static void a_adxl345_envelope_clear(adxl345_envelope_t *envelope)
+{
+    memset(envelope->sum, 0, sizeof(envelope->sum));                   /* clear sum */
+    memset(envelope->sum_2, 0, sizeof(envelope->sum_2));               /* clear square sum */
+    memset(envelope->sum_3, 0, sizeof(envelope->sum_3));               /* clear cube sum */
+    memset(envelope->sum_4, 0, sizeof(envelope->sum_4));               /* clear fourth power sum */
+    memset(envelope->sum_envelope, 0, sizeof(envelope->sum_envelope)); /* clear envelope sum */
+    memset(envelope->peak, 0, sizeof(envelope->peak));                 /* clear peak */
+    envelope->count = 0;                                               /* clear count */
+}
+
+/**
+ * @brief     finish a block
+ * @param[in] *envelope pointer to an adxl345 envelope structure
+ * @note      the central moments come from the raw power sums in double, the band has no mean
+ *            so nothing cancels
+ */
+static void a_adxl345_envelope_finish(adxl345_envelope_t *envelope)
+{
+    adxl345_envelope_result_t *result = &envelope->result;
+    double n = (double)envelope->count;
+    double mean, m2, m4;
+    uint8_t j;
+    
+    result->count = envelope->count;                                                         /* set count */
+    for (j = 0; j < 3; j++)                                                                  /* run all axes */
+    {
+        mean = envelope->sum[j] / n;                                                         /* get mean */
+        m2 = envelope->sum_2[j] / n - mean * mean;                                           /* get variance */
+        m4 = envelope->sum_4[j] / n - 4.0 * mean * envelope->sum_3[j] / n
+             + 6.0 * mean * mean * envelope->sum_2[j] / n - 3.0 * mean * mean * mean * mean; /* get fourth moment */
+        m2 = (m2 > 0.0) ? m2 : 0.0;                                                          /* clamp rounding */
+        result->rms[j] = (float)sqrt(m2);                                                    /* set rms */
+        result->peak[j] = envelope->peak[j];                                                 /* set peak */
+        result->crest[j] = (m2 > 0.0) ? (float)(envelope->peak[j] / sqrt(m2)) : 0.0f;        /* set crest factor */
+        result->kurtosis[j] = (m2 > 0.0) ? (float)(m4 / (m2 * m2)) : 0.0f;                   /* set kurtosis */
+        result->envelope[j] = (float)(envelope->sum_envelope[j] / n);                        /* set envelope mean */
+    }
+    envelope->blocks++;                                                                      /* blocks++ */
+    a_adxl345_envelope_clear(envelope);                                                      /* start the next block */
+}
+
+/**
+ * @brief     initialize the envelope stage
+ * @param[in] *envelope pointer to an adxl345 envelope structure
+ * @param[in] rate output data rate of the chip
+ * @param[in] band_hz corner of the band high pass
+ * @param[in] envelope_hz corner of the envelope low pass
+ * @param[in] block samples of one block
+ * @param[in] *callback pointer to a block callback function address
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ *            - 2 envelope is NULL
+ *            - 4 param is invalid
+ * @note      both filters are fourth order butterworth, envelope_hz is below band_hz, band_hz is below
+ *            half the rate and the callback may be NULL
+ */
+uint8_t adxl345_envelope_init(adxl345_envelope_t *envelope, adxl345_rate_t rate, float band_hz, float envelope_hz,
+                              uint32_t block,
+                              void (*callback)(adxl345_envelope_t *envelope, const adxl345_envelope_result_t *result))
+{
+    uint8_t res;
+    
+    if (envelope == NULL)                                                    /* check envelope */
+    {
+        return 2;                                                            /* return error */
+    }
+    if ((block == 0) || (envelope_hz <= 0.0f) || (envelope_hz >= band_hz))   /* check param */
+    {
+        return 4;                                                            /* return error */
+    }
+    
+    memset(envelope, 0, sizeof(adxl345_envelope_t));                         /* clear the stage */
+    res = adxl345_biquad_init(&envelope->band, rate);                        /* init the band */
+    if (res == 0)                                                            /* if ok */
+    {
+        res = adxl345_biquad_add_section(&envelope->band, ADXL345_BIQUAD_TYPE_HIGH_PASS,
+                                         band_hz, ADXL345_ENVELOPE_Q_0);     /* add the first section */
+    }
+    if (res == 0)                                                            /* if ok */
+    {
+        res = adxl345_biquad_add_section(&envelope->band, ADXL345_BIQUAD_TYPE_HIGH_PASS,
+                                         band_hz, ADXL345_ENVELOPE_Q_1);     /* add the second section */
+    }
+    if (res == 0)                                                            /* if ok */
+    {
+        res = adxl345_biquad_init(&envelope->smooth, rate);                  /* init the smoothing */
+    }
+    if (res == 0)                                                            /* if ok */
+    {
+        res = adxl345_biquad_add_section(&envelope->smooth, ADXL345_BIQUAD_TYPE_LOW_PASS,
+                                         envelope_hz, ADXL345_ENVELOPE_Q_0); /* add the first section */
+    }
+    if (res == 0)                                                            /* if ok */
+    {
+        res = adxl345_biquad_add_section(&envelope->smooth, ADXL345_BIQUAD_TYPE_LOW_PASS,
+                                         envelope_hz, ADXL345_ENVELOPE_Q_1); /* add the second section */
+    }
+    if (res == 4)                                                            /* check rate and frequencies */
+    {
+        return 4;                                                            /* return error */
+    }
+    else if (res != 0)                                                       /* check the result */
+    {
+        return 1;                                                            /* return error */
+    }
+    envelope->block = block;                                                 /* set block */
+    envelope->callback = callback;                                           /* set callback */
+    envelope->inited = 1;                                                    /* flag finish initialization */
+    
+    return 0;                                                                /* success return 0 */
+}
+
+/**
+ * @brief     reset the envelope stage
+ * @param[in] *envelope pointer to an adxl345 envelope structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 envelope is NULL
+ *            - 3 envelope is not initialized
+ * @note      the filter states are cleared and the block being filled is restarted
+ */
+uint8_t adxl345_envelope_reset(adxl345_envelope_t *envelope)
+{
+    if (envelope == NULL)                          /* check envelope */
+    {
+        return 2;                                  /* return error */
+    }
+    if (envelope->inited != 1)                     /* check envelope initialization */
+    {
+        return 3;                                  /* return error */
+    }
+    
+    (void)adxl345_biquad_reset(&envelope->band);   /* clear the band */
+    (void)adxl345_biquad_reset(&envelope->smooth); /* clear the smoothing */
+    a_adxl345_envelope_clear(envelope);            /* restart the block */
+    
+    return 0;                                      /* success return 0 */
+}
+
+/**
+ * @brief         update the envelope stage
+ * @param[in]     *envelope pointer to an adxl345 envelope structure
+ * @param[in,out] **g pointer to a converted data buffer
+ * @param[in]     len length of the data buffer
+ * @return        status code
+ *                - 0 success
+ *                - 2 envelope is NULL
+ *                - 3 envelope is not initialized
+ * @note          the samples are replaced by the envelope in place, a batch may end anywhere in a block,
+ *                the result is made and the callback runs at the end of every block
+ */
+uint8_t adxl345_envelope_update(adxl345_envelope_t *envelope, float (*g)[3], uint16_t len)
+{
+    double sum[3];
+    double sum_2[3];
+    double sum_3[3];
+    double sum_4[3];
+    double sum_envelope[3];
+    float peak[3];
+    double x, x2;
+    uint32_t n;
+    uint32_t i;
+    uint8_t j;
+    
+    if (envelope == NULL)                                                /* check envelope */
+    {
+        return 2;                                                        /* return error */
+    }
+    if (envelope->inited != 1)                                           /* check envelope initialization */
+    {
+        return 3;                                                        /* return error */
+    }
+    
+    while (len > 0)                                                      /* run all samples */
+    {
+        n = envelope->block - envelope->count;                           /* samples left in the block */
+        n = (n < len) ? n : len;                                         /* limit to the batch */
+        for (j = 0; j < 3; j++)                                          /* run all axes */
+        {
+            sum[j] = envelope->sum[j];                                   /* load sum */
+            sum_2[j] = envelope->sum_2[j];                               /* load square sum */
+            sum_3[j] = envelope->sum_3[j];                               /* load cube sum */
+            sum_4[j] = envelope->sum_4[j];                               /* load fourth power sum */
+            sum_envelope[j] = envelope->sum_envelope[j];                 /* load envelope sum */
+            peak[j] = envelope->peak[j];                                 /* load peak */
+        }
+        (void)adxl345_biquad_process(&envelope->band, g, (uint16_t)n);   /* high pass the band */
+        for (i = 0; i < n; i++)                                          /* run the chunk */
+        {
+            for (j = 0; j < 3; j++)                                      /* run all axes */
+            {
+                x = g[i][j];                                             /* get band */
+                x2 = x * x;                                              /* get square */
+                sum[j] += x;                                             /* sum */
+                sum_2[j] += x2;                                          /* sum squares */
+                sum_3[j] += x2 * x;                                      /* sum cubes */
+                sum_4[j] += x2 * x2;                                     /* sum fourth powers */
+                g[i][j] = fabsf(g[i][j]);                                /* rectify */
+                peak[j] = (g[i][j] > peak[j]) ? g[i][j] : peak[j];       /* update peak */
+            }
+        }
+        (void)adxl345_biquad_process(&envelope->smooth, g, (uint16_t)n); /* low pass the rectified band */
+        for (i = 0; i < n; i++)                                          /* run the chunk */
+        {
+            for (j = 0; j < 3; j++)                                      /* run all axes */
+            {
+                sum_envelope[j] += g[i][j];                              /* sum the envelope */
+            }
+        }
+        for (j = 0; j < 3; j++)                                          /* run all axes */
+        {
+            envelope->sum[j] = sum[j];                                   /* save sum */
+            envelope->sum_2[j] = sum_2[j];                               /* save square sum */
+            envelope->sum_3[j] = sum_3[j];                               /* save cube sum */
+            envelope->sum_4[j] = sum_4[j];                               /* save fourth power sum */
+            envelope->sum_envelope[j] = sum_envelope[j];                 /* save envelope sum */
+            envelope->peak[j] = peak[j];                                 /* save peak */
+        }
+        envelope->count += n;                                            /* count += n */
+        g += n;                                                          /* next chunk */
+        len = (uint16_t)(len - n);                                       /* len -= n */
+        if (envelope->count == envelope->block)                          /* if the block is full */
+        {
+            a_adxl345_envelope_finish(envelope);                         /* finish the block */
+            if (envelope->callback != NULL)                              /* if the callback is linked */
+            {
+                envelope->callback(envelope, &envelope->result);         /* run callback */
+            }
+        }
+    }
+    
+    return 0;                                                            /* success return 0 */
+}
+
+/**
+ * @brief      get the result of the last block
+ * @param[in]  *envelope pointer to an adxl345 envelope structure
+ * @param[out] *result pointer to an adxl345 envelope result structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 no block
+ *             - 2 envelope is NULL
+ *             - 3 envelope is not initialized
+ * @note       none
+ */
+uint8_t adxl345_envelope_get(adxl345_envelope_t *envelope, adxl345_envelope_result_t *result)
+{
+    if (envelope == NULL)                                                 /* check envelope */
+    {
+        return 2;                                                         /* return error */
+    }
+    if (envelope->inited != 1)                                            /* check envelope initialization */
+    {
+        return 3;                                                         /* return error */
+    }
+    if (envelope->blocks == 0)                                            /* check blocks */
+    {
+        return 1;                                                         /* return error */
+    }
+    
+    memcpy(result, &envelope->result, sizeof(adxl345_envelope_result_t)); /* copy result */
+    
+    return 0;                                                             /* success return 0 */
+}
@@ -0,0 +1,154 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_adxl345_envelope.h
+ * @brief     driver adxl345 envelope header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_ADXL345_ENVELOPE_H
+#define DRIVER_ADXL345_ENVELOPE_H
+
+#include "driver_adxl345_biquad.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup adxl345_envelope_driver adxl345 envelope driver function
+ * @brief    adxl345 envelope driver modules
+ * @ingroup  adxl345_driver
+ * @{
+ */
+
+/**
+ * @brief adxl345 envelope result structure definition
+ */
+typedef struct adxl345_envelope_result_s
+{
+    uint32_t count;             /**< samples of the block */
+    float rms[3];               /**< rms of the band in g */
+    float peak[3];              /**< absolute peak of the band in g */
+    float crest[3];             /**< peak / rms of the band */
+    float kurtosis[3];          /**< kurtosis of the band, 3 for gaussian noise, 1.5 for a sine */
+    float envelope[3];          /**< mean of the envelope in g */
+} adxl345_envelope_result_t;
+
+/**
+ * @brief adxl345 envelope structure definition
+ */
+typedef struct adxl345_envelope_s
+{
+    adxl345_biquad_t band;                                                                                   /**< high pass of the band */
+    adxl345_biquad_t smooth;                                                                                 /**< low pass of the rectified band */
+    double sum[3];                                                                                           /**< sum of the band */
+    double sum_2[3];                                                                                         /**< sum of the band squares */
+    double sum_3[3];                                                                                         /**< sum of the band cubes */
+    double sum_4[3];                                                                                         /**< sum of the band fourth powers */
+    double sum_envelope[3];                                                                                  /**< sum of the envelope */
+    float peak[3];                                                                                           /**< absolute peak of the band */
+    adxl345_envelope_result_t result;                                                                        /**< last block result */
+    uint32_t block;                                                                                          /**< samples of one block */
+    uint32_t count;                                                                                          /**< samples of the block being filled */
+    uint32_t blocks;                                                                                         /**< finished blocks */
+    void (*callback)(struct adxl345_envelope_s *envelope, const adxl345_envelope_result_t *result);           /**< block callback */
+    void *user;                                                                                              /**< user data */
+    uint8_t inited;                                                                                          /**< inited flag */
+} adxl345_envelope_t;
+
+/**
+ * @brief     initialize the envelope stage
+ * @param[in] *envelope pointer to an adxl345 envelope structure
+ * @param[in] rate output data rate of the chip
+ * @param[in] band_hz corner of the band high pass
+ * @param[in] envelope_hz corner of the envelope low pass
+ * @param[in] block samples of one block
+ * @param[in] *callback pointer to a block callback function address
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ *            - 2 envelope is NULL
+ *            - 4 param is invalid
+ * @note      both filters are fourth order butterworth, envelope_hz is below band_hz, band_hz is below
+ *            half the rate and the callback may be NULL
+ */
+uint8_t adxl345_envelope_init(adxl345_envelope_t *envelope, adxl345_rate_t rate, float band_hz, float envelope_hz,
+                              uint32_t block,
+                              void (*callback)(adxl345_envelope_t *envelope, const adxl345_envelope_result_t *result));
+
+/**
+ * @brief     reset the envelope stage
+ * @param[in] *envelope pointer to an adxl345 envelope structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 envelope is NULL
+ *            - 3 envelope is not initialized
+ * @note      the filter states are cleared and the block being filled is restarted
+ */
+uint8_t adxl345_envelope_reset(adxl345_envelope_t *envelope);
+
+/**
+ * @brief         update the envelope stage
+ * @param[in]     *envelope pointer to an adxl345 envelope structure
+ * @param[in,out] **g pointer to a converted data buffer
+ * @param[in]     len length of the data buffer
+ * @return        status code
+ *                - 0 success
+ *                - 2 envelope is NULL
+ *                - 3 envelope is not initialized
+ * @note          the samples are replaced by the envelope in place, a batch may end anywhere in a block,
+ *                the result is made and the callback runs at the end of every block
+ */
+uint8_t adxl345_envelope_update(adxl345_envelope_t *envelope, float (*g)[3], uint16_t len);
+
+/**
+ * @brief      get the result of the last block
+ * @param[in]  *envelope pointer to an adxl345 envelope structure
+ * @param[out] *result pointer to an adxl345 envelope result structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 no block
+ *             - 2 envelope is NULL
+ *             - 3 envelope is not initialized
+ * @note       none
+ */
+uint8_t adxl345_envelope_get(adxl345_envelope_t *envelope, adxl345_envelope_result_t *result);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
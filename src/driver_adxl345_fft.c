@@ -0,0 +1,448 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_adxl345_fft.c
+ * @brief     driver adxl345 fft source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_adxl345_fft.h"
+#include <math.h>
+
+/**
+ * @brief pi definition
+ */
+#define ADXL345_FFT_PI        3.14159265358979323846        /**< pi */
+
+/**
+ * @brief     run a segment of every axis
+ * @param[in] *welch pointer to an adxl345 welch structure
+ * @note      the input keeps the last n - hop samples for the next segment
+ */
+static void a_adxl345_welch_segment(adxl345_welch_t *welch)
+{
+    uint16_t bins = (uint16_t)(welch->n / 2 + 1);
+    uint16_t i;
+    uint8_t axis;
+    float *input;
+    float *psd;
+    float mean;
+    
+    for (axis = 0; axis < 3; axis++)                                                         /* run all axes */
+    {
+        input = &welch->input[axis * welch->n];                                              /* get axis input */
+        psd = &welch->psd[axis * bins];                                                      /* get axis power */
+        mean = 0.0f;                                                                         /* init 0 */
+        for (i = 0; i < welch->n; i++)                                                       /* run all samples */
+        {
+            mean += input[i];                                                                /* sum */
+        }
+        mean /= (float)welch->n;                                                             /* get mean */
+        for (i = 0; i < welch->n; i++)                                                       /* run all samples */
+        {
+            welch->segment[i] = (input[i] - mean) * welch->window[i];                        /* detrend and window */
+        }
+        (void)adxl345_fft_forward(welch->fft, welch->segment, welch->bin_re, welch->bin_im); /* run fft */
+        for (i = 0; i < bins; i++)                                                           /* run all bins */
+        {
+            psd[i] += welch->bin_re[i] * welch->bin_re[i] +
+                      welch->bin_im[i] * welch->bin_im[i];                                   /* add power */
+        }
+        memmove(input, &input[welch->hop], sizeof(float) * (welch->n - welch->hop));         /* keep the overlap */
+    }
+    welch->fill = (uint16_t)(welch->n - welch->hop);                                         /* set fill */
+    welch->segments++;                                                                       /* segments++ */
+}
+
+/**
+ * @brief     run the butterflies of a group
+ * @param[in] *ar pointer to the upper real part
+ * @param[in] *ai pointer to the upper imaginary part
+ * @param[in] *br pointer to the lower real part
+ * @param[in] *bi pointer to the lower imaginary part
+ * @param[in] *sr pointer to the twiddle real part
+ * @param[in] *si pointer to the twiddle imaginary part
+ * @param[in] half butterflies of the group
+ * @note      the arrays don't overlap, so the loop is vectorized with neon or sse
+ */
+static void a_adxl345_fft_butterfly(float *restrict ar, float *restrict ai, float *restrict br, float *restrict bi,
+                                    const float *restrict sr, const float *restrict si, uint32_t half)
+{
+    uint32_t j;
+    float tr;
+    float ti;
+    
+    for (j = 0; j < half; j++)              /* run all butterflies */
+    {
+        tr = sr[j] * br[j] - si[j] * bi[j]; /* twiddled real part */
+        ti = sr[j] * bi[j] + si[j] * br[j]; /* twiddled imaginary part */
+        br[j] = ar[j] - tr;                 /* lower real part */
+        bi[j] = ai[j] - ti;                 /* lower imaginary part */
+        ar[j] = ar[j] + tr;                 /* upper real part */
+        ai[j] = ai[j] + ti;                 /* upper imaginary part */
+    }
+}
+
+/**
+ * @brief     initialize the fft
+ * @param[in] *fft pointer to an adxl345 fft structure
+ * @param[in] n real fft size
+ * @param[in] *buffer pointer to a buffer of ADXL345_FFT_BUFFER_SIZE(n) floats
+ * @return    status code
+ *            - 0 success
+ *            - 2 fft is NULL
+ *            - 4 param is invalid
+ * @note      n is a power of two from ADXL345_FFT_MIN_SIZE to ADXL345_FFT_MAX_SIZE,
+ *            the twiddles are computed once here and the buffer must stay valid until the fft is no longer used
+ */
+uint8_t adxl345_fft_init(adxl345_fft_t *fft, uint16_t n, float *buffer)
+{
+    uint16_t half;
+    uint16_t j;
+    uint16_t offset;
+    double angle;
+    
+    if (fft == NULL)                                            /* check fft */
+    {
+        return 2;                                               /* return error */
+    }
+    if ((buffer == NULL) || (n < ADXL345_FFT_MIN_SIZE) ||
+        (n > ADXL345_FFT_MAX_SIZE) || ((n & (n - 1)) != 0))     /* check param */
+    {
+        return 4;                                               /* return error */
+    }
+    
+    fft->n = n;                                                 /* set size */
+    fft->m = (uint16_t)(n / 2);                                 /* set complex size */
+    fft->stage_re = buffer;                                     /* m - 1 stage twiddles */
+    fft->stage_im = &buffer[fft->m];                            /* m - 1 stage twiddles */
+    fft->split_re = &buffer[2 * fft->m];                        /* m split twiddles */
+    fft->split_im = &buffer[3 * fft->m];                        /* m split twiddles */
+    fft->re = &buffer[4 * fft->m];                              /* m work values */
+    fft->im = &buffer[5 * fft->m];                              /* m work values */
+    offset = 0;                                                 /* init 0 */
+    for (half = 1; half < fft->m; half = (uint16_t)(half * 2))  /* run all stages */
+    {
+        for (j = 0; j < half; j++)                              /* run the stage */
+        {
+            angle = -ADXL345_FFT_PI * (double)j / (double)half; /* e^(-2pi j / 2half) */
+            fft->stage_re[offset + j] = (float)cos(angle);      /* set real part */
+            fft->stage_im[offset + j] = (float)sin(angle);      /* set imaginary part */
+        }
+        offset = (uint16_t)(offset + half);                     /* next stage */
+    }
+    for (j = 0; j < fft->m; j++)                                /* run all split twiddles */
+    {
+        angle = -2.0 * ADXL345_FFT_PI * (double)j / (double)n;  /* e^(-2pi j / n) */
+        fft->split_re[j] = (float)cos(angle);                   /* set real part */
+        fft->split_im[j] = (float)sin(angle);                   /* set imaginary part */
+    }
+    fft->inited = 1;                                            /* flag finish initialization */
+    
+    return 0;                                                   /* success return 0 */
+}
+
+/**
+ * @brief      run the real fft
+ * @param[in]  *fft pointer to an adxl345 fft structure
+ * @param[in]  *in pointer to n real samples
+ * @param[out] *re pointer to a n / 2 + 1 real part buffer
+ * @param[out] *im pointer to a n / 2 + 1 imaginary part buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 fft is NULL
+ *             - 3 fft is not initialized
+ * @note       bin k is k * rate / n, the samples run through a n / 2 point complex fft and a split stage,
+ *             the butterflies work on separate real and imaginary arrays with contiguous twiddles, so the
+ *             compiler vectorizes them with neon or sse, an fft must not run on two threads at once
+ */
+uint8_t adxl345_fft_forward(adxl345_fft_t *fft, const float *in, float *re, float *im)
+{
+    uint16_t m;
+    uint16_t k;
+    uint16_t j;
+    uint16_t bit;
+    uint16_t half;
+    uint16_t start;
+    uint16_t offset;
+    float *zr;
+    float *zi;
+    float wr, wi;
+    float er, ei, orr, oi;
+    
+    if (fft == NULL)                                                                       /* check fft */
+    {
+        return 2;                                                                          /* return error */
+    }
+    if (fft->inited != 1)                                                                  /* check fft initialization */
+    {
+        return 3;                                                                          /* return error */
+    }
+    
+    m = fft->m;                                                                            /* get complex size */
+    zr = fft->re;                                                                          /* get real part */
+    zi = fft->im;                                                                          /* get imaginary part */
+    j = 0;                                                                                 /* init 0 */
+    for (k = 0; k < m; k++)                                                                /* pack in bit reversed order */
+    {
+        zr[j] = in[2 * k];                                                                 /* even sample */
+        zi[j] = in[2 * k + 1];                                                             /* odd sample */
+        bit = (uint16_t)(m >> 1);                                                          /* top bit */
+        while ((j & bit) != 0)                                                             /* reversed increment */
+        {
+            j ^= bit;                                                                      /* clear bit */
+            bit >>= 1;                                                                     /* next bit */
+        }
+        j |= bit;                                                                          /* set bit */
+    }
+    offset = 0;                                                                            /* init 0 */
+    for (half = 1; half < m; half = (uint16_t)(half * 2))                                  /* run all stages */
+    {
+        for (start = 0; start < m; start = (uint16_t)(start + 2 * half))                   /* run all groups */
+        {
+            a_adxl345_fft_butterfly(&zr[start], &zi[start], &zr[start + half], &zi[start + half],
+                                    &fft->stage_re[offset], &fft->stage_im[offset], half); /* run the group */
+        }
+        offset = (uint16_t)(offset + half);                                                /* next stage */
+    }
+    re[0] = zr[0] + zi[0];                                                                 /* dc */
+    im[0] = 0.0f;                                                                          /* dc */
+    re[m] = zr[0] - zi[0];                                                                 /* nyquist */
+    im[m] = 0.0f;                                                                          /* nyquist */
+    for (k = 1; k < m; k++)                                                                /* split the spectrum */
+    {
+        er = 0.5f * (zr[k] + zr[m - k]);                                                   /* even real part */
+        ei = 0.5f * (zi[k] - zi[m - k]);                                                   /* even imaginary part */
+        orr = 0.5f * (zi[k] + zi[m - k]);                                                  /* odd real part */
+        oi = -0.5f * (zr[k] - zr[m - k]);                                                  /* odd imaginary part */
+        wr = fft->split_re[k];                                                             /* twiddle real part */
+        wi = fft->split_im[k];                                                             /* twiddle imaginary part */
+        re[k] = er + wr * orr - wi * oi;                                                   /* set real part */
+        im[k] = ei + wr * oi + wi * orr;                                                   /* set imaginary part */
+    }
+    
+    return 0;                                                                              /* success return 0 */
+}
+
+/**
+ * @brief     initialize the welch psd
+ * @param[in] *welch pointer to an adxl345 welch structure
+ * @param[in] *fft pointer to an initialized adxl345 fft structure
+ * @param[in] window segment window
+ * @param[in] overlap overlapped samples of two segments
+ * @param[in] rate_hz output data rate
+ * @param[in] *buffer pointer to a buffer of ADXL345_WELCH_BUFFER_SIZE(n) floats
+ * @return    status code
+ *            - 0 success
+ *            - 2 welch is NULL
+ *            - 3 fft is not initialized
+ *            - 4 param is invalid
+ * @note      the segments have the size of the fft and overlap must be smaller than it,
+ *            the buffer must stay valid until the welch psd is no longer used
+ */
+uint8_t adxl345_welch_init(adxl345_welch_t *welch, adxl345_fft_t *fft, adxl345_welch_window_t window,
+                           uint16_t overlap, float rate_hz, float *buffer)
+{
+    uint16_t n;
+    uint16_t i;
+    double x;
+    double w;
+    double power;
+    
+    if (welch == NULL)                                       /* check welch */
+    {
+        return 2;                                            /* return error */
+    }
+    if ((fft == NULL) || (fft->inited != 1))                 /* check fft */
+    {
+        return 3;                                            /* return error */
+    }
+    n = fft->n;                                              /* get size */
+    if ((buffer == NULL) || (overlap >= n) || (rate_hz <= 0.0f) ||
+        (window > ADXL345_WELCH_WINDOW_BLACKMAN))            /* check param */
+    {
+        return 4;                                            /* return error */
+    }
+    
+    welch->fft = fft;                                        /* set fft */
+    welch->n = n;                                            /* set size */
+    welch->hop = (uint16_t)(n - overlap);                    /* set hop */
+    welch->window = buffer;                                  /* n coefficients */
+    welch->input = &buffer[n];                                                         /* 3 * n samples */
+    welch->segment = &buffer[4 * n];                         /* n samples */
+    welch->psd = &buffer[5 * n];                                                       /* 3 * (n / 2 + 1) bins */
+    welch->bin_re = &welch->psd[3 * (n / 2 + 1)];            /* n / 2 + 1 bins */
+    welch->bin_im = &welch->bin_re[n / 2 + 1];               /* n / 2 + 1 bins */
+    power = 0.0;                                             /* init 0 */
+    for (i = 0; i < n; i++)                                  /* run all coefficients */
+    {
+        x = 2.0 * ADXL345_FFT_PI * (double)i / (double)n;    /* periodic phase */
+        if (window == ADXL345_WELCH_WINDOW_HANN)             /* hann */
+        {
+            w = 0.5 - 0.5 * cos(x);                          /* set hann */
+        }
+        else if (window == ADXL345_WELCH_WINDOW_HAMMING)     /* hamming */
+        {
+            w = 0.54 - 0.46 * cos(x);                        /* set hamming */
+        }
+        else if (window == ADXL345_WELCH_WINDOW_BLACKMAN)    /* blackman */
+        {
+            w = 0.42 - 0.5 * cos(x) + 0.08 * cos(2.0 * x);   /* set blackman */
+        }
+        else                                                 /* rectangular */
+        {
+            w = 1.0;                                         /* set rectangular */
+        }
+        welch->window[i] = (float)w;                         /* set coefficient */
+        power += w * w;                                      /* add power */
+    }
+    welch->scale = (float)(1.0 / ((double)rate_hz * power)); /* set density scale */
+    welch->inited = 1;                                       /* flag finish initialization */
+    
+    return adxl345_welch_reset(welch);                       /* reset the average */
+}
+
+/**
+ * @brief     reset the welch psd
+ * @param[in] *welch pointer to an adxl345 welch structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 welch is NULL
+ *            - 3 welch is not initialized
+ * @note      the input and the averaged segments are emptied
+ */
+uint8_t adxl345_welch_reset(adxl345_welch_t *welch)
+{
+    if (welch == NULL)                                             /* check welch */
+    {
+        return 2;                                                  /* return error */
+    }
+    if (welch->inited != 1)                                        /* check welch initialization */
+    {
+        return 3;                                                  /* return error */
+    }
+    
+    memset(welch->psd, 0, sizeof(float) * 3 * (welch->n / 2 + 1)); /* clear power */
+    welch->fill = 0;                                               /* clear fill */
+    welch->segments = 0;                                           /* clear segments */
+    
+    return 0;                                                      /* success return 0 */
+}
+
+/**
+ * @brief     update the welch psd
+ * @param[in] *welch pointer to an adxl345 welch structure
+ * @param[in] **g pointer to a converted data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 2 welch is NULL
+ *            - 3 welch is not initialized
+ * @note      the samples are taken in the order of adxl345_read, every full segment of every axis has its mean
+ *            removed, is windowed and transformed and its power is added to the average
+ */
+uint8_t adxl345_welch_update(adxl345_welch_t *welch, float (*g)[3], uint16_t len)
+{
+    uint16_t i;
+    
+    if (welch == NULL)                                      /* check welch */
+    {
+        return 2;                                           /* return error */
+    }
+    if (welch->inited != 1)                                 /* check welch initialization */
+    {
+        return 3;                                           /* return error */
+    }
+    
+    for (i = 0; i < len; i++)                               /* run all samples */
+    {
+        welch->input[welch->fill] = g[i][0];                /* append x */
+        welch->input[welch->n + welch->fill] = g[i][1];     /* append y */
+        welch->input[2 * welch->n + welch->fill] = g[i][2]; /* append z */
+        welch->fill++;                                      /* fill++ */
+        if (welch->fill == welch->n)                        /* if a segment is full */
+        {
+            a_adxl345_welch_segment(welch);                 /* run the segment */
+        }
+    }
+    
+    return 0;                                               /* success return 0 */
+}
+
+/**
+ * @brief      get the welch psd of an axis
+ * @param[in]  *welch pointer to an adxl345 welch structure
+ * @param[in]  axis 0 for x, 1 for y and 2 for z
+ * @param[out] *psd pointer to a n / 2 + 1 density buffer in g^2/Hz
+ * @param[out] *segments pointer to an averaged segments buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 no segment
+ *             - 2 welch is NULL
+ *             - 3 welch is not initialized
+ *             - 4 axis is invalid
+ * @note       the density is one sided, so its sum times rate / n is the variance of the axis
+ */
+uint8_t adxl345_welch_get(adxl345_welch_t *welch, uint8_t axis, float *psd, uint32_t *segments)
+{
+    uint16_t bins;
+    uint16_t i;
+    float scale;
+    const float *power;
+    
+    if (welch == NULL)                                                             /* check welch */
+    {
+        return 2;                                                                  /* return error */
+    }
+    if (welch->inited != 1)                                                        /* check welch initialization */
+    {
+        return 3;                                                                  /* return error */
+    }
+    if (axis > 2)                                                                  /* check axis */
+    {
+        return 4;                                                                  /* return error */
+    }
+    
+    *segments = welch->segments;                                                   /* set segments */
+    if (welch->segments == 0)                                                      /* check segments */
+    {
+        return 1;                                                                  /* return error */
+    }
+    bins = (uint16_t)(welch->n / 2 + 1);                                           /* get bins */
+    power = &welch->psd[axis * bins];                                              /* get axis power */
+    scale = welch->scale / (float)welch->segments;                                 /* average density scale */
+    for (i = 0; i < bins; i++)                                                     /* run all bins */
+    {
+        psd[i] = power[i] * scale * (((i == 0) || (i == bins - 1)) ? 1.0f : 2.0f); /* one sided density */
+    }
+    
+    return 0;                                                                      /* success return 0 */
+}
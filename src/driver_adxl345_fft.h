@@ -0,0 +1,206 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_adxl345_fft.h
+ * @brief     driver adxl345 fft header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_ADXL345_FFT_H
+#define DRIVER_ADXL345_FFT_H
+
+#include "driver_adxl345.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup adxl345_fft_driver adxl345 fft driver function
+ * @brief    adxl345 fft driver modules
+ * @ingroup  adxl345_driver
+ * @{
+ */
+
+/**
+ * @brief fft size definition
+ */
+#define ADXL345_FFT_MIN_SIZE                256                                 /**< smallest fft size */
+#define ADXL345_FFT_MAX_SIZE                4096                                /**< largest fft size */
+#define ADXL345_FFT_BUFFER_SIZE(n)          (3 * (n))                           /**< floats of the fft buffer */
+#define ADXL345_WELCH_BUFFER_SIZE(n)        (5 * (n) + 5 * ((n) / 2 + 1))       /**< floats of the welch buffer */
+
+/**
+ * @brief adxl345 welch window enumeration definition
+ */
+typedef enum
+{
+    ADXL345_WELCH_WINDOW_RECT     = 0x00,        /**< rectangular window */
+    ADXL345_WELCH_WINDOW_HANN     = 0x01,        /**< hann window */
+    ADXL345_WELCH_WINDOW_HAMMING  = 0x02,        /**< hamming window */
+    ADXL345_WELCH_WINDOW_BLACKMAN = 0x03,        /**< blackman window */
+} adxl345_welch_window_t;
+
+/**
+ * @brief adxl345 fft structure definition
+ */
+typedef struct adxl345_fft_s
+{
+    uint16_t n;                 /**< real fft size */
+    uint16_t m;                 /**< complex fft size, n / 2 */
+    float *stage_re;            /**< butterfly twiddles of every stage, real part */
+    float *stage_im;            /**< butterfly twiddles of every stage, imaginary part */
+    float *split_re;            /**< real split twiddles, real part */
+    float *split_im;            /**< real split twiddles, imaginary part */
+    float *re;                  /**< complex work buffer, real part */
+    float *im;                  /**< complex work buffer, imaginary part */
+    uint8_t inited;             /**< inited flag */
+} adxl345_fft_t;
+
+/**
+ * @brief adxl345 welch structure definition
+ */
+typedef struct adxl345_welch_s
+{
+    adxl345_fft_t *fft;         /**< fft of the segments */
+    float *window;              /**< window coefficients */
+    float *input;               /**< unprocessed samples of every axis */
+    float *segment;             /**< windowed segment */
+    float *psd;                 /**< accumulated power of every axis */
+    float *bin_re;              /**< spectrum of the segment, real part */
+    float *bin_im;              /**< spectrum of the segment, imaginary part */
+    uint16_t n;                 /**< segment size */
+    uint16_t hop;               /**< samples between two segments */
+    uint16_t fill;              /**< samples in the input */
+    uint32_t segments;          /**< averaged segments */
+    float scale;                /**< one sided density scale */
+    uint8_t inited;             /**< inited flag */
+} adxl345_welch_t;
+
+/**
+ * @brief     initialize the fft
+ * @param[in] *fft pointer to an adxl345 fft structure
+ * @param[in] n real fft size
+ * @param[in] *buffer pointer to a buffer of ADXL345_FFT_BUFFER_SIZE(n) floats
+ * @return    status code
+ *            - 0 success
+ *            - 2 fft is NULL
+ *            - 4 param is invalid
+ * @note      n is a power of two from ADXL345_FFT_MIN_SIZE to ADXL345_FFT_MAX_SIZE,
+ *            the twiddles are computed once here and the buffer must stay valid until the fft is no longer used
+ */
+uint8_t adxl345_fft_init(adxl345_fft_t *fft, uint16_t n, float *buffer);
+
+/**
+ * @brief      run the real fft
+ * @param[in]  *fft pointer to an adxl345 fft structure
+ * @param[in]  *in pointer to n real samples
+ * @param[out] *re pointer to a n / 2 + 1 real part buffer
+ * @param[out] *im pointer to a n / 2 + 1 imaginary part buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 fft is NULL
+ *             - 3 fft is not initialized
+ * @note       bin k is k * rate / n, the samples run through a n / 2 point complex fft and a split stage,
+ *             the butterflies work on separate real and imaginary arrays with contiguous twiddles, so the
+ *             compiler vectorizes them with neon or sse, an fft must not run on two threads at once
+ */
+uint8_t adxl345_fft_forward(adxl345_fft_t *fft, const float *in, float *re, float *im);
+
+/**
+ * @brief     initialize the welch psd
+ * @param[in] *welch pointer to an adxl345 welch structure
+ * @param[in] *fft pointer to an initialized adxl345 fft structure
+ * @param[in] window segment window
+ * @param[in] overlap overlapped samples of two segments
+ * @param[in] rate_hz output data rate
+ * @param[in] *buffer pointer to a buffer of ADXL345_WELCH_BUFFER_SIZE(n) floats
+ * @return    status code
+ *            - 0 success
+ *            - 2 welch is NULL
+ *            - 3 fft is not initialized
+ *            - 4 param is invalid
+ * @note      the segments have the size of the fft and overlap must be smaller than it,
+ *            the buffer must stay valid until the welch psd is no longer used
+ */
+uint8_t adxl345_welch_init(adxl345_welch_t *welch, adxl345_fft_t *fft, adxl345_welch_window_t window,
+                           uint16_t overlap, float rate_hz, float *buffer);
+
+/**
+ * @brief     reset the welch psd
+ * @param[in] *welch pointer to an adxl345 welch structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 welch is NULL
+ *            - 3 welch is not initialized
+ * @note      the input and the averaged segments are emptied
+ */
+uint8_t adxl345_welch_reset(adxl345_welch_t *welch);
+
+/**
+ * @brief     update the welch psd
+ * @param[in] *welch pointer to an adxl345 welch structure
+ * @param[in] **g pointer to a converted data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 2 welch is NULL
+ *            - 3 welch is not initialized
+ * @note      the samples are taken in the order of adxl345_read, every full segment of every axis has its mean
+ *            removed, is windowed and transformed and its power is added to the average
+ */
+uint8_t adxl345_welch_update(adxl345_welch_t *welch, float (*g)[3], uint16_t len);
+
+/**
+ * @brief      get the welch psd of an axis
+ * @param[in]  *welch pointer to an adxl345 welch structure
+ * @param[in]  axis 0 for x, 1 for y and 2 for z
+ * @param[out] *psd pointer to a n / 2 + 1 density buffer in g^2/Hz
+ * @param[out] *segments pointer to an averaged segments buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 no segment
+ *             - 2 welch is NULL
+ *             - 3 welch is not initialized
+ *             - 4 axis is invalid
+ * @note       the density is one sided, so its sum times rate / n is the variance of the axis
+ */
+uint8_t adxl345_welch_get(adxl345_welch_t *welch, uint8_t axis, float *psd, uint32_t *segments);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
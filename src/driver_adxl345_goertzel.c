@@ -0,0 +1,271 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_adxl345_goertzel.c
+ * @brief     driver adxl345 goertzel source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_adxl345_goertzel.h"
+#include <math.h>
+
+/**
+ * @brief pi definition
+ */
+#define ADXL345_GOERTZEL_PI        3.14159265358979323846        /**< pi */
+
+/**
+ * @brief     finish a block
+ * @param[in] *goertzel pointer to an adxl345 goertzel structure
+ * @note      the power of the last two states is the squared dtft at the tone
+ */
+static void a_adxl345_goertzel_finish(adxl345_goertzel_t *goertzel)
+{
+    adxl345_goertzel_tone_t *tone;
+    double power;
+    uint8_t i;
+    uint8_t j;
+    
+    for (i = 0; i < goertzel->tones; i++)                                                     /* run all tones */
+    {
+        tone = &goertzel->tone[i];                                                            /* get tone */
+        for (j = 0; j < 3; j++)                                                               /* run all axes */
+        {
+            power = (double)tone->s1[j] * tone->s1[j] + (double)tone->s2[j] * tone->s2[j] -
+                    (double)tone->coeff * tone->s1[j] * tone->s2[j];                          /* get power */
+            power = (power > 0.0) ? power : 0.0;                                              /* clamp rounding */
+            goertzel->amplitude[i][j] = (float)(2.0 * sqrt(power) / (double)goertzel->block); /* set amplitude */
+            tone->s1[j] = 0.0f;                                                               /* clear state */
+            tone->s2[j] = 0.0f;                                                               /* clear state */
+        }
+    }
+    goertzel->count = 0;                                                                      /* clear count */
+    goertzel->blocks++;                                                                       /* blocks++ */
+}
+
+/**
+ * @brief     initialize the goertzel bank
+ * @param[in] *goertzel pointer to an adxl345 goertzel structure
+ * @param[in] rate output data rate of the chip
+ * @param[in] block samples of one block
+ * @param[in] *callback pointer to a block callback function address
+ * @return    status code
+ *            - 0 success
+ *            - 2 goertzel is NULL
+ *            - 4 param is invalid
+ * @note      the bank starts without tones, the frequency resolution is rate / block and
+ *            the callback may be NULL
+ */
+uint8_t adxl345_goertzel_init(adxl345_goertzel_t *goertzel, adxl345_rate_t rate, uint32_t block,
+                              void (*callback)(adxl345_goertzel_t *goertzel, float (*amplitude)[3]))
+{
+    if (goertzel == NULL)                                                     /* check goertzel */
+    {
+        return 2;                                                             /* return error */
+    }
+    if ((block < 2) || (rate > ADXL345_LOW_POWER_RATE_400) ||
+        ((rate > ADXL345_RATE_3200) && (rate < ADXL345_LOW_POWER_RATE_12P5))) /* check param */
+    {
+        return 4;                                                             /* return error */
+    }
+    
+    memset(goertzel, 0, sizeof(adxl345_goertzel_t));                          /* clear the bank */
+    goertzel->rate_hz = 3200.0f / (float)(1U << (15 - (rate & 0x0F)));        /* set rate */
+    goertzel->block = block;                                                  /* set block */
+    goertzel->callback = callback;                                            /* set callback */
+    goertzel->inited = 1;                                                     /* flag finish initialization */
+    
+    return 0;                                                                 /* success return 0 */
+}
+
+/**
+ * @brief     add a tone to the goertzel bank
+ * @param[in] *goertzel pointer to an adxl345 goertzel structure
+ * @param[in] hz tone frequency
+ * @return    status code
+ *            - 0 success
+ *            - 1 bank is full
+ *            - 2 goertzel is NULL
+ *            - 3 goertzel is not initialized
+ *            - 4 hz is invalid
+ * @note      hz is above 0 and below half the rate, it needn't be a multiple of rate / block,
+ *            the block being filled is restarted
+ */
+uint8_t adxl345_goertzel_add_tone(adxl345_goertzel_t *goertzel, float hz)
+{
+    adxl345_goertzel_tone_t *tone;
+    
+    if (goertzel == NULL)                                                                         /* check goertzel */
+    {
+        return 2;                                                                                 /* return error */
+    }
+    if (goertzel->inited != 1)                                                                    /* check goertzel initialization */
+    {
+        return 3;                                                                                 /* return error */
+    }
+    if (goertzel->tones >= ADXL345_GOERTZEL_MAX_TONE)                                             /* check tones */
+    {
+        return 1;                                                                                 /* return error */
+    }
+    if ((hz <= 0.0f) || (hz >= goertzel->rate_hz / 2.0f))                                         /* check hz */
+    {
+        return 4;                                                                                 /* return error */
+    }
+    
+    tone = &goertzel->tone[goertzel->tones];                                                      /* get tone */
+    tone->hz = hz;                                                                                /* set frequency */
+    tone->coeff = (float)(2.0 * cos(2.0 * ADXL345_GOERTZEL_PI * (double)hz / goertzel->rate_hz)); /* set coefficient */
+    goertzel->tones++;                                                                            /* tones++ */
+    
+    return adxl345_goertzel_reset(goertzel);                                                      /* restart the block */
+}
+
+/**
+ * @brief     reset the goertzel bank
+ * @param[in] *goertzel pointer to an adxl345 goertzel structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 goertzel is NULL
+ *            - 3 goertzel is not initialized
+ * @note      the tones are kept and the block being filled is restarted
+ */
+uint8_t adxl345_goertzel_reset(adxl345_goertzel_t *goertzel)
+{
+    uint8_t i;
+    
+    if (goertzel == NULL)                                   /* check goertzel */
+    {
+        return 2;                                           /* return error */
+    }
+    if (goertzel->inited != 1)                              /* check goertzel initialization */
+    {
+        return 3;                                           /* return error */
+    }
+    
+    for (i = 0; i < goertzel->tones; i++)                   /* run all tones */
+    {
+        memset(goertzel->tone[i].s1, 0, sizeof(float) * 3); /* clear state */
+        memset(goertzel->tone[i].s2, 0, sizeof(float) * 3); /* clear state */
+    }
+    goertzel->count = 0;                                    /* clear count */
+    goertzel->blocks = 0;                                   /* clear blocks */
+    
+    return 0;                                               /* success return 0 */
+}
+
+/**
+ * @brief     update the goertzel bank
+ * @param[in] *goertzel pointer to an adxl345 goertzel structure
+ * @param[in] **g pointer to a converted data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 2 goertzel is NULL
+ *            - 3 goertzel is not initialized
+ * @note      a sample costs one multiply and two adds per tone and axis, the amplitudes are made and the
+ *            callback runs at the end of every block
+ */
+uint8_t adxl345_goertzel_update(adxl345_goertzel_t *goertzel, float (*g)[3], uint16_t len)
+{
+    adxl345_goertzel_tone_t *tone;
+    float s0;
+    uint16_t n;
+    uint8_t i;
+    uint8_t j;
+    
+    if (goertzel == NULL)                                               /* check goertzel */
+    {
+        return 2;                                                       /* return error */
+    }
+    if (goertzel->inited != 1)                                          /* check goertzel initialization */
+    {
+        return 3;                                                       /* return error */
+    }
+    
+    for (n = 0; n < len; n++)                                           /* run all samples */
+    {
+        for (i = 0; i < goertzel->tones; i++)                           /* run all tones */
+        {
+            tone = &goertzel->tone[i];                                  /* get tone */
+            for (j = 0; j < 3; j++)                                     /* run all axes */
+            {
+                s0 = g[n][j] + tone->coeff * tone->s1[j] - tone->s2[j]; /* run the resonator */
+                tone->s2[j] = tone->s1[j];                              /* shift state */
+                tone->s1[j] = s0;                                       /* shift state */
+            }
+        }
+        goertzel->count++;                                              /* count++ */
+        if (goertzel->count == goertzel->block)                         /* if the block is full */
+        {
+            a_adxl345_goertzel_finish(goertzel);                        /* finish the block */
+            if (goertzel->callback != NULL)                             /* if the callback is linked */
+            {
+                goertzel->callback(goertzel, goertzel->amplitude);      /* run callback */
+            }
+        }
+    }
+    
+    return 0;                                                           /* success return 0 */
+}
+
+/**
+ * @brief      get the amplitudes of the last block
+ * @param[in]  *goertzel pointer to an adxl345 goertzel structure
+ * @param[out] **amplitude pointer to a tones x 3 amplitude buffer in g
+ * @param[out] *tones pointer to a tone count buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 no block
+ *             - 2 goertzel is NULL
+ *             - 3 goertzel is not initialized
+ * @note       the amplitude is the peak of a sine at the tone, the block is not windowed,
+ *             so a tone between two multiples of rate / block leaks into its neighbours
+ */
+uint8_t adxl345_goertzel_get(adxl345_goertzel_t *goertzel, float (*amplitude)[3], uint8_t *tones)
+{
+    if (goertzel == NULL)                                                        /* check goertzel */
+    {
+        return 2;                                                                /* return error */
+    }
+    if (goertzel->inited != 1)                                                   /* check goertzel initialization */
+    {
+        return 3;                                                                /* return error */
+    }
+    
+    *tones = goertzel->tones;                                                    /* set tones */
+    if (goertzel->blocks == 0)                                                   /* check blocks */
+    {
+        return 1;                                                                /* return error */
+    }
+    memcpy(amplitude, goertzel->amplitude, sizeof(float) * 3 * goertzel->tones); /* copy amplitudes */
+    
+    return 0;                                                                    /* success return 0 */
+}
@@ -0,0 +1,165 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_adxl345_goertzel.h
+ * @brief     driver adxl345 goertzel header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_ADXL345_GOERTZEL_H
+#define DRIVER_ADXL345_GOERTZEL_H
+
+#include "driver_adxl345.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup adxl345_goertzel_driver adxl345 goertzel driver function
+ * @brief    adxl345 goertzel driver modules
+ * @ingroup  adxl345_driver
+ * @{
+ */
+
+/**
+ * @brief goertzel tone definition
+ */
+#define ADXL345_GOERTZEL_MAX_TONE        16        /**< largest tone count of a bank */
+
+/**
+ * @brief adxl345 goertzel tone structure definition
+ */
+typedef struct adxl345_goertzel_tone_s
+{
+    float hz;                 /**< tone frequency */
+    float coeff;              /**< 2cos(w) */
+    float s1[3];              /**< last state of every axis */
+    float s2[3];              /**< state before the last of every axis */
+} adxl345_goertzel_tone_t;
+
+/**
+ * @brief adxl345 goertzel structure definition
+ */
+typedef struct adxl345_goertzel_s
+{
+    adxl345_goertzel_tone_t tone[ADXL345_GOERTZEL_MAX_TONE];                                 /**< tone detectors */
+    float amplitude[ADXL345_GOERTZEL_MAX_TONE][3];                                          /**< amplitudes of the last block in g */
+    uint8_t tones;                                                                           /**< tone count */
+    float rate_hz;                                                                           /**< output data rate */
+    uint32_t block;                                                                          /**< samples of one block */
+    uint32_t count;                                                                          /**< samples of the block being filled */
+    uint32_t blocks;                                                                         /**< finished blocks */
+    void (*callback)(struct adxl345_goertzel_s *goertzel, float (*amplitude)[3]);             /**< block callback */
+    void *user;                                                                              /**< user data */
+    uint8_t inited;                                                                          /**< inited flag */
+} adxl345_goertzel_t;
+
+/**
+ * @brief     initialize the goertzel bank
+ * @param[in] *goertzel pointer to an adxl345 goertzel structure
+ * @param[in] rate output data rate of the chip
+ * @param[in] block samples of one block
+ * @param[in] *callback pointer to a block callback function address
+ * @return    status code
+ *            - 0 success
+ *            - 2 goertzel is NULL
+ *            - 4 param is invalid
+ * @note      the bank starts without tones, the frequency resolution is rate / block and
+ *            the callback may be NULL
+ */
+uint8_t adxl345_goertzel_init(adxl345_goertzel_t *goertzel, adxl345_rate_t rate, uint32_t block,
+                              void (*callback)(adxl345_goertzel_t *goertzel, float (*amplitude)[3]));
+
+/**
+ * @brief     add a tone to the goertzel bank
+ * @param[in] *goertzel pointer to an adxl345 goertzel structure
+ * @param[in] hz tone frequency
+ * @return    status code
+ *            - 0 success
+ *            - 1 bank is full
+ *            - 2 goertzel is NULL
+ *            - 3 goertzel is not initialized
+ *            - 4 hz is invalid
+ * @note      hz is above 0 and below half the rate, it needn't be a multiple of rate / block,
+ *            the block being filled is restarted
+ */
+uint8_t adxl345_goertzel_add_tone(adxl345_goertzel_t *goertzel, float hz);
+
+/**
+ * @brief     reset the goertzel bank
+ * @param[in] *goertzel pointer to an adxl345 goertzel structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 goertzel is NULL
+ *            - 3 goertzel is not initialized
+ * @note      the tones are kept and the block being filled is restarted
+ */
+uint8_t adxl345_goertzel_reset(adxl345_goertzel_t *goertzel);
+
+/**
+ * @brief     update the goertzel bank
+ * @param[in] *goertzel pointer to an adxl345 goertzel structure
+ * @param[in] **g pointer to a converted data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 2 goertzel is NULL
+ *            - 3 goertzel is not initialized
+ * @note      a sample costs one multiply and two adds per tone and axis, the amplitudes are made and the
+ *            callback runs at the end of every block
+ */
+uint8_t adxl345_goertzel_update(adxl345_goertzel_t *goertzel, float (*g)[3], uint16_t len);
+
+/**
+ * @brief      get the amplitudes of the last block
+ * @param[in]  *goertzel pointer to an adxl345 goertzel structure
+ * @param[out] **amplitude pointer to a tones x 3 amplitude buffer in g
+ * @param[out] *tones pointer to a tone count buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 no block
+ *             - 2 goertzel is NULL
+ *             - 3 goertzel is not initialized
+ * @note       the amplitude is the peak of a sine at the tone, the block is not windowed,
+ *             so a tone between two multiples of rate / block leaks into its neighbours
+ */
+uint8_t adxl345_goertzel_get(adxl345_goertzel_t *goertzel, float (*amplitude)[3], uint8_t *tones);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
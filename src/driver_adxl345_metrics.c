@@ -0,0 +1,369 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_adxl345_metrics.c
+ * @brief     driver adxl345 metrics source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_adxl345_metrics.h"
+#include <float.h>
+#include <math.h>
+
+/**
+ * @brief     push the hop being filled into the window
+ * @param[in] *metrics pointer to an adxl345 metrics structure
+ * @note      the window is a two stack queue of hop blocks, the front stack keeps the suffix summaries of the
+ *            oldest hops and the back stack only its total, so a pop is O(1) and the front is rebuilt
+ *            from the back once every hops pops
+ */
+static void a_adxl345_metrics_push(adxl345_metrics_t *metrics)
+{
+    uint16_t i;
+    uint16_t index;
+    uint16_t next;
+    
+    if (metrics->used == metrics->hops)                                                             /* if the window is full */
+    {
+        if (metrics->front == 0)                                                                    /* if the front is empty */
+        {
+            index = (uint16_t)((metrics->head + metrics->used - 1) % metrics->hops);                /* newest hop */
+            metrics->entry[index].suffix = metrics->entry[index].block;                             /* set suffix */
+            for (i = 1; i < metrics->used; i++)                                                     /* rebuild the front */
+            {
+                next = index;                                                                       /* save newer hop */
+                index = (uint16_t)((index + metrics->hops - 1) % metrics->hops);                    /* older hop */
+                (void)adxl345_metrics_merge(&metrics->entry[index].block,
+                                            &metrics->entry[next].suffix,
+                                            &metrics->entry[index].suffix);                         /* merge suffix */
+            }
+            metrics->front = metrics->used;                                                         /* all hops in the front */
+            (void)adxl345_metrics_clear(&metrics->back);                                            /* empty back */
+        }
+        metrics->head = (uint16_t)((metrics->head + 1) % metrics->hops);                            /* pop oldest hop */
+        metrics->used--;                                                                            /* used-- */
+        metrics->front--;                                                                           /* front-- */
+    }
+    index = (uint16_t)((metrics->head + metrics->used) % metrics->hops);                            /* get newest slot */
+    metrics->entry[index].block = metrics->current;                                                 /* copy hop */
+    metrics->used++;                                                                                /* used++ */
+    (void)adxl345_metrics_merge(&metrics->back, &metrics->current, &metrics->back);                 /* add to back */
+    (void)adxl345_metrics_clear(&metrics->current);                                                 /* empty hop */
+}
+
+/**
+ * @brief     initialize the metrics
+ * @param[in] *metrics pointer to an adxl345 metrics structure
+ * @param[in] *entry pointer to a hop ring of hops entries
+ * @param[in] hops hops of one window
+ * @param[in] hop samples of one hop
+ * @param[in] *callback pointer to a window callback function address
+ * @return    status code
+ *            - 0 success
+ *            - 2 metrics is NULL
+ *            - 4 param is invalid
+ * @note      the window is hops * hop samples and a result is made every hop samples once the window is full,
+ *            1 hop makes tumbling windows and more hops make sliding windows,
+ *            the callback may be NULL and the entry ring must stay valid until the metrics are no longer used
+ */
+uint8_t adxl345_metrics_init(adxl345_metrics_t *metrics, adxl345_metrics_entry_t *entry, uint16_t hops, uint32_t hop,
+                             void (*callback)(adxl345_metrics_t *metrics, const adxl345_metrics_result_t *result))
+{
+    if (metrics == NULL)                              /* check metrics */
+    {
+        return 2;                                     /* return error */
+    }
+    if ((entry == NULL) || (hops == 0) || (hop == 0)) /* check param */
+    {
+        return 4;                                     /* return error */
+    }
+    
+    metrics->entry = entry;                           /* set entry ring */
+    metrics->hops = hops;                             /* set hops */
+    metrics->hop = hop;                               /* set hop */
+    metrics->callback = callback;                     /* set callback */
+    metrics->user = NULL;                             /* clear user data */
+    metrics->inited = 1;                              /* flag finish initialization */
+    
+    return adxl345_metrics_reset(metrics);            /* reset the window */
+}
+
+/**
+ * @brief     reset the metrics
+ * @param[in] *metrics pointer to an adxl345 metrics structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 metrics is NULL
+ *            - 3 metrics is not initialized
+ * @note      the window and the hop being filled are emptied
+ */
+uint8_t adxl345_metrics_reset(adxl345_metrics_t *metrics)
+{
+    if (metrics == NULL)                            /* check metrics */
+    {
+        return 2;                                   /* return error */
+    }
+    if (metrics->inited != 1)                       /* check metrics initialization */
+    {
+        return 3;                                   /* return error */
+    }
+    
+    metrics->head = 0;                              /* clear head */
+    metrics->used = 0;                              /* clear used */
+    metrics->front = 0;                             /* clear front */
+    (void)adxl345_metrics_clear(&metrics->current); /* empty hop */
+    (void)adxl345_metrics_clear(&metrics->back);    /* empty back */
+    
+    return 0;                                       /* success return 0 */
+}
+
+/**
+ * @brief     update the metrics
+ * @param[in] *metrics pointer to an adxl345 metrics structure
+ * @param[in] **g pointer to a converted data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 2 metrics is NULL
+ *            - 3 metrics is not initialized
+ * @note      the samples are taken in the order of adxl345_read and the callback runs for every full window,
+ *            a sample costs O(1) and a hop is pushed in amortized O(1) with the two stack window
+ */
+uint8_t adxl345_metrics_update(adxl345_metrics_t *metrics, float (*g)[3], uint16_t len)
+{
+    adxl345_metrics_block_t *current;
+    adxl345_metrics_block_t block;
+    adxl345_metrics_result_t result;
+    uint16_t i;
+    uint8_t j;
+    
+    if (metrics == NULL)                                                     /* check metrics */
+    {
+        return 2;                                                            /* return error */
+    }
+    if (metrics->inited != 1)                                                /* check metrics initialization */
+    {
+        return 3;                                                            /* return error */
+    }
+    
+    current = &metrics->current;                                             /* get hop */
+    for (i = 0; i < len; i++)                                                /* run all samples */
+    {
+        for (j = 0; j < 3; j++)                                              /* run all axes */
+        {
+            current->sum[j] += (double)g[i][j];                              /* add sample */
+            current->sum_sq[j] += (double)g[i][j] * (double)g[i][j];         /* add squared sample */
+            if (g[i][j] < current->min[j])                                   /* check min */
+            {
+                current->min[j] = g[i][j];                                   /* set min */
+            }
+            if (g[i][j] > current->max[j])                                   /* check max */
+            {
+                current->max[j] = g[i][j];                                   /* set max */
+            }
+        }
+        current->count++;                                                    /* count++ */
+        if (current->count < metrics->hop)                                   /* if the hop isn't full */
+        {
+            continue;                                                        /* next sample */
+        }
+        a_adxl345_metrics_push(metrics);                                     /* push the hop */
+        if ((metrics->used == metrics->hops) && (metrics->callback != NULL)) /* if the window is full */
+        {
+            (void)adxl345_metrics_get_block(metrics, &block);                /* get window */
+            (void)adxl345_metrics_compute(&block, &result);                  /* compute result */
+            metrics->callback(metrics, &result);                             /* run callback */
+        }
+    }
+    
+    return 0;                                                                /* success return 0 */
+}
+
+/**
+ * @brief      get the summary of the window
+ * @param[in]  *metrics pointer to an adxl345 metrics structure
+ * @param[out] *block pointer to an adxl345 metrics block structure
+ * @return     status code
+ *             - 0 success
+ *             - 2 metrics is NULL
+ *             - 3 metrics is not initialized
+ * @note       the summary covers the finished hops in the ring, the hop being filled isn't included
+ */
+uint8_t adxl345_metrics_get_block(adxl345_metrics_t *metrics, adxl345_metrics_block_t *block)
+{
+    if (metrics == NULL)                                    /* check metrics */
+    {
+        return 2;                                           /* return error */
+    }
+    if (metrics->inited != 1)                               /* check metrics initialization */
+    {
+        return 3;                                           /* return error */
+    }
+    
+    if (metrics->front != 0)                                /* if the front has hops */
+    {
+        (void)adxl345_metrics_merge(&metrics->entry[metrics->head].suffix,
+                                    &metrics->back, block); /* merge front and back */
+    }
+    else
+    {
+        *block = metrics->back;                             /* only the back */
+    }
+    
+    return 0;                                               /* success return 0 */
+}
+
+/**
+ * @brief      get the result of the window
+ * @param[in]  *metrics pointer to an adxl345 metrics structure
+ * @param[out] *result pointer to an adxl345 metrics result structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 window is empty
+ *             - 2 metrics is NULL
+ *             - 3 metrics is not initialized
+ * @note       a window which isn't full yet gives the result of the finished hops
+ */
+uint8_t adxl345_metrics_get(adxl345_metrics_t *metrics, adxl345_metrics_result_t *result)
+{
+    adxl345_metrics_block_t block;
+    uint8_t res;
+    
+    res = adxl345_metrics_get_block(metrics, &block); /* get window */
+    if (res != 0)                                     /* check result */
+    {
+        return res;                                   /* return error */
+    }
+    
+    return adxl345_metrics_compute(&block, result);   /* compute result */
+}
+
+/**
+ * @brief     clear a block
+ * @param[in] *block pointer to an adxl345 metrics block structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 block is NULL
+ * @note      an empty block is the identity of adxl345_metrics_merge
+ */
+uint8_t adxl345_metrics_clear(adxl345_metrics_block_t *block)
+{
+    uint8_t i;
+    
+    if (block == NULL)            /* check block */
+    {
+        return 2;                 /* return error */
+    }
+    
+    block->count = 0;             /* clear count */
+    for (i = 0; i < 3; i++)       /* run all axes */
+    {
+        block->sum[i] = 0.0;      /* clear sum */
+        block->sum_sq[i] = 0.0;   /* clear squared sum */
+        block->min[i] = FLT_MAX;  /* set min */
+        block->max[i] = -FLT_MAX; /* set max */
+    }
+    
+    return 0;                     /* success return 0 */
+}
+
+/**
+ * @brief      merge two blocks
+ * @param[in]  *a pointer to an adxl345 metrics block structure
+ * @param[in]  *b pointer to an adxl345 metrics block structure
+ * @param[out] *out pointer to an adxl345 metrics block structure
+ * @return     status code
+ *             - 0 success
+ *             - 2 block is NULL
+ * @note       out may be a or b, so the blocks of sub windows or of other threads combine into one result
+ */
+uint8_t adxl345_metrics_merge(const adxl345_metrics_block_t *a, const adxl345_metrics_block_t *b,
+                              adxl345_metrics_block_t *out)
+{
+    uint8_t i;
+    
+    if ((a == NULL) || (b == NULL) || (out == NULL))                   /* check blocks */
+    {
+        return 2;                                                      /* return error */
+    }
+    
+    for (i = 0; i < 3; i++)                                            /* run all axes */
+    {
+        out->sum[i] = a->sum[i] + b->sum[i];                           /* add sum */
+        out->sum_sq[i] = a->sum_sq[i] + b->sum_sq[i];                  /* add squared sum */
+        out->min[i] = (a->min[i] < b->min[i]) ? a->min[i] : b->min[i]; /* get min */
+        out->max[i] = (a->max[i] > b->max[i]) ? a->max[i] : b->max[i]; /* get max */
+    }
+    out->count = a->count + b->count;                                  /* add count */
+    
+    return 0;                                                          /* success return 0 */
+}
+
+/**
+ * @brief      compute the result of a block
+ * @param[in]  *block pointer to an adxl345 metrics block structure
+ * @param[out] *result pointer to an adxl345 metrics result structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 block is empty
+ * @note       the rms and the peak are taken around the mean, so the gravity doesn't count
+ */
+uint8_t adxl345_metrics_compute(const adxl345_metrics_block_t *block, adxl345_metrics_result_t *result)
+{
+    double mean;
+    double var;
+    double high;
+    double low;
+    uint8_t i;
+    
+    if (block->count == 0)                                           /* check count */
+    {
+        return 1;                                                    /* return error */
+    }
+    
+    result->count = block->count;                                    /* set count */
+    for (i = 0; i < 3; i++)                                          /* run all axes */
+    {
+        mean = block->sum[i] / (double)block->count;                 /* get mean */
+        var = block->sum_sq[i] / (double)block->count - mean * mean; /* get variance */
+        var = (var > 0.0) ? var : 0.0;                               /* clamp rounding */
+        high = (double)block->max[i] - mean;                         /* distance of max */
+        low = mean - (double)block->min[i];                          /* distance of min */
+        result->mean[i] = (float)mean;                               /* set mean */
+        result->rms[i] = (float)sqrt(var);                           /* set rms */
+        result->peak[i] = (float)((high > low) ? high : low);        /* set peak */
+        result->peak_to_peak[i] = block->max[i] - block->min[i];     /* set peak to peak */
+        result->crest[i] = (result->rms[i] > 0.0f) ?
+                           result->peak[i] / result->rms[i] : 0.0f;  /* set crest factor */
+    }
+    
+    return 0;                                                        /* success return 0 */
+}
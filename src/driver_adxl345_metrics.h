@@ -0,0 +1,216 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_adxl345_metrics.h
+ * @brief     driver adxl345 metrics header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_ADXL345_METRICS_H
+#define DRIVER_ADXL345_METRICS_H
+
+#include "driver_adxl345.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup adxl345_metrics_driver adxl345 metrics driver function
+ * @brief    adxl345 metrics driver modules
+ * @ingroup  adxl345_driver
+ * @{
+ */
+
+/**
+ * @brief adxl345 metrics block structure definition
+ * @note  a block is the mergeable summary of a run of samples
+ */
+typedef struct adxl345_metrics_block_s
+{
+    uint32_t count;           /**< sample count */
+    double sum[3];            /**< sum of the samples */
+    double sum_sq[3];         /**< sum of the squared samples */
+    float min[3];             /**< smallest sample */
+    float max[3];             /**< largest sample */
+} adxl345_metrics_block_t;
+
+/**
+ * @brief adxl345 metrics entry structure definition
+ */
+typedef struct adxl345_metrics_entry_s
+{
+    adxl345_metrics_block_t block;        /**< summary of one hop */
+    adxl345_metrics_block_t suffix;       /**< summary from this hop to the newest hop of the front stack */
+} adxl345_metrics_entry_t;
+
+/**
+ * @brief adxl345 metrics result structure definition
+ */
+typedef struct adxl345_metrics_result_s
+{
+    uint32_t count;                 /**< sample count */
+    float mean[3];                  /**< mean in g */
+    float rms[3];                   /**< rms around the mean in g */
+    float peak[3];                  /**< largest distance from the mean in g */
+    float peak_to_peak[3];          /**< largest minus smallest sample in g */
+    float crest[3];                 /**< peak divided by rms, 0 when the rms is 0 */
+} adxl345_metrics_result_t;
+
+/**
+ * @brief adxl345 metrics structure definition
+ */
+typedef struct adxl345_metrics_s
+{
+    adxl345_metrics_entry_t *entry;                                                                    /**< hop ring of the window */
+    uint16_t hops;                                                                                     /**< hops of one window */
+    uint16_t head;                                                                                     /**< oldest hop */
+    uint16_t used;                                                                                     /**< hops in the ring */
+    uint16_t front;                                                                                    /**< oldest hops with a valid suffix */
+    uint32_t hop;                                                                                      /**< samples of one hop */
+    adxl345_metrics_block_t current;                                                                   /**< hop being filled */
+    adxl345_metrics_block_t back;                                                                      /**< summary of the hops after the front */
+    void (*callback)(struct adxl345_metrics_s *metrics, const adxl345_metrics_result_t *result);       /**< window callback */
+    void *user;                                                                                        /**< user data */
+    uint8_t inited;                                                                                    /**< inited flag */
+} adxl345_metrics_t;
+
+/**
+ * @brief     initialize the metrics
+ * @param[in] *metrics pointer to an adxl345 metrics structure
+ * @param[in] *entry pointer to a hop ring of hops entries
+ * @param[in] hops hops of one window
+ * @param[in] hop samples of one hop
+ * @param[in] *callback pointer to a window callback function address
+ * @return    status code
+ *            - 0 success
+ *            - 2 metrics is NULL
+ *            - 4 param is invalid
+ * @note      the window is hops * hop samples and a result is made every hop samples once the window is full,
+ *            1 hop makes tumbling windows and more hops make sliding windows,
+ *            the callback may be NULL and the entry ring must stay valid until the metrics are no longer used
+ */
+uint8_t adxl345_metrics_init(adxl345_metrics_t *metrics, adxl345_metrics_entry_t *entry, uint16_t hops, uint32_t hop,
+                             void (*callback)(adxl345_metrics_t *metrics, const adxl345_metrics_result_t *result));
+
+/**
+ * @brief     reset the metrics
+ * @param[in] *metrics pointer to an adxl345 metrics structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 metrics is NULL
+ *            - 3 metrics is not initialized
+ * @note      the window and the hop being filled are emptied
+ */
+uint8_t adxl345_metrics_reset(adxl345_metrics_t *metrics);
+
+/**
+ * @brief     update the metrics
+ * @param[in] *metrics pointer to an adxl345 metrics structure
+ * @param[in] **g pointer to a converted data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 2 metrics is NULL
+ *            - 3 metrics is not initialized
+ * @note      the samples are taken in the order of adxl345_read and the callback runs for every full window,
+ *            a sample costs O(1) and a hop is pushed in amortized O(1) with the two stack window
+ */
+uint8_t adxl345_metrics_update(adxl345_metrics_t *metrics, float (*g)[3], uint16_t len);
+
+/**
+ * @brief      get the summary of the window
+ * @param[in]  *metrics pointer to an adxl345 metrics structure
+ * @param[out] *block pointer to an adxl345 metrics block structure
+ * @return     status code
+ *             - 0 success
+ *             - 2 metrics is NULL
+ *             - 3 metrics is not initialized
+ * @note       the summary covers the finished hops in the ring, the hop being filled isn't included
+ */
+uint8_t adxl345_metrics_get_block(adxl345_metrics_t *metrics, adxl345_metrics_block_t *block);
+
+/**
+ * @brief      get the result of the window
+ * @param[in]  *metrics pointer to an adxl345 metrics structure
+ * @param[out] *result pointer to an adxl345 metrics result structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 window is empty
+ *             - 2 metrics is NULL
+ *             - 3 metrics is not initialized
+ * @note       a window which isn't full yet gives the result of the finished hops
+ */
+uint8_t adxl345_metrics_get(adxl345_metrics_t *metrics, adxl345_metrics_result_t *result);
+
+/**
+ * @brief     clear a block
+ * @param[in] *block pointer to an adxl345 metrics block structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 block is NULL
+ * @note      an empty block is the identity of adxl345_metrics_merge
+ */
+uint8_t adxl345_metrics_clear(adxl345_metrics_block_t *block);
+
+/**
+ * @brief      merge two blocks
+ * @param[in]  *a pointer to an adxl345 metrics block structure
+ * @param[in]  *b pointer to an adxl345 metrics block structure
+ * @param[out] *out pointer to an adxl345 metrics block structure
+ * @return     status code
+ *             - 0 success
+ *             - 2 block is NULL
+ * @note       out may be a or b, so the blocks of sub windows or of other threads combine into one result
+ */
+uint8_t adxl345_metrics_merge(const adxl345_metrics_block_t *a, const adxl345_metrics_block_t *b,
+                              adxl345_metrics_block_t *out);
+
+/**
+ * @brief      compute the result of a block
+ * @param[in]  *block pointer to an adxl345 metrics block structure
+ * @param[out] *result pointer to an adxl345 metrics result structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 block is empty
+ * @note       the rms and the peak are taken around the mean, so the gravity doesn't count
+ */
+uint8_t adxl345_metrics_compute(const adxl345_metrics_block_t *block, adxl345_metrics_result_t *result);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
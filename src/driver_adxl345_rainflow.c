@@ -0,0 +1,480 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_adxl345_rainflow.c
+ * @brief     driver adxl345 rainflow source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_adxl345_rainflow.h"
+#include <math.h>
+
+/**
+ * @brief      get the histogram bin of a range
+ * @param[in]  *rainflow pointer to an adxl345 rainflow structure
+ * @param[in]  a first turning point in g
+ * @param[in]  b second turning point in g
+ * @param[out] *r pointer to a range bin buffer
+ * @param[out] *m pointer to a mean bin buffer
+ * @note       a range out of the bins goes to the nearest edge bin
+ */
+static void a_adxl345_rainflow_bin(adxl345_rainflow_t *rainflow, float a, float b, uint8_t *r, uint8_t *m)
+{
+    float fr = fabsf(a - b) / rainflow->range_max * (float)ADXL345_RAINFLOW_RANGE_BINS;                 /* range position */
+    float fm = (0.5f * (a + b) - rainflow->mean_min) /
+               (rainflow->mean_max - rainflow->mean_min) * (float)ADXL345_RAINFLOW_MEAN_BINS;           /* mean position */
+    
+    *r = (fr < (float)ADXL345_RAINFLOW_RANGE_BINS) ? (uint8_t)fr : (ADXL345_RAINFLOW_RANGE_BINS - 1);   /* clamp range */
+    if (!(fm > 0.0f))                                                                                   /* below the bins */
+    {
+        *m = 0;                                                                                         /* first bin */
+    }
+    else                                                                                                /* in or above the bins */
+    {
+        *m = (fm < (float)ADXL345_RAINFLOW_MEAN_BINS) ? (uint8_t)fm : (ADXL345_RAINFLOW_MEAN_BINS - 1); /* clamp mean */
+    }
+}
+
+/**
+ * @brief      close the last cycle of a residue
+ * @param[in]  *s pointer to a residue buffer
+ * @param[in]  *len pointer to a residue length buffer
+ * @param[out] *a pointer to a first turning point buffer
+ * @param[out] *b pointer to a second turning point buffer
+ * @return     1 if a cycle is closed else 0
+ * @note       when the inner range of the last four points is not above both outer ranges, it is
+ *             a closed cycle and its two points are taken out of the residue, a tie closes too
+ *             so a steady amplitude keeps the residue short
+ */
+static uint8_t a_adxl345_rainflow_close(float *s, uint16_t *len, float *a, float *b)
+{
+    uint16_t n = *len;
+    float inner;
+    
+    if (n < 4)                                                                        /* four point rule */
+    {
+        return 0;                                                                     /* not closed */
+    }
+    inner = fabsf(s[n - 2] - s[n - 3]);                                               /* inner range */
+    if ((inner > fabsf(s[n - 3] - s[n - 4])) || (inner > fabsf(s[n - 1] - s[n - 2]))) /* check outer ranges */
+    {
+        return 0;                                                                     /* not closed */
+    }
+    *a = s[n - 3];                                                                    /* get first point */
+    *b = s[n - 2];                                                                    /* get second point */
+    s[n - 3] = s[n - 1];                                                              /* keep the last point */
+    *len = n - 2;                                                                     /* take out the cycle */
+    
+    return 1;                                                                         /* closed */
+}
+
+/**
+ * @brief     push a turning point to the residue
+ * @param[in] *rainflow pointer to an adxl345 rainflow structure
+ * @param[in] ch channel
+ * @param[in] p turning point in g
+ * @note      every cycle the point closes is counted, a full residue counts its oldest range as a half cycle
+ */
+static void a_adxl345_rainflow_push(adxl345_rainflow_t *rainflow, uint8_t ch, float p)
+{
+    float *s = rainflow->residue[ch];
+    uint16_t len = rainflow->residue_len[ch];
+    float a;
+    float b;
+    uint8_t r;
+    uint8_t m;
+    
+    if (len == ADXL345_RAINFLOW_MAX_RESIDUE)                  /* if the residue is full */
+    {
+        a_adxl345_rainflow_bin(rainflow, s[0], s[1], &r, &m); /* get the oldest range bin */
+        rainflow->half[ch][r][m] += 1;                        /* count a half cycle */
+        rainflow->overflow[ch]++;                             /* overflow++ */
+        memmove(&s[0], &s[1], sizeof(float) * (len - 1));     /* drop the oldest point */
+        len--;                                                /* len-- */
+    }
+    s[len] = p;                                               /* push the point */
+    len++;                                                    /* len++ */
+    while (a_adxl345_rainflow_close(s, &len, &a, &b) != 0)    /* close all cycles */
+    {
+        a_adxl345_rainflow_bin(rainflow, a, b, &r, &m);       /* get the cycle bin */
+        rainflow->half[ch][r][m] += 2;                        /* count a full cycle */
+        rainflow->cycles[ch]++;                               /* cycles++ */
+    }
+    rainflow->residue_len[ch] = len;                          /* save len */
+}
+
+/**
+ * @brief     run one sample of a channel
+ * @param[in] *rainflow pointer to an adxl345 rainflow structure
+ * @param[in] ch channel
+ * @param[in] v sample in g
+ * @note      the running extreme becomes a turning point once the stream has come back more than the gate
+ */
+static void a_adxl345_rainflow_sample(adxl345_rainflow_t *rainflow, uint8_t ch, float v)
+{
+    float gate = rainflow->gate;
+    float extreme = rainflow->extreme[ch];
+    
+    if (rainflow->samples == 0)                             /* if the first sample */
+    {
+        rainflow->residue[ch][0] = v;                       /* start point */
+        rainflow->residue_len[ch] = 1;                      /* set len */
+        rainflow->extreme[ch] = v;                          /* set extreme */
+        rainflow->direction[ch] = 0;                        /* no direction */
+    }
+    else if (rainflow->direction[ch] == 0)                  /* if no direction */
+    {
+        if (v - rainflow->residue[ch][0] > gate)            /* rising from the start */
+        {
+            rainflow->extreme[ch] = v;                      /* set extreme */
+            rainflow->direction[ch] = 1;                    /* rising */
+        }
+        else if (rainflow->residue[ch][0] - v > gate)       /* falling from the start */
+        {
+            rainflow->extreme[ch] = v;                      /* set extreme */
+            rainflow->direction[ch] = -1;                   /* falling */
+        }
+        else
+        {
+            /* inside the gate */
+        }
+    }
+    else if (rainflow->direction[ch] > 0)                   /* if rising */
+    {
+        if (v > extreme)                                    /* higher */
+        {
+            rainflow->extreme[ch] = v;                      /* set extreme */
+        }
+        else if (extreme - v > gate)                        /* a peak */
+        {
+            a_adxl345_rainflow_push(rainflow, ch, extreme); /* push the peak */
+            rainflow->extreme[ch] = v;                      /* set extreme */
+            rainflow->direction[ch] = -1;                   /* falling */
+        }
+        else
+        {
+            /* inside the gate */
+        }
+    }
+    else                                                    /* if falling */
+    {
+        if (v < extreme)                                    /* lower */
+        {
+            rainflow->extreme[ch] = v;                      /* set extreme */
+        }
+        else if (v - extreme > gate)                        /* a valley */
+        {
+            a_adxl345_rainflow_push(rainflow, ch, extreme); /* push the valley */
+            rainflow->extreme[ch] = v;                      /* set extreme */
+            rainflow->direction[ch] = 1;                    /* rising */
+        }
+        else
+        {
+            /* inside the gate */
+        }
+    }
+}
+
+/**
+ * @brief     clear the count
+ * @param[in] *rainflow pointer to an adxl345 rainflow structure
+ * @note      none
+ */
+static void a_adxl345_rainflow_clear(adxl345_rainflow_t *rainflow)
+{
+    memset(rainflow->half, 0, sizeof(rainflow->half));               /* clear histogram */
+    memset(rainflow->residue_len, 0, sizeof(rainflow->residue_len)); /* clear residue */
+    memset(rainflow->direction, 0, sizeof(rainflow->direction));     /* clear direction */
+    memset(rainflow->cycles, 0, sizeof(rainflow->cycles));           /* clear cycles */
+    memset(rainflow->overflow, 0, sizeof(rainflow->overflow));       /* clear overflow */
+    rainflow->samples = 0;                                           /* clear samples */
+}
+
+/**
+ * @brief     initialize the rainflow counter
+ * @param[in] *rainflow pointer to an adxl345 rainflow structure
+ * @param[in] source counted source
+ * @param[in] gate hysteresis of a reversal in g
+ * @return    status code
+ *            - 0 success
+ *            - 2 rainflow is NULL
+ *            - 4 param is invalid
+ * @note      a reversal smaller than the gate is taken as noise and doesn't make a turning point,
+ *            the histogram starts with ranges up to 4g and means from -2g to 2g
+ */
+uint8_t adxl345_rainflow_init(adxl345_rainflow_t *rainflow, adxl345_rainflow_source_t source, float gate)
+{
+    if (rainflow == NULL)                                                  /* check rainflow */
+    {
+        return 2;                                                          /* return error */
+    }
+    if ((source > ADXL345_RAINFLOW_SOURCE_MAGNITUDE) || (!(gate >= 0.0f))) /* check param */
+    {
+        return 4;                                                          /* return error */
+    }
+    
+    memset(rainflow, 0, sizeof(adxl345_rainflow_t));                       /* clear the counter */
+    rainflow->source = (uint8_t)source;                                    /* set source */
+    rainflow->channels = (source == ADXL345_RAINFLOW_SOURCE_AXES) ? 3 : 1; /* set channels */
+    rainflow->gate = gate;                                                 /* set gate */
+    rainflow->range_max = 4.0f;                                            /* set range max */
+    rainflow->mean_min = -2.0f;                                            /* set mean min */
+    rainflow->mean_max = 2.0f;                                             /* set mean max */
+    rainflow->inited = 1;                                                  /* flag finish initialization */
+    
+    return 0;                                                              /* success return 0 */
+}
+
+/**
+ * @brief     set the histogram bins of the rainflow counter
+ * @param[in] *rainflow pointer to an adxl345 rainflow structure
+ * @param[in] range_max top of the last range bin in g
+ * @param[in] mean_min bottom of the first mean bin in g
+ * @param[in] mean_max top of the last mean bin in g
+ * @return    status code
+ *            - 0 success
+ *            - 2 rainflow is NULL
+ *            - 3 rainflow is not initialized
+ *            - 4 param is invalid
+ * @note      none
+ */
+uint8_t adxl345_rainflow_set_bins(adxl345_rainflow_t *rainflow, float range_max, float mean_min, float mean_max)
+{
+    if (rainflow == NULL)                                  /* check rainflow */
+    {
+        return 2;                                          /* return error */
+    }
+    if (rainflow->inited != 1)                             /* check rainflow initialization */
+    {
+        return 3;                                          /* return error */
+    }
+    if ((!(range_max > 0.0f)) || (!(mean_max > mean_min))) /* check param */
+    {
+        return 4;                                          /* return error */
+    }
+    
+    rainflow->range_max = range_max;                       /* set range max */
+    rainflow->mean_min = mean_min;                         /* set mean min */
+    rainflow->mean_max = mean_max;                         /* set mean max */
+    a_adxl345_rainflow_clear(rainflow);                    /* restart the count */
+    
+    return 0;                                              /* success return 0 */
+}
+
+/**
+ * @brief     reset the rainflow counter
+ * @param[in] *rainflow pointer to an adxl345 rainflow structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 rainflow is NULL
+ *            - 3 rainflow is not initialized
+ * @note      none
+ */
+uint8_t adxl345_rainflow_reset(adxl345_rainflow_t *rainflow)
+{
+    if (rainflow == NULL)               /* check rainflow */
+    {
+        return 2;                       /* return error */
+    }
+    if (rainflow->inited != 1)          /* check rainflow initialization */
+    {
+        return 3;                       /* return error */
+    }
+    
+    a_adxl345_rainflow_clear(rainflow); /* restart the count */
+    
+    return 0;                           /* success return 0 */
+}
+
+/**
+ * @brief     update the rainflow counter
+ * @param[in] *rainflow pointer to an adxl345 rainflow structure
+ * @param[in] **g pointer to a converted data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 2 rainflow is NULL
+ *            - 3 rainflow is not initialized
+ * @note      the magnitude is taken in float so a counter fed again with the same samples counts the same cycles
+ */
+uint8_t adxl345_rainflow_update(adxl345_rainflow_t *rainflow, float (*g)[3], uint16_t len)
+{
+    uint16_t i;
+    uint8_t j;
+    
+    if (rainflow == NULL)                                                                                /* check rainflow */
+    {
+        return 2;                                                                                        /* return error */
+    }
+    if (rainflow->inited != 1)                                                                           /* check rainflow initialization */
+    {
+        return 3;                                                                                        /* return error */
+    }
+    
+    for (i = 0; i < len; i++)                                                                            /* run all samples */
+    {
+        if (rainflow->source == ADXL345_RAINFLOW_SOURCE_AXES)                                            /* if axes */
+        {
+            for (j = 0; j < 3; j++)                                                                      /* run all axes */
+            {
+                a_adxl345_rainflow_sample(rainflow, j, g[i][j]);                                         /* count the axis */
+            }
+        }
+        else                                                                                             /* if magnitude */
+        {
+            a_adxl345_rainflow_sample(rainflow, 0,
+                                      sqrtf(g[i][0] * g[i][0] + g[i][1] * g[i][1] + g[i][2] * g[i][2])); /* count the magnitude */
+        }
+        rainflow->samples++;                                                                             /* samples++ */
+    }
+    
+    return 0;                                                                                            /* success return 0 */
+}
+
+/**
+ * @brief      get the range and mean histogram of a channel
+ * @param[in]  *rainflow pointer to an adxl345 rainflow structure
+ * @param[in]  channel counted channel
+ * @param[in]  residue bool value
+ * @param[out] **histogram pointer to a range bins x mean bins cycle buffer
+ * @param[out] *cycles pointer to a total cycle buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 no sample
+ *             - 2 rainflow is NULL
+ *             - 3 rainflow is not initialized
+ *             - 4 channel is invalid
+ * @note       none
+ */
+uint8_t adxl345_rainflow_get(adxl345_rainflow_t *rainflow, uint8_t channel, adxl345_bool_t residue,
+                             float (*histogram)[ADXL345_RAINFLOW_MEAN_BINS], float *cycles)
+{
+    float point[ADXL345_RAINFLOW_MAX_RESIDUE + 1];
+    float a;
+    float b;
+    uint32_t half = 0;
+    uint16_t len;
+    uint16_t i;
+    uint8_t r;
+    uint8_t m;
+    
+    if (rainflow == NULL)                                                     /* check rainflow */
+    {
+        return 2;                                                             /* return error */
+    }
+    if (rainflow->inited != 1)                                                /* check rainflow initialization */
+    {
+        return 3;                                                             /* return error */
+    }
+    if (channel >= rainflow->channels)                                        /* check channel */
+    {
+        return 4;                                                             /* return error */
+    }
+    if (rainflow->samples == 0)                                               /* check samples */
+    {
+        return 1;                                                             /* return error */
+    }
+    
+    for (r = 0; r < ADXL345_RAINFLOW_RANGE_BINS; r++)                         /* run all ranges */
+    {
+        for (m = 0; m < ADXL345_RAINFLOW_MEAN_BINS; m++)                      /* run all means */
+        {
+            histogram[r][m] = 0.5f * (float)rainflow->half[channel][r][m];    /* half cycles to cycles */
+            half += rainflow->half[channel][r][m];                            /* sum half cycles */
+        }
+    }
+    if (residue == ADXL345_BOOL_TRUE)                                         /* if with residue */
+    {
+        (void)adxl345_rainflow_get_residue(rainflow, channel, point, &len);   /* get the residue */
+        while (a_adxl345_rainflow_close(point, &len, &a, &b) != 0)            /* close the cycles of the extreme */
+        {
+            a_adxl345_rainflow_bin(rainflow, a, b, &r, &m);                   /* get the cycle bin */
+            histogram[r][m] += 1.0f;                                          /* add a full cycle */
+            half += 2;                                                        /* half += 2 */
+        }
+        for (i = 1; i < len; i++)                                             /* run all ranges */
+        {
+            a_adxl345_rainflow_bin(rainflow, point[i - 1], point[i], &r, &m); /* get the range bin */
+            histogram[r][m] += 0.5f;                                          /* add a half cycle */
+            half++;                                                           /* half++ */
+        }
+    }
+    *cycles = 0.5f * (float)half;                                             /* set cycles */
+    
+    return 0;                                                                 /* success return 0 */
+}
+
+/**
+ * @brief      get the residue of a channel
+ * @param[in]  *rainflow pointer to an adxl345 rainflow structure
+ * @param[in]  channel counted channel
+ * @param[out] *point pointer to a turning point buffer with ADXL345_RAINFLOW_MAX_RESIDUE + 1 points
+ * @param[out] *len pointer to a turning point count buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 no sample
+ *             - 2 rainflow is NULL
+ *             - 3 rainflow is not initialized
+ *             - 4 channel is invalid
+ * @note       none
+ */
+uint8_t adxl345_rainflow_get_residue(adxl345_rainflow_t *rainflow, uint8_t channel, float *point, uint16_t *len)
+{
+    uint16_t n;
+    
+    if (rainflow == NULL)                                         /* check rainflow */
+    {
+        return 2;                                                 /* return error */
+    }
+    if (rainflow->inited != 1)                                    /* check rainflow initialization */
+    {
+        return 3;                                                 /* return error */
+    }
+    if (channel >= rainflow->channels)                            /* check channel */
+    {
+        return 4;                                                 /* return error */
+    }
+    if (rainflow->samples == 0)                                   /* check samples */
+    {
+        return 1;                                                 /* return error */
+    }
+    
+    n = rainflow->residue_len[channel];                           /* get len */
+    memcpy(point, rainflow->residue[channel], sizeof(float) * n); /* copy the residue */
+    if (rainflow->direction[channel] != 0)                        /* if the extreme passed the gate */
+    {
+        point[n] = rainflow->extreme[channel];                    /* add the running extreme */
+        n++;                                                      /* n++ */
+    }
+    *len = n;                                                     /* set len */
+    
+    return 0;                                                     /* success return 0 */
+}
@@ -0,0 +1,192 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_adxl345_rainflow.h
+ * @brief     driver adxl345 rainflow header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_ADXL345_RAINFLOW_H
+#define DRIVER_ADXL345_RAINFLOW_H
+
+#include "driver_adxl345.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup adxl345_rainflow_driver adxl345 rainflow driver function
+ * @brief    adxl345 rainflow driver modules
+ * @ingroup  adxl345_driver
+ * @{
+ */
+
+/**
+ * @brief rainflow histogram definition
+ */
+#define ADXL345_RAINFLOW_MAX_RESIDUE        64        /**< largest turning point count of a residue */
+#define ADXL345_RAINFLOW_RANGE_BINS         16        /**< range bin count of the histogram */
+#define ADXL345_RAINFLOW_MEAN_BINS          16        /**< mean bin count of the histogram */
+
+/**
+ * @brief adxl345 rainflow source enumeration definition
+ */
+typedef enum
+{
+    ADXL345_RAINFLOW_SOURCE_AXES      = 0x00,        /**< x, y and z axes as three channels */
+    ADXL345_RAINFLOW_SOURCE_MAGNITUDE = 0x01,        /**< magnitude of the three axes as one channel */
+} adxl345_rainflow_source_t;
+
+/**
+ * @brief adxl345 rainflow structure definition
+ */
+typedef struct adxl345_rainflow_s
+{
+    uint32_t half[3][ADXL345_RAINFLOW_RANGE_BINS][ADXL345_RAINFLOW_MEAN_BINS];        /**< counted half cycles of every channel */
+    float residue[3][ADXL345_RAINFLOW_MAX_RESIDUE];                                   /**< residue turning points of every channel in g */
+    float extreme[3];                                                                 /**< running extreme of every channel in g */
+    int8_t direction[3];                                                              /**< direction of the running extreme */
+    uint16_t residue_len[3];                                                          /**< residue length of every channel */
+    uint32_t cycles[3];                                                               /**< closed full cycles of every channel */
+    uint32_t overflow[3];                                                             /**< half cycles pushed out of a full residue */
+    float gate;                                                                       /**< hysteresis of a reversal in g */
+    float range_max;                                                                  /**< top of the last range bin in g */
+    float mean_min;                                                                   /**< bottom of the first mean bin in g */
+    float mean_max;                                                                   /**< top of the last mean bin in g */
+    uint32_t samples;                                                                 /**< counted samples */
+    uint8_t source;                                                                   /**< counted source */
+    uint8_t channels;                                                                 /**< channel count */
+    uint8_t inited;                                                                   /**< inited flag */
+} adxl345_rainflow_t;
+
+/**
+ * @brief     initialize the rainflow counter
+ * @param[in] *rainflow pointer to an adxl345 rainflow structure
+ * @param[in] source counted source
+ * @param[in] gate hysteresis of a reversal in g
+ * @return    status code
+ *            - 0 success
+ *            - 2 rainflow is NULL
+ *            - 4 param is invalid
+ * @note      a reversal smaller than the gate is taken as noise and doesn't make a turning point,
+ *            the histogram starts with ranges up to 4g and means from -2g to 2g
+ */
+uint8_t adxl345_rainflow_init(adxl345_rainflow_t *rainflow, adxl345_rainflow_source_t source, float gate);
+
+/**
+ * @brief     set the histogram bins of the rainflow counter
+ * @param[in] *rainflow pointer to an adxl345 rainflow structure
+ * @param[in] range_max top of the last range bin in g
+ * @param[in] mean_min bottom of the first mean bin in g
+ * @param[in] mean_max top of the last mean bin in g
+ * @return    status code
+ *            - 0 success
+ *            - 2 rainflow is NULL
+ *            - 3 rainflow is not initialized
+ *            - 4 param is invalid
+ * @note      the bins are even, a cycle out of the bins is counted in the nearest edge bin,
+ *            the count is restarted
+ */
+uint8_t adxl345_rainflow_set_bins(adxl345_rainflow_t *rainflow, float range_max, float mean_min, float mean_max);
+
+/**
+ * @brief     reset the rainflow counter
+ * @param[in] *rainflow pointer to an adxl345 rainflow structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 rainflow is NULL
+ *            - 3 rainflow is not initialized
+ * @note      the histogram and the residue are cleared, the bins are kept
+ */
+uint8_t adxl345_rainflow_reset(adxl345_rainflow_t *rainflow);
+
+/**
+ * @brief     update the rainflow counter
+ * @param[in] *rainflow pointer to an adxl345 rainflow structure
+ * @param[in] **g pointer to a converted data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 2 rainflow is NULL
+ *            - 3 rainflow is not initialized
+ * @note      the stream may come in fifo drains of any length, only the residue of turning points is kept,
+ *            every new turning point closes the cycles of the four point rule and the residue stays
+ *            a diverging then converging sequence, a full residue counts its oldest range as a half cycle
+ */
+uint8_t adxl345_rainflow_update(adxl345_rainflow_t *rainflow, float (*g)[3], uint16_t len);
+
+/**
+ * @brief      get the range and mean histogram of a channel
+ * @param[in]  *rainflow pointer to an adxl345 rainflow structure
+ * @param[in]  channel counted channel
+ * @param[in]  residue bool value
+ * @param[out] **histogram pointer to a range bins x mean bins cycle buffer
+ * @param[out] *cycles pointer to a total cycle buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 no sample
+ *             - 2 rainflow is NULL
+ *             - 3 rainflow is not initialized
+ *             - 4 channel is invalid
+ * @note       the histogram counts cycles with a half cycle as 0.5, with residue true the record is closed
+ *             like it ended here, the running extreme is pushed as the last turning point, the cycles
+ *             it closes are added and the ranges left in the residue are added as half cycles,
+ *             the counter goes on unchanged
+ */
+uint8_t adxl345_rainflow_get(adxl345_rainflow_t *rainflow, uint8_t channel, adxl345_bool_t residue,
+                             float (*histogram)[ADXL345_RAINFLOW_MEAN_BINS], float *cycles);
+
+/**
+ * @brief      get the residue of a channel
+ * @param[in]  *rainflow pointer to an adxl345 rainflow structure
+ * @param[in]  channel counted channel
+ * @param[out] *point pointer to a turning point buffer with ADXL345_RAINFLOW_MAX_RESIDUE + 1 points
+ * @param[out] *len pointer to a turning point count buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 no sample
+ *             - 2 rainflow is NULL
+ *             - 3 rainflow is not initialized
+ *             - 4 channel is invalid
+ * @note       the running extreme is the last point once it has passed the gate
+ */
+uint8_t adxl345_rainflow_get_residue(adxl345_rainflow_t *rainflow, uint8_t channel, float *point, uint16_t *len);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,304 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_adxl345_srs.c
+ * @brief     driver adxl345 srs source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_adxl345_srs.h"
+#include <math.h>
+
+/**
+ * @brief pi definition
+ */
+#define ADXL345_SRS_PI        3.14159265358979323846        /**< pi */
+
+/**
+ * @brief     clear the event
+ * @param[in] *srs pointer to an adxl345 srs structure
+ * @note      none
+ */
+static void a_adxl345_srs_clear(adxl345_srs_t *srs)
+{
+    memset(srs->y1, 0, sizeof(srs->y1));             /* clear last response */
+    memset(srs->y2, 0, sizeof(srs->y2));             /* clear response before the last */
+    memset(srs->positive, 0, sizeof(srs->positive)); /* clear positive peaks */
+    memset(srs->negative, 0, sizeof(srs->negative)); /* clear negative peaks */
+    memset(srs->x1, 0, sizeof(srs->x1));             /* clear last input */
+    memset(srs->x2, 0, sizeof(srs->x2));             /* clear input before the last */
+    memset(srs->base, 0, sizeof(srs->base));         /* clear pre event level */
+    srs->samples = 0;                                /* clear samples */
+}
+
+/**
+ * @brief      run one sample of an axis through every oscillator
+ * @param[in]  *srs pointer to an adxl345 srs structure
+ * @param[in]  j axis
+ * @param[in]  x input in g
+ * @note       the oscillators don't depend on each other, so the loop runs across the frequencies
+ *             and the compiler spreads it over the simd lanes
+ */
+static inline void a_adxl345_srs_sample(adxl345_srs_t *srs, uint8_t j, float x)
+{
+    const float *restrict b0 = srs->b0;
+    const float *restrict b1 = srs->b1;
+    const float *restrict b2 = srs->b2;
+    const float *restrict a1 = srs->a1;
+    const float *restrict a2 = srs->a2;
+    float *restrict y1 = srs->y1[j];
+    float *restrict y2 = srs->y2[j];
+    float *restrict positive = srs->positive[j];
+    float *restrict negative = srs->negative[j];
+    float x1 = srs->x1[j];
+    float x2 = srs->x2[j];
+    float y;
+    uint16_t count = srs->count;
+    uint16_t k;
+    
+    for (k = 0; k < count; k++)                                                              /* run all oscillators */
+    {
+        y = b0[k] * x + b1[k] * x1 + b2[k] * x2 + a1[k] * y1[k] + a2[k] * y2[k];            /* smallwood recursion */
+        y2[k] = y1[k];                                                                       /* shift response */
+        y1[k] = y;                                                                           /* save response */
+        positive[k] = (y > positive[k]) ? y : positive[k];                                   /* update positive peak */
+        negative[k] = (y < negative[k]) ? y : negative[k];                                   /* update negative peak */
+    }
+    srs->x2[j] = x1;                                                                         /* shift input */
+    srs->x1[j] = x;                                                                          /* save input */
+}
+
+/**
+ * @brief     initialize the srs engine
+ * @param[in] *srs pointer to an adxl345 srs structure
+ * @param[in] rate output data rate of the chip
+ * @param[in] q quality factor of the oscillators
+ * @return    status code
+ *            - 0 success
+ *            - 2 srs is NULL
+ *            - 4 param is invalid
+ * @note      q is above 0.5, 10 is the usual shock qualification damping of 5 percent,
+ *            the engine starts without a grid
+ */
+uint8_t adxl345_srs_init(adxl345_srs_t *srs, adxl345_rate_t rate, float q)
+{
+    if (srs == NULL)                                                          /* check srs */
+    {
+        return 2;                                                             /* return error */
+    }
+    if ((!(q > 0.5f)) || (rate > ADXL345_LOW_POWER_RATE_400) ||
+        ((rate > ADXL345_RATE_3200) && (rate < ADXL345_LOW_POWER_RATE_12P5))) /* check param */
+    {
+        return 4;                                                             /* return error */
+    }
+    
+    memset(srs, 0, sizeof(adxl345_srs_t));                                    /* clear the engine */
+    srs->rate_hz = 3200.0f / (float)(1U << (15 - (rate & 0x0F)));             /* set rate */
+    srs->damping = 0.5f / q;                                                  /* set damping ratio */
+    srs->inited = 1;                                                          /* flag finish initialization */
+    
+    return 0;                                                                 /* success return 0 */
+}
+
+/**
+ * @brief     set the natural frequency grid of the srs engine
+ * @param[in] *srs pointer to an adxl345 srs structure
+ * @param[in] start_hz lowest natural frequency
+ * @param[in] stop_hz highest natural frequency
+ * @param[in] count natural frequency count
+ * @return    status code
+ *            - 0 success
+ *            - 2 srs is NULL
+ *            - 3 srs is not initialized
+ *            - 4 param is invalid
+ * @note      the coefficients are made in double precision, the poles of the low frequencies sit close to
+ *            the unit circle and a float design loses the input coefficient
+ */
+uint8_t adxl345_srs_set_grid(adxl345_srs_t *srs, float start_hz, float stop_hz, uint16_t count)
+{
+    double zeta, hz, wn, wd, t, e, k, c, s, sp;
+    uint16_t i;
+    
+    if (srs == NULL)                                                                             /* check srs */
+    {
+        return 2;                                                                                /* return error */
+    }
+    if (srs->inited != 1)                                                                        /* check srs initialization */
+    {
+        return 3;                                                                                /* return error */
+    }
+    if ((count == 0) || (count > ADXL345_SRS_MAX_FREQ) || (!(start_hz > 0.0f)) ||
+        (stop_hz < start_hz) || (stop_hz >= srs->rate_hz / 2.0f) ||
+        ((count == 1) && (stop_hz != start_hz)))                                                 /* check param */
+    {
+        return 4;                                                                                /* return error */
+    }
+    
+    zeta = (double)srs->damping;                                                                 /* get damping ratio */
+    t = 1.0 / (double)srs->rate_hz;                                                              /* get sample period */
+    for (i = 0; i < count; i++)                                                                  /* run all frequencies */
+    {
+        hz = (count == 1) ? (double)start_hz :
+             (double)start_hz * pow((double)stop_hz / (double)start_hz, (double)i / (count - 1)); /* log spacing */
+        wn = 2.0 * ADXL345_SRS_PI * hz;                                                          /* natural angular frequency */
+        wd = wn * sqrt(1.0 - zeta * zeta);                                                       /* damped angular frequency */
+        e = exp(-zeta * wn * t);                                                                 /* pole radius */
+        k = wd * t;                                                                              /* pole angle */
+        c = e * cos(k);                                                                          /* e cos(k) */
+        s = e * sin(k);                                                                          /* e sin(k) */
+        sp = s / k;                                                                              /* e sin(k) / k */
+        srs->hz[i] = (float)hz;                                                                  /* set frequency */
+        srs->b0[i] = (float)(1.0 - sp);                                                          /* set b0 */
+        srs->b1[i] = (float)(2.0 * (sp - c));                                                    /* set b1 */
+        srs->b2[i] = (float)(e * e - sp);                                                        /* set b2 */
+        srs->a1[i] = (float)(2.0 * c);                                                           /* set a1 */
+        srs->a2[i] = (float)(-e * e);                                                            /* set a2 */
+    }
+    srs->count = count;                                                                          /* set count */
+    a_adxl345_srs_clear(srs);                                                                    /* restart the event */
+    
+    return 0;                                                                                    /* success return 0 */
+}
+
+/**
+ * @brief     reset the srs engine
+ * @param[in] *srs pointer to an adxl345 srs structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 srs is NULL
+ *            - 3 srs is not initialized
+ * @note      the oscillators and the peaks are cleared for a new event, the grid is kept
+ */
+uint8_t adxl345_srs_reset(adxl345_srs_t *srs)
+{
+    if (srs == NULL)                  /* check srs */
+    {
+        return 2;                     /* return error */
+    }
+    if (srs->inited != 1)             /* check srs initialization */
+    {
+        return 3;                     /* return error */
+    }
+    
+    a_adxl345_srs_clear(srs);         /* restart the event */
+    
+    return 0;                         /* success return 0 */
+}
+
+/**
+ * @brief     update the srs engine
+ * @param[in] *srs pointer to an adxl345 srs structure
+ * @param[in] **g pointer to a converted data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 2 srs is NULL
+ *            - 3 srs is not initialized
+ * @note      the event may come in fifo drains or as one capture, the first sample after a reset is the pre
+ *            event level and is taken off every sample so the gravity doesn't ring the oscillators
+ */
+uint8_t adxl345_srs_update(adxl345_srs_t *srs, float (*g)[3], uint16_t len)
+{
+    uint16_t i;
+    uint8_t j;
+    
+    if (srs == NULL)                                            /* check srs */
+    {
+        return 2;                                               /* return error */
+    }
+    if (srs->inited != 1)                                       /* check srs initialization */
+    {
+        return 3;                                               /* return error */
+    }
+    
+    if ((srs->samples == 0) && (len > 0))                       /* if the event starts */
+    {
+        for (j = 0; j < 3; j++)                                 /* run all axes */
+        {
+            srs->base[j] = g[0][j];                             /* set pre event level */
+        }
+    }
+    for (i = 0; i < len; i++)                                   /* run all samples */
+    {
+        for (j = 0; j < 3; j++)                                 /* run all axes */
+        {
+            a_adxl345_srs_sample(srs, j, g[i][j] - srs->base[j]); /* run the oscillators */
+        }
+    }
+    srs->samples += len;                                        /* samples += len */
+    
+    return 0;                                                   /* success return 0 */
+}
+
+/**
+ * @brief      get the maximax spectrum of the event
+ * @param[in]  *srs pointer to an adxl345 srs structure
+ * @param[out] *hz pointer to a natural frequency buffer
+ * @param[out] **maximax pointer to a count x 3 maximax buffer in g
+ * @param[out] *count pointer to a natural frequency count buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 no event
+ *             - 2 srs is NULL
+ *             - 3 srs is not initialized
+ * @note       none
+ */
+uint8_t adxl345_srs_get(adxl345_srs_t *srs, float *hz, float (*maximax)[3], uint16_t *count)
+{
+    uint16_t i;
+    uint8_t j;
+    
+    if (srs == NULL)                                                               /* check srs */
+    {
+        return 2;                                                                  /* return error */
+    }
+    if (srs->inited != 1)                                                          /* check srs initialization */
+    {
+        return 3;                                                                  /* return error */
+    }
+    if ((srs->samples == 0) || (srs->count == 0))                                  /* check event */
+    {
+        return 1;                                                                  /* return error */
+    }
+    
+    for (i = 0; i < srs->count; i++)                                               /* run all frequencies */
+    {
+        hz[i] = srs->hz[i];                                                        /* get frequency */
+        for (j = 0; j < 3; j++)                                                    /* run all axes */
+        {
+            maximax[i][j] = (srs->positive[j][i] > -srs->negative[j][i]) ?
+                            srs->positive[j][i] : -srs->negative[j][i];            /* larger of both signs */
+        }
+    }
+    *count = srs->count;                                                           /* get count */
+    
+    return 0;                                                                      /* success return 0 */
+}
@@ -0,0 +1,164 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_adxl345_srs.h
+ * @brief     driver adxl345 srs header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_ADXL345_SRS_H
+#define DRIVER_ADXL345_SRS_H
+
+#include "driver_adxl345.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup adxl345_srs_driver adxl345 srs driver function
+ * @brief    adxl345 srs driver modules
+ * @ingroup  adxl345_driver
+ * @{
+ */
+
+/**
+ * @brief srs frequency definition
+ */
+#define ADXL345_SRS_MAX_FREQ        256        /**< largest natural frequency count of a grid */
+
+/**
+ * @brief adxl345 srs structure definition
+ */
+typedef struct adxl345_srs_s
+{
+    float hz[ADXL345_SRS_MAX_FREQ];                /**< natural frequencies */
+    float b0[ADXL345_SRS_MAX_FREQ];                /**< input coefficient of every oscillator */
+    float b1[ADXL345_SRS_MAX_FREQ];                /**< last input coefficient of every oscillator */
+    float b2[ADXL345_SRS_MAX_FREQ];                /**< input before the last coefficient of every oscillator */
+    float a1[ADXL345_SRS_MAX_FREQ];                /**< last response coefficient of every oscillator */
+    float a2[ADXL345_SRS_MAX_FREQ];                /**< response before the last coefficient of every oscillator */
+    float y1[3][ADXL345_SRS_MAX_FREQ];             /**< last response of every axis in g */
+    float y2[3][ADXL345_SRS_MAX_FREQ];             /**< response before the last of every axis in g */
+    float positive[3][ADXL345_SRS_MAX_FREQ];       /**< largest positive response of every axis in g */
+    float negative[3][ADXL345_SRS_MAX_FREQ];       /**< largest negative response of every axis in g */
+    float x1[3];                                   /**< last input of every axis in g */
+    float x2[3];                                   /**< input before the last of every axis in g */
+    float base[3];                                 /**< pre event level of every axis in g */
+    float rate_hz;                                 /**< output data rate */
+    float damping;                                 /**< damping ratio of the oscillators */
+    uint16_t count;                                /**< natural frequency count */
+    uint32_t samples;                              /**< samples of the event */
+    uint8_t inited;                                /**< inited flag */
+} adxl345_srs_t;
+
+/**
+ * @brief     initialize the srs engine
+ * @param[in] *srs pointer to an adxl345 srs structure
+ * @param[in] rate output data rate of the chip
+ * @param[in] q quality factor of the oscillators
+ * @return    status code
+ *            - 0 success
+ *            - 2 srs is NULL
+ *            - 4 param is invalid
+ * @note      q is above 0.5, 10 is the usual shock qualification damping of 5 percent,
+ *            the engine starts without a grid
+ */
+uint8_t adxl345_srs_init(adxl345_srs_t *srs, adxl345_rate_t rate, float q);
+
+/**
+ * @brief     set the natural frequency grid of the srs engine
+ * @param[in] *srs pointer to an adxl345 srs structure
+ * @param[in] start_hz lowest natural frequency
+ * @param[in] stop_hz highest natural frequency
+ * @param[in] count natural frequency count
+ * @return    status code
+ *            - 0 success
+ *            - 2 srs is NULL
+ *            - 3 srs is not initialized
+ *            - 4 param is invalid
+ * @note      the frequencies are spaced evenly on a log scale, count is from 1 to ADXL345_SRS_MAX_FREQ,
+ *            stop_hz is below half the rate and should stay below a tenth of it where the ramp invariant
+ *            filter matches the analog oscillator, the event is restarted
+ */
+uint8_t adxl345_srs_set_grid(adxl345_srs_t *srs, float start_hz, float stop_hz, uint16_t count);
+
+/**
+ * @brief     reset the srs engine
+ * @param[in] *srs pointer to an adxl345 srs structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 srs is NULL
+ *            - 3 srs is not initialized
+ * @note      the oscillators and the peaks are cleared for a new event, the grid is kept
+ */
+uint8_t adxl345_srs_reset(adxl345_srs_t *srs);
+
+/**
+ * @brief     update the srs engine
+ * @param[in] *srs pointer to an adxl345 srs structure
+ * @param[in] **g pointer to a converted data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 2 srs is NULL
+ *            - 3 srs is not initialized
+ * @note      the event may come in fifo drains or as one capture, the first sample after a reset is the pre
+ *            event level and is taken off every sample so the gravity doesn't ring the oscillators,
+ *            every oscillator is a smallwood ramp invariant recursive filter of the absolute acceleration
+ */
+uint8_t adxl345_srs_update(adxl345_srs_t *srs, float (*g)[3], uint16_t len);
+
+/**
+ * @brief      get the maximax spectrum of the event
+ * @param[in]  *srs pointer to an adxl345 srs structure
+ * @param[out] *hz pointer to a natural frequency buffer
+ * @param[out] **maximax pointer to a count x 3 maximax buffer in g
+ * @param[out] *count pointer to a natural frequency count buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 no event
+ *             - 2 srs is NULL
+ *             - 3 srs is not initialized
+ * @note       the maximax is the larger of the positive and the negative peaks,
+ *             the peaks of both signs are kept in the structure
+ */
+uint8_t adxl345_srs_get(adxl345_srs_t *srs, float *hz, float (*maximax)[3], uint16_t *count);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,366 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_adxl345_velocity.c
+ * @brief     driver adxl345 velocity source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_adxl345_velocity.h"
+#include <math.h>
+
+/**
+ * @brief velocity definition
+ */
+#define ADXL345_VELOCITY_GRAVITY        9806.65        /**< standard gravity in mm/s2 */
+#define ADXL345_VELOCITY_Q              0.7071068f     /**< quality factor of a second order butterworth section */
+
+/**
+ * @brief     clear the block sums
+ * @param[in] *velocity pointer to an adxl345 velocity structure
+ * @note      none
+ */
+static void a_adxl345_velocity_clear(adxl345_velocity_t *velocity)
+{
+    memset(velocity->sum_2, 0, sizeof(velocity->sum_2)); /* clear square sum */
+    memset(velocity->peak, 0, sizeof(velocity->peak));   /* clear peak */
+    velocity->count = 0;                                 /* clear count */
+}
+
+/**
+ * @brief     get the zone of an rms
+ * @param[in] *velocity pointer to an adxl345 velocity structure
+ * @param[in] rms velocity rms in mm/s
+ * @return    zone
+ * @note      none
+ */
+static adxl345_velocity_zone_t a_adxl345_velocity_zone(adxl345_velocity_t *velocity, float rms)
+{
+    if (velocity->limit[0] <= 0.0f)        /* if no limits */
+    {
+        return ADXL345_VELOCITY_ZONE_NONE; /* no zone */
+    }
+    else if (rms < velocity->limit[0])     /* below a_b */
+    {
+        return ADXL345_VELOCITY_ZONE_A;    /* zone a */
+    }
+    else if (rms < velocity->limit[1])     /* below b_c */
+    {
+        return ADXL345_VELOCITY_ZONE_B;    /* zone b */
+    }
+    else if (rms < velocity->limit[2])     /* below c_d */
+    {
+        return ADXL345_VELOCITY_ZONE_C;    /* zone c */
+    }
+    else                                   /* above c_d */
+    {
+        return ADXL345_VELOCITY_ZONE_D;    /* zone d */
+    }
+}
+
+/**
+ * @brief     finish a block
+ * @param[in] *velocity pointer to an adxl345 velocity structure
+ * @note      none
+ */
+static void a_adxl345_velocity_finish(adxl345_velocity_t *velocity)
+{
+    adxl345_velocity_result_t *result = &velocity->result;
+    uint8_t j;
+    
+    result->count = velocity->count;                                                         /* set count */
+    result->worst = ADXL345_VELOCITY_ZONE_NONE;                                              /* clear worst zone */
+    for (j = 0; j < 3; j++)                                                                  /* run all axes */
+    {
+        result->rms[j] = (float)sqrt(velocity->sum_2[j] / (double)velocity->count);          /* set rms */
+        result->peak[j] = velocity->peak[j];                                                 /* set peak */
+        result->zone[j] = a_adxl345_velocity_zone(velocity, result->rms[j]);                 /* set zone */
+        result->worst = (result->zone[j] > result->worst) ? result->zone[j] : result->worst; /* update worst zone */
+    }
+    velocity->blocks++;                                                                      /* blocks++ */
+    a_adxl345_velocity_clear(velocity);                                                      /* start the next block */
+}
+
+/**
+ * @brief     initialize the velocity stage
+ * @param[in] *velocity pointer to an adxl345 velocity structure
+ * @param[in] rate output data rate of the chip
+ * @param[in] low_hz lower band edge
+ * @param[in] high_hz upper band edge
+ * @param[in] block samples of one block
+ * @param[in] *callback pointer to a block callback function address
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ *            - 2 velocity is NULL
+ *            - 4 param is invalid
+ * @note      the band edges are second order butterworth, 10Hz and 1000Hz for the usual severity band,
+ *            high_hz is below half the rate, the zones start unset and the callback may be NULL
+ */
+uint8_t adxl345_velocity_init(adxl345_velocity_t *velocity, adxl345_rate_t rate, float low_hz, float high_hz,
+                              uint32_t block,
+                              void (*callback)(adxl345_velocity_t *velocity, const adxl345_velocity_result_t *result))
+{
+    uint8_t res;
+    
+    if (velocity == NULL)                                                      /* check velocity */
+    {
+        return 2;                                                              /* return error */
+    }
+    if ((block == 0) || (low_hz <= 0.0f) || (high_hz <= low_hz))               /* check param */
+    {
+        return 4;                                                              /* return error */
+    }
+    
+    memset(velocity, 0, sizeof(adxl345_velocity_t));                           /* clear the stage */
+    res = adxl345_biquad_init(&velocity->pre, rate);                           /* init the pre filter */
+    if (res == 0)                                                              /* if ok */
+    {
+        res = adxl345_biquad_add_section(&velocity->pre, ADXL345_BIQUAD_TYPE_HIGH_PASS,
+                                         low_hz, ADXL345_VELOCITY_Q);          /* remove gravity and offset */
+    }
+    if (res == 0)                                                              /* if ok */
+    {
+        res = adxl345_biquad_init(&velocity->post, rate);                      /* init the post filter */
+    }
+    if (res == 0)                                                              /* if ok */
+    {
+        res = adxl345_biquad_add_section(&velocity->post, ADXL345_BIQUAD_TYPE_HIGH_PASS,
+                                         low_hz, ADXL345_VELOCITY_Q);          /* remove drift */
+    }
+    if (res == 0)                                                              /* if ok */
+    {
+        res = adxl345_biquad_add_section(&velocity->post, ADXL345_BIQUAD_TYPE_LOW_PASS,
+                                         high_hz, ADXL345_VELOCITY_Q);         /* limit the band */
+    }
+    if (res == 4)                                                              /* check rate and frequencies */
+    {
+        return 4;                                                              /* return error */
+    }
+    else if (res != 0)                                                         /* check the result */
+    {
+        return 1;                                                              /* return error */
+    }
+    velocity->step = (float)(ADXL345_VELOCITY_GRAVITY / 2.0 /
+                             (3200.0 / (double)(1U << (15 - (rate & 0x0F))))); /* set trapezoid step */
+    velocity->block = block;                                                   /* set block */
+    velocity->callback = callback;                                             /* set callback */
+    velocity->inited = 1;                                                      /* flag finish initialization */
+    
+    return 0;                                                                  /* success return 0 */
+}
+
+/**
+ * @brief     set the zone limits of the velocity stage
+ * @param[in] *velocity pointer to an adxl345 velocity structure
+ * @param[in] a_b limit between the zones a and b in mm/s
+ * @param[in] b_c limit between the zones b and c in mm/s
+ * @param[in] c_d limit between the zones c and d in mm/s
+ * @return    status code
+ *            - 0 success
+ *            - 2 velocity is NULL
+ *            - 3 velocity is not initialized
+ *            - 4 param is invalid
+ * @note      the limits rise, all 0 disables the zones, an rms equal to a limit is in the upper zone
+ */
+uint8_t adxl345_velocity_set_zone(adxl345_velocity_t *velocity, float a_b, float b_c, float c_d)
+{
+    if (velocity == NULL)                              /* check velocity */
+    {
+        return 2;                                      /* return error */
+    }
+    if (velocity->inited != 1)                         /* check velocity initialization */
+    {
+        return 3;                                      /* return error */
+    }
+    if (!((a_b == 0.0f) && (b_c == 0.0f) && (c_d == 0.0f)) &&
+        !((a_b > 0.0f) && (b_c > a_b) && (c_d > b_c))) /* check limits */
+    {
+        return 4;                                      /* return error */
+    }
+    
+    velocity->limit[0] = a_b;                          /* set a_b */
+    velocity->limit[1] = b_c;                          /* set b_c */
+    velocity->limit[2] = c_d;                          /* set c_d */
+    
+    return 0;                                          /* success return 0 */
+}
+
+/**
+ * @brief     reset the velocity stage
+ * @param[in] *velocity pointer to an adxl345 velocity structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 velocity is NULL
+ *            - 3 velocity is not initialized
+ * @note      the filters and the integrator are cleared and the block being filled is restarted
+ */
+uint8_t adxl345_velocity_reset(adxl345_velocity_t *velocity)
+{
+    if (velocity == NULL)                                      /* check velocity */
+    {
+        return 2;                                              /* return error */
+    }
+    if (velocity->inited != 1)                                 /* check velocity initialization */
+    {
+        return 3;                                              /* return error */
+    }
+    
+    (void)adxl345_biquad_reset(&velocity->pre);                /* clear the pre filter */
+    (void)adxl345_biquad_reset(&velocity->post);               /* clear the post filter */
+    memset(velocity->last, 0, sizeof(velocity->last));         /* clear last acceleration */
+    memset(velocity->integral, 0, sizeof(velocity->integral)); /* clear integrator */
+    a_adxl345_velocity_clear(velocity);                        /* restart the block */
+    
+    return 0;                                                  /* success return 0 */
+}
+
+/**
+ * @brief         update the velocity stage
+ * @param[in]     *velocity pointer to an adxl345 velocity structure
+ * @param[in,out] **g pointer to a converted data buffer
+ * @param[in]     len length of the data buffer
+ * @return        status code
+ *                - 0 success
+ *                - 2 velocity is NULL
+ *                - 3 velocity is not initialized
+ * @note          the samples are replaced by the velocity in mm/s in place, a batch may end anywhere in a
+ *                block, the result is made and the callback runs at the end of every block
+ */
+uint8_t adxl345_velocity_update(adxl345_velocity_t *velocity, float (*g)[3], uint16_t len)
+{
+    float step;
+    float last[3];
+    float integral[3];
+    double sum_2[3];
+    float peak[3];
+    float a;
+    float v;
+    uint32_t n;
+    uint32_t i;
+    uint8_t j;
+    
+    if (velocity == NULL)                                              /* check velocity */
+    {
+        return 2;                                                      /* return error */
+    }
+    if (velocity->inited != 1)                                         /* check velocity initialization */
+    {
+        return 3;                                                      /* return error */
+    }
+    
+    step = velocity->step;                                             /* get trapezoid step */
+    while (len > 0)                                                    /* run all samples */
+    {
+        n = velocity->block - velocity->count;                         /* samples left in the block */
+        n = (n < len) ? n : len;                                       /* limit to the batch */
+        for (j = 0; j < 3; j++)                                        /* run all axes */
+        {
+            last[j] = velocity->last[j];                               /* load last acceleration */
+            integral[j] = velocity->integral[j];                       /* load integrator */
+            sum_2[j] = velocity->sum_2[j];                             /* load square sum */
+            peak[j] = velocity->peak[j];                               /* load peak */
+        }
+        (void)adxl345_biquad_process(&velocity->pre, g, (uint16_t)n);  /* remove gravity and offset */
+        for (i = 0; i < n; i++)                                        /* run the chunk */
+        {
+            for (j = 0; j < 3; j++)                                    /* run all axes */
+            {
+                a = g[i][j];                                           /* get acceleration */
+                integral[j] += step * (a + last[j]);                   /* trapezoid integration */
+                last[j] = a;                                           /* save acceleration */
+                g[i][j] = integral[j];                                 /* write velocity */
+            }
+        }
+        (void)adxl345_biquad_process(&velocity->post, g, (uint16_t)n); /* remove drift and limit the band */
+        for (i = 0; i < n; i++)                                        /* run the chunk */
+        {
+            for (j = 0; j < 3; j++)                                    /* run all axes */
+            {
+                v = g[i][j];                                           /* get velocity */
+                sum_2[j] += (double)v * v;                             /* sum squares */
+                v = fabsf(v);                                          /* get absolute */
+                peak[j] = (v > peak[j]) ? v : peak[j];                 /* update peak */
+            }
+        }
+        for (j = 0; j < 3; j++)                                        /* run all axes */
+        {
+            velocity->last[j] = last[j];                               /* save last acceleration */
+            velocity->integral[j] = integral[j];                       /* save integrator */
+            velocity->sum_2[j] = sum_2[j];                             /* save square sum */
+            velocity->peak[j] = peak[j];                               /* save peak */
+        }
+        velocity->count += n;                                          /* count += n */
+        g += n;                                                        /* next chunk */
+        len = (uint16_t)(len - n);                                     /* len -= n */
+        if (velocity->count == velocity->block)                        /* if the block is full */
+        {
+            a_adxl345_velocity_finish(velocity);                       /* finish the block */
+            if (velocity->callback != NULL)                            /* if the callback is linked */
+            {
+                velocity->callback(velocity, &velocity->result);       /* run callback */
+            }
+        }
+    }
+    
+    return 0;                                                          /* success return 0 */
+}
+
+/**
+ * @brief      get the result of the last block
+ * @param[in]  *velocity pointer to an adxl345 velocity structure
+ * @param[out] *result pointer to an adxl345 velocity result structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 no block
+ *             - 2 velocity is NULL
+ *             - 3 velocity is not initialized
+ * @note       none
+ */
+uint8_t adxl345_velocity_get(adxl345_velocity_t *velocity, adxl345_velocity_result_t *result)
+{
+    if (velocity == NULL)                                                 /* check velocity */
+    {
+        return 2;                                                         /* return error */
+    }
+    if (velocity->inited != 1)                                            /* check velocity initialization */
+    {
+        return 3;                                                         /* return error */
+    }
+    if (velocity->blocks == 0)                                            /* check blocks */
+    {
+        return 1;                                                         /* return error */
+    }
+    
+    memcpy(result, &velocity->result, sizeof(adxl345_velocity_result_t)); /* copy result */
+    
+    return 0;                                                             /* success return 0 */
+}
@@ -0,0 +1,180 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_adxl345_velocity.h
+ * @brief     driver adxl345 velocity header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_ADXL345_VELOCITY_H
+#define DRIVER_ADXL345_VELOCITY_H
+
+#include "driver_adxl345_biquad.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup adxl345_velocity_driver adxl345 velocity driver function
+ * @brief    adxl345 velocity driver modules
+ * @ingroup  adxl345_driver
+ * @{
+ */
+
+/**
+ * @brief adxl345 velocity zone enumeration definition
+ */
+typedef enum
+{
+    ADXL345_VELOCITY_ZONE_NONE = 0x00,        /**< no zone limits */
+    ADXL345_VELOCITY_ZONE_A    = 0x01,        /**< newly commissioned */
+    ADXL345_VELOCITY_ZONE_B    = 0x02,        /**< unrestricted long term operation */
+    ADXL345_VELOCITY_ZONE_C    = 0x03,        /**< restricted operation */
+    ADXL345_VELOCITY_ZONE_D    = 0x04,        /**< damage */
+} adxl345_velocity_zone_t;
+
+/**
+ * @brief adxl345 velocity result structure definition
+ */
+typedef struct adxl345_velocity_result_s
+{
+    uint32_t count;                            /**< samples of the block */
+    float rms[3];                              /**< velocity rms in mm/s */
+    float peak[3];                             /**< absolute velocity peak in mm/s */
+    adxl345_velocity_zone_t zone[3];           /**< zone of every axis */
+    adxl345_velocity_zone_t worst;             /**< worst zone of the axes */
+} adxl345_velocity_result_t;
+
+/**
+ * @brief adxl345 velocity structure definition
+ */
+typedef struct adxl345_velocity_s
+{
+    adxl345_biquad_t pre;                                                                                    /**< high pass before the integration */
+    adxl345_biquad_t post;                                                                                   /**< high pass and low pass after the integration */
+    float last[3];                                                                                           /**< last acceleration of every axis in g */
+    float integral[3];                                                                                       /**< integrator of every axis in mm/s */
+    float step;                                                                                              /**< half the sample period times the gravity in mm/s per g */
+    float limit[3];                                                                                          /**< zone limits in mm/s */
+    double sum_2[3];                                                                                         /**< sum of the velocity squares */
+    float peak[3];                                                                                           /**< absolute velocity peak */
+    adxl345_velocity_result_t result;                                                                        /**< last block result */
+    uint32_t block;                                                                                          /**< samples of one block */
+    uint32_t count;                                                                                          /**< samples of the block being filled */
+    uint32_t blocks;                                                                                         /**< finished blocks */
+    void (*callback)(struct adxl345_velocity_s *velocity, const adxl345_velocity_result_t *result);           /**< block callback */
+    void *user;                                                                                              /**< user data */
+    uint8_t inited;                                                                                          /**< inited flag */
+} adxl345_velocity_t;
+
+/**
+ * @brief     initialize the velocity stage
+ * @param[in] *velocity pointer to an adxl345 velocity structure
+ * @param[in] rate output data rate of the chip
+ * @param[in] low_hz lower band edge
+ * @param[in] high_hz upper band edge
+ * @param[in] block samples of one block
+ * @param[in] *callback pointer to a block callback function address
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ *            - 2 velocity is NULL
+ *            - 4 param is invalid
+ * @note      the band edges are second order butterworth, 10Hz and 1000Hz for the usual severity band,
+ *            high_hz is below half the rate, the zones start unset and the callback may be NULL
+ */
+uint8_t adxl345_velocity_init(adxl345_velocity_t *velocity, adxl345_rate_t rate, float low_hz, float high_hz,
+                              uint32_t block,
+                              void (*callback)(adxl345_velocity_t *velocity, const adxl345_velocity_result_t *result));
+
+/**
+ * @brief     set the zone limits of the velocity stage
+ * @param[in] *velocity pointer to an adxl345 velocity structure
+ * @param[in] a_b limit between the zones a and b in mm/s
+ * @param[in] b_c limit between the zones b and c in mm/s
+ * @param[in] c_d limit between the zones c and d in mm/s
+ * @return    status code
+ *            - 0 success
+ *            - 2 velocity is NULL
+ *            - 3 velocity is not initialized
+ *            - 4 param is invalid
+ * @note      the limits rise, all 0 disables the zones, an rms equal to a limit is in the upper zone
+ */
+uint8_t adxl345_velocity_set_zone(adxl345_velocity_t *velocity, float a_b, float b_c, float c_d);
+
+/**
+ * @brief     reset the velocity stage
+ * @param[in] *velocity pointer to an adxl345 velocity structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 velocity is NULL
+ *            - 3 velocity is not initialized
+ * @note      the filters and the integrator are cleared and the block being filled is restarted
+ */
+uint8_t adxl345_velocity_reset(adxl345_velocity_t *velocity);
+
+/**
+ * @brief         update the velocity stage
+ * @param[in]     *velocity pointer to an adxl345 velocity structure
+ * @param[in,out] **g pointer to a converted data buffer
+ * @param[in]     len length of the data buffer
+ * @return        status code
+ *                - 0 success
+ *                - 2 velocity is NULL
+ *                - 3 velocity is not initialized
+ * @note          the samples are replaced by the velocity in mm/s in place, a batch may end anywhere in a
+ *                block, the result is made and the callback runs at the end of every block
+ */
+uint8_t adxl345_velocity_update(adxl345_velocity_t *velocity, float (*g)[3], uint16_t len);
+
+/**
+ * @brief      get the result of the last block
+ * @param[in]  *velocity pointer to an adxl345 velocity structure
+ * @param[out] *result pointer to an adxl345 velocity result structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 no block
+ *             - 2 velocity is NULL
+ *             - 3 velocity is not initialized
+ * @note       none
+ */
+uint8_t adxl345_velocity_get(adxl345_velocity_t *velocity, adxl345_velocity_result_t *result);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
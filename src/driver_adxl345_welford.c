@@ -0,0 +1,215 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_adxl345_welford.c
+ * @brief     driver adxl345 welford source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_adxl345_welford.h"
+#include <float.h>
+#include <math.h>
+
+/**
+ * @brief     clear an accumulator
+ * @param[in] *welford pointer to an adxl345 welford structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 welford is NULL
+ * @note      an empty accumulator is the identity of adxl345_welford_merge
+ */
+uint8_t adxl345_welford_clear(adxl345_welford_t *welford)
+{
+    uint8_t i;
+    
+    if (welford == NULL)            /* check welford */
+    {
+        return 2;                   /* return error */
+    }
+    
+    welford->count = 0;             /* clear count */
+    for (i = 0; i < 3; i++)         /* run all axes */
+    {
+        welford->mean[i] = 0.0;     /* clear mean */
+        welford->m2[i] = 0.0;       /* clear squared distances */
+        welford->min[i] = FLT_MAX;  /* set min */
+        welford->max[i] = -FLT_MAX; /* set max */
+    }
+    
+    return 0;                       /* success return 0 */
+}
+
+/**
+ * @brief     update an accumulator
+ * @param[in] *welford pointer to an adxl345 welford structure
+ * @param[in] **g pointer to a converted data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 2 welford is NULL
+ *            - 4 g is NULL
+ * @note      the mean and the squared distances of the batch are taken in two passes and merged into the
+ *            accumulator with the welford update, so a large offset like the gravity doesn't cancel
+ */
+uint8_t adxl345_welford_update(adxl345_welford_t *welford, float (*g)[3], uint16_t len)
+{
+    adxl345_welford_t batch;
+    double sum[3];
+    double d;
+    uint16_t n;
+    uint8_t i;
+    
+    if (welford == NULL)                                                      /* check welford */
+    {
+        return 2;                                                             /* return error */
+    }
+    if (len == 0)                                                             /* check len */
+    {
+        return 0;                                                             /* nothing to add */
+    }
+    if (g == NULL)                                                            /* check g */
+    {
+        return 4;                                                             /* return error */
+    }
+    
+    (void)adxl345_welford_clear(&batch);                                            /* clear the batch */
+    for (i = 0; i < 3; i++)                                                   /* run all axes */
+    {
+        sum[i] = 0.0;                                                         /* clear sum */
+    }
+    for (n = 0; n < len; n++)                                                 /* run all samples */
+    {
+        for (i = 0; i < 3; i++)                                               /* run all axes */
+        {
+            sum[i] += g[n][i];                                                /* sum */
+            batch.min[i] = (g[n][i] < batch.min[i]) ? g[n][i] : batch.min[i]; /* update min */
+            batch.max[i] = (g[n][i] > batch.max[i]) ? g[n][i] : batch.max[i]; /* update max */
+        }
+    }
+    for (i = 0; i < 3; i++)                                                   /* run all axes */
+    {
+        batch.mean[i] = sum[i] / (double)len;                                 /* get batch mean */
+    }
+    for (n = 0; n < len; n++)                                                 /* run all samples */
+    {
+        for (i = 0; i < 3; i++)                                               /* run all axes */
+        {
+            d = g[n][i] - batch.mean[i];                                      /* distance from the mean */
+            batch.m2[i] += d * d;                                             /* sum squared distances */
+        }
+    }
+    batch.count = len;                                                        /* set batch count */
+    
+    return adxl345_welford_merge(welford, &batch, welford);                   /* merge the batch */
+}
+
+/**
+ * @brief      merge two accumulators
+ * @param[in]  *a pointer to an adxl345 welford structure
+ * @param[in]  *b pointer to an adxl345 welford structure
+ * @param[out] *out pointer to an adxl345 welford structure
+ * @return     status code
+ *             - 0 success
+ *             - 2 a, b or out is NULL
+ * @note       out may be a or b, so the accumulators of sub windows or of other threads combine into the
+ *             accumulator of all their samples
+ */
+uint8_t adxl345_welford_merge(const adxl345_welford_t *a, const adxl345_welford_t *b, adxl345_welford_t *out)
+{
+    uint64_t count;
+    double na;
+    double nb;
+    double delta;
+    uint8_t i;
+    
+    if ((a == NULL) || (b == NULL) || (out == NULL))                            /* check welford */
+    {
+        return 2;                                                               /* return error */
+    }
+    
+    count = a->count + b->count;                                                /* get count */
+    na = (double)a->count;                                                      /* get a count */
+    nb = (double)b->count;                                                      /* get b count */
+    if (count == 0)                                                             /* check count */
+    {
+        return adxl345_welford_clear(out);                                      /* both are empty */
+    }
+    
+    for (i = 0; i < 3; i++)                                                     /* run all axes */
+    {
+        delta = b->mean[i] - a->mean[i];                                        /* distance of the means */
+        out->m2[i] = a->m2[i] + b->m2[i] + delta * delta * na * nb / (na + nb); /* add squared distances */
+        out->mean[i] = a->mean[i] + delta * nb / (na + nb);                     /* move mean */
+        out->min[i] = (a->min[i] < b->min[i]) ? a->min[i] : b->min[i];          /* get min */
+        out->max[i] = (a->max[i] > b->max[i]) ? a->max[i] : b->max[i];          /* get max */
+    }
+    out->count = count;                                                         /* add count */
+    
+    return 0;                                                                   /* success return 0 */
+}
+
+/**
+ * @brief      compute the result of an accumulator
+ * @param[in]  *welford pointer to an adxl345 welford structure
+ * @param[out] *result pointer to an adxl345 welford result structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 accumulator is empty
+ *             - 2 welford or result is NULL
+ * @note       none
+ */
+uint8_t adxl345_welford_compute(const adxl345_welford_t *welford, adxl345_welford_result_t *result)
+{
+    double var;
+    uint8_t i;
+    
+    if ((welford == NULL) || (result == NULL))                                            /* check welford */
+    {
+        return 2;                                                                         /* return error */
+    }
+    if (welford->count == 0)                                                              /* check count */
+    {
+        return 1;                                                                         /* return error */
+    }
+    
+    result->count = welford->count;                                                       /* set count */
+    for (i = 0; i < 3; i++)                                                               /* run all axes */
+    {
+        var = (welford->count > 1) ? welford->m2[i] / (double)(welford->count - 1) : 0.0; /* get sample variance */
+        result->mean[i] = (float)welford->mean[i];                                        /* set mean */
+        result->variance[i] = (float)var;                                                 /* set variance */
+        result->std[i] = (float)sqrt(var);                                                /* set standard deviation */
+        result->min[i] = welford->min[i];                                                 /* set min */
+        result->max[i] = welford->max[i];                                                 /* set max */
+    }
+    
+    return 0;                                                                             /* success return 0 */
+}
@@ -0,0 +1,136 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_adxl345_welford.h
+ * @brief     driver adxl345 welford header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_ADXL345_WELFORD_H
+#define DRIVER_ADXL345_WELFORD_H
+
+#include "driver_adxl345.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup adxl345_welford_driver adxl345 welford driver function
+ * @brief    adxl345 welford driver modules
+ * @ingroup  adxl345_driver
+ * @{
+ */
+
+/**
+ * @brief adxl345 welford structure definition
+ * @note  the accumulator keeps no samples, m2 is the sum of the squared distances from the mean
+ */
+typedef struct adxl345_welford_s
+{
+    uint64_t count;           /**< sample count */
+    double mean[3];           /**< running mean */
+    double m2[3];             /**< sum of the squared distances from the mean */
+    float min[3];             /**< smallest sample */
+    float max[3];             /**< largest sample */
+} adxl345_welford_t;
+
+/**
+ * @brief adxl345 welford result structure definition
+ */
+typedef struct adxl345_welford_result_s
+{
+    uint64_t count;                 /**< sample count */
+    float mean[3];                  /**< mean in g */
+    float variance[3];              /**< sample variance in g2, 0 for a single sample */
+    float std[3];                   /**< sample standard deviation in g */
+    float min[3];                   /**< smallest sample in g */
+    float max[3];                   /**< largest sample in g */
+} adxl345_welford_result_t;
+
+/**
+ * @brief     clear an accumulator
+ * @param[in] *welford pointer to an adxl345 welford structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 welford is NULL
+ * @note      an empty accumulator is the identity of adxl345_welford_merge
+ */
+uint8_t adxl345_welford_clear(adxl345_welford_t *welford);
+
+/**
+ * @brief     update an accumulator
+ * @param[in] *welford pointer to an adxl345 welford structure
+ * @param[in] **g pointer to a converted data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 2 welford is NULL
+ *            - 4 g is NULL
+ * @note      the mean and the squared distances of the batch are taken in two passes and merged into the
+ *            accumulator with the welford update, so a large offset like the gravity doesn't cancel
+ */
+uint8_t adxl345_welford_update(adxl345_welford_t *welford, float (*g)[3], uint16_t len);
+
+/**
+ * @brief      merge two accumulators
+ * @param[in]  *a pointer to an adxl345 welford structure
+ * @param[in]  *b pointer to an adxl345 welford structure
+ * @param[out] *out pointer to an adxl345 welford structure
+ * @return     status code
+ *             - 0 success
+ *             - 2 a, b or out is NULL
+ * @note       out may be a or b, so the accumulators of sub windows or of other threads combine into the
+ *             accumulator of all their samples
+ */
+uint8_t adxl345_welford_merge(const adxl345_welford_t *a, const adxl345_welford_t *b, adxl345_welford_t *out);
+
+/**
+ * @brief      compute the result of an accumulator
+ * @param[in]  *welford pointer to an adxl345 welford structure
+ * @param[out] *result pointer to an adxl345 welford result structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 accumulator is empty
+ *             - 2 welford or result is NULL
+ * @note       none
+ */
+uint8_t adxl345_welford_compute(const adxl345_welford_t *welford, adxl345_welford_result_t *result);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
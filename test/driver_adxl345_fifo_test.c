@@ -128,6 +128,7 @@ uint8_t adxl345_fifo_test(adxl345_interface_t interface, adxl345_address_t addr_
     uint8_t timeout;
     uint8_t source;
     uint8_t status;
+    uint8_t level;
     int8_t reg;
     uint16_t len;
     adxl345_info_t info;
@@ -819,6 +820,16 @@ uint8_t adxl345_fifo_test(adxl345_interface_t interface, adxl345_address_t addr_
     
     /* delay 500ms */
     adxl345_interface_delay_ms(500);
+    
+    /* get fifo level */
+    res = adxl345_get_watermark_level(&gs_handle, &status);
+    if (res != 0)
+    {
+        adxl345_interface_debug_print("adxl345: get watermark level failed.\n");
+        (void)adxl345_deinit(&gs_handle);
+        
+        return 1;
+    }
     len = 20;
     if (adxl345_read(&gs_handle, (int16_t (*)[3])gs_raw_test, (float (*)[3])gs_test, (uint16_t *)&len) != 0)
     {
@@ -827,6 +838,25 @@ uint8_t adxl345_fifo_test(adxl345_interface_t interface, adxl345_address_t addr_
         
         return 1;
     }
+    res = adxl345_get_watermark_level(&gs_handle, &level);
+    if (res != 0)
+    {
+        adxl345_interface_debug_print("adxl345: get watermark level failed.\n");
+        (void)adxl345_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* the chip pops one entry per transaction, so every read entry must leave the fifo, */
+    /* one new sample may come during the read */
+    adxl345_interface_debug_print("adxl345: fifo drain read %d entries, level %d to %d.\n", len, status, level);
+    if ((len == 0) || (len + level > status + 1))
+    {
+        adxl345_interface_debug_print("adxl345: fifo drain check failed.\n");
+        (void)adxl345_deinit(&gs_handle);
+        
+        return 1;
+    }
     
     while (gs_watermark_flag < 3)
     {
@@ -0,0 +1,486 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_adxl345_shared_test.c
+ * @brief     driver adxl345 shared bus test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_adxl345_shared_test.h"
+
+static adxl345_handle_t gs_handle[2];          /**< adxl345 handles */
+static uint32_t gs_watermark[2];               /**< watermark counters */
+static uint32_t gs_sample[2];                  /**< sample counters */
+static uint8_t gs_error;                       /**< read error flag */
+static int16_t gs_raw_test[32][3];             /**< raw test buffer */
+static float gs_test[32][3];                   /**< test buffer */
+
+/**
+ * @brief  shared test irq
+ * @return status code
+ *         - 0 success
+ *         - 1 run failed
+ * @note   the irq handlers of both chips are run
+ */
+uint8_t adxl345_shared_test_irq_handler(void)
+{
+    uint8_t res;
+    uint8_t i;
+    
+    res = 0;
+    for (i = 0; i < 2; i++)
+    {
+        if (adxl345_irq_handler(&gs_handle[i]) != 0)
+        {
+            res = 1;
+        }
+    }
+    
+    return res;
+}
+
+/**
+ * @brief     drain the fifo of a chip
+ * @param[in] index chip index
+ * @note      none
+ */
+static void a_adxl345_shared_test_drain(uint8_t index)
+{
+    uint16_t len;
+    
+    len = 32;
+    if (adxl345_read(&gs_handle[index], (int16_t (*)[3])gs_raw_test, (float (*)[3])gs_test, (uint16_t *)&len) != 0)
+    {
+        adxl345_interface_debug_print("adxl345: read failed.\n");
+        gs_error = 1;
+        
+        return;
+    }
+    gs_watermark[index]++;
+    gs_sample[index] += len;
+}
+
+/**
+ * @brief     chip 0 receive callback
+ * @param[in] type irq type
+ * @note      none
+ */
+static void a_adxl345_shared_test_receive_callback_0(uint8_t type)
+{
+    if (type == ADXL345_INTERRUPT_WATERMARK)
+    {
+        a_adxl345_shared_test_drain(0);
+    }
+}
+
+/**
+ * @brief     chip 1 receive callback
+ * @param[in] type irq type
+ * @note      none
+ */
+static void a_adxl345_shared_test_receive_callback_1(uint8_t type)
+{
+    if (type == ADXL345_INTERRUPT_WATERMARK)
+    {
+        a_adxl345_shared_test_drain(1);
+    }
+}
+
+/**
+ * @brief     shared test chip init
+ * @param[in] index chip index
+ * @param[in] addr_pin iic device address
+ * @param[in] *callback pointer to a receive callback address
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      the chip streams at 800Hz with the watermark and the overrun on int1
+ */
+static uint8_t a_adxl345_shared_test_init(uint8_t index, adxl345_address_t addr_pin, void (*callback)(uint8_t type))
+{
+    const adxl345_interrupt_t off[6] = {ADXL345_INTERRUPT_DATA_READY, ADXL345_INTERRUPT_SINGLE_TAP,
+                                        ADXL345_INTERRUPT_DOUBLE_TAP, ADXL345_INTERRUPT_ACTIVITY,
+                                        ADXL345_INTERRUPT_INACTIVITY, ADXL345_INTERRUPT_FREE_FALL};
+    adxl345_handle_t *handle = &gs_handle[index];
+    uint8_t res;
+    uint8_t i;
+    
+    /* link interface function */
+    DRIVER_ADXL345_LINK_INIT(handle, adxl345_handle_t);
+    DRIVER_ADXL345_LINK_IIC_INIT(handle, adxl345_interface_iic_init);
+    DRIVER_ADXL345_LINK_IIC_DEINIT(handle, adxl345_interface_iic_deinit);
+    DRIVER_ADXL345_LINK_IIC_READ(handle, adxl345_interface_iic_read);
+    DRIVER_ADXL345_LINK_IIC_WRITE(handle, adxl345_interface_iic_write);
+    DRIVER_ADXL345_LINK_SPI_INIT(handle, adxl345_interface_spi_init);
+    DRIVER_ADXL345_LINK_SPI_DEINIT(handle, adxl345_interface_spi_deinit);
+    DRIVER_ADXL345_LINK_SPI_READ(handle, adxl345_interface_spi_read);
+    DRIVER_ADXL345_LINK_SPI_WRITE(handle, adxl345_interface_spi_write);
+    DRIVER_ADXL345_LINK_DELAY_MS(handle, adxl345_interface_delay_ms);
+    DRIVER_ADXL345_LINK_DEBUG_PRINT(handle, adxl345_interface_debug_print);
+    DRIVER_ADXL345_LINK_RECEIVE_CALLBACK(handle, callback);
+    
+    /* set iic interface */
+    res = adxl345_set_interface(handle, ADXL345_INTERFACE_IIC);
+    if (res != 0)
+    {
+        adxl345_interface_debug_print("adxl345: set interface failed.\n");
+       
+        return 1;
+    }
+    
+    /* set address pin */
+    res = adxl345_set_addr_pin(handle, addr_pin);
+    if (res != 0)
+    {
+        adxl345_interface_debug_print("adxl345: set addr pin failed.\n");
+       
+        return 1;
+    }
+    
+    /* adxl345 initialization */
+    res = adxl345_init(handle);
+    if (res != 0)
+    {
+        adxl345_interface_debug_print("adxl345: init failed.\n");
+       
+        return 1;
+    }
+    
+    /* set 800Hz rate */
+    res = adxl345_set_rate(handle, ADXL345_RATE_800);
+    if (res != 0)
+    {
+        adxl345_interface_debug_print("adxl345: set rate failed.\n");
+        (void)adxl345_deinit(handle);
+        
+        return 1;
+    }
+    
+    /* set interrupt low */
+    res = adxl345_set_interrupt_active_level(handle, ADXL345_INTERRUPT_ACTIVE_LEVEL_LOW);
+    if (res != 0)
+    {
+        adxl345_interface_debug_print("adxl345: set interrupt active level failed.\n");
+        (void)adxl345_deinit(handle);
+        
+        return 1;
+    }
+    
+    /* set full resolution */
+    res = adxl345_set_full_resolution(handle, ADXL345_BOOL_TRUE);
+    if (res != 0)
+    {
+        adxl345_interface_debug_print("adxl345: set full resolution failed.\n");
+        (void)adxl345_deinit(handle);
+        
+        return 1;
+    }
+    
+    /* set justify right */
+    res = adxl345_set_justify(handle, ADXL345_JUSTIFY_RIGHT);
+    if (res != 0)
+    {
+        adxl345_interface_debug_print("adxl345: set justify failed.\n");
+        (void)adxl345_deinit(handle);
+        
+        return 1;
+    }
+    
+    /* set range 16g */
+    res = adxl345_set_range(handle, ADXL345_RANGE_16G);
+    if (res != 0)
+    {
+        adxl345_interface_debug_print("adxl345: set range failed.\n");
+        (void)adxl345_deinit(handle);
+        
+        return 1;
+    }
+    
+    /* disable auto sleep */
+    res = adxl345_set_auto_sleep(handle, ADXL345_BOOL_FALSE);
+    if (res != 0)
+    {
+        adxl345_interface_debug_print("adxl345: set auto sleep failed.\n");
+        (void)adxl345_deinit(handle);
+        
+        return 1;
+    }
+    
+    /* disable sleep */
+    res = adxl345_set_sleep(handle, ADXL345_BOOL_FALSE);
+    if (res != 0)
+    {
+        adxl345_interface_debug_print("adxl345: set sleep failed.\n");
+        (void)adxl345_deinit(handle);
+        
+        return 1;
+    }
+    
+    /* set stream mode */
+    res = adxl345_set_mode(handle, ADXL345_MODE_STREAM);
+    if (res != 0)
+    {
+        adxl345_interface_debug_print("adxl345: set mode failed.\n");
+        (void)adxl345_deinit(handle);
+        
+        return 1;
+    }
+    
+    /* set trigger pin int 2 */
+    res = adxl345_set_trigger_pin(handle, ADXL345_INTERRUPT_PIN2);
+    if (res != 0)
+    {
+        adxl345_interface_debug_print("adxl345: set trigger pin failed.\n");
+        (void)adxl345_deinit(handle);
+        
+        return 1;
+    }
+    
+    /* set watermark 16 level */
+    res = adxl345_set_watermark(handle, 16);
+    if (res != 0)
+    {
+        adxl345_interface_debug_print("adxl345: set watermark failed.\n");
+        (void)adxl345_deinit(handle);
+        
+        return 1;
+    }
+    
+    /* disable the other interrupts */
+    for (i = 0; i < 6; i++)
+    {
+        res = adxl345_set_interrupt(handle, off[i], ADXL345_BOOL_FALSE);
+        if (res != 0)
+        {
+            adxl345_interface_debug_print("adxl345: set interrupt failed.\n");
+            (void)adxl345_deinit(handle);
+            
+            return 1;
+        }
+    }
+    
+    /* set interrupt 1 watermark */
+    res = adxl345_set_interrupt_map(handle, ADXL345_INTERRUPT_WATERMARK, ADXL345_INTERRUPT_PIN1);
+    if (res != 0)
+    {
+        adxl345_interface_debug_print("adxl345: set interrupt map failed.\n");
+        (void)adxl345_deinit(handle);
+        
+        return 1;
+    }
+    res = adxl345_set_interrupt(handle, ADXL345_INTERRUPT_WATERMARK, ADXL345_BOOL_TRUE);
+    if (res != 0)
+    {
+        adxl345_interface_debug_print("adxl345: set interrupt failed.\n");
+        (void)adxl345_deinit(handle);
+        
+        return 1;
+    }
+    
+    /* set interrupt 1 overrun */
+    res = adxl345_set_interrupt_map(handle, ADXL345_INTERRUPT_OVERRUN, ADXL345_INTERRUPT_PIN1);
+    if (res != 0)
+    {
+        adxl345_interface_debug_print("adxl345: set interrupt map failed.\n");
+        (void)adxl345_deinit(handle);
+        
+        return 1;
+    }
+    res = adxl345_set_interrupt(handle, ADXL345_INTERRUPT_OVERRUN, ADXL345_BOOL_TRUE);
+    if (res != 0)
+    {
+        adxl345_interface_debug_print("adxl345: set interrupt failed.\n");
+        (void)adxl345_deinit(handle);
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     shared test
+ * @param[in] times test times
+ * @return    status code
+ *            - 0 success
+ *            - 1 test failed
+ * @note      two chips with the address 0 and 1 stream at 800Hz on one iic bus,
+ *            int1 of both chips drives one interrupt line
+ */
+uint8_t adxl345_shared_test(uint32_t times)
+{
+    uint8_t res;
+    uint8_t i;
+    uint8_t source;
+    uint32_t timeout;
+    adxl345_stats_t stats;
+    adxl345_info_t info;
+    
+    /* get information */
+    res = adxl345_info(&info);
+    if (res != 0)
+    {
+        adxl345_interface_debug_print("adxl345: get info failed.\n");
+       
+        return 1;
+    }
+    else
+    {
+        /* print chip info */
+        adxl345_interface_debug_print("adxl345: chip is %s.\n", info.chip_name);
+        adxl345_interface_debug_print("adxl345: manufacturer is %s.\n", info.manufacturer_name);
+        adxl345_interface_debug_print("adxl345: interface is %s.\n", info.interface);
+        adxl345_interface_debug_print("adxl345: driver version is %d.%d.\n", info.driver_version / 1000, (info.driver_version % 1000) / 100);
+        adxl345_interface_debug_print("adxl345: min supply voltage is %0.1fV.\n", info.supply_voltage_min_v);
+        adxl345_interface_debug_print("adxl345: max supply voltage is %0.1fV.\n", info.supply_voltage_max_v);
+        adxl345_interface_debug_print("adxl345: max current is %0.2fmA.\n", info.max_current_ma);
+        adxl345_interface_debug_print("adxl345: max temperature is %0.1fC.\n", info.temperature_max);
+        adxl345_interface_debug_print("adxl345: min temperature is %0.1fC.\n", info.temperature_min);
+    }
+    
+    /* init both chips */
+    res = a_adxl345_shared_test_init(0, ADXL345_ADDRESS_ALT_0, a_adxl345_shared_test_receive_callback_0);
+    if (res != 0)
+    {
+        return 1;
+    }
+    res = a_adxl345_shared_test_init(1, ADXL345_ADDRESS_ALT_1, a_adxl345_shared_test_receive_callback_1);
+    if (res != 0)
+    {
+        (void)adxl345_deinit(&gs_handle[0]);
+        
+        return 1;
+    }
+    
+    /* start shared test */
+    adxl345_interface_debug_print("adxl345: start shared bus test.\n");
+    gs_watermark[0] = 0;
+    gs_watermark[1] = 0;
+    gs_sample[0] = 0;
+    gs_sample[1] = 0;
+    gs_error = 0;
+    for (i = 0; i < 2; i++)
+    {
+        /* clear interrupt */
+        res = adxl345_get_interrupt_source(&gs_handle[i], &source);
+        if (res != 0)
+        {
+            adxl345_interface_debug_print("adxl345: get interrupt source failed.\n");
+            (void)adxl345_deinit(&gs_handle[0]);
+            (void)adxl345_deinit(&gs_handle[1]);
+            
+            return 1;
+        }
+        
+        /* clear the counters */
+        res = adxl345_reset_stats(&gs_handle[i]);
+        if (res != 0)
+        {
+            adxl345_interface_debug_print("adxl345: reset stats failed.\n");
+            (void)adxl345_deinit(&gs_handle[0]);
+            (void)adxl345_deinit(&gs_handle[1]);
+            
+            return 1;
+        }
+        
+        /* start measure */
+        res = adxl345_set_measure(&gs_handle[i], ADXL345_BOOL_TRUE);
+        if (res != 0)
+        {
+            adxl345_interface_debug_print("adxl345: set measure failed.\n");
+            (void)adxl345_deinit(&gs_handle[0]);
+            (void)adxl345_deinit(&gs_handle[1]);
+            
+            return 1;
+        }
+    }
+    
+    /* every watermark drains 16 samples of each chip in 20ms */
+    timeout = 0;
+    while ((gs_watermark[0] < times) || (gs_watermark[1] < times))
+    {
+        timeout++;
+        if ((timeout > times * 10 + 100) || (gs_error != 0))
+        {
+            adxl345_interface_debug_print("adxl345: shared bus test timeout.\n");
+            (void)adxl345_deinit(&gs_handle[0]);
+            (void)adxl345_deinit(&gs_handle[1]);
+            
+            return 1;
+        }
+        adxl345_interface_delay_ms(10);
+    }
+    
+    /* stop measure */
+    for (i = 0; i < 2; i++)
+    {
+        res = adxl345_set_measure(&gs_handle[i], ADXL345_BOOL_FALSE);
+        if (res != 0)
+        {
+            adxl345_interface_debug_print("adxl345: set measure failed.\n");
+            (void)adxl345_deinit(&gs_handle[0]);
+            (void)adxl345_deinit(&gs_handle[1]);
+            
+            return 1;
+        }
+    }
+    
+    /* check the lost samples */
+    for (i = 0; i < 2; i++)
+    {
+        res = adxl345_get_stats(&gs_handle[i], &stats);
+        if (res != 0)
+        {
+            adxl345_interface_debug_print("adxl345: get stats failed.\n");
+            (void)adxl345_deinit(&gs_handle[0]);
+            (void)adxl345_deinit(&gs_handle[1]);
+            
+            return 1;
+        }
+        adxl345_interface_debug_print("adxl345: chip %d drained %d samples in %d watermarks with %d overruns.\n",
+                                      i, gs_sample[i], gs_watermark[i], stats.overrun);
+        if ((stats.overrun != 0) || (stats.gap != 0) || (gs_sample[i] < gs_watermark[i] * 16))
+        {
+            adxl345_interface_debug_print("adxl345: chip %d lost samples on the shared bus.\n", i);
+            (void)adxl345_deinit(&gs_handle[0]);
+            (void)adxl345_deinit(&gs_handle[1]);
+            
+            return 1;
+        }
+    }
+    
+    /* finish shared test */
+    adxl345_interface_debug_print("adxl345: finish shared bus test.\n");
+    (void)adxl345_deinit(&gs_handle[0]);
+    (void)adxl345_deinit(&gs_handle[1]);
+    
+    return 0;
+}